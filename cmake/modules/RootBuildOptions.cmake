@@ -84,6 +84,7 @@ ROOT_BUILD_OPTION(builtin_xrootd OFF "Build the XROOTD internally (downloading t
 ROOT_BUILD_OPTION(builtin_llvm ON "Build the LLVM internally")
 ROOT_BUILD_OPTION(builtin_tbb OFF "Build the TBB internally")
 ROOT_BUILD_OPTION(builtin_vc OFF "Build the Vc package internally")
+ROOT_BUILD_OPTION(cblas OFF "Use a CBLAS library (e.g. OpenBLAS) for the matrix multiplications and decompositions of libMatrix")
 ROOT_BUILD_OPTION(cxx11 ON "Build using C++11 compatible mode, requires gcc > 4.7.x or clang")
 ROOT_BUILD_OPTION(cxx14 OFF "Build using C++14 compatible mode, requires gcc > 4.9.x or clang")
 ROOT_BUILD_OPTION(libcxx OFF "Build using libc++, requires cxx11 option (MacOS X only, for the time being)")
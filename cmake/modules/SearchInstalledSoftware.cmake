@@ -1243,6 +1243,24 @@ if(tmva)
   find_package(BLAS QUIET)
 endif()
 
+#---Check for a CBLAS library used by the matrix package-----------------------------
+if(cblas)
+  message(STATUS "Looking for CBLAS")
+  find_path(CBLAS_INCLUDE_DIR cblas.h PATH_SUFFIXES openblas)
+  find_library(CBLAS_LIBRARY NAMES openblas cblas blas)
+  if(CBLAS_INCLUDE_DIR AND CBLAS_LIBRARY)
+    set(CBLAS_LIBRARIES ${CBLAS_LIBRARY})
+  else()
+    if(fail-on-missing)
+      message(FATAL_ERROR "CBLAS library not found and is required (cblas option enabled)")
+    else()
+      message(STATUS "CBLAS not found. Switching off cblas option")
+      set(cblas OFF CACHE BOOL "" FORCE)
+    endif()
+  endif()
+  mark_as_advanced(CBLAS_INCLUDE_DIR CBLAS_LIBRARY)
+endif()
+
 #---Report non implemented options---------------------------------------------------
 foreach(opt afs glite sapdb srp)
   if(${opt})
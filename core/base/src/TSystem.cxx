@@ -2366,6 +2366,26 @@ int TSystem::SendRaw(int, const void *, int, int)
    return -1;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Send exactly the nbuf buffers, one after the other, as a single stream
+/// of bytes (gather write). Returns the total number of bytes sent or the
+/// SendRaw() error code of the first buffer that could not be sent.
+/// This default implementation simply calls SendRaw() for each buffer;
+/// system specific implementations hand all buffers to the kernel at once.
+
+int TSystem::SendRawv(int sock, const void **buffers, const int *lengths, int nbuf, int flag)
+{
+   int ntot = 0;
+   for (int i = 0; i < nbuf; i++) {
+      if (lengths[i] <= 0) continue;
+      int n = SendRaw(sock, buffers[i], lengths[i], flag);
+      if (n <= 0)
+         return n;
+      ntot += n;
+   }
+   return ntot;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Receive a buffer headed by a length indicator.
 
@@ -33,11 +33,17 @@
 
 typedef void (*SigHandler_t)(ESignals);
 
+class TEpollSet;
+struct pollfd;
+
 
 class TUnixSystem : public TSystem {
 
 private:
+   TEpollSet     *fEpoll;   //!epoll based monitoring of the file handlers (Linux only)
+
    void FillWithCwd(char *cwd) const;
+   void UseEpoll();
 
 protected:
    const char    *FindDynamicLibrary(TString &lib, Bool_t quiet = kFALSE);
@@ -54,6 +60,7 @@ protected:
    static int          UnixSetitimer(Long_t ms);
    static int          UnixSelect(Int_t nfds, TFdSet *readready, TFdSet *writeready,
                                   Long_t timeout);
+   static int          UnixPoll(struct pollfd *fds, unsigned long nfds, Long_t timeout);
    static void         UnixSignal(ESignals sig, SigHandler_t h);
    static const char  *UnixSigname(ESignals sig);
    static void         UnixSigAlarmInterruptsSyscalls(Bool_t set);
@@ -74,6 +81,7 @@ protected:
    static int          UnixUnixService(const char *sockpath, int backlog);
    static int          UnixRecv(int sock, void *buf, int len, int flag);
    static int          UnixSend(int sock, const void *buf, int len, int flag);
+   static int          UnixSendv(int sock, const void **bufs, const int *lens, int nbuf, int flag);
 
 public:
    TUnixSystem();
@@ -208,6 +216,7 @@ public:
    void              CloseConnection(int sock, Bool_t force = kFALSE);
    int               RecvRaw(int sock, void *buffer, int length, int flag);
    int               SendRaw(int sock, const void *buffer, int length, int flag);
+   int               SendRawv(int sock, const void **buffers, const int *lengths, int nbuf, int flag);
    int               RecvBuf(int sock, void *buffer, int length);
    int               SendBuf(int sock, const void *buffer, int length);
    int               SetSockOpt(int sock, int option, int val);
@@ -100,6 +100,7 @@
 #include <sys/time.h>
 #include <sys/file.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #if defined(R__AIX)
@@ -213,6 +214,14 @@ extern "C" {
    static const int kMAX_BACKTRACE_DEPTH = 128;
 #endif
 
+// scalable descriptor monitoring
+#if defined(R__LINUX) && !defined(R__WINGCC)
+#   define HAVE_EPOLL
+#   include <sys/epoll.h>
+#endif
+#include <poll.h>
+#include <vector>
+
 // FPE handling includes
 #if (defined(R__LINUX) && !defined(R__WINGCC))
 #include <fpu_control.h>
@@ -399,6 +408,196 @@ public:
    ULong_t *GetBits() { return (ULong_t *)fds_bits; }
 };
 
+//------------------- Linux TEpollSet ------------------------------------------
+//
+// Set of file handlers monitored via epoll(7). Used by the event loop
+// instead of the TFdSet masks when many descriptors are monitored: the
+// cost of a wait and of dispatching the ready descriptors is proportional
+// to the number of active descriptors, and descriptors beyond kFDSETSIZE
+// are supported.
+
+class TEpollSet {
+private:
+   Int_t                                     fEpfd;     // epoll instance
+   std::map<Int_t, std::vector<TFileHandler*> > fFds;   // handlers per descriptor
+#ifdef HAVE_EPOLL
+   std::vector<struct epoll_event>           fEvents;   // events from last Wait()
+#endif
+   Int_t                                     fNEvents;  // number of events in fEvents
+   Int_t                                     fCurrent;  // next event to dispatch
+
+   void   Update(Int_t fd);
+
+public:
+   TEpollSet();
+   ~TEpollSet();
+
+   Bool_t IsValid() const { return fEpfd >= 0; }
+   void   Add(TFileHandler *h);
+   void   Remove(TFileHandler *h);
+   Int_t  Wait(Long_t timeout);
+   Bool_t NextReady(Int_t &fd, Bool_t &read, Bool_t &write);
+   void   Discard(Int_t fd);
+   const std::vector<TFileHandler*> *GetHandlers(Int_t fd) const;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the epoll instance. Check IsValid() for success.
+
+TEpollSet::TEpollSet() : fEpfd(-1), fNEvents(0), fCurrent(0)
+{
+#ifdef HAVE_EPOLL
+   fEpfd = epoll_create1(EPOLL_CLOEXEC);
+   if (fEpfd < 0)
+      ::SysError("TEpollSet::TEpollSet", "epoll_create1");
+   fEvents.resize(256);
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Close the epoll instance. Does not delete the handlers.
+
+TEpollSet::~TEpollSet()
+{
+   if (fEpfd >= 0)
+      ::close(fEpfd);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// (Re-)register descriptor fd with the union of the interests of all
+/// the handlers of fd. The descriptor is unregistered when it has no
+/// more handlers.
+
+void TEpollSet::Update(Int_t fd)
+{
+#ifdef HAVE_EPOLL
+   std::map<Int_t, std::vector<TFileHandler*> >::iterator it = fFds.find(fd);
+   if (it == fFds.end() || it->second.empty()) {
+      if (it != fFds.end()) fFds.erase(it);
+      // may fail with EBADF when the descriptor has been closed already
+      epoll_ctl(fEpfd, EPOLL_CTL_DEL, fd, 0);
+      Discard(fd);
+      return;
+   }
+   struct epoll_event ev;
+   memset(&ev, 0, sizeof(ev));
+   for (size_t i = 0; i < it->second.size(); i++) {
+      if (it->second[i]->HasReadInterest())  ev.events |= EPOLLIN;
+      if (it->second[i]->HasWriteInterest()) ev.events |= EPOLLOUT;
+   }
+   ev.data.fd = fd;
+   if (epoll_ctl(fEpfd, EPOLL_CTL_MOD, fd, &ev) < 0 && errno == ENOENT) {
+      if (epoll_ctl(fEpfd, EPOLL_CTL_ADD, fd, &ev) < 0)
+         ::SysError("TEpollSet::Update", "epoll_ctl: cannot add fd %d", fd);
+   }
+#else
+   (void) fd;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add handler h, or update its interest if it has been added before.
+
+void TEpollSet::Add(TFileHandler *h)
+{
+   Int_t fd = h->GetFd();
+   if (fd < 0) return;
+   std::vector<TFileHandler*> &hs = fFds[fd];
+   if (std::find(hs.begin(), hs.end(), h) == hs.end())
+      hs.push_back(h);
+   Update(fd);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove handler h.
+
+void TEpollSet::Remove(TFileHandler *h)
+{
+   Int_t fd = h->GetFd();
+   std::map<Int_t, std::vector<TFileHandler*> >::iterator it = fFds.find(fd);
+   if (it == fFds.end()) return;
+   std::vector<TFileHandler*>::iterator ih = std::find(it->second.begin(), it->second.end(), h);
+   if (ih == it->second.end()) return;
+   it->second.erase(ih);
+   Update(fd);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the handlers registered for descriptor fd, or 0 if none.
+
+const std::vector<TFileHandler*> *TEpollSet::GetHandlers(Int_t fd) const
+{
+   std::map<Int_t, std::vector<TFileHandler*> >::const_iterator it = fFds.find(fd);
+   return (it == fFds.end()) ? 0 : &it->second;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for events on the registered descriptors or for timeout (in
+/// milliseconds) to occur. Returns the number of ready descriptors, or 0
+/// in case of timeout, or < 0 in case of an error, with -2 being EINTR.
+
+Int_t TEpollSet::Wait(Long_t timeout)
+{
+   fNEvents = 0;
+   fCurrent = 0;
+#ifdef HAVE_EPOLL
+   // let the event buffer follow the number of monitored descriptors
+   if (fFds.size() > fEvents.size())
+      fEvents.resize(fFds.size());
+   Int_t to = (timeout < 0) ? -1 : (Int_t) timeout;
+   Int_t rc = epoll_wait(fEpfd, &fEvents[0], (Int_t)fEvents.size(), to);
+   if (rc < 0) {
+      if (errno == EINTR) {
+         errno = 0;
+         return -2;
+      }
+      return -1;
+   }
+   fNEvents = rc;
+   return rc;
+#else
+   (void) timeout;
+   return -1;
+#endif
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Get the next descriptor ready for reading or writing from the last
+/// Wait(). Hang-ups and errors are reported as read (and write) readiness,
+/// like select() does. Returns kFALSE when there are no more events.
+
+Bool_t TEpollSet::NextReady(Int_t &fd, Bool_t &read, Bool_t &write)
+{
+#ifdef HAVE_EPOLL
+   while (fCurrent < fNEvents) {
+      struct epoll_event &ev = fEvents[fCurrent++];
+      if (ev.data.fd < 0) continue;   // discarded
+      fd    = ev.data.fd;
+      read  = (ev.events & (EPOLLIN | EPOLLPRI | EPOLLHUP | EPOLLERR)) ? kTRUE : kFALSE;
+      write = (ev.events & (EPOLLOUT | EPOLLERR)) ? kTRUE : kFALSE;
+      if (read || write)
+         return kTRUE;
+   }
+#else
+   (void) fd; (void) read; (void) write;
+#endif
+   return kFALSE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget any not yet dispatched event for descriptor fd.
+
+void TEpollSet::Discard(Int_t fd)
+{
+#ifdef HAVE_EPOLL
+   for (Int_t i = fCurrent; i < fNEvents; i++)
+      if (fEvents[i].data.fd == fd)
+         fEvents[i].data.fd = -1;
+#else
+   (void) fd;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Unix signal handler.
 
@@ -562,7 +761,7 @@ ClassImp(TUnixSystem)
 
 ////////////////////////////////////////////////////////////////////////////////
 
-TUnixSystem::TUnixSystem() : TSystem("Unix", "Unix System")
+TUnixSystem::TUnixSystem() : TSystem("Unix", "Unix System"), fEpoll(0)
 { }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -577,6 +776,7 @@ TUnixSystem::~TUnixSystem()
    delete fReadready;
    delete fWriteready;
    delete fSignals;
+   delete fEpoll;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -753,6 +953,13 @@ void TUnixSystem::AddFileHandler(TFileHandler *h)
    TSystem::AddFileHandler(h);
    if (h) {
       int fd = h->GetFd();
+      if (!fEpoll && (fd >= kFDSETSIZE || (fFileHandler->GetSize() == 1 &&
+          gEnv && gEnv->GetValue("Root.UseEpoll", 0))))
+         UseEpoll();
+      if (fEpoll) {
+         fEpoll->Add(h);
+         return;
+      }
       if (h->HasReadInterest()) {
          fReadmask->Set(fd);
          fMaxrfd = TMath::Max(fMaxrfd, fd);
@@ -775,7 +982,9 @@ TFileHandler *TUnixSystem::RemoveFileHandler(TFileHandler *h)
    R__LOCKGUARD2(gSystemMutex);
 
    TFileHandler *oh = TSystem::RemoveFileHandler(h);
-   if (oh) {       // found
+   if (oh && fEpoll) {
+      fEpoll->Remove(oh);
+   } else if (oh) {       // found
       TFileHandler *th;
       TIter next(fFileHandler);
       fMaxrfd = -1;
@@ -797,6 +1006,38 @@ TFileHandler *TUnixSystem::RemoveFileHandler(TFileHandler *h)
    return oh;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Switch the monitoring of the file handlers from select(2) to epoll(7).
+/// This happens automatically when a descriptor beyond the select() limit
+/// (FD_SETSIZE) is added, or when the first file handler is added if
+/// Root.UseEpoll is set in the .rootrc. epoll is only available on Linux;
+/// the switch is permanent for the lifetime of the process.
+
+void TUnixSystem::UseEpoll()
+{
+#ifdef HAVE_EPOLL
+   TEpollSet *ep = new TEpollSet;
+   if (!ep->IsValid()) {
+      delete ep;
+      return;
+   }
+   TIter next(fFileHandler);
+   TFileHandler *th;
+   while ((th = (TFileHandler *) next()))
+      ep->Add(th);
+   fEpoll = ep;
+   fNfd = 0;
+   fMaxrfd = -1;
+   fMaxwfd = -1;
+   fReadmask->Zero();
+   fWritemask->Zero();
+   fReadready->Zero();
+   fWriteready->Zero();
+   if (gDebug > 0)
+      Info("UseEpoll", "monitoring %d file handlers via epoll", fFileHandler->GetSize());
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Add a signal handler to list of system signal handlers. Only adds
 /// the handler if it is not already in the list of signal handlers.
@@ -1064,7 +1305,9 @@ void TUnixSystem::DispatchOneEvent(Bool_t pendingOnly)
    while (1) {
       // first handle any X11 events
       if (gXDisplay && gXDisplay->Notify()) {
-         if (fReadready->IsSet(gXDisplay->GetFd())) {
+         if (fEpoll) {
+            fEpoll->Discard(gXDisplay->GetFd());
+         } else if (fReadready->IsSet(gXDisplay->GetFd())) {
             fReadready->Clr(gXDisplay->GetFd());
             fNfd--;
          }
@@ -1108,6 +1351,16 @@ void TUnixSystem::DispatchOneEvent(Bool_t pendingOnly)
          pollOnce = kFALSE;
       }
 
+      // nothing ready, wait on the epoll set
+      if (fEpoll) {
+         if (fFileHandler->GetSize() == 0 && nextto == -1)
+            return;
+         fNfd = fEpoll->Wait(nextto);
+         if (fNfd < 0 && fNfd != -2)
+            SysError("DispatchOneEvent", "epoll_wait");
+         continue;
+      }
+
       // nothing ready, so setup select call
       *fReadready  = *fReadmask;
       *fWriteready = *fWritemask;
@@ -1165,41 +1418,47 @@ void TUnixSystem::Sleep(UInt_t milliSec)
 /// the errno has been reset and the method can be called again. Returns
 /// -4 in case the list did not contain any file handlers or file handlers
 /// with file descriptor >= 0.
+/// Implemented with poll(2), so that there is no limit on the values of
+/// the file descriptors.
 
 Int_t TUnixSystem::Select(TList *act, Long_t to)
 {
    Int_t rc = -4;
 
-   TFdSet rd, wr;
-   Int_t mxfd = -1;
+   std::vector<struct pollfd> pfds;
+   std::vector<TFileHandler*> hs;
+   pfds.reserve(act->GetSize());
+   hs.reserve(act->GetSize());
    TIter next(act);
    TFileHandler *h = 0;
    while ((h = (TFileHandler *) next())) {
       Int_t fd = h->GetFd();
       if (fd > -1) {
-         if (h->HasReadInterest()) {
-            rd.Set(fd);
-            mxfd = TMath::Max(mxfd, fd);
-         }
-         if (h->HasWriteInterest()) {
-            wr.Set(fd);
-            mxfd = TMath::Max(mxfd, fd);
+         struct pollfd pfd;
+         pfd.fd      = fd;
+         pfd.events  = 0;
+         pfd.revents = 0;
+         if (h->HasReadInterest())
+            pfd.events |= POLLIN;
+         if (h->HasWriteInterest())
+            pfd.events |= POLLOUT;
+         if (pfd.events) {
+            pfds.push_back(pfd);
+            hs.push_back(h);
          }
          h->ResetReadyMask();
       }
    }
-   if (mxfd > -1)
-      rc = UnixSelect(mxfd+1, &rd, &wr, to);
+   if (!pfds.empty())
+      rc = UnixPoll(&pfds[0], pfds.size(), to);
 
    // Set readiness bits
    if (rc > 0) {
-      next.Reset();
-      while ((h = (TFileHandler *) next())) {
-         Int_t fd = h->GetFd();
-         if (rd.IsSet(fd))
-            h->SetReadReady();
-         if (wr.IsSet(fd))
-            h->SetWriteReady();
+      for (size_t i = 0; i < pfds.size(); i++) {
+         if (pfds[i].revents & (POLLIN | POLLPRI | POLLHUP | POLLERR))
+            hs[i]->SetReadReady();
+         if (pfds[i].revents & (POLLOUT | POLLERR))
+            hs[i]->SetWriteReady();
       }
    }
 
@@ -1218,27 +1477,27 @@ Int_t TUnixSystem::Select(TFileHandler *h, Long_t to)
 {
    Int_t rc = -4;
 
-   TFdSet rd, wr;
-   Int_t mxfd = -1;
-   Int_t fd = -1;
+   struct pollfd pfd;
+   pfd.fd      = -1;
+   pfd.events  = 0;
+   pfd.revents = 0;
    if (h) {
-      fd = h->GetFd();
-      if (fd > -1) {
+      pfd.fd = h->GetFd();
+      if (pfd.fd > -1) {
          if (h->HasReadInterest())
-            rd.Set(fd);
+            pfd.events |= POLLIN;
          if (h->HasWriteInterest())
-            wr.Set(fd);
+            pfd.events |= POLLOUT;
          h->ResetReadyMask();
-         mxfd = fd;
-         rc = UnixSelect(mxfd+1, &rd, &wr, to);
+         rc = UnixPoll(&pfd, 1, to);
       }
    }
 
    // Fill output lists, if required
    if (rc > 0) {
-      if (rd.IsSet(fd))
+      if (pfd.revents & (POLLIN | POLLPRI | POLLHUP | POLLERR))
          h->SetReadReady();
-      if (wr.IsSet(fd))
+      if (pfd.revents & (POLLOUT | POLLERR))
          h->SetWriteReady();
    }
 
@@ -1303,6 +1562,38 @@ void TUnixSystem::CheckChilds()
 
 Bool_t TUnixSystem::CheckDescriptors()
 {
+   if (fEpoll) {
+      // dispatch the next ready descriptor, as for select below all its
+      // handlers are notified, first of read and then of write readiness
+      Int_t fd;
+      Bool_t rd, wr;
+      while (fEpoll->NextReady(fd, rd, wr)) {
+         fNfd--;
+         const std::vector<TFileHandler*> *hs = fEpoll->GetHandlers(fd);
+         if (!hs) continue;
+         // notification may add or remove handlers, so work on a copy
+         std::vector<TFileHandler*> handlers(*hs);
+         for (Int_t pass = 0; pass < 2; pass++) {
+            if ((pass == 0 && !rd) || (pass == 1 && !wr))
+               continue;
+            for (size_t i = 0; i < handlers.size(); i++) {
+               hs = fEpoll->GetHandlers(fd);
+               if (!hs || std::find(hs->begin(), hs->end(), handlers[i]) == hs->end())
+                  continue;
+               if (!handlers[i]->IsActive())
+                  continue;
+               if (pass == 0)
+                  handlers[i]->ReadNotify();
+               else
+                  handlers[i]->WriteNotify();
+            }
+         }
+         return kTRUE;
+      }
+      fNfd = 0;
+      return kFALSE;
+   }
+
    TFileHandler *fh;
    Int_t  fddone = -1;
    Bool_t read   = kFALSE;
@@ -3425,6 +3716,43 @@ int TUnixSystem::SendRaw(int sock, const void *buf, int length, int opt)
    return n;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Send exactly the nbuf buffers as one contiguous stream using a single
+/// gather write where possible (see TSystem::SendRawv). Use opt to send
+/// out-of-band data (see TSocket). Returns the total number of bytes sent
+/// or -1 in case of error. Returns -4 in case of kNoBlock and
+/// errno == EWOULDBLOCK. Returns -5 if pipe broken or reset by peer
+/// (EPIPE || ECONNRESET).
+
+int TUnixSystem::SendRawv(int sock, const void **bufs, const int *lens, int nbuf, int opt)
+{
+   int flag;
+
+   switch (opt) {
+   case kDefault:
+      flag = 0;
+      break;
+   case kOob:
+      flag = MSG_OOB;
+      break;
+   case kDontBlock:
+      flag = -1;
+      break;
+   case kPeek:            // receive only option (see RecvRaw)
+   default:
+      flag = 0;
+      break;
+   }
+
+   int n;
+   if ((n = UnixSendv(sock, bufs, lens, nbuf, flag)) <= 0) {
+      if (n == -1 && GetErrno() != EINTR)
+         Error("SendRawv", "cannot send buffers");
+      return n;
+   }
+   return n;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Set socket option.
 
@@ -3915,6 +4243,33 @@ int TUnixSystem::UnixSelect(Int_t nfds, TFdSet *readready, TFdSet *writeready,
    return retcode;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Wait for the events requested in the nfds pollfd structures or for
+/// timeout (in milliseconds) to occur. Returns the number of ready
+/// descriptors, or 0 in case of timeout, or < 0 in case of an error, with
+/// -2 being EINTR and -3 EBADF (i.e. one of the descriptors is not open).
+/// In case of EINTR the errno has been reset and the method can be called
+/// again.
+
+int TUnixSystem::UnixPoll(struct pollfd *fds, unsigned long nfds, Long_t timeout)
+{
+   int retcode = poll(fds, (nfds_t) nfds, (timeout >= 0) ? (int) timeout : -1);
+   if (retcode == -1) {
+      if (GetErrno() == EINTR) {
+         ResetErrno();  // errno is not self reseting
+         return -2;
+      }
+      return -1;
+   }
+   if (retcode > 0) {
+      for (unsigned long i = 0; i < nfds; i++)
+         if (fds[i].revents & POLLNVAL)
+            return -3;
+   }
+
+   return retcode;
+}
+
 //---- directories -------------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -4577,6 +4932,81 @@ int TUnixSystem::UnixSend(int sock, const void *buffer, int length, int flag)
    return n;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Send exactly the nbuf buffers, in order, with sendmsg(). Partial writes
+/// are resumed where they stopped, so that the kernel sees as few calls as
+/// possible. Returns -1 in case of error, otherwise number of sent bytes.
+/// Returns -4 in case of kNoBlock and errno == EWOULDBLOCK. Returns -5 if
+/// pipe broken or reset by peer (EPIPE || ECONNRESET).
+
+int TUnixSystem::UnixSendv(int sock, const void **bufs, const int *lens, int nbuf, int flag)
+{
+   if (sock < 0) return -1;
+
+   int once = 0;
+   if (flag == -1) {
+      flag = 0;
+      once = 1;
+   }
+
+   const int kMaxIov = 64;
+   struct iovec iov[kMaxIov];
+
+   int ibuf = 0;     // first buffer not yet completely sent
+   int off  = 0;     // number of bytes of bufs[ibuf] already sent
+   int n    = 0;
+
+   while (ibuf < nbuf) {
+      int niov = 0;
+      for (int i = ibuf; i < nbuf && niov < kMaxIov; i++) {
+         int skip = (i == ibuf) ? off : 0;
+         if (lens[i] - skip <= 0) continue;
+         iov[niov].iov_base = (char *)bufs[i] + skip;
+         iov[niov].iov_len  = lens[i] - skip;
+         niov++;
+      }
+      if (niov == 0)
+         break;
+
+      struct msghdr msg;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov    = iov;
+      msg.msg_iovlen = niov;
+
+      int nsent;
+      if ((nsent = sendmsg(sock, &msg, flag)) <= 0) {
+         if (nsent == 0)
+            break;
+         if (GetErrno() == EWOULDBLOCK)
+            return -4;
+         else {
+            if (GetErrno() != EINTR)
+               ::SysError("TUnixSystem::UnixSendv", "sendmsg");
+            if (GetErrno() == EPIPE || GetErrno() == ECONNRESET)
+               return -5;
+            else
+               return -1;
+         }
+      }
+      n += nsent;
+      if (once)
+         return n;
+
+      // advance over the buffers (or part of a buffer) just sent
+      while (ibuf < nbuf) {
+         int left = lens[ibuf] > off ? lens[ibuf] - off : 0;
+         if (nsent < left) {
+            off += nsent;
+            break;
+         }
+         nsent -= left;
+         ibuf++;
+         off = 0;
+      }
+   }
+   return n;
+}
+
 //---- Dynamic Loading ---------------------------------------------------------
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -48,6 +48,7 @@ struct Foption_t {
    int Robust;      // "ROB" or "H":  For a TGraph use robust fitting
    int StoreResult; // "S": Stores the result in a TFitResult structure
    int BinVolume;   // "WIDTH": scale content by the bin width/volume
+   int MultiThread; // "MULTITHREAD": evaluate the fit method function in parallel (needs implicit MT enabled)
    double hRobust;  //  value of h parameter used in robust fitting
 
   Foption_t() :
@@ -73,6 +74,7 @@ struct Foption_t {
       Robust       (0),
       StoreResult  (0),
       BinVolume    (0),
+      MultiThread  (0),
       hRobust      (0)
    {}
 };
@@ -82,11 +82,23 @@ public:
       return new WrappedMultiTF1(*this);
    }
 
+   /**
+       Clone the wrapper and the original function, which holds the parameter values
+   */
+   IMultiGenFunction * CloneForThread() const {
+      WrappedMultiTF1 * f = new WrappedMultiTF1(*this);
+      if (!fOwnFunc) f->SetAndCopyFunction();
+      return f;
+   }
+
    /// function dimension
    unsigned int NDim() const {
       return fDim;
    }
 
+   /// batch evaluation is re-implemented (see DoEvalBatch), except for interpreted functions
+   bool HasEvalBatch() const { return !fFunc->GetMethodCall(); }
+
 
    /** @name interface inherited from IParamFunction */
 
@@ -117,6 +129,12 @@ public:
    /// evaluate the derivative of the function with respect to the parameters
    void  ParameterGradient(const double * x, const double * par, double * grad ) const;
 
+   /// the gradient is thread safe when it is the exact gradient generated for the TFormula
+   /// (see TFormula::GenerateGradientPar), which does not need to set the parameters in the TF1
+   bool HasThreadSafeParameterGradient() const {
+      return !fLinear && fFunc->GetFormula() && !fFunc->IsEvalNormalized() && fFunc->GetFormula()->HasGradientPar();
+   }
+
    /// precision value used for calculating the derivative step-size
    /// h = eps * |x|. The default is 0.001, give a smaller in case function changes rapidly
    static void SetDerivPrecision(double eps);
@@ -150,6 +168,21 @@ private:
       return fFunc->EvalPar(x, 0 ); 
    }
 
+   /// evaluate the function using the cached parameter values (of TF1) for n points
+   /// given in columnar layout. This is not a vectorized evaluation: TF1 has no batch
+   /// interface, so the points are still evaluated one by one with TF1::EvalPar.
+   /// The TF1 is not modified, so it can be called concurrently, except for interpreted
+   /// functions, whose arguments are set in the TF1 for each point (as in DoEvalPar)
+   void DoEvalBatch(const double * const * x, double * result, unsigned int n) const {
+      std::vector<double> xp(fDim > 0 ? fDim : 1);
+      double * xbuf = &xp.front();
+      for (unsigned int i = 0; i < n; ++i) {
+         for (unsigned int icoord = 0; icoord < fDim; ++icoord)
+            xbuf[icoord] = x[icoord][i];
+         result[i] = (fFunc->GetMethodCall() ) ? DoEvalPar(xbuf, fFunc->GetParameters() ) : fFunc->EvalPar(xbuf, 0 );
+      }
+   }
+
 
    /// evaluate the partial derivative with respect to the parameter
    double DoParameterDerivative(const double * x, const double * p, unsigned int ipar) const;
@@ -103,6 +103,8 @@ private:
 
    TInterpreter::CallFuncIFacePtr_t::Generic_t fFuncPtr;   //!  function pointer
    void *   fLambdaPtr;                                    //!  pointer to the lambda function
+   TInterpreter::CallFuncIFacePtr_t::Generic_t fGradFuncPtr;   //!  pointer to the function computing the parameter gradient
+   Bool_t   fGradGenerated;                                //!  flag set when the generation of the gradient function has been tried
 
    void     InputFormulaIntoCling();
    Bool_t   PrepareEvalMethod();
@@ -113,6 +115,7 @@ private:
    void     HandleLinear(TString &formula);
    Bool_t   InitLambdaExpression(const char * formula);
    static Bool_t   IsDefaultVariableName(const TString &name);
+   static Bool_t   IsDifferentiable(const TString &expression);
 protected:
 
    std::list<TFormulaFunction>         fFuncs;    //!
@@ -169,6 +172,7 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   Bool_t         GenerateGradientPar();
    TString        GetExpFormula(Option_t *option="") const;
    const TObject *GetLinearPart(Int_t i) const;
    Int_t          GetNdim() const {return fNdim;}
@@ -183,8 +187,11 @@ public:
    Double_t       GetVariable(const char *name) const;
    Int_t          GetVarNumber(const char *name) const;
    TString        GetVarName(Int_t ivar) const;
+   void           GradientPar(const Double_t *x, Double_t *grad, const Double_t *params=0);
+   Bool_t         HasGradientPar() const { return fGradFuncPtr != nullptr; }
    Bool_t         IsValid() const { return fReadyToExecute && fClingInitialized; }
    Bool_t         IsLinear() const { return TestBit(kLinear); }
+   static Bool_t  IsVdtUsed();
    void           Print(Option_t *option = "") const;
    void           SetName(const char* name);
    void           SetParameter(const char* name, Double_t value);
@@ -201,6 +208,7 @@ public:
                              *name8="p8",const char *name9="p9",const char *name10="p10"); // *MENU*
    void           SetVariable(const TString &name, Double_t value);
    void           SetVariables(const std::pair<TString,Double_t> *vars, const Int_t size);
+   static Bool_t  UseVdt(Bool_t on = kTRUE);
 
    ClassDef(TFormula,10)
 };
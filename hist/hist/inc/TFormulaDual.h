@@ -0,0 +1,158 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2016, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFormulaDual
+#define ROOT_TFormulaDual
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TFormulaDual                                                         //
+//                                                                      //
+// Dual number used by TFormula to differentiate a formula expression   //
+// with respect to its parameters (forward mode automatic               //
+// differentiation). The expression passed to Cling is compiled a       //
+// second time with the parameters declared as TFormulaDual, so each    //
+// operation propagates the value and the derivative.                   //
+// The overloads of the TMath functions which can be used in a formula  //
+// are provided below. Formulas calling other functions are             //
+// differentiated numerically (see TFormula::GenerateGradientPar).      //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_TMath
+#include "TMath.h"
+#endif
+
+namespace ROOT {
+
+   namespace Internal {
+
+class TFormulaDual {
+
+private:
+
+   Double_t fValue;   // value of the expression
+   Double_t fDeriv;   // derivative of the expression
+
+public:
+
+   TFormulaDual(Double_t value = 0, Double_t deriv = 0) : fValue(value), fDeriv(deriv) {}
+
+   Double_t Value() const { return fValue; }
+   Double_t Derivative() const { return fDeriv; }
+
+   friend TFormulaDual operator+(const TFormulaDual &a) { return a; }
+   friend TFormulaDual operator-(const TFormulaDual &a) { return TFormulaDual(-a.fValue, -a.fDeriv); }
+
+   friend TFormulaDual operator+(const TFormulaDual &a, const TFormulaDual &b) {
+      return TFormulaDual(a.fValue + b.fValue, a.fDeriv + b.fDeriv);
+   }
+   friend TFormulaDual operator-(const TFormulaDual &a, const TFormulaDual &b) {
+      return TFormulaDual(a.fValue - b.fValue, a.fDeriv - b.fDeriv);
+   }
+   friend TFormulaDual operator*(const TFormulaDual &a, const TFormulaDual &b) {
+      return TFormulaDual(a.fValue * b.fValue, a.fDeriv * b.fValue + a.fValue * b.fDeriv);
+   }
+   friend TFormulaDual operator/(const TFormulaDual &a, const TFormulaDual &b) {
+      return TFormulaDual(a.fValue / b.fValue, (a.fDeriv * b.fValue - a.fValue * b.fDeriv) / (b.fValue * b.fValue));
+   }
+
+   // comparisons use only the values (e.g. for expressions like (x>[0])*[1])
+   friend bool operator<(const TFormulaDual &a, const TFormulaDual &b) { return a.fValue < b.fValue; }
+   friend bool operator>(const TFormulaDual &a, const TFormulaDual &b) { return a.fValue > b.fValue; }
+   friend bool operator<=(const TFormulaDual &a, const TFormulaDual &b) { return a.fValue <= b.fValue; }
+   friend bool operator>=(const TFormulaDual &a, const TFormulaDual &b) { return a.fValue >= b.fValue; }
+   friend bool operator==(const TFormulaDual &a, const TFormulaDual &b) { return a.fValue == b.fValue; }
+   friend bool operator!=(const TFormulaDual &a, const TFormulaDual &b) { return a.fValue != b.fValue; }
+};
+
+/// return the derivative of an expression (zero if it does not depend on the parameters)
+inline Double_t GetDerivative(const TFormulaDual &a) { return a.Derivative(); }
+inline Double_t GetDerivative(Double_t) { return 0; }
+
+// derivatives of the elementary functions which can be used in a formula
+
+inline TFormulaDual Sin(const TFormulaDual &a) { return TFormulaDual(sin(a.Value()), cos(a.Value()) * a.Derivative()); }
+inline TFormulaDual Cos(const TFormulaDual &a) { return TFormulaDual(cos(a.Value()), -sin(a.Value()) * a.Derivative()); }
+inline TFormulaDual Tan(const TFormulaDual &a) {
+   Double_t t = tan(a.Value());
+   return TFormulaDual(t, (1. + t * t) * a.Derivative());
+}
+inline TFormulaDual ASin(const TFormulaDual &a) {
+   return TFormulaDual(TMath::ASin(a.Value()), a.Derivative() / sqrt(1. - a.Value() * a.Value()));
+}
+inline TFormulaDual ACos(const TFormulaDual &a) {
+   return TFormulaDual(TMath::ACos(a.Value()), -a.Derivative() / sqrt(1. - a.Value() * a.Value()));
+}
+inline TFormulaDual ATan(const TFormulaDual &a) { return TFormulaDual(atan(a.Value()), a.Derivative() / (1. + a.Value() * a.Value())); }
+inline TFormulaDual ATan2(const TFormulaDual &y, const TFormulaDual &x) {
+   Double_t r2 = x.Value() * x.Value() + y.Value() * y.Value();
+   return TFormulaDual(TMath::ATan2(y.Value(), x.Value()), (x.Value() * y.Derivative() - y.Value() * x.Derivative()) / r2);
+}
+inline TFormulaDual SinH(const TFormulaDual &a) { return TFormulaDual(sinh(a.Value()), cosh(a.Value()) * a.Derivative()); }
+inline TFormulaDual CosH(const TFormulaDual &a) { return TFormulaDual(cosh(a.Value()), sinh(a.Value()) * a.Derivative()); }
+inline TFormulaDual TanH(const TFormulaDual &a) {
+   Double_t t = tanh(a.Value());
+   return TFormulaDual(t, (1. - t * t) * a.Derivative());
+}
+inline TFormulaDual Exp(const TFormulaDual &a) {
+   Double_t e = exp(a.Value());
+   return TFormulaDual(e, e * a.Derivative());
+}
+inline TFormulaDual Log(const TFormulaDual &a) { return TFormulaDual(log(a.Value()), a.Derivative() / a.Value()); }
+inline TFormulaDual Log10(const TFormulaDual &a) { return TFormulaDual(log10(a.Value()), a.Derivative() / (a.Value() * TMath::Ln10())); }
+inline TFormulaDual Sqrt(const TFormulaDual &a) {
+   Double_t s = sqrt(a.Value());
+   return TFormulaDual(s, 0.5 * a.Derivative() / s);
+}
+inline TFormulaDual Sq(const TFormulaDual &a) { return a * a; }
+inline TFormulaDual Abs(const TFormulaDual &a) { return (a.Value() < 0) ? -a : a; }
+inline TFormulaDual Power(const TFormulaDual &a, Double_t y) {
+   Double_t d = (y == 0) ? 0. : y * pow(a.Value(), y - 1.) * a.Derivative();
+   return TFormulaDual(pow(a.Value(), y), d);
+}
+inline TFormulaDual Power(Double_t x, const TFormulaDual &b) {
+   Double_t v = pow(x, b.Value());
+   return TFormulaDual(v, (b.Derivative() == 0) ? 0. : v * log(x) * b.Derivative());
+}
+inline TFormulaDual Power(const TFormulaDual &a, const TFormulaDual &b) {
+   if (b.Derivative() == 0) return Power(a, b.Value());
+   if (a.Derivative() == 0) return Power(a.Value(), b);
+   Double_t v = pow(a.Value(), b.Value());
+   return TFormulaDual(v, v * (b.Derivative() * log(a.Value()) + b.Value() * a.Derivative() / a.Value()));
+}
+
+   } // end namespace Internal
+
+} // end namespace ROOT
+
+
+// make the overloads visible for the TMath calls generated by TFormula (e.g. exp -> TMath::Exp)
+namespace TMath {
+   using ROOT::Internal::Sin;
+   using ROOT::Internal::Cos;
+   using ROOT::Internal::Tan;
+   using ROOT::Internal::ASin;
+   using ROOT::Internal::ACos;
+   using ROOT::Internal::ATan;
+   using ROOT::Internal::ATan2;
+   using ROOT::Internal::SinH;
+   using ROOT::Internal::CosH;
+   using ROOT::Internal::TanH;
+   using ROOT::Internal::Exp;
+   using ROOT::Internal::Log;
+   using ROOT::Internal::Log10;
+   using ROOT::Internal::Sqrt;
+   using ROOT::Internal::Sq;
+   using ROOT::Internal::Abs;
+   using ROOT::Internal::Power;
+}
+
+#endif
@@ -59,6 +59,8 @@ namespace HFit {
 
    void GetFunctionRange(const TF1 & f1, ROOT::Fit::DataRange & range);
 
+   void GenerateGradient(TF1 * f1);
+
    void FitOptionsMake(const char *option, Foption_t &fitOption);
 
    void CheckGraphFitOptions(Foption_t &fitOption);
@@ -118,6 +120,13 @@ int HFit::CheckFitFunction(const TF1 * f1, int dim) {
 }
 
 
+void HFit::GenerateGradient(TF1 * f1) {
+   // generate the exact parameter gradient of a formula function (see TFormula::GenerateGradientPar)
+   // before the minimization, which can evaluate the gradient in several threads
+   TFormula * formula = f1->GetFormula();
+   if (formula && !f1->IsEvalNormalized() ) formula->GenerateGradientPar();
+}
+
 void HFit::GetFunctionRange(const TF1 & f1, ROOT::Fit::DataRange & range) {
    // get the range form the function and fill and return the DataRange object
    Double_t fxmin, fymin, fzmin, fxmax, fymax, fzmax;
@@ -233,6 +242,7 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
 
    // set the fit function
    // if option grad is specified use gradient
+   if (fitOption.Gradient) GenerateGradient(f1);
    if ( (linear || fitOption.Gradient) )
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*f1) );
    else
@@ -303,6 +313,9 @@ TFitResultPtr HFit::Fit(FitObject * h1, TF1 *f1 , Foption_t & fitOption , const
    if (fitOption.Verbose) fitConfig.MinimizerOptions().SetPrintLevel(3);
    if (fitOption.Quiet)    fitConfig.MinimizerOptions().SetPrintLevel(0);
 
+   // evaluate the chi2 or likelihood in parallel
+   if (fitOption.MultiThread) fitConfig.SetParallel(true);
+
    // specific minimizer options depending on minimizer
    if (linear) {
       if (fitOption.Robust  ) {
@@ -685,6 +698,12 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
    TString opt = option;
    opt.ToUpper();
 
+   // parse first the multi-character options containing other option letters
+   if (opt.Contains("MULTITHREAD")) {
+      fitOption.MultiThread = 1;
+      opt.ReplaceAll("MULTITHREAD","");
+   }
+
    // parse firt the specific options
    if (type == kHistogram) {
 
@@ -816,6 +835,7 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    // need to create a wrapper for an automatic  normalized TF1 ???
    if ( fitOption.Gradient ) {
       assert ( (int) dim == fitfunc->GetNdim() );
+      HFit::GenerateGradient(fitfunc);
       fitter->SetFunction(ROOT::Math::WrappedMultiTF1(*fitfunc) );
    }
    else
@@ -864,6 +884,9 @@ TFitResultPtr ROOT::Fit::UnBinFit(ROOT::Fit::UnBinData * data, TF1 * fitfunc, Fo
    if (fitOption.Verbose)   fitConfig.MinimizerOptions().SetPrintLevel(3);
    if (fitOption.Quiet)     fitConfig.MinimizerOptions().SetPrintLevel(0);
 
+   // evaluate the likelihood in parallel
+   if (fitOption.MultiThread) fitConfig.SetParallel(true);
+
    // more
    if (fitOption.More)   fitConfig.SetMinimizer("Minuit","MigradImproved");
 
@@ -2209,10 +2209,24 @@ Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
 /// default value of eps = 0.01
 /// Method is the same as in Derivative() function
 ///
+/// For functions defined by a formula for which the gradient with respect to the
+/// parameters has been generated (see TFormula::GenerateGradientPar, called by the fits
+/// with option "G") the gradient is computed exactly by the formula and eps is not used.
+///
 /// If a parameter is fixed, the gradient on this parameter = 0
 
 void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
 {
+   if (fType == 0 && !fNormalized && fFormula && fFormula->HasGradientPar() ) {
+      fFormula->GradientPar(x, grad);
+      Double_t al, bl;
+      for (Int_t ipar=0; ipar< GetNpar(); ipar++){
+         GetParLimits(ipar,al,bl);
+         if (al*bl != 0 && al >= bl) grad[ipar] = 0;
+      }
+      return;
+   }
+
    if(eps< 1e-10 || eps > 1) {
       Warning("Derivative","parameter esp=%g out of allowed range[1e-10,1], reset to 0.01",eps);
       eps = 0.01;
@@ -13,6 +13,7 @@
 #define ROOT_CPLUSPLUS11 1
 #endif
 
+#include "RConfigure.h"
 #include "TROOT.h"
 #include "TClass.h"
 #include "TMethod.h"
@@ -23,6 +24,7 @@
 #include "TError.h"
 #include "TInterpreter.h"
 #include "TFormula.h"
+#include <algorithm>
 #include <cassert>
 #include <iostream>
 #include <unordered_map>
@@ -147,6 +149,10 @@ static const TString gNamePrefix = "TFormula__";
 // static map of function pointers and expressions
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
+// static map of the gradient function pointers (null when the gradient could not be generated)
+static std::unordered_map<std::string,  void *> gClingGradFunctions = std::unordered_map<std::string,  void * >();
+// flag to use the elementary functions of VDT in the new formulae (see TFormula::UseVdt)
+static Bool_t gFormulaUseVdt = kFALSE;
 
 Bool_t TFormula::IsOperator(const char c)
 {
@@ -180,6 +186,80 @@ Bool_t TFormula::IsDefaultVariableName(const TString &name)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Check if all the functions called in the expression passed to Cling have
+/// a derivative for the dual numbers defined in TFormulaDual.h
+
+Bool_t TFormula::IsDifferentiable(const TString &expression)
+{
+   static const char * const differentiableFunctions[] = {
+      "TMath::Sin","TMath::Cos","TMath::Tan","TMath::ASin","TMath::ACos","TMath::ATan","TMath::ATan2",
+      "TMath::SinH","TMath::CosH","TMath::TanH","TMath::Exp","TMath::Log","TMath::Log10",
+      "TMath::Sqrt","TMath::Sq","TMath::Abs","TMath::Power" };
+
+   Ssiz_t n = expression.Length();
+   Ssiz_t i = 0;
+   while (i < n) {
+      if (!isalpha(expression[i]) && expression[i] != '_') {
+         ++i;
+         continue;
+      }
+      // read the full (eventually qualified) name and check if it is a function call
+      Ssiz_t ibegin = i;
+      while (i < n && (isalnum(expression[i]) || expression[i] == '_' || expression[i] == ':') ) ++i;
+      Ssiz_t iend = i;
+      while (i < n && expression[i] == ' ') ++i;
+      if (i == n || expression[i] != '(') continue;
+      TString name = expression(ibegin, iend - ibegin);
+      Bool_t found = false;
+      for (auto fname : differentiableFunctions) {
+         if (name == fname) {
+            found = true;
+            break;
+         }
+      }
+      if (!found) return false;
+   }
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Use (on = kTRUE) or not the elementary functions of VDT (vdt::fast_exp,
+/// vdt::fast_log, vdt::fast_sin, vdt::fast_cos and vdt::fast_atan2) for the
+/// shortcuts exp, log, sin, cos and atan2 in the formulae created afterwards.
+/// The VDT functions are inline and can be vectorised by the compiler; their
+/// results differ from the ones of the standard library by a few units in the
+/// last place. The formulae already created are not changed.
+/// The option is available only when ROOT is built with VDT.
+/// Return the previous value of the option.
+
+Bool_t TFormula::UseVdt(Bool_t on)
+{
+   Bool_t prev = gFormulaUseVdt;
+#ifdef R__HAS_VDT
+   if (on && !prev) {
+      static Bool_t declared = kFALSE;
+      if (!declared) declared = gInterpreter->Declare("#include \"vdt/vdtMath.h\"");
+      if (!declared) {
+         ::Error("TFormula::UseVdt","Cannot declare the VDT functions to the interpreter");
+         return prev;
+      }
+   }
+   gFormulaUseVdt = on;
+#else
+   if (on) ::Warning("TFormula::UseVdt","ROOT has been built without VDT - option is ignored");
+#endif
+   return prev;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the formulae use the elementary functions of VDT (see UseVdt)
+
+Bool_t TFormula::IsVdtUsed()
+{
+   return gFormulaUseVdt;
+}
+
 Bool_t TFormula::IsScientificNotation(const TString & formula, int i)
 {
    // check if the character at position i  is part of a scientific notation
@@ -258,6 +338,8 @@ TFormula::TFormula()
    fClingName = "";
    fFormula = "";
    fLambdaPtr = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradGenerated = false;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -303,6 +385,8 @@ TFormula::TFormula(const char *name, const char *formula, bool addToGlobList)
    fNumber = 0;
    fMethod = 0;
    fLambdaPtr = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradGenerated = false;
 
    FillDefaults();
 
@@ -341,6 +425,8 @@ TFormula::TFormula(const char *name, const char *formula, int ndim, int npar, bo
    fNpar = 0;
    fMethod = 0;
    fLambdaPtr = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradGenerated = false;
 
 
    fNdim = ndim;
@@ -387,6 +473,8 @@ TFormula::TFormula(const TFormula &formula) :
    fNumber = formula.GetNumber();
    fFormula = formula.GetExpFormula();   // returns fFormula in case of Lambda's
    fLambdaPtr = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradGenerated = false;
 
    // case of function based on a C++  expression (lambda's) which is ready to be compiled
    if (formula.fLambdaPtr && formula.TestBit(TFormula::kLambda)) {
@@ -587,6 +675,8 @@ void TFormula::Copy(TObject &obj) const
    }
 
    fnew.fFuncPtr = fFuncPtr;
+   fnew.fGradFuncPtr = fGradFuncPtr;
+   fnew.fGradGenerated = fGradGenerated;
 
 }
 
@@ -602,6 +692,8 @@ void TFormula::Clear(Option_t * )
 
    if(fMethod) fMethod->Delete();
    fMethod = nullptr;
+   fGradFuncPtr = nullptr;
+   fGradGenerated = false;
 
    fClingVariables.clear();
    fClingParameters.clear();
@@ -744,6 +836,16 @@ void TFormula::FillDefaults()
    {
       fFunctionsShortcuts[fun.first] = fun.second;
    }
+   if (gFormulaUseVdt) {
+      // inline and vectorisable versions of the elementary functions
+      const pair<TString,TString> vdtShortcuts[] =
+         { {"sin","vdt::fast_sin"}, {"cos","vdt::fast_cos"}, {"exp","vdt::fast_exp"},
+           {"log","vdt::fast_log"}, {"atan2","vdt::fast_atan2"} };
+      for(auto fun : vdtShortcuts)
+      {
+         fFunctionsShortcuts[fun.first] = fun.second;
+      }
+   }
 
 /*** - old code tu support C++03
 #else
@@ -1786,6 +1888,9 @@ void TFormula::ProcessFormula(TString &formula)
    if(!fReadyToExecute)
    {
       fReadyToExecute = true;
+      // the gradient function needs to be generated again for the new expression
+      fGradFuncPtr = nullptr;
+      fGradGenerated = false;
       Bool_t hasVariables = (fNdim > 0);
       Bool_t hasParameters = (fNpar > 0);
       if(!hasParameters)
@@ -2603,6 +2708,100 @@ Double_t TFormula::DoEval(const double * x, const double * params) const
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the function computing the gradient of the formula with respect to
+/// the parameters.
+/// The expression passed to Cling is compiled a second time with the parameters
+/// declared as dual numbers (see TFormulaDual.h), so the derivatives are exact
+/// (forward mode automatic differentiation) and no step size is needed.
+/// Return false if the formula cannot be differentiated in this way, i.e. when it
+/// calls functions for which the derivative is not known or when it is built from
+/// a lambda expression. In this case the gradient must be computed numerically,
+/// as done in TF1::GradientPar.
+/// The function is generated only once and it is shared between the formulas
+/// having the same expression.
+/// The gradient is not generated on first use: this function must be called before
+/// GradientPar, and before the gradient is evaluated from several threads. The fits
+/// with option "G" call it before the minimization.
+
+Bool_t TFormula::GenerateGradientPar()
+{
+   R__LOCKGUARD2(gROOTMutex);
+   if (fGradGenerated) return (fGradFuncPtr != nullptr);
+   fGradGenerated = true;
+
+   if (!IsValid() || fNpar <= 0 || TestBit(TFormula::kLambda) ) return false;
+
+   // extract the expression from the function passed to Cling
+   Ssiz_t ibegin = fClingInput.Index("return ");
+   Ssiz_t iend = fClingInput.Last(';');
+   if (ibegin == kNPOS || iend == kNPOS || iend <= ibegin) return false;
+   ibegin += 7;
+   TString expression = fClingInput(ibegin, iend - ibegin);
+   if (!IsDifferentiable(expression)) return false;
+
+   TString gradName = TString::Format("%s_grad%d",fClingName.Data(), fNpar);
+   auto funcit = gClingGradFunctions.find(std::string(gradName));
+   if (funcit != gClingGradFunctions.end() ) {
+      fGradFuncPtr = (TInterpreter::CallFuncIFacePtr_t::Generic_t) funcit->second;
+      return (fGradFuncPtr != nullptr);
+   }
+
+   // the derivative with respect to p[i] is obtained by evaluating the expression
+   // with a unit derivative for the parameter i
+   TString gradInput = TString::Format("#include \"TFormulaDual.h\"\n"
+                                       "void %s(Double_t *x, Double_t *pv, Double_t *g) {\n"
+                                       "   ROOT::Internal::TFormulaDual p[%d];\n"
+                                       "   for (Int_t i = 0; i < %d; ++i) p[i] = pv[i];\n"
+                                       "   for (Int_t i = 0; i < %d; ++i) {\n"
+                                       "      p[i] = ROOT::Internal::TFormulaDual(pv[i], 1.);\n"
+                                       "      g[i] = ROOT::Internal::GetDerivative(%s);\n"
+                                       "      p[i] = pv[i];\n"
+                                       "   }\n"
+                                       "}",gradName.Data(), fNpar, fNpar, fNpar, expression.Data() );
+
+   void * gradPtr = nullptr;
+   if (gCling->Declare(gradInput)) {
+      TMethodCall method;
+      method.InitWithPrototype(gradName,"Double_t*,Double_t*,Double_t*");
+      if (method.IsValid()) {
+         TInterpreter::CallFuncIFacePtr_t faceptr = gCling->CallFunc_IFacePtr(method.GetCallFunc());
+         gradPtr = (void*) faceptr.fGeneric;
+      }
+   }
+   if (!gradPtr && gDebug)
+      Info("GenerateGradientPar","Could not generate the gradient of %s - use numerical derivatives",GetExpFormula().Data() );
+
+   gClingGradFunctions.insert( std::make_pair( std::string(gradName), gradPtr) );
+   fGradFuncPtr = (TInterpreter::CallFuncIFacePtr_t::Generic_t) gradPtr;
+   return (fGradFuncPtr != nullptr);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the gradient of the formula with respect to the parameters at the point x.
+/// The given parameter values params are used, or the formula parameters when params is null.
+/// The derivatives are exact. The gradient function must have been generated before
+/// with GenerateGradientPar: an error is issued and a null gradient is returned otherwise,
+/// or if the formula cannot be differentiated.
+
+void TFormula::GradientPar(const Double_t *x, Double_t *grad, const Double_t *params)
+{
+   if (fNpar <= 0) return;
+   if (!HasGradientPar() ) {
+      Error("GradientPar","The gradient of the formula %s is not available - call GenerateGradientPar first",GetExpFormula().Data() );
+      std::fill(grad, grad + fNpar, 0.);
+      return;
+   }
+
+   void* args[3];
+   double * vars = (x) ? const_cast<double*>(x) : fClingVariables.data();
+   double * pars = (params) ? const_cast<double*>(params) : fClingParameters.data();
+   args[0] = &vars;
+   args[1] = &pars;
+   args[2] = &grad;
+   (*fGradFuncPtr)(0, 3, args, 0);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// return the expression formula
 /// If option = "P" replace the parameter names with their values
@@ -1085,9 +1085,11 @@ TFitResultPtr TGraph::Fit(const char *fname, Option_t *option, Option_t *, Axis_
 /// "+" | Add this new fitted function to the list of fitted functions (by default, any previous function is deleted)
 /// "C" | In case of linear fitting, do not calculate the chisquare (saves time)
 /// "F" | If fitting a polN, use the minuit fitter
+/// "G" | Use the gradient of the fit function with respect to the parameters. It is exact for functions defined by a formula (see TFormula::GenerateGradientPar), otherwise it is computed numerically
 /// "EX0" | When fitting a TGraphErrors or TGraphAsymErrors do not consider errors in the coordinate
 /// "ROB" | In case of linear fitting, compute the LTS regression coefficients (robust (resistant) regression), using the default fraction of good points "ROB=0.x" - compute the LTS regression coefficients, using 0.x as a fraction of good points
 /// "S" |  The result of the fit is returned in the TFitResultPtr (see below Access to the Fit Result)
+/// "MULTITHREAD" | Evaluate the chi2 and its gradient in parallel when the implicit multi-threading is enabled (the fit function must be thread safe)
 ///
 /// When the fit is drawn (by default), the parameter goption may be used
 /// to specify a list of graphics options. See TGraphPainter for a complete
@@ -3622,8 +3622,15 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///        - "C"  In case of linear fitting, don't calculate the chisquare
 ///          (saves time)
 ///        - "F"  If fitting a polN, switch to minuit fitter
+///        - "G"  Use the gradient of the fit function with respect to the parameters to compute
+///          the gradient of the chi2 or of the likelihood passed to the minimizer. It is exact for
+///          functions defined by a formula (see TFormula::GenerateGradientPar), otherwise it is
+///          computed numerically (see TF1::GradientPar).
 ///        - "S"  The result of the fit is returned in the TFitResultPtr
 ///          (see below Access to the Fit Result)
+///        - "MULTITHREAD" Evaluate the chi2 or the likelihood and their gradient in parallel
+///          when the implicit multi-threading is enabled (see ROOT::EnableImplicitMT).
+///          The fit function must be thread safe.
 /// \param[in] goption specify a list of graphics options. See TH1::Draw for a complete list of these options.
 /// \param[in] xxmin range
 /// \param[in] xxmax range
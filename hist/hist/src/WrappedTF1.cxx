@@ -200,7 +200,17 @@ void  WrappedMultiTF1::ParameterGradient(const double * x, const double * par, d
    //  BUT the TLinearFitter wants to have the derivatives also for fixed parameters.
    //  so in case of fLinear (or fPolynomial) a non-zero value will be returned for fixed parameters
 
-   if (!fLinear) {
+   if (HasThreadSafeParameterGradient() ) {
+      // exact gradient: the parameter values are passed directly to the formula
+      fFunc->GetFormula()->GradientPar(x,grad,par);
+      double al, bl;
+      unsigned int np = NPar();
+      for (unsigned int i = 0; i < np; ++i) {
+         fFunc->GetParLimits(i,al,bl);
+         if (al*bl != 0 && al >= bl) grad[i] = 0;
+      }
+   }
+   else if (!fLinear) {
       // need to set parameter values
       fFunc->SetParameters( par );
       // no need to call InitArgs (it is called in TF1::GradientPar)
@@ -23,6 +23,8 @@
 #endif
 
 #include <map>
+#include <vector>
+#include <iosfwd>
 
 class TVirtualStreamerInfo;
 class TStreamerInfo;
@@ -31,6 +33,9 @@ class TObjArray;
 class TMemberStreamer;
 class TDataMember;
 class TJSONStackObj;
+class TJSONNode;
+class TArray;
+class TCollection;
 
 
 class TBufferJSON : public TBuffer {
@@ -46,6 +51,13 @@ public:
    static TString   ConvertToJSON(const void *obj, const TClass *cl, Int_t compact = 0, const char *member_name = 0);
    static TString   ConvertToJSON(const void *obj, TDataMember *member, Int_t compact = 0, Int_t arraylen = -1);
 
+   static Long64_t  ExportToStream(std::ostream &out, const void *obj, const TClass *cl, Int_t compact = 0);
+   static Long64_t  ExportToFile(const char *filename, const TObject *obj, Int_t compact = 0);
+   static Long64_t  ExportToFile(const char *filename, const void *obj, const TClass *cl, Int_t compact = 0);
+
+   static TObject  *ConvertFromJSON(const char *str);
+   static void     *ConvertFromJSONAny(const char *str, TClass **cl = 0);
+
    // suppress class writing/reading
 
    virtual TClass  *ReadClass(const TClass *cl = 0, UInt_t *objTag = 0);
@@ -448,17 +460,33 @@ protected:
 
    void              AppendOutput(const char *line0, const char *line1 = 0);
 
+   void              FlushOutput();
+
+   void             *JsonReadObject(TJSONNode *node, void *obj, const TClass *objClass, TClass **readClass = 0);
+   void              JsonReadClassMembers(TJSONNode *node, void *obj, const TClass *cl);
+   void              JsonReadValue(TJSONNode *value, void *addr, Int_t type, TClass *cl, Int_t arraylen);
+   void              JsonReadEmbedded(TJSONNode *value, void *addr, const TClass *cl);
+   void              JsonReadPointer(TJSONNode *value, void **ptr, const TClass *cl, Bool_t keepOnNull);
+   void              JsonReadTArray(TJSONNode *value, TArray *arr);
+   void              JsonReadCollection(TJSONNode *node, TCollection *col);
+   void              JsonReadSTL(TJSONNode *value, void *addr, const TClass *cl);
+
    TString                   fOutBuffer;    //!  main output buffer for json code
    TString                  *fOutput;       //!  current output buffer for json code
    TString                   fValue;        //!  buffer for current value
    std::map<const void *, unsigned>  fJsonrMap;   //!  map of recorded objects, used in JsonR to restore references
    unsigned                  fJsonrCnt;     //!  counter for all objects and arrays
    TObjArray                 fStack;        //!  stack of streamer infos
+   TObjArray                 fStackPool;    //!  released stack objects, reused by PushStack()
+   std::ostream             *fSink;         //!  when specified, output is flushed into this stream in chunks
+   Long64_t                  fSinkLength;   //!  number of bytes flushed into the sink
+   std::vector<std::pair<void *, const TClass *> > fJsonrRefs; //! objects read from JSON, used to resolve "$ref:N"
    Bool_t                    fExpectedChain; //!   flag to resolve situation when several elements of same basic type stored as FastArray
    Int_t                     fCompact;       //!  0 - no any compression, 1 - no spaces in the begin, 2 - no new lines, 3 - no spaces at all
    TString                   fSemicolon;     //!  depending from compression level, " : " or ":"
    TString                   fArraySepar;    //!  depending from compression level, ", " or ","
-   TString                   fNumericLocale; //!  stored value of setlocale(LC_NUMERIC), which should be recovered at the end
+   TString                   fNumericLocale; //!  stored value of setlocale(LC_NUMERIC), which should be recovered at the end (Windows)
+   void                     *fThreadLocale;  //!  locale of the current thread before uselocale(), recovered at the end
 
    static const char *fgFloatFmt;          //!  printf argument for floats and doubles, either "%f" or "%e" or "%10f" and so on
 
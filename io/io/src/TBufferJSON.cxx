@@ -28,6 +28,21 @@
 //    h1->FillRandom("gaus",10000);
 //    TString json = TBufferJSON::ConvertToJSON(h1);
 //
+// Large objects can be written directly into file or any std::ostream.
+// In this case produced JSON code is flushed into the stream in chunks
+// and never kept completely in memory:
+//
+//    TBufferJSON::ExportToFile("h1.json", h1);
+//
+// Objects, stored with automatic (streamer info based) streamers, can be
+// reconstructed from JSON code:
+//
+//    TH1 *h2 = (TH1 *) TBufferJSON::ConvertFromJSON(json);
+//
+// Data members are matched by name, members missing in JSON keep values
+// from the default constructor. TCollection, TArray, TString, std::string
+// and STL containers are supported, references "$ref:N" are resolved.
+//
 //________________________________________________________________________
 
 
@@ -36,11 +51,29 @@
 #include <typeinfo>
 #include <string>
 #include <string.h>
+#include <stdlib.h>
 #include <locale.h>
+#ifdef R__MACOSX
+#include <xlocale.h>
+#endif
+#include <math.h>
+#include <errno.h>
+#include <type_traits>
+#include <fstream>
+#include <ostream>
 
 #include "Compression.h"
 
 #include "TArrayI.h"
+#include "TArrayC.h"
+#include "TArrayS.h"
+#include "TArrayL.h"
+#include "TArrayL64.h"
+#include "TArrayF.h"
+#include "TArrayD.h"
+#include "TList.h"
+#include "TObjString.h"
+#include "TVirtualCollectionProxy.h"
 #include "TObjArray.h"
 #include "TROOT.h"
 #include "TClass.h"
@@ -62,6 +95,7 @@
 #include "TClonesArray.h"
 #include "TVirtualMutex.h"
 #include "TInterpreter.h"
+#include "TError.h"
 
 #ifdef R__VISUAL_CPLUSPLUS
 #define FLong64    "%I64d"
@@ -76,6 +110,9 @@ ClassImp(TBufferJSON)
 
 const char *TBufferJSON::fgFloatFmt = "%e";
 
+// size of output portion, written at once into the sink
+static const Int_t kJsonChunkSize = 65536;
+
 
 // TJSONStackObj is used to keep stack of object hierarchy,
 // stored in TBuffer. For instance, data for parent class(es)
@@ -115,6 +152,23 @@ public:
       if (fIsElemOwner) delete fElem;
    }
 
+   void Reset()
+   {
+      // prepare object for reuse, keeps allocated memory of values array
+
+      if (fIsElemOwner) delete fElem;
+      fInfo = 0;
+      fElem = 0;
+      fElemNumber = 0;
+      fIsStreamerInfo = kFALSE;
+      fIsElemOwner = kFALSE;
+      fIsPostProcessed = kFALSE;
+      fIsObjStarted = kFALSE;
+      fAccObjects = kFALSE;
+      fValues.Delete();
+      fLevel = 0;
+   }
+
    Bool_t IsStreamerInfo() const
    {
       return fIsStreamerInfo;
@@ -131,6 +185,470 @@ public:
    }
 };
 
+// TJSONNode is node of parsed JSON document, used to reconstruct objects.
+// Arrays of plain numbers are kept in fNumbers vector without creating
+// separate node for each element. When all of them are integers, their
+// exact values are kept in fIntegers as well, Double_t has only 53 bits.
+
+class TJSONNode {
+public:
+   enum EKind { kNull, kBool, kNumber, kString, kArray, kObject };
+
+   EKind                     fKind;       //! kind of JSON value
+   Bool_t                    fBool;       //! value of boolean
+   Bool_t                    fIsInteger;  //! true when number written without fraction and exponent
+   Double_t                  fNumber;     //! value of number
+   Long64_t                  fInteger;    //! exact value of integer number
+   std::string               fString;     //! value of string
+   std::vector<TJSONNode *>  fItems;      //! array items or object members
+   std::vector<std::string>  fKeys;       //! names of object members
+   std::vector<Double_t>     fNumbers;    //! array of plain numbers
+   std::vector<Long64_t>     fIntegers;   //! exact values of plain numbers, when all of them are integers
+
+   TJSONNode(EKind kind = kNull) :
+      fKind(kind),
+      fBool(kFALSE),
+      fIsInteger(kFALSE),
+      fNumber(0),
+      fInteger(0),
+      fString(),
+      fItems(),
+      fKeys(),
+      fNumbers(),
+      fIntegers()
+   {
+   }
+
+   ~TJSONNode()
+   {
+      for (UInt_t n = 0; n < fItems.size(); n++) delete fItems[n];
+   }
+
+   Int_t GetSize() const
+   {
+      // number of items in the array
+      if (fKind != kArray) return 0;
+      return fNumbers.size() > 0 ? (Int_t) fNumbers.size() : (Int_t) fItems.size();
+   }
+
+   TJSONNode *Get(const char *name) const
+   {
+      // returns object member with specified name
+      if (fKind != kObject) return 0;
+      for (UInt_t n = 0; n < fKeys.size(); n++)
+         if (fKeys[n] == name) return fItems[n];
+      return 0;
+   }
+
+   const char *GetString(const char *name) const
+   {
+      // returns string value of object member
+      TJSONNode *node = Get(name);
+      return (node && (node->fKind == kString)) ? node->fString.c_str() : 0;
+   }
+};
+
+// TJSONParser is simple recursive descent parser, which produces tree of TJSONNode.
+// Beside standard JSON syntax it accepts nan and inf values, which could be
+// produced by TBufferJSON for not finite numbers.
+
+class TJSONParser {
+protected:
+   const char *fStart;   //! begin of parsed string
+   const char *fPos;     //! current parsing position
+
+   void SkipSpaces()
+   {
+      while ((*fPos == ' ') || (*fPos == '\n') || (*fPos == '\r') || (*fPos == '\t')) fPos++;
+   }
+
+   Bool_t IsNumberStart() const
+   {
+      char c = *fPos;
+      if (((c >= '0') && (c <= '9')) || (c == '-') || (c == '+') || (c == '.') || (c == 'i')) return kTRUE;
+      return (c == 'n') && (strncmp(fPos, "null", 4) != 0);
+   }
+
+   Bool_t ParseNumber(Double_t &value, Long64_t &ivalue, Bool_t &isint)
+   {
+      char *end = 0;
+      value = strtod(fPos, &end);
+      if ((end == 0) || (end == fPos)) return kFALSE;
+
+      isint = kTRUE;
+      for (const char *p = fPos; p != end; p++)
+         if ((*p == '.') || (*p == 'e') || (*p == 'E') || (*p == 'n') || (*p == 'i') || (*p == 'N') || (*p == 'I')) {
+            isint = kFALSE;
+            break;
+         }
+
+      // integers beyond the Long64_t (ULong64_t for positive) range, like
+      // big doubles written with "%1.0f", are kept only as Double_t
+      if (isint) {
+         errno = 0;
+         ivalue = (*fPos == '-') ? strtoll(fPos, 0, 10) : (Long64_t) strtoull(fPos, 0, 10);
+         if (errno == ERANGE) isint = kFALSE;
+      }
+
+      fPos = end;
+      return kTRUE;
+   }
+
+   void AppendUtf8(std::string &res, UInt_t code)
+   {
+      if (code < 0x100) {
+         // TBufferJSON encodes all non-ASCII bytes as \u00XX
+         res.append(1, (char) code);
+      } else if (code < 0x800) {
+         res.append(1, (char) (0xC0 | (code >> 6)));
+         res.append(1, (char) (0x80 | (code & 0x3F)));
+      } else if (code < 0x10000) {
+         res.append(1, (char) (0xE0 | (code >> 12)));
+         res.append(1, (char) (0x80 | ((code >> 6) & 0x3F)));
+         res.append(1, (char) (0x80 | (code & 0x3F)));
+      } else {
+         res.append(1, (char) (0xF0 | (code >> 18)));
+         res.append(1, (char) (0x80 | ((code >> 12) & 0x3F)));
+         res.append(1, (char) (0x80 | ((code >> 6) & 0x3F)));
+         res.append(1, (char) (0x80 | (code & 0x3F)));
+      }
+   }
+
+   Bool_t ParseHex(UInt_t &code)
+   {
+      code = 0;
+      for (Int_t n = 0; n < 4; n++) {
+         char c = *fPos++;
+         code = code << 4;
+         if ((c >= '0') && (c <= '9')) code += c - '0'; else
+         if ((c >= 'a') && (c <= 'f')) code += c - 'a' + 10; else
+         if ((c >= 'A') && (c <= 'F')) code += c - 'A' + 10; else return kFALSE;
+      }
+      return kTRUE;
+   }
+
+   Bool_t ParseString(std::string &res)
+   {
+      // parse string, fPos should point on opening quote
+
+      fPos++;
+      while (kTRUE) {
+         const char *beg = fPos;
+         while ((*fPos != '"') && (*fPos != '\\') && (*fPos != 0)) fPos++;
+         if (fPos != beg) res.append(beg, fPos - beg);
+         if (*fPos == 0) return kFALSE;
+         if (*fPos++ == '"') return kTRUE;
+
+         char c = *fPos++;
+         switch (c) {
+            case 'n': res.append(1, '\n'); break;
+            case 't': res.append(1, '\t'); break;
+            case 'r': res.append(1, '\r'); break;
+            case 'b': res.append(1, '\b'); break;
+            case 'f': res.append(1, '\f'); break;
+            case '"':
+            case '\\':
+            case '/': res.append(1, c); break;
+            case 'u': {
+               UInt_t code = 0;
+               if (!ParseHex(code)) return kFALSE;
+               if ((code >= 0xD800) && (code < 0xDC00) && (fPos[0] == '\\') && (fPos[1] == 'u')) {
+                  // surrogate pair
+                  UInt_t low = 0;
+                  fPos += 2;
+                  if (!ParseHex(low)) return kFALSE;
+                  code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+               }
+               AppendUtf8(res, code);
+               break;
+            }
+            default:
+               return kFALSE;
+         }
+      }
+      return kFALSE;
+   }
+
+   TJSONNode *ParseValue(Int_t depth)
+   {
+      if (depth > 1000) return 0;
+
+      SkipSpaces();
+
+      switch (*fPos) {
+         case '{': {
+            TJSONNode *node = new TJSONNode(TJSONNode::kObject);
+            fPos++;
+            SkipSpaces();
+            if (*fPos == '}') {
+               fPos++;
+               return node;
+            }
+            while (kTRUE) {
+               SkipSpaces();
+               std::string key;
+               if ((*fPos != '"') || !ParseString(key)) break;
+               SkipSpaces();
+               if (*fPos++ != ':') break;
+               TJSONNode *value = ParseValue(depth + 1);
+               if (value == 0) break;
+               node->fKeys.push_back(key);
+               node->fItems.push_back(value);
+               SkipSpaces();
+               if (*fPos == ',') {
+                  fPos++;
+                  continue;
+               }
+               if (*fPos++ == '}') return node;
+               break;
+            }
+            delete node;
+            return 0;
+         }
+         case '[': {
+            TJSONNode *node = new TJSONNode(TJSONNode::kArray);
+            fPos++;
+            SkipSpaces();
+            if (*fPos == ']') {
+               fPos++;
+               return node;
+            }
+            Bool_t plain = kTRUE, allint = kTRUE;
+            while (kTRUE) {
+               SkipSpaces();
+               if (plain && IsNumberStart()) {
+                  Double_t value;
+                  Long64_t ivalue;
+                  Bool_t isint;
+                  if (!ParseNumber(value, ivalue, isint)) break;
+                  node->fNumbers.push_back(value);
+                  if (allint && isint) {
+                     node->fIntegers.push_back(ivalue);
+                  } else if (allint) {
+                     allint = kFALSE;
+                     node->fIntegers.clear();
+                  }
+               } else {
+                  if (plain) {
+                     // array contains not only numbers, create nodes for numbers parsed before
+                     plain = kFALSE;
+                     for (UInt_t n = 0; n < node->fNumbers.size(); n++) {
+                        TJSONNode *item = new TJSONNode(TJSONNode::kNumber);
+                        item->fNumber = node->fNumbers[n];
+                        item->fIsInteger = allint;
+                        item->fInteger = allint ? node->fIntegers[n] : 0;
+                        node->fItems.push_back(item);
+                     }
+                     node->fNumbers.clear();
+                     node->fIntegers.clear();
+                  }
+                  TJSONNode *item = ParseValue(depth + 1);
+                  if (item == 0) break;
+                  node->fItems.push_back(item);
+               }
+               SkipSpaces();
+               if (*fPos == ',') {
+                  fPos++;
+                  continue;
+               }
+               if (*fPos++ == ']') return node;
+               break;
+            }
+            delete node;
+            return 0;
+         }
+         case '"': {
+            TJSONNode *node = new TJSONNode(TJSONNode::kString);
+            if (ParseString(node->fString)) return node;
+            delete node;
+            return 0;
+         }
+         case 't':
+            if (strncmp(fPos, "true", 4) != 0) return 0;
+            fPos += 4;
+            {
+               TJSONNode *node = new TJSONNode(TJSONNode::kBool);
+               node->fBool = kTRUE;
+               return node;
+            }
+         case 'f':
+            if (strncmp(fPos, "false", 5) != 0) return 0;
+            fPos += 5;
+            return new TJSONNode(TJSONNode::kBool);
+         default:
+            if (strncmp(fPos, "null", 4) == 0) {
+               fPos += 4;
+               return new TJSONNode(TJSONNode::kNull);
+            }
+            if (IsNumberStart()) {
+               TJSONNode *node = new TJSONNode(TJSONNode::kNumber);
+               if (ParseNumber(node->fNumber, node->fInteger, node->fIsInteger)) return node;
+               delete node;
+            }
+      }
+
+      return 0;
+   }
+
+public:
+   TJSONParser(const char *str) : fStart(str), fPos(str) {}
+
+   Int_t GetPosition() const { return fPos - fStart; }
+
+   TJSONNode *Parse()
+   {
+      // parse complete string, returns 0 if syntax error is detected
+      TJSONNode *res = ParseValue(0);
+      if (res != 0) {
+         SkipSpaces();
+         if (*fPos != 0) {
+            delete res;
+            res = 0;
+         }
+      }
+      return res;
+   }
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Returns number of basic values in JSON value, used to allocate arrays
+
+static Int_t JsonCountNumbers(const TJSONNode *node)
+{
+   if (node == 0) return 0;
+   switch (node->fKind) {
+      case TJSONNode::kNumber:
+      case TJSONNode::kBool:
+         return 1;
+      case TJSONNode::kString:
+         return node->fString.length();
+      case TJSONNode::kArray: {
+         if (node->fNumbers.size() > 0) return node->fNumbers.size();
+         Int_t cnt = 0;
+         for (UInt_t n = 0; n < node->fItems.size(); n++)
+            cnt += JsonCountNumbers(node->fItems[n]);
+         return cnt;
+      }
+      default:
+         break;
+   }
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads basic values from JSON value into array,
+/// multi-dimensional arrays are flatten, strings are used for char arrays.
+/// Returns number of read values
+
+template <typename T>
+static Int_t JsonReadNumbers(const TJSONNode *node, T *vals, Int_t maxlen)
+{
+   if ((node == 0) || (maxlen <= 0)) return 0;
+
+   // exact integer values are used for integer types only, for floating
+   // types the parsed Double_t is the best value
+   const Bool_t intype = std::is_integral<T>::value;
+
+   switch (node->fKind) {
+      case TJSONNode::kNumber:
+         vals[0] = (intype && node->fIsInteger) ? (T) node->fInteger : (T) node->fNumber;
+         return 1;
+      case TJSONNode::kBool:
+         vals[0] = (T) node->fBool;
+         return 1;
+      case TJSONNode::kString: {
+         Int_t len = node->fString.length();
+         if (len > maxlen) len = maxlen;
+         for (Int_t n = 0; n < len; n++) vals[n] = (T) node->fString[n];
+         return len;
+      }
+      case TJSONNode::kArray: {
+         Int_t cnt = 0;
+         if (node->fNumbers.size() > 0) {
+            cnt = node->fNumbers.size();
+            if (cnt > maxlen) cnt = maxlen;
+            if (intype && (node->fIntegers.size() == node->fNumbers.size())) {
+               const Long64_t *src = &(node->fIntegers[0]);
+               for (Int_t n = 0; n < cnt; n++) vals[n] = (T) src[n];
+            } else {
+               const Double_t *src = &(node->fNumbers[0]);
+               for (Int_t n = 0; n < cnt; n++) vals[n] = (T) src[n];
+            }
+         } else {
+            for (UInt_t n = 0; (n < node->fItems.size()) && (cnt < maxlen); n++)
+               cnt += JsonReadNumbers(node->fItems[n], vals + cnt, maxlen - cnt);
+         }
+         return cnt;
+      }
+      default:
+         break;
+   }
+   return 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads fixed-size array of basic values, not provided values are set to 0
+
+template <typename T>
+static void JsonReadBasicArray(const TJSONNode *node, void *addr, Int_t len)
+{
+   T *vals = (T *) addr;
+   for (Int_t n = JsonReadNumbers(node, vals, len); n < len; n++) vals[n] = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads array of basic values, referenced by pointer (with //[fN] comment)
+/// Previous array is deleted, new array allocated with length of JSON array
+
+template <typename T>
+static void JsonReadBasicPointer(const TJSONNode *node, void *addr)
+{
+   T **ptr = (T **) addr;
+   delete [] *ptr;
+   *ptr = 0;
+   Int_t len = JsonCountNumbers(node);
+   if (len <= 0) return;
+   *ptr = new T[len];
+   JsonReadBasicArray<T>(node, *ptr, len);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reads basic value(s) of specified type
+
+static void JsonReadBasic(const TJSONNode *node, void *addr, Int_t type, Int_t len, Bool_t isptr)
+{
+#define TJSONReadBasicCase(id, tname)                             \
+   case id:                                                       \
+      if (isptr) JsonReadBasicPointer<tname>(node, addr); else    \
+         JsonReadBasicArray<tname>(node, addr, len);              \
+      break;
+
+   switch (type) {
+      TJSONReadBasicCase(kChar_t, Char_t)
+      TJSONReadBasicCase(kShort_t, Short_t)
+      TJSONReadBasicCase(kInt_t, Int_t)
+      TJSONReadBasicCase(kLong_t, Long_t)
+      TJSONReadBasicCase(kFloat_t, Float_t)
+      TJSONReadBasicCase(kCounter, Int_t)
+      TJSONReadBasicCase(kDouble_t, Double_t)
+      TJSONReadBasicCase(kDouble32_t, Double_t)
+      TJSONReadBasicCase(kchar, char)
+      TJSONReadBasicCase(kUChar_t, UChar_t)
+      TJSONReadBasicCase(kUShort_t, UShort_t)
+      TJSONReadBasicCase(kUInt_t, UInt_t)
+      TJSONReadBasicCase(kULong_t, ULong_t)
+      TJSONReadBasicCase(kBits, UInt_t)
+      TJSONReadBasicCase(kLong64_t, Long64_t)
+      TJSONReadBasicCase(kULong64_t, ULong64_t)
+      TJSONReadBasicCase(kBool_t, Bool_t)
+      TJSONReadBasicCase(kFloat16_t, Float_t)
+      default:
+         break;
+   }
+
+#undef TJSONReadBasicCase
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Creates buffer object to serialize data into json.
@@ -143,11 +661,16 @@ TBufferJSON::TBufferJSON() :
    fJsonrMap(),
    fJsonrCnt(0),
    fStack(),
+   fStackPool(),
+   fSink(0),
+   fSinkLength(0),
+   fJsonrRefs(),
    fExpectedChain(kFALSE),
    fCompact(0),
    fSemicolon(" : "),
    fArraySepar(", "),
-   fNumericLocale()
+   fNumericLocale(),
+   fThreadLocale(0)
 {
    fBufSize = 1000000000;
 
@@ -159,6 +682,16 @@ TBufferJSON::TBufferJSON() :
    fValue.Capacity(1000);
    fOutput = &fOutBuffer;
 
+#ifndef R__WIN32
+   // numbers are always formatted and parsed with "C" numeric locale
+   // the locale is switched only for the current thread with uselocale(),
+   // setlocale() changes it for the whole process and is not safe when
+   // several buffers are used in parallel threads (e.g. in THttpServer)
+
+   static locale_t clocale = newlocale(LC_NUMERIC_MASK, "C", (locale_t) 0);
+   if (clocale != (locale_t) 0)
+      fThreadLocale = (void *) uselocale(clocale);
+#else
    // checks if setlocale(LC_NUMERIC) returns others than "C"
    // in this case locale will be changed and restored at the end of object conversion
 
@@ -167,6 +700,7 @@ TBufferJSON::TBufferJSON() :
       fNumericLocale = loc;
       setlocale(LC_NUMERIC, "C");
    }
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -175,9 +709,15 @@ TBufferJSON::TBufferJSON() :
 TBufferJSON::~TBufferJSON()
 {
    fStack.Delete();
+   fStackPool.Delete();
 
+#ifndef R__WIN32
+   if (fThreadLocale)
+      uselocale((locale_t) fThreadLocale);
+#else
    if (fNumericLocale.Length()>0)
       setlocale(LC_NUMERIC, fNumericLocale.Data());
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -256,6 +796,66 @@ TString TBufferJSON::ConvertToJSON(const void *obj, const TClass *cl,
    return buf.fOutBuffer.Length() ? buf.fOutBuffer : buf.fValue;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Write object as JSON into output stream
+/// Produced code is flushed into the stream in portions of 64 KB, therefore
+/// JSON representation of the object never kept completely in memory.
+/// Returns number of written bytes or -1 in case of stream failure
+
+Long64_t TBufferJSON::ExportToStream(std::ostream &out, const void *obj, const TClass *cl, Int_t compact)
+{
+   TBufferJSON buf;
+
+   buf.SetCompact(compact);
+   buf.fSink = &out;
+
+   buf.JsonWriteObject(obj, cl);
+
+   // special classes like TArray or TString keep complete output in the value
+   if ((buf.fSinkLength == 0) && (buf.fOutBuffer.Length() == 0))
+      buf.fOutBuffer = buf.fValue;
+
+   buf.FlushOutput();
+
+   return out.good() ? buf.fSinkLength : -1;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write object, inherited from TObject class, as JSON into the file
+/// Returns number of written bytes or -1 in case of failure
+
+Long64_t TBufferJSON::ExportToFile(const char *filename, const TObject *obj, Int_t compact)
+{
+   TClass *clActual = 0;
+   void *ptr = (void *) obj;
+
+   if (obj != 0) {
+      clActual = TObject::Class()->GetActualClass(obj);
+      if (!clActual) clActual = TObject::Class(); else
+      if (clActual != TObject::Class())
+         ptr = (void *) ((Long_t) obj - clActual->GetBaseClassOffset(TObject::Class()));
+   }
+
+   return ExportToFile(filename, ptr, clActual, compact);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write any object as JSON into the file
+/// Returns number of written bytes or -1 in case of failure
+
+Long64_t TBufferJSON::ExportToFile(const char *filename, const void *obj, const TClass *cl, Int_t compact)
+{
+   if ((filename == 0) || (*filename == 0)) return -1;
+
+   std::ofstream ofs(filename, std::ios::out | std::ios::binary | std::ios::trunc);
+   if (!ofs) {
+      ::Error("TBufferJSON::ExportToFile", "Cannot create file %s", filename);
+      return -1;
+   }
+
+   return ExportToStream(ofs, obj, cl, compact);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Converts selected data member into json
 /// Parameter ptr specifies address in memory, where data member is located
@@ -619,7 +1219,10 @@ void TBufferJSON::WriteObject(const TObject *obj)
 TJSONStackObj *TBufferJSON::PushStack(Int_t inclevel)
 {
    TJSONStackObj *curr = Stack();
-   TJSONStackObj *stack = new TJSONStackObj();
+   TJSONStackObj *stack = 0;
+   if (fStackPool.GetLast() >= 0)
+      stack = (TJSONStackObj *) fStackPool.RemoveAt(fStackPool.GetLast());
+   if (stack == 0) stack = new TJSONStackObj();
    stack->fLevel = (curr ? curr->fLevel : 0) + inclevel;
    fStack.Add(stack);
    return stack;
@@ -630,13 +1233,13 @@ TJSONStackObj *TBufferJSON::PushStack(Int_t inclevel)
 
 TJSONStackObj *TBufferJSON::PopStack()
 {
-   TObject *last = fStack.Last();
+   // stack never contains holes, last element can be removed without compression
+   TJSONStackObj *last = (TJSONStackObj *) fStack.RemoveAt(fStack.GetLast());
    if (last != 0) {
-      fStack.Remove(last);
-      delete last;
-      fStack.Compress();
+      last->Reset();
+      fStackPool.Add(last);
    }
-   return dynamic_cast<TJSONStackObj *>(fStack.Last());
+   return (TJSONStackObj *) fStack.Last();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -646,7 +1249,7 @@ TJSONStackObj *TBufferJSON::Stack(Int_t depth)
 {
    TJSONStackObj *stack = 0;
    if (depth <= fStack.GetLast())
-      stack = dynamic_cast<TJSONStackObj *>(fStack.At(fStack.GetLast() - depth));
+      stack = (TJSONStackObj *) fStack.At(fStack.GetLast() - depth);
    return stack;
 }
 
@@ -669,6 +1272,22 @@ void TBufferJSON::AppendOutput(const char *line0, const char *line1)
          fOutput->Append(line1);
       }
    }
+
+   if ((fSink != 0) && (fOutput == &fOutBuffer) && (fOutBuffer.Length() >= kJsonChunkSize))
+      FlushOutput();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write content of main output buffer into the sink
+/// Buffer memory is kept and reused for the next portion of JSON code
+
+void TBufferJSON::FlushOutput()
+{
+   if ((fSink == 0) || (fOutBuffer.Length() == 0)) return;
+
+   fSink->write(fOutBuffer.Data(), fOutBuffer.Length());
+   fSinkLength += fOutBuffer.Length();
+   fOutBuffer.Clear();
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2044,6 +2663,9 @@ void TBufferJSON::ReadFastArray(void ** /*startp*/, const TClass * /*cl*/,
 
 #define TJSONWriteArrayContent(vname, arrsize)        \
    {                                                     \
+      Ssiz_t need = fValue.Length() + (arrsize)*16;      \
+      if (fValue.Capacity() < need)                      \
+         fValue.Capacity(need + need/2);                 \
       fValue.Append("["); /* fJsonrCnt++; */             \
       for (Int_t indx=0;indx<arrsize;indx++) {           \
          if (indx>0) fValue.Append(fArraySepar.Data());  \
@@ -2776,14 +3398,91 @@ void TBufferJSON::WriteStdString(const std::string &s)
    JsonWriteConstChar(s.c_str(), s.length());
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fast conversion of integer value to decimal string, returns string length
+
+static Int_t JsonFormatInteger(ULong64_t value, Bool_t negative, char *buf)
+{
+   char tmp[30];
+   Int_t len = 0;
+   do {
+      tmp[len++] = '0' + (char)(value % 10);
+      value /= 10;
+   } while (value > 0);
+
+   Int_t pos = 0;
+   if (negative) buf[pos++] = '-';
+   while (len > 0) buf[pos++] = tmp[--len];
+   buf[pos] = 0;
+   return pos;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fast conversion of floating point value, produces same output as
+/// printf("%1.0f") for integral values and printf("%e") for all others.
+/// Returns 0 when value cannot be converted exactly without printf
+/// (very small/large exponents, NaN, infinity or rounding close to tie)
+
+static Int_t JsonFormatDouble(Double_t value, char *buf)
+{
+   static const Double_t pow10[23] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                                       1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22 };
+
+   if (value != value) return 0; // NaN
+
+   Bool_t negative = (value < 0) || ((value == 0) && signbit(value));
+   Double_t absval = negative ? -value : value;
+
+   if (absval == floor(absval)) {
+      // values up to 2^63 converted exactly, others (including infinity) go to printf
+      if (absval >= 9.2e18) return 0;
+      return JsonFormatInteger((ULong64_t) absval, negative, buf);
+   }
+
+   Int_t exp = (Int_t) floor(log10(absval));
+   Double_t scaled = 0;
+
+   // scale value to [1e6, 1e7) - seven significant digits as "%e" produces
+   for (Int_t iter = 0; iter < 3; iter++) {
+      Int_t p = 6 - exp;
+      if ((p > 22) || (p < -22)) return 0;
+      scaled = (p >= 0) ? absval * pow10[p] : absval / pow10[-p];
+      if (scaled < 1e6) exp--; else
+      if (scaled >= 1e7) exp++; else break;
+   }
+   if ((scaled < 1e6) || (scaled >= 1e7)) return 0;
+
+   Double_t fl = floor(scaled);
+   Double_t frac = scaled - fl;
+   // scaling error is far below 1e-5, only close to tie printf can round differently
+   if (fabs(frac - 0.5) < 1e-5) return 0;
+
+   ULong64_t mant = (ULong64_t) fl + ((frac > 0.5) ? 1 : 0);
+   if (mant >= 10000000) { mant = 1000000; exp++; }
+
+   Int_t pos = 0;
+   if (negative) buf[pos++] = '-';
+   buf[pos++] = '0' + (char) (mant / 1000000);
+   buf[pos++] = '.';
+   for (ULong64_t div = 100000; div > 0; div /= 10)
+      buf[pos++] = '0' + (char) ((mant / div) % 10);
+   buf[pos++] = 'e';
+   buf[pos++] = (exp < 0) ? '-' : '+';
+   Int_t aexp = (exp < 0) ? -exp : exp;
+   if (aexp >= 100) buf[pos++] = '0' + (char) (aexp / 100);
+   buf[pos++] = '0' + (char) ((aexp / 10) % 10);
+   buf[pos++] = '0' + (char) (aexp % 10);
+   buf[pos] = 0;
+   return pos;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// converts Char_t to string and add to json value buffer
 
 void TBufferJSON::JsonWriteBasic(Char_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value < 0 ? -(ULong64_t) value : (ULong64_t) value, value < 0, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2792,8 +3491,7 @@ void TBufferJSON::JsonWriteBasic(Char_t value)
 void TBufferJSON::JsonWriteBasic(Short_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%hd", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value < 0 ? -(ULong64_t) value : (ULong64_t) value, value < 0, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2802,8 +3500,7 @@ void TBufferJSON::JsonWriteBasic(Short_t value)
 void TBufferJSON::JsonWriteBasic(Int_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%d", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value < 0 ? -(ULong64_t) value : (ULong64_t) value, value < 0, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2812,8 +3509,7 @@ void TBufferJSON::JsonWriteBasic(Int_t value)
 void TBufferJSON::JsonWriteBasic(Long_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%ld", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value < 0 ? -(ULong64_t) value : (ULong64_t) value, value < 0, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2822,8 +3518,7 @@ void TBufferJSON::JsonWriteBasic(Long_t value)
 void TBufferJSON::JsonWriteBasic(Long64_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), FLong64, value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value < 0 ? -(ULong64_t) value : (ULong64_t) value, value < 0, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2832,11 +3527,18 @@ void TBufferJSON::JsonWriteBasic(Long64_t value)
 void TBufferJSON::JsonWriteBasic(Float_t value)
 {
    char buf[200];
-   if (value == floor(value))
-      snprintf(buf, sizeof(buf), "%1.0f", value);
-   else
-      snprintf(buf, sizeof(buf), fgFloatFmt, value);
-   fValue.Append(buf);
+   Int_t len = 0;
+   if (fgFloatFmt[0] == '%' && fgFloatFmt[1] == 'e' && fgFloatFmt[2] == 0)
+      len = JsonFormatDouble(value, buf);
+   if (len > 0)
+      fValue.Append(buf, len);
+   else {
+      if (value == floor(value))
+         snprintf(buf, sizeof(buf), "%1.0f", value);
+      else
+         snprintf(buf, sizeof(buf), fgFloatFmt, value);
+      fValue.Append(buf);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2845,11 +3547,18 @@ void TBufferJSON::JsonWriteBasic(Float_t value)
 void TBufferJSON::JsonWriteBasic(Double_t value)
 {
    char buf[200];
-   if (value == floor(value))
-      snprintf(buf, sizeof(buf), "%1.0f", value);
-   else
-      snprintf(buf, sizeof(buf), fgFloatFmt, value);
-   fValue.Append(buf);
+   Int_t len = 0;
+   if (fgFloatFmt[0] == '%' && fgFloatFmt[1] == 'e' && fgFloatFmt[2] == 0)
+      len = JsonFormatDouble(value, buf);
+   if (len > 0)
+      fValue.Append(buf, len);
+   else {
+      if (value == floor(value))
+         snprintf(buf, sizeof(buf), "%1.0f", value);
+      else
+         snprintf(buf, sizeof(buf), fgFloatFmt, value);
+      fValue.Append(buf);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2866,8 +3575,7 @@ void TBufferJSON::JsonWriteBasic(Bool_t value)
 void TBufferJSON::JsonWriteBasic(UChar_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value, kFALSE, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2876,8 +3584,7 @@ void TBufferJSON::JsonWriteBasic(UChar_t value)
 void TBufferJSON::JsonWriteBasic(UShort_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%hu", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value, kFALSE, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2886,8 +3593,7 @@ void TBufferJSON::JsonWriteBasic(UShort_t value)
 void TBufferJSON::JsonWriteBasic(UInt_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%u", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value, kFALSE, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2896,8 +3602,7 @@ void TBufferJSON::JsonWriteBasic(UInt_t value)
 void TBufferJSON::JsonWriteBasic(ULong_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), "%lu", value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value, kFALSE, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2906,8 +3611,7 @@ void TBufferJSON::JsonWriteBasic(ULong_t value)
 void TBufferJSON::JsonWriteBasic(ULong64_t value)
 {
    char buf[50];
-   snprintf(buf, sizeof(buf), FULong64, value);
-   fValue.Append(buf);
+   fValue.Append(buf, JsonFormatInteger(value, kFALSE, buf));
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2951,7 +3655,7 @@ void TBufferJSON::JsonWriteConstChar(const char* value, Int_t len)
                if ((c > 31) && (c < 127))
                   fValue.Append(c);
                else
-                  fValue.Append(TString::Format("\\u%04x", (unsigned) c));
+                  fValue.Append(TString::Format("\\u%04x", (unsigned) (unsigned char) c));
          }
       }
    }
@@ -3201,3 +3905,477 @@ Int_t TBufferJSON::WriteClassBuffer(const TClass *cl, void *pointer)
       Info("WriteClassBuffer", "class: %s version %d done", cl->GetName(), cl->GetClassVersion());
    return 0;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reconstruct object, inherited from TObject class, from JSON code
+/// Returns 0 if JSON code cannot be parsed or object is not TObject
+
+TObject *TBufferJSON::ConvertFromJSON(const char *str)
+{
+   TClass *cl = 0;
+   void *obj = ConvertFromJSONAny(str, &cl);
+
+   if ((cl == 0) || (obj == 0)) return 0;
+
+   Int_t delta = cl->GetBaseClassOffset(TObject::Class());
+   if (delta < 0) {
+      ::Error("TBufferJSON::ConvertFromJSON", "Class %s is not derived from TObject", cl->GetName());
+      cl->Destructor(obj);
+      return 0;
+   }
+
+   return (TObject *) ((char *) obj + delta);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Reconstruct object of any class from JSON code
+/// Class of created object taken from "_typename" and returned in cl argument
+/// Only data members, which are streamed via streamer info, are restored.
+/// Members are matched by names, members missing in JSON code keep values
+/// assigned by default constructor.
+
+void *TBufferJSON::ConvertFromJSONAny(const char *str, TClass **cl)
+{
+   if (cl) *cl = 0;
+   if ((str == 0) || (*str == 0)) return 0;
+
+   TBufferJSON buf; // also sets "C" numeric locale for parsing
+
+   TJSONParser parser(str);
+   TJSONNode *top = parser.Parse();
+   if (top == 0) {
+      ::Error("TBufferJSON::ConvertFromJSONAny", "Syntax error in JSON code at position %d", parser.GetPosition());
+      return 0;
+   }
+
+   TClass *readClass = 0;
+   void *obj = buf.JsonReadObject(top, 0, 0, &readClass);
+
+   delete top;
+
+   if (cl) *cl = readClass;
+
+   return obj;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read object from JSON node
+/// If obj not specified, new instance of class from "_typename" is created.
+/// Every read object is registered to resolve "$ref:N" references,
+/// numbering corresponds to the order in which TBufferJSON writes objects
+
+void *TBufferJSON::JsonReadObject(TJSONNode *node, void *obj, const TClass *objClass, TClass **readClass)
+{
+   if (readClass) *readClass = 0;
+
+   if ((node == 0) || (node->fKind == TJSONNode::kNull)) return 0;
+
+   if ((node->fKind == TJSONNode::kString) && (node->fString.compare(0, 5, "$ref:") == 0)) {
+      UInt_t id = (UInt_t) atoi(node->fString.c_str() + 5);
+      if ((id >= fJsonrRefs.size()) || (fJsonrRefs[id].first == 0)) {
+         Error("JsonReadObject", "Cannot resolve reference %s", node->fString.c_str());
+         return 0;
+      }
+      if (readClass) *readClass = (TClass *) fJsonrRefs[id].second;
+      return fJsonrRefs[id].first;
+   }
+
+   if (node->fKind != TJSONNode::kObject) {
+      Error("JsonReadObject", "JSON object is expected");
+      return 0;
+   }
+
+   TClass *cl = (TClass *) objClass;
+   const char *clname = node->GetString("_typename");
+
+   if ((obj == 0) && (clname != 0)) {
+      cl = TClass::GetClass(clname);
+      if (cl == 0) {
+         Error("JsonReadObject", "Unknown class %s", clname);
+         fJsonrRefs.push_back(std::make_pair((void *) 0, (const TClass *) 0));
+         return 0;
+      }
+      if ((objClass != 0) && (cl->GetBaseClassOffset(objClass) < 0)) {
+         Error("JsonReadObject", "Class %s is not derived from %s", clname, objClass->GetName());
+         fJsonrRefs.push_back(std::make_pair((void *) 0, (const TClass *) 0));
+         return 0;
+      }
+   }
+
+   if (cl == 0) {
+      Error("JsonReadObject", "Class of the object is not specified");
+      return 0;
+   }
+
+   if (obj == 0) obj = cl->New();
+
+   if (obj == 0) {
+      Error("JsonReadObject", "Cannot create object of class %s", cl->GetName());
+      fJsonrRefs.push_back(std::make_pair((void *) 0, (const TClass *) 0));
+      return 0;
+   }
+
+   fJsonrRefs.push_back(std::make_pair(obj, (const TClass *) cl));
+
+   if (JsonSpecialClass(cl) == -130)
+      JsonReadCollection(node, (TCollection *) obj);
+   else
+      JsonReadClassMembers(node, obj, cl);
+
+   if (readClass) *readClass = cl;
+
+   return obj;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read data members of specified class from JSON object
+/// Base classes data are stored in the same JSON object
+
+void TBufferJSON::JsonReadClassMembers(TJSONNode *node, void *obj, const TClass *cl)
+{
+   TStreamerInfo *info = (TStreamerInfo *) const_cast<TClass *>(cl)->GetStreamerInfo();
+   if (info == 0) {
+      Error("JsonReadClassMembers", "No streamer info for class %s", cl->GetName());
+      return;
+   }
+
+   TIter iter(info->GetElements());
+   TStreamerElement *elem = 0;
+
+   while ((elem = (TStreamerElement *) iter()) != 0) {
+      if (elem->GetOffset() == TStreamerInfo::kMissing) continue;
+
+      char *addr = (char *) obj + elem->GetOffset();
+
+      if (elem->IsBase()) {
+         TClass *bcl = elem->GetClassPointer();
+         if (bcl == 0) continue;
+
+         if (bcl == TObject::Class()) {
+            TObject *tobj = (TObject *) addr;
+            TJSONNode *value = node->Get("fUniqueID");
+            if (value != 0) {
+               UInt_t uid = 0;
+               JsonReadNumbers(value, &uid, 1);
+               tobj->SetUniqueID(uid);
+            }
+            value = node->Get("fBits");
+            if (value != 0) {
+               UInt_t bits = 0;
+               JsonReadNumbers(value, &bits, 1);
+               tobj->ResetBit(TObject::kBitMask);
+               tobj->SetBit(bits & ~TObject::kIsReferenced);
+            }
+            continue;
+         }
+
+         switch (JsonSpecialClass(bcl)) {
+            case 0:
+            case -130:
+               JsonReadClassMembers(node, addr, bcl);
+               break;
+            case 100:
+               JsonReadTArray(node->Get("fArray"), (TArray *) addr);
+               break;
+            case 110:
+               JsonReadEmbedded(node->Get("fString"), addr, bcl);
+               break;
+            default:
+               if (gDebug > 0)
+                  Info("JsonReadClassMembers", "Base class %s of %s is not supported", bcl->GetName(), cl->GetName());
+               break;
+         }
+         continue;
+      }
+
+      TJSONNode *value = node->Get(elem->GetName());
+      if (value == 0) continue;
+
+      JsonReadValue(value, addr, elem->GetType(), elem->GetClassPointer(), elem->GetArrayLength());
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read value of single data member, type is streamer element type
+
+void TBufferJSON::JsonReadValue(TJSONNode *value, void *addr, Int_t type, TClass *cl, Int_t arraylen)
+{
+   if ((type > 0) && (type < 20) && (type != TStreamerInfo::kCharStar)) {
+      JsonReadBasic(value, addr, type, 1, kFALSE);
+      return;
+   }
+
+   if ((type > TStreamerInfo::kOffsetL) && (type < TStreamerInfo::kOffsetL + 20)) {
+      JsonReadBasic(value, addr, type - TStreamerInfo::kOffsetL, arraylen, kFALSE);
+      return;
+   }
+
+   if ((type > TStreamerInfo::kOffsetP) && (type < TStreamerInfo::kOffsetP + 20)) {
+      JsonReadBasic(value, addr, type - TStreamerInfo::kOffsetP, 0, kTRUE);
+      return;
+   }
+
+   if ((type >= TStreamerInfo::kOffsetL + TStreamerInfo::kObject) &&
+       (type <= TStreamerInfo::kOffsetL + TStreamerInfo::kAnyPnoVT)) {
+      // fixed-size array of objects or pointers
+      if ((value->fKind != TJSONNode::kArray) || (arraylen <= 0)) return;
+      Int_t itemtype = type - TStreamerInfo::kOffsetL;
+      Bool_t isptr = (itemtype == TStreamerInfo::kObjectp) || (itemtype == TStreamerInfo::kObjectP) ||
+                     (itemtype == TStreamerInfo::kAnyp) || (itemtype == TStreamerInfo::kAnyP) ||
+                     (itemtype == TStreamerInfo::kAnyPnoVT);
+      Int_t size = isptr ? (Int_t) sizeof(void *) : (cl ? cl->Size() : 0);
+      if (size <= 0) return;
+      for (Int_t n = 0; (n < arraylen) && (n < (Int_t) value->fItems.size()); n++)
+         JsonReadValue(value->fItems[n], (char *) addr + n * size, itemtype, cl, 1);
+      return;
+   }
+
+   switch (type) {
+      case TStreamerInfo::kCharStar: {
+         char **ptr = (char **) addr;
+         delete [] *ptr;
+         *ptr = 0;
+         if (value->fKind == TJSONNode::kString) {
+            *ptr = new char[value->fString.length() + 1];
+            strcpy(*ptr, value->fString.c_str());
+         }
+         break;
+      }
+      case TStreamerInfo::kTString:
+      case TStreamerInfo::kSTLstring:
+      case TStreamerInfo::kObject:
+      case TStreamerInfo::kAny:
+      case TStreamerInfo::kTObject:
+      case TStreamerInfo::kTNamed:
+      case TStreamerInfo::kSTL:
+         JsonReadEmbedded(value, addr, cl);
+         break;
+      case TStreamerInfo::kObjectp:
+      case TStreamerInfo::kAnyp:
+         // pointer with //-> comment should always reference an object
+         JsonReadPointer(value, (void **) addr, cl, kTRUE);
+         break;
+      case TStreamerInfo::kObjectP:
+      case TStreamerInfo::kAnyP:
+      case TStreamerInfo::kAnyPnoVT:
+      case TStreamerInfo::kSTLp:
+         JsonReadPointer(value, (void **) addr, cl, kFALSE);
+         break;
+      default:
+         if (gDebug > 0)
+            Info("JsonReadValue", "Element type %d is not supported", type);
+         break;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read object data into existing memory, class cannot be changed
+
+void TBufferJSON::JsonReadEmbedded(TJSONNode *value, void *addr, const TClass *cl)
+{
+   if ((value == 0) || (cl == 0)) return;
+
+   Int_t special_kind = JsonSpecialClass(cl);
+
+   if (special_kind == 100) {
+      JsonReadTArray(value, (TArray *) addr);
+   } else if (special_kind == 110) {
+      if (value->fKind == TJSONNode::kString)
+         *((TString *) addr) = value->fString.c_str();
+   } else if (special_kind == 120) {
+      if (value->fKind == TJSONNode::kString)
+         *((std::string *) addr) = value->fString;
+   } else if ((special_kind > 0) && (special_kind <= TClassEdit::kBitSet)) {
+      JsonReadSTL(value, addr, cl);
+   } else if (value->fKind == TJSONNode::kObject) {
+      JsonReadObject(value, addr, cl);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read object, referenced by pointer
+/// If existing object has same class as in JSON, it will be reused.
+/// Otherwise new object is created, previous object is not deleted
+/// as it could be referenced somewhere else.
+
+void TBufferJSON::JsonReadPointer(TJSONNode *value, void **ptr, const TClass *cl, Bool_t keepOnNull)
+{
+   if ((value == 0) || (cl == 0)) return;
+
+   if (value->fKind == TJSONNode::kNull) {
+      if (!keepOnNull) *ptr = 0;
+      return;
+   }
+
+   Int_t special_kind = JsonSpecialClass(cl);
+   if ((special_kind > 0) && (value->fKind != TJSONNode::kObject)) {
+      // TArray, TString or STL container referenced by pointer
+      if (*ptr == 0) *ptr = const_cast<TClass *>(cl)->New();
+      if (*ptr != 0) JsonReadEmbedded(value, *ptr, cl);
+      return;
+   }
+
+   const char *clname = (value->fKind == TJSONNode::kObject) ? value->GetString("_typename") : 0;
+
+   if ((*ptr != 0) && (clname != 0)) {
+      TClass *actual = const_cast<TClass *>(cl)->GetActualClass(*ptr);
+      if ((actual != 0) && (strcmp(actual->GetName(), clname) == 0)) {
+         Int_t delta = actual->GetBaseClassOffset(cl);
+         if (delta >= 0) {
+            JsonReadObject(value, (char *) *ptr - delta, actual);
+            return;
+         }
+      }
+   }
+
+   TClass *readClass = 0;
+   void *obj = JsonReadObject(value, 0, cl, &readClass);
+   if ((obj == 0) || (readClass == 0)) {
+      if (!keepOnNull) *ptr = 0;
+      return;
+   }
+
+   Int_t delta = readClass->GetBaseClassOffset(cl);
+   if (delta < 0) {
+      Error("JsonReadPointer", "Class %s is not derived from %s", readClass->GetName(), cl->GetName());
+      return;
+   }
+
+   *ptr = (char *) obj + delta;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read content of TArray
+
+void TBufferJSON::JsonReadTArray(TJSONNode *value, TArray *arr)
+{
+   if ((value == 0) || (arr == 0)) return;
+
+   Int_t len = JsonCountNumbers(value);
+
+#define TJSONReadTArray(tname)                             \
+   if (tname *tarr = dynamic_cast<tname *>(arr)) {         \
+      tarr->Set(len);                                      \
+      if (len > 0) JsonReadNumbers(value, tarr->GetArray(), len); \
+      return;                                              \
+   }
+
+   TJSONReadTArray(TArrayD)
+   TJSONReadTArray(TArrayF)
+   TJSONReadTArray(TArrayI)
+   TJSONReadTArray(TArrayS)
+   TJSONReadTArray(TArrayC)
+   TJSONReadTArray(TArrayL)
+   TJSONReadTArray(TArrayL64)
+
+#undef TJSONReadTArray
+
+   // unknown TArray subclass, use generic interface
+   Double_t *vals = new Double_t[len > 0 ? len : 1];
+   JsonReadBasicArray<Double_t>(value, vals, len);
+   arr->Set(len);
+   for (Int_t n = 0; n < len; n++) arr->SetAt(vals[n], n);
+   delete [] vals;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read content of TCollection, written by JsonStreamCollection()
+
+void TBufferJSON::JsonReadCollection(TJSONNode *node, TCollection *col)
+{
+   const char *name = node->GetString("name");
+   if (name != 0) col->SetName(name);
+
+   TJSONNode *arr = node->Get("arr");
+   if ((arr == 0) || (arr->fKind != TJSONNode::kArray)) return;
+
+   TJSONNode *opt = node->Get("opt");
+   if ((opt != 0) && (opt->fKind != TJSONNode::kArray)) opt = 0;
+
+   col->Clear();
+
+   TClonesArray *clones = dynamic_cast<TClonesArray *>(col);
+   if (clones != 0) {
+      for (UInt_t n = 0; n < arr->fItems.size(); n++) {
+         TJSONNode *item = arr->fItems[n];
+         const char *clname = item->GetString("_typename");
+         if (clname == 0) continue;
+         if (clones->GetClass() == 0) clones->SetClass(clname);
+         TClass *cl = clones->GetClass();
+         if ((cl == 0) || (strcmp(cl->GetName(), clname) != 0)) {
+            Error("JsonReadCollection", "Wrong class %s for TClonesArray", clname);
+            break;
+         }
+         TObject *tobj = clones->ConstructedAt(n);
+         JsonReadObject(item, (char *) tobj - cl->GetBaseClassOffset(TObject::Class()), cl);
+      }
+      return;
+   }
+
+   TList *lst = dynamic_cast<TList *>(col);
+   Bool_t isarray = col->InheritsFrom(TObjArray::Class());
+
+   for (UInt_t n = 0; n < arr->fItems.size(); n++) {
+      TClass *readClass = 0;
+      void *obj = JsonReadObject(arr->fItems[n], 0, TObject::Class(), &readClass);
+      TObject *tobj = (obj && readClass) ? (TObject *) ((char *) obj + readClass->GetBaseClassOffset(TObject::Class())) : 0;
+
+      if (tobj == 0) {
+         if (isarray) col->Add(0);
+         continue;
+      }
+
+      if ((lst != 0) && (opt != 0) && (n < opt->fItems.size()) && (opt->fItems[n]->fKind == TJSONNode::kString))
+         lst->Add(tobj, opt->fItems[n]->fString.c_str());
+      else
+         col->Add(tobj);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read content of STL container using collection proxy
+
+void TBufferJSON::JsonReadSTL(TJSONNode *value, void *addr, const TClass *cl)
+{
+   if ((value == 0) || (value->fKind != TJSONNode::kArray)) return;
+
+   TVirtualCollectionProxy *proxy = const_cast<TClass *>(cl)->GetCollectionProxy();
+   if (proxy == 0) return;
+
+   TVirtualCollectionProxy::TPushPop helper(proxy, addr);
+
+   TClass *valueClass = proxy->GetValueClass();
+   Int_t type = proxy->GetType();
+   Int_t len = value->GetSize();
+
+   if ((valueClass == 0) && ((type <= 0) || (type >= 20))) {
+      if (gDebug > 0)
+         Info("JsonReadSTL", "Content of %s is not supported", cl->GetName());
+      return;
+   }
+
+   proxy->Clear();
+   void *env = proxy->Allocate(len, kTRUE);
+
+   for (Int_t n = 0; n < len; n++) {
+      void *item = proxy->At(n);
+      if (value->fNumbers.size() > 0) {
+         if (valueClass != 0) continue;
+         TJSONNode num(TJSONNode::kNumber);
+         num.fNumber = value->fNumbers[n];
+         if (value->fIntegers.size() == value->fNumbers.size()) {
+            num.fIsInteger = kTRUE;
+            num.fInteger = value->fIntegers[n];
+         }
+         JsonReadBasic(&num, item, type, 1, kFALSE);
+      } else if (valueClass == 0) {
+         JsonReadBasic(value->fItems[n], item, type, 1, kFALSE);
+      } else if (proxy->HasPointers()) {
+         JsonReadPointer(value->fItems[n], (void **) item, valueClass, kFALSE);
+      } else {
+         JsonReadEmbedded(value->fItems[n], item, valueClass);
+      }
+   }
+
+   proxy->Commit(env);
+}
@@ -0,0 +1,215 @@
+// @(#)root/mathcore:$Id$
+
+// Header file for class DisplacementVector3DSoA
+//
+#ifndef ROOT_Math_GenVector_DisplacementVector3DSoA
+#define ROOT_Math_GenVector_DisplacementVector3DSoA  1
+
+#ifndef ROOT_Math_GenVector_DisplacementVector3D
+#include "Math/GenVector/DisplacementVector3D.h"
+#endif
+
+#ifndef ROOT_Math_GenVector_Cartesian3D
+#include "Math/GenVector/Cartesian3D.h"
+#endif
+
+#ifndef ROOT_Math_GenVector_CylindricalEta3D
+#include "Math/GenVector/CylindricalEta3D.h"
+#endif
+
+#ifndef ROOT_Math_GenVector_eta
+#include "Math/GenVector/eta.h"
+#endif
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+
+namespace ROOT {
+
+  namespace Math {
+
+//__________________________________________________________________________________________
+    /**
+        Collection of 3D displacement vectors stored as a structure of arrays:
+        the X, Y and Z components of all the vectors are stored in three
+        contiguous arrays, on which the operations on the whole collection
+        are simple loops which can be vectorised by the compiler.
+        See also LorentzVectorSoA.
+
+        The collection interoperates with the scalar types: any DisplacementVector3D
+        (with the same coordinate system tag) can be added or set and operator[]
+        returns the i-th element as a DisplacementVector3D<Cartesian3D<Scalar>,Tag>.
+
+        @ingroup GenVector
+    */
+    template <class ScalarType = double, class Tag = DefaultCoordinateSystemTag>
+    class DisplacementVector3DSoA {
+
+    public:
+
+       typedef ScalarType Scalar;
+       typedef DisplacementVector3D<Cartesian3D<Scalar>, Tag> Vector;
+
+       /**
+          default constructor of an empty collection
+       */
+       DisplacementVector3DSoA() { }
+
+       /**
+          construct a collection of n null vectors
+       */
+       explicit DisplacementVector3DSoA(size_t n) : fX(n), fY(n), fZ(n) { }
+
+       /**
+          construct from a vector of DisplacementVector3D in any coordinate system
+       */
+       template <class CoordSystem>
+       explicit DisplacementVector3DSoA(const std::vector<DisplacementVector3D<CoordSystem, Tag> > & v) {
+          Reserve(v.size());
+          for (size_t i = 0; i < v.size(); ++i) PushBack(v[i]);
+       }
+
+       // ------ size ------
+
+       size_t Size() const { return fX.size(); }
+       bool Empty() const { return fX.empty(); }
+
+       void Resize(size_t n) { fX.resize(n); fY.resize(n); fZ.resize(n); }
+       void Reserve(size_t n) { fX.reserve(n); fY.reserve(n); fZ.reserve(n); }
+       void Clear() { fX.clear(); fY.clear(); fZ.clear(); }
+
+       // ------ element access ------
+
+       /**
+          add a vector (in any coordinate system) at the end of the collection
+       */
+       template <class CoordSystem>
+       void PushBack(const DisplacementVector3D<CoordSystem, Tag> & v) {
+          fX.push_back(v.X()); fY.push_back(v.Y()); fZ.push_back(v.Z());
+       }
+
+       /**
+          set the i-th vector from a vector in any coordinate system
+       */
+       template <class CoordSystem>
+       void Set(size_t i, const DisplacementVector3D<CoordSystem, Tag> & v) {
+          fX[i] = v.X(); fY[i] = v.Y(); fZ[i] = v.Z();
+       }
+
+       /**
+          return the i-th vector
+       */
+       Vector operator[](size_t i) const { return Vector(fX[i], fY[i], fZ[i]); }
+
+       /**
+          arrays of the components
+       */
+       const Scalar * X() const { return fX.data(); }
+       const Scalar * Y() const { return fY.data(); }
+       const Scalar * Z() const { return fZ.data(); }
+       Scalar * X() { return fX.data(); }
+       Scalar * Y() { return fY.data(); }
+       Scalar * Z() { return fZ.data(); }
+
+       // ------ coordinate conversions ------
+
+       /**
+          set the collection from n vectors given as arrays of rho, eta and phi.
+          The conversion gives the same result as the one of the CylindricalEta3D
+          coordinate system, apart for a value of phi outside [-PI,PI]
+       */
+       void SetRhoEtaPhi(size_t n, const Scalar * rho, const Scalar * eta, const Scalar * phi) {
+          Resize(n);
+          Scalar * x = fX.data(); Scalar * y = fY.data(); Scalar * z = fZ.data();
+          for (size_t i = 0; i < n; ++i) {
+             x[i] = rho[i] * std::cos(phi[i]);
+             y[i] = rho[i] * std::sin(phi[i]);
+             z[i] = rho[i] * std::sinh(eta[i]);
+          }
+          // vectors with null rho are converted by the coordinate system class
+          for (size_t i = 0; i < n; ++i) {
+             if (rho[i] > 0) continue;
+             Set(i, DisplacementVector3D<CylindricalEta3D<Scalar>, Tag>(rho[i], eta[i], phi[i]));
+          }
+       }
+
+       // ------ derived quantities of all the vectors ------
+       // the output arrays must have a size of at least Size()
+
+       /**
+          magnitudes
+       */
+       void R(Scalar * out) const {
+          const size_t n = Size();
+          const Scalar * x = fX.data(); const Scalar * y = fY.data(); const Scalar * z = fZ.data();
+          for (size_t i = 0; i < n; ++i) out[i] = std::sqrt(x[i] * x[i] + y[i] * y[i] + z[i] * z[i]);
+       }
+
+       /**
+          transverse components
+       */
+       void Rho(Scalar * out) const {
+          const size_t n = Size();
+          const Scalar * x = fX.data(); const Scalar * y = fY.data();
+          for (size_t i = 0; i < n; ++i) out[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+       }
+
+       /**
+          azimuthal angles
+       */
+       void Phi(Scalar * out) const {
+          const size_t n = Size();
+          const Scalar * x = fX.data(); const Scalar * y = fY.data();
+          for (size_t i = 0; i < n; ++i) out[i] = (x[i] == 0.0 && y[i] == 0.0) ? 0 : std::atan2(y[i], x[i]);
+       }
+
+       /**
+          pseudorapidities
+       */
+       void Eta(Scalar * out) const {
+          Rho(out);
+          const size_t n = Size();
+          const Scalar * z = fZ.data();
+          for (size_t i = 0; i < n; ++i) out[i] = Impl::Eta_FromRhoZ(out[i], z[i]);
+       }
+
+       /**
+          dot products of all the vectors with a vector v
+       */
+       template <class OtherVector>
+       void Dot(const OtherVector & v, Scalar * out) const {
+          const Scalar vx = v.X(); const Scalar vy = v.Y(); const Scalar vz = v.Z();
+          const size_t n = Size();
+          const Scalar * x = fX.data(); const Scalar * y = fY.data(); const Scalar * z = fZ.data();
+          for (size_t i = 0; i < n; ++i) out[i] = x[i] * vx + y[i] * vy + z[i] * vz;
+       }
+
+       /**
+          return the sum of all the vectors
+       */
+       Vector Sum() const {
+          const size_t n = Size();
+          Scalar sx = 0, sy = 0, sz = 0;
+          for (size_t i = 0; i < n; ++i) {
+             sx += fX[i]; sy += fY[i]; sz += fZ[i];
+          }
+          return Vector(sx, sy, sz);
+       }
+
+    private:
+
+       std::vector<Scalar> fX;  // x components
+       std::vector<Scalar> fY;  // y components
+       std::vector<Scalar> fZ;  // z components
+
+    };
+
+
+  } // end namespace Math
+
+} // end namespace ROOT
+
+
+#endif /* ROOT_Math_GenVector_DisplacementVector3DSoA  */
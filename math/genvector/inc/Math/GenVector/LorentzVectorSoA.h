@@ -0,0 +1,286 @@
+// @(#)root/mathcore:$Id$
+
+// Header file for class LorentzVectorSoA
+//
+#ifndef ROOT_Math_GenVector_LorentzVectorSoA
+#define ROOT_Math_GenVector_LorentzVectorSoA  1
+
+#ifndef ROOT_Math_GenVector_LorentzVector
+#include "Math/GenVector/LorentzVector.h"
+#endif
+
+#ifndef ROOT_Math_GenVector_PtEtaPhiM4D
+#include "Math/GenVector/PtEtaPhiM4D.h"
+#endif
+
+#ifndef ROOT_Math_GenVector_PtEtaPhiE4D
+#include "Math/GenVector/PtEtaPhiE4D.h"
+#endif
+
+#ifndef ROOT_Math_GenVector_eta
+#include "Math/GenVector/eta.h"
+#endif
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+
+namespace ROOT {
+
+  namespace Math {
+
+//__________________________________________________________________________________________
+    /**
+        Collection of Lorentz vectors stored as a structure of arrays: the
+        Px, Py, Pz and E components of all the vectors are stored in four
+        contiguous arrays.
+        The operations on the whole collection (coordinate conversions,
+        boosts, computation of the masses, ...) are simple loops on these
+        arrays, which can be vectorised by the compiler, instead of
+        operations on single LorentzVector objects.
+
+        The collection interoperates with the scalar types: any LorentzVector
+        can be added or set and operator[] returns the i-th element as a
+        LorentzVector<PxPyPzE4D<Scalar> >.
+        The functions of VectorUtil working on whole collections (e.g. InvariantMass)
+        are defined in Math/GenVector/VectorUtilSoA.h
+
+        @ingroup GenVector
+    */
+    template <class ScalarType = double>
+    class LorentzVectorSoA {
+
+    public:
+
+       typedef ScalarType Scalar;
+       typedef LorentzVector<PxPyPzE4D<Scalar> > Vector;
+
+       /**
+          default constructor of an empty collection
+       */
+       LorentzVectorSoA() { }
+
+       /**
+          construct a collection of n null vectors
+       */
+       explicit LorentzVectorSoA(size_t n) : fX(n), fY(n), fZ(n), fT(n) { }
+
+       /**
+          construct from a vector of LorentzVector in any coordinate system
+       */
+       template <class CoordSystem>
+       explicit LorentzVectorSoA(const std::vector<LorentzVector<CoordSystem> > & v) {
+          Reserve(v.size());
+          for (size_t i = 0; i < v.size(); ++i) PushBack(v[i]);
+       }
+
+       // ------ size ------
+
+       size_t Size() const { return fX.size(); }
+       bool Empty() const { return fX.empty(); }
+
+       void Resize(size_t n) { fX.resize(n); fY.resize(n); fZ.resize(n); fT.resize(n); }
+       void Reserve(size_t n) { fX.reserve(n); fY.reserve(n); fZ.reserve(n); fT.reserve(n); }
+       void Clear() { fX.clear(); fY.clear(); fZ.clear(); fT.clear(); }
+
+       // ------ element access ------
+
+       /**
+          add a vector (in any coordinate system) at the end of the collection
+       */
+       template <class CoordSystem>
+       void PushBack(const LorentzVector<CoordSystem> & v) {
+          fX.push_back(v.Px()); fY.push_back(v.Py()); fZ.push_back(v.Pz()); fT.push_back(v.E());
+       }
+
+       /**
+          set the i-th vector from a vector in any coordinate system
+       */
+       template <class CoordSystem>
+       void Set(size_t i, const LorentzVector<CoordSystem> & v) {
+          fX[i] = v.Px(); fY[i] = v.Py(); fZ[i] = v.Pz(); fT[i] = v.E();
+       }
+
+       /**
+          return the i-th vector
+       */
+       Vector operator[](size_t i) const { return Vector(fX[i], fY[i], fZ[i], fT[i]); }
+
+       /**
+          arrays of the components
+       */
+       const Scalar * Px() const { return fX.data(); }
+       const Scalar * Py() const { return fY.data(); }
+       const Scalar * Pz() const { return fZ.data(); }
+       const Scalar * E()  const { return fT.data(); }
+       Scalar * Px() { return fX.data(); }
+       Scalar * Py() { return fY.data(); }
+       Scalar * Pz() { return fZ.data(); }
+       Scalar * E()  { return fT.data(); }
+
+       // ------ coordinate conversions ------
+
+       /**
+          set the collection from n vectors given as arrays of pt, eta, phi and mass.
+          The conversion gives the same result as the one of the PtEtaPhiM4D
+          coordinate system, apart for a value of phi outside [-PI,PI]
+       */
+       void SetPtEtaPhiM(size_t n, const Scalar * pt, const Scalar * eta, const Scalar * phi, const Scalar * m) {
+          Resize(n);
+          Scalar * x = fX.data(); Scalar * y = fY.data(); Scalar * z = fZ.data(); Scalar * t = fT.data();
+          for (size_t i = 0; i < n; ++i) {
+             x[i] = pt[i] * std::cos(phi[i]);
+             y[i] = pt[i] * std::sin(phi[i]);
+             z[i] = pt[i] * std::sinh(eta[i]);
+             Scalar p = pt[i] * std::cosh(eta[i]);
+             Scalar e2 = p * p + m[i] * m[i];
+             t[i] = std::sqrt(e2);
+          }
+          // the rare vectors with null pt or negative mass are converted by the coordinate system class
+          for (size_t i = 0; i < n; ++i) {
+             if (pt[i] > 0 && m[i] >= 0) continue;
+             Set(i, LorentzVector<PtEtaPhiM4D<Scalar> >(pt[i], eta[i], phi[i], m[i]));
+          }
+       }
+
+       /**
+          set the collection from n vectors given as arrays of pt, eta, phi and energy.
+       */
+       void SetPtEtaPhiE(size_t n, const Scalar * pt, const Scalar * eta, const Scalar * phi, const Scalar * e) {
+          Resize(n);
+          Scalar * x = fX.data(); Scalar * y = fY.data(); Scalar * z = fZ.data(); Scalar * t = fT.data();
+          for (size_t i = 0; i < n; ++i) {
+             x[i] = pt[i] * std::cos(phi[i]);
+             y[i] = pt[i] * std::sin(phi[i]);
+             z[i] = pt[i] * std::sinh(eta[i]);
+             t[i] = e[i];
+          }
+          for (size_t i = 0; i < n; ++i) {
+             if (pt[i] > 0) continue;
+             Set(i, LorentzVector<PtEtaPhiE4D<Scalar> >(pt[i], eta[i], phi[i], e[i]));
+          }
+       }
+
+       /**
+          fill the arrays pt, eta, phi and m (of size Size()) with the
+          cylindrical coordinates of the vectors
+       */
+       void GetPtEtaPhiM(Scalar * pt, Scalar * eta, Scalar * phi, Scalar * m) const {
+          Pt(pt);
+          Eta(eta);
+          Phi(phi);
+          M(m);
+       }
+
+       // ------ derived quantities of all the vectors ------
+       // the output arrays must have a size of at least Size()
+
+       /**
+          transverse momenta
+       */
+       void Pt(Scalar * out) const {
+          const size_t n = Size();
+          const Scalar * x = fX.data(); const Scalar * y = fY.data();
+          for (size_t i = 0; i < n; ++i) out[i] = std::sqrt(x[i] * x[i] + y[i] * y[i]);
+       }
+
+       /**
+          squared invariant masses
+       */
+       void M2(Scalar * out) const {
+          const size_t n = Size();
+          const Scalar * x = fX.data(); const Scalar * y = fY.data(); const Scalar * z = fZ.data(); const Scalar * t = fT.data();
+          for (size_t i = 0; i < n; ++i) out[i] = t[i] * t[i] - x[i] * x[i] - y[i] * y[i] - z[i] * z[i];
+       }
+
+       /**
+          invariant masses. As in VectorUtil::InvariantMass, a negative value
+          -sqrt(-M2) is returned for tachyonic vectors (without warnings)
+       */
+       void M(Scalar * out) const {
+          M2(out);
+          const size_t n = Size();
+          for (size_t i = 0; i < n; ++i) out[i] = (out[i] < 0) ? -std::sqrt(-out[i]) : std::sqrt(out[i]);
+       }
+
+       /**
+          azimuthal angles
+       */
+       void Phi(Scalar * out) const {
+          const size_t n = Size();
+          const Scalar * x = fX.data(); const Scalar * y = fY.data();
+          for (size_t i = 0; i < n; ++i) out[i] = (x[i] == 0.0 && y[i] == 0.0) ? 0 : std::atan2(y[i], x[i]);
+       }
+
+       /**
+          pseudorapidities
+       */
+       void Eta(Scalar * out) const {
+          Pt(out);
+          const size_t n = Size();
+          const Scalar * z = fZ.data();
+          for (size_t i = 0; i < n; ++i) out[i] = Impl::Eta_FromRhoZ(out[i], z[i]);
+       }
+
+       // ------ transformations of all the vectors ------
+
+       /**
+          boost all the vectors with the velocity (bx,by,bz) (in units of c),
+          as VectorUtil::boost. A velocity >= 1 leaves the collection unchanged
+       */
+       void Boost(Scalar bx, Scalar by, Scalar bz) {
+          Scalar b2 = bx * bx + by * by + bz * bz;
+          if (b2 >= 1) {
+             GenVector::Throw ( "Beta Vector supplied to set Boost represents speed >= c");
+             return;
+          }
+          const Scalar gamma = 1.0 / std::sqrt(1.0 - b2);
+          const Scalar gamma2 = b2 > 0 ? (gamma - 1.0) / b2 : 0.0;
+          const size_t n = Size();
+          Scalar * x = fX.data(); Scalar * y = fY.data(); Scalar * z = fZ.data(); Scalar * t = fT.data();
+          for (size_t i = 0; i < n; ++i) {
+             Scalar bp = bx * x[i] + by * y[i] + bz * z[i];
+             Scalar ti = t[i];
+             x[i] = x[i] + gamma2 * bp * bx + gamma * bx * ti;
+             y[i] = y[i] + gamma2 * bp * by + gamma * by * ti;
+             z[i] = z[i] + gamma2 * bp * bz + gamma * bz * ti;
+             t[i] = gamma * (ti + bp);
+          }
+       }
+
+       /**
+          boost all the vectors with a velocity given as a generic 3D vector
+          implementing X(), Y() and Z() (e.g. the result of LorentzVector::BoostToCM)
+       */
+       template <class BoostVector>
+       void Boost(const BoostVector & b) { Boost(b.X(), b.Y(), b.Z()); }
+
+       /**
+          return the sum of all the vectors
+       */
+       Vector Sum() const {
+          const size_t n = Size();
+          Scalar sx = 0, sy = 0, sz = 0, st = 0;
+          for (size_t i = 0; i < n; ++i) {
+             sx += fX[i]; sy += fY[i]; sz += fZ[i]; st += fT[i];
+          }
+          return Vector(sx, sy, sz, st);
+       }
+
+    private:
+
+       std::vector<Scalar> fX;  // px components
+       std::vector<Scalar> fY;  // py components
+       std::vector<Scalar> fZ;  // pz components
+       std::vector<Scalar> fT;  // energy components
+
+    };
+
+
+  } // end namespace Math
+
+} // end namespace ROOT
+
+
+#endif /* ROOT_Math_GenVector_LorentzVectorSoA  */
@@ -0,0 +1,134 @@
+// @(#)root/mathcore:$Id$
+
+// Header file for the Vector Utility functions working on collections of vectors
+//
+#ifndef ROOT_Math_GenVector_VectorUtilSoA
+#define ROOT_Math_GenVector_VectorUtilSoA  1
+
+#ifndef ROOT_Math_Math
+#include "Math/Math.h"
+#endif
+
+#ifndef ROOT_Math_GenVector_LorentzVectorSoA
+#include "Math/GenVector/LorentzVectorSoA.h"
+#endif
+
+#ifndef ROOT_Math_GenVector_DisplacementVector3DSoA
+#include "Math/GenVector/DisplacementVector3DSoA.h"
+#endif
+
+#include <vector>
+#include <cmath>
+#include <cstddef>
+
+
+namespace ROOT {
+
+   namespace Math {
+
+      /**
+       Versions of the VectorUtil functions working on whole collections of vectors
+       stored as structure of arrays (LorentzVectorSoA and DisplacementVector3DSoA).
+       The functions of two collections are applied element by element: the second
+       collection must have at least the size of the first one, and the output array
+       must have a size of at least the size of the first collection.
+
+       @ingroup GenVector
+       */
+      namespace VectorUtil {
+
+         /**
+          squared invariant masses of the pairs (v1[i],v2[i])
+          */
+         template <class T>
+         void InvariantMass2( const LorentzVectorSoA<T> & v1, const LorentzVectorSoA<T> & v2, T * out) {
+            const size_t n = v1.Size();
+            const T * x1 = v1.Px(); const T * y1 = v1.Py(); const T * z1 = v1.Pz(); const T * t1 = v1.E();
+            const T * x2 = v2.Px(); const T * y2 = v2.Py(); const T * z2 = v2.Pz(); const T * t2 = v2.E();
+            for (size_t i = 0; i < n; ++i) {
+               T ee = t1[i] + t2[i];
+               T xx = x1[i] + x2[i];
+               T yy = y1[i] + y2[i];
+               T zz = z1[i] + z2[i];
+               out[i] = ee*ee - xx*xx - yy*yy - zz*zz;
+            }
+         }
+
+         /**
+          invariant masses of the pairs (v1[i],v2[i]), as InvariantMass(v1[i],v2[i])
+          */
+         template <class T>
+         void InvariantMass( const LorentzVectorSoA<T> & v1, const LorentzVectorSoA<T> & v2, T * out) {
+            InvariantMass2(v1, v2, out);
+            const size_t n = v1.Size();
+            for (size_t i = 0; i < n; ++i)
+               out[i] = out[i] < 0.0 ? -std::sqrt(-out[i]) : std::sqrt(out[i]);
+         }
+
+         /**
+          invariant masses of all the pairs (v[i],v[j]) with i < j of a collection,
+          stored in out in the order (0,1), (0,2), ... (0,n-1), (1,2), ...
+          The output array must have a size of at least n*(n-1)/2, where n = v.Size()
+          */
+         template <class T>
+         void InvariantMassPairs( const LorentzVectorSoA<T> & v, T * out) {
+            const size_t n = v.Size();
+            const T * x = v.Px(); const T * y = v.Py(); const T * z = v.Pz(); const T * t = v.E();
+            for (size_t i = 0; i + 1 < n; ++i) {
+               const T xi = x[i]; const T yi = y[i]; const T zi = z[i]; const T ti = t[i];
+               // inner loop on the vectors j > i is vectorised
+               for (size_t j = i + 1; j < n; ++j) {
+                  T ee = ti + t[j];
+                  T xx = xi + x[j];
+                  T yy = yi + y[j];
+                  T zz = zi + z[j];
+                  T mm2 = ee*ee - xx*xx - yy*yy - zz*zz;
+                  out[j - i - 1] = mm2 < 0.0 ? -std::sqrt(-mm2) : std::sqrt(mm2);
+               }
+               out += n - i - 1;
+            }
+         }
+
+         /**
+          Delta R of the pairs (v1[i],v2[i]) of two collections of vectors
+          implementing the Eta(T*) and Phi(T*) methods, as DeltaR(v1[i],v2[i])
+          */
+         template <class Vectors1, class Vectors2, class T>
+         void DeltaR( const Vectors1 & v1, const Vectors2 & v2, T * out) {
+            const size_t n = v1.Size();
+            std::vector<T> eta1(n), phi1(n), eta2(v2.Size()), phi2(v2.Size());
+            v1.Eta(eta1.data());
+            v1.Phi(phi1.data());
+            v2.Eta(eta2.data());
+            v2.Phi(phi2.data());
+            for (size_t i = 0; i < n; ++i) {
+               T dphi = phi2[i] - phi1[i];
+               if ( dphi > M_PI ) {
+                  dphi -= 2.0*M_PI;
+               } else if ( dphi <= -M_PI ) {
+                  dphi += 2.0*M_PI;
+               }
+               T deta = eta2[i] - eta1[i];
+               out[i] = std::sqrt( dphi*dphi + deta*deta );
+            }
+         }
+
+         /**
+          return a copy of the collection v with all the vectors boosted
+          by the velocity b, as boost(v[i],b)
+          */
+         template <class T, class BoostVector>
+         LorentzVectorSoA<T> boost(const LorentzVectorSoA<T> & v, const BoostVector & b) {
+            LorentzVectorSoA<T> lv(v);
+            lv.Boost(b);
+            return lv;
+         }
+
+      }  // end namespace VectorUtil
+
+   }  // end namespace Math
+
+}  // end namespace ROOT
+
+
+#endif /* ROOT_Math_GenVector_VectorUtilSoA  */
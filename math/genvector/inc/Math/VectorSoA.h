@@ -0,0 +1,13 @@
+// @(#)root/mathcore:$Id$
+
+#ifndef ROOT_Math_VectorSoA
+#define ROOT_Math_VectorSoA
+
+// collections of 3D and Lorentz vectors stored as structure of arrays
+#include "Math/GenVector/DisplacementVector3DSoA.h"
+#include "Math/GenVector/LorentzVectorSoA.h"
+
+// VectorUtil functions for the collections
+#include "Math/GenVector/VectorUtilSoA.h"
+
+#endif
@@ -22,6 +22,8 @@
 #include "Math/LorentzRotation.h"
 
 #include "Math/VectorUtil.h"
+#include "Math/Vector4D.h"
+#include "Math/VectorSoA.h"
 #ifndef NO_SMATRIX
 #include "Math/SMatrix.h"
 #endif
@@ -743,6 +745,67 @@ int testVectorUtil() {
 
 }
 
+int testVectorSoA() {
+
+  std::cout << "testing VectorSoA  \t:\t";
+   int iret = 0;
+
+   const int n = 5;
+   double pt[n]  = { 10., 25., 0., 40., 3. };
+   double eta[n] = { 0.5, -1.2, 2., 0., 3.1 };
+   double phi[n] = { 0.1, 2.5, -1., -3., 1.6 };
+   double m[n]   = { 0.105, 0., 1., 91., 0.5 };
+
+   std::vector<PtEtaPhiMVector> vec;
+   for (int i = 0; i < n; ++i) vec.push_back(PtEtaPhiMVector(pt[i],eta[i],phi[i],m[i]) );
+
+   // conversion from the cylindrical coordinates
+   LorentzVectorSoA<double> lv;
+   lv.SetPtEtaPhiM(n, pt, eta, phi, m);
+   LorentzVectorSoA<double> lv2(vec);
+   iret |= compare(lv.Size(), n, "size");
+   for (int i = 0; i < n; ++i) {
+      iret |= compare(lv[i].Px(), vec[i].Px(), "px");
+      iret |= compare(lv[i].Pz(), vec[i].Pz(), "pz");
+      iret |= compare(lv[i].E(), lv2[i].E(), "e");
+   }
+
+   std::vector<double> out(n);
+   lv.M(out.data());
+   for (int i = 0; i < n; ++i) iret |= compare(out[i], lv[i].M(), "m");
+   lv.Eta(out.data());
+   for (int i = 0; i < n; ++i) iret |= compare(out[i], lv[i].Eta(), "eta");
+
+   // invariant masses
+   std::vector<double> mass(n*(n-1)/2);
+   InvariantMassPairs(lv, mass.data());
+   int k = 0;
+   for (int i = 0; i < n; ++i)
+      for (int j = i+1; j < n; ++j)
+         iret |= compare(mass[k++], InvariantMass(lv[i], lv[j]), "mass pairs");
+
+   lv2.Boost(lv[0].BoostToCM());
+   InvariantMass(lv, lv2, out.data());
+   for (int i = 0; i < n; ++i)
+      iret |= compare(out[i], InvariantMass(lv[i], boost(lv[i], lv[0].BoostToCM())), "mass");
+
+   DeltaR(lv, lv2, out.data());
+   for (int i = 0; i < n; ++i) iret |= compare(out[i], DeltaR(lv[i], lv2[i]), "deltaR");
+
+   // 3D vectors
+   DisplacementVector3DSoA<double> v3;
+   v3.SetRhoEtaPhi(n, pt, eta, phi);
+   XYZVector sum;
+   for (int i = 0; i < n; ++i) sum += RhoEtaPhiVector(pt[i], eta[i], phi[i]);
+   iret |= compare(v3.Sum().X(), sum.X(), "sum x", 10);
+   iret |= compare(v3.Sum().Z(), sum.Z(), "sum z", 10);
+
+  if (iret == 0) std::cout << "\t\t\tOK\n";
+  else std::cout << "\t\t\t\t\t\tFAILED\n";
+  return iret;
+
+}
+
 int testGenVector() {
 
   int iret = 0;
@@ -758,6 +821,8 @@ int testGenVector() {
 
   iret |= testVectorUtil();
 
+  iret |= testVectorSoA();
+
 
   if (iret !=0) std::cout << "\nTest GenVector FAILED!!!!!!!!!\n";
   return iret;
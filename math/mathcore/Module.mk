@@ -125,7 +125,7 @@ $(MATHCORELIB): $(MATHCOREO) $(MATHCOREDO) $(ORDER_) $(MAINLIBS)
 		@$(MAKELIB) $(PLATFORM) $(LD) "$(LDFLAGS)"  \
 		   "$(SOFLAGS)" libMathCore.$(SOEXT) $@     \
 		   "$(MATHCOREO) $(MATHCOREDO)" \
-		   "$(MATHCORELIBEXTRA)"
+		   "$(MATHCORELIBEXTRA) $(TBBLIBDIR) $(TBBLIB)"
 
 $(call pcmrule,MATHCORE)
 	$(noop)
@@ -170,6 +170,16 @@ endif
 ##### extra rules ######
 $(MATHCOREO): CXXFLAGS += -DUSE_ROOT_ERROR
 $(MATHCOREDO): CXXFLAGS += -DUSE_ROOT_ERROR 
+ifeq ($(BUILDTBB),yes)
+$(MATHCOREO): CXXFLAGS += $(TBBINCDIR:%=-I%)
+endif
+ifeq ($(BUILDVDT),yes)
+$(MATHCOREO): CXXFLAGS += -I$(ROOT_SRCDIR)/math/vdt/include
+endif
+ifneq ($(PLATFORM),win32)
+# let the compiler vectorise the loops of the array versions of the functions
+$(call stripsrc,$(MODDIRS)/VecFuncMathCore.o $(MODDIRS)/TMath.o $(MODDIRS)/RandomFunctions.o): CXXFLAGS += -fno-trapping-math
+endif
 # add optimization to G__Math compilation
 # Optimize dictionary with stl containers.
 $(MATHCOREDO1) : NOOPT = $(OPT)
@@ -509,6 +509,44 @@ public :
    */
    double SumOfError2() const { return fSumError2;}
 
+   /**
+      build a columnar copy of the data (see DataColumns), with a contiguous array for
+      each coordinate, for the values and for the inverse of the errors.
+      It is used by the fit method functions (see FitUtil) to evaluate the model function in
+      batches of points. It is supported only for data without coordinate errors
+      (type kNoError or kValueError) and it must be rebuilt after modifying the data.
+      Return false if the columns cannot be built
+   */
+   bool BuildColumns();
+
+   /**
+      query if a valid columnar copy of the data exists
+   */
+   bool HasColumns() const {
+      return fNPoints > 0 && fColumns.NPoints() == fNPoints;
+   }
+
+   /**
+      return the contiguous array of the coordinate icoord of all the points
+      (available only when HasColumns() is true)
+   */
+   const double * CoordColumn(unsigned int icoord) const {
+      assert(icoord < fDim);
+      return fColumns.Column(icoord);
+   }
+
+   /**
+      return the contiguous array of the values of all the points
+      (available only when HasColumns() is true)
+   */
+   const double * ValueColumn() const { return fColumns.Column(fDim); }
+
+   /**
+      return the contiguous array of the inverse errors of all the points (1 for kNoError)
+      (available only when HasColumns() is true)
+   */
+   const double * InvErrorColumn() const { return fColumns.Column(fDim+1); }
+
 
 protected:
 
@@ -529,6 +567,8 @@ private:
 
    std::vector<double> fBinEdge;  // vector containing the bin upper edge (coordinate will contain low edge)
 
+   DataColumns fColumns;  // columnar copy of the data (coordinates, values and inverse errors)
+
 
 #ifdef USE_BINPOINT_CLASS
    mutable BinPoint fPoint;
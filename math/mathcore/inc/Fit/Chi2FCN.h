@@ -33,13 +33,9 @@
 #include "Fit/FitUtil.h"
 #endif
 
-//#define ROOT_FIT_PARALLEL
-
-#ifdef ROOT_FIT_PARALLEL
 #ifndef ROOT_Fit_FitUtilParallel
 #include "Fit/FitUtilParallel.h"
 #endif
-#endif
 
 #include <memory>
 
@@ -79,10 +75,13 @@ public:
    typedef typename BaseObjFunction::Type_t Type_t;
 
    /**
-      Constructor from data set (binned ) and model function
+      Constructor from data set (binned ) and model function.
+      If parallel is true the chi2 and its gradient are evaluated in parallel
+      (see FitUtilParallel)
    */
-   Chi2FCN (const std::shared_ptr<BinData> & data, const std::shared_ptr<IModelFunction> & func) :
+   Chi2FCN (const std::shared_ptr<BinData> & data, const std::shared_ptr<IModelFunction> & func, bool parallel = false) :
       BaseFCN( data, func),
+      fParallel(parallel),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func->NPar() ) )
    { }
@@ -91,8 +90,9 @@ public:
       Same Constructor from data set (binned ) and model function but now managed by the user
       we clone the function but not the data
    */
-   Chi2FCN ( const BinData & data, const IModelFunction & func) :
+   Chi2FCN ( const BinData & data, const IModelFunction & func, bool parallel = false) :
       BaseFCN(std::shared_ptr<BinData>(const_cast<BinData*>(&data), DummyDeleter<BinData>()), std::shared_ptr<IModelFunction>(dynamic_cast<IModelFunction*>(func.Clone() ) ) ),
+      fParallel(parallel),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func.NPar() ) )
    { }
@@ -106,6 +106,7 @@ public:
    */
    Chi2FCN(const Chi2FCN & f) :
       BaseFCN(f.DataPtr(), f.ModelFunctionPtr() ),
+      fParallel( f.fParallel ),
       fNEffPoints( f.fNEffPoints ),
       fGrad( f.fGrad)
    {  }
@@ -116,6 +117,7 @@ public:
    Chi2FCN & operator = (const Chi2FCN & rhs) {
       SetData(rhs.DataPtr() );
       SetModelFunction(rhs.ModelFunctionPtr() );
+      fParallel = rhs.fParallel;
       fNEffPoints = rhs.fNEffPoints;
       fGrad = rhs.fGrad; 
    }
@@ -127,6 +129,22 @@ public:
       return new Chi2FCN(*this); 
    }
 
+   /**
+      clone the function with an independent clone of the model function (see
+      IBaseFunctionMultiDim::CloneForThread). Return 0 when the model function does not provide one
+   */
+   virtual BaseFunction * CloneForThread() const {
+      ::ROOT::Math::IBaseFunctionMultiDim * f = this->ModelFunction().CloneForThread();
+      IModelFunction * func = dynamic_cast<IModelFunction*>(f);
+      if (!func) {
+         delete f;
+         return 0;
+      }
+      Chi2FCN * fcn = new Chi2FCN(*this);
+      fcn->SetModelFunction(std::shared_ptr<IModelFunction>(func) );
+      return fcn;
+   }
+
 
 
    using BaseObjFunction::operator();
@@ -141,9 +159,34 @@ public:
    // need to be virtual to be instantiated
    virtual void Gradient(const double *x, double *g) const {
       // evaluate the chi2 gradient
-      FitUtil::EvaluateChi2Gradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints);
+      if (fParallel)
+         FitUtilParallel::EvaluateChi2Gradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints);
+      else
+         FitUtil::EvaluateChi2Gradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints);
    }
 
+   /// evaluate at the same time the chi2 and its gradient, with a single loop on the data
+   virtual void FdF(const double * x, double & f, double * g) const {
+      const BinData & data = BaseFCN::Data();
+      // the gradient does not support errors on the coordinates or expected errors
+      if (data.HaveCoordErrors() || data.Opt().fExpErrors) {
+         f = DoEval(x);
+         Gradient(x, g);
+         return;
+      }
+      this->UpdateNCalls();
+      if (fParallel)
+         f = FitUtilParallel::EvaluateChi2AndGradient(BaseFCN::ModelFunction(), data, x, g, fNEffPoints);
+      else
+         f = FitUtil::EvaluateChi2AndGradient(BaseFCN::ModelFunction(), data, x, g, fNEffPoints);
+   }
+
+   /// return true if the evaluation is done in parallel
+   bool IsParallel() const { return fParallel; }
+
+   /// evaluate the chi2 and its gradient in parallel (see FitUtilParallel)
+   void SetParallel(bool on = true) { fParallel = on; }
+
    /// get type of fit method function
    virtual  typename BaseObjFunction::Type_t Type() const { return BaseObjFunction::kLeastSquare; }
 
@@ -161,14 +204,12 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
-#ifdef ROOT_FIT_PARALLEL
-      return FitUtilParallel::EvaluateChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
-#else
+      if (fParallel)
+         return FitUtilParallel::EvaluateChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
       if (!BaseFCN::Data().HaveCoordErrors() )
          return FitUtil::EvaluateChi2(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
       else
          return FitUtil::EvaluateChi2Effective(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
-#endif
    }
 
    // for derivatives
@@ -178,6 +219,8 @@ private:
    }
 
 
+   bool fParallel;  // flag to evaluate the chi2 and its gradient in parallel
+
    mutable unsigned int fNEffPoints;  // number of effective points used in the fit
 
    mutable std::vector<double> fGrad; // for derivatives
@@ -38,6 +38,7 @@ Classes for describing the input data for fitting
 
 #include <vector>
 #include <cassert>
+#include <algorithm>
 #include <iostream>
 
 
@@ -203,6 +204,118 @@ private:
 };
 
 
+/**
+   class holding a columnar (structure of arrays) copy of the fit data points.
+   Each column (a coordinate, the values, the errors, ...) is stored in a contiguous
+   array, aligned to kAlignment bytes and padded to a multiple of kAlignment bytes,
+   so the points can be processed in vector-width batches.
+   The columns are filled by the data classes (see BinData::BuildColumns and
+   UnBinData::BuildColumns)
+
+   @ingroup FitData
+*/
+
+class DataColumns {
+
+public:
+
+   enum { kAlignment = 64 };   // alignment of the columns in bytes
+
+   /**
+      default constructor (no columns)
+   */
+   DataColumns() :
+      fNColumns(0),
+      fNPoints(0),
+      fStride(0),
+      fOffset(0)
+   {}
+
+   /**
+      constructor allocating ncols columns of npoints values (initialized to zero)
+   */
+   DataColumns(unsigned int ncols, unsigned int npoints) :
+      fNColumns(0),
+      fNPoints(0),
+      fStride(0),
+      fOffset(0)
+   {
+      Allocate(ncols, npoints);
+   }
+
+   // copy keeping the alignment of the columns
+   DataColumns(const DataColumns & rhs) :
+      fNColumns(0),
+      fNPoints(0),
+      fStride(0),
+      fOffset(0)
+   {
+      (*this) = rhs;
+   }
+
+   DataColumns & operator= (const DataColumns & rhs) {
+      if (&rhs == this) return *this;
+      Allocate(rhs.fNColumns, rhs.fNPoints);
+      for (unsigned int icol = 0; icol < fNColumns; ++icol)
+         std::copy(rhs.Column(icol), rhs.Column(icol) + fNPoints, Column(icol) );
+      return *this;
+   }
+
+   /**
+      (re)allocate ncols columns of npoints values (initialized to zero)
+   */
+   void Allocate(unsigned int ncols, unsigned int npoints) {
+      const unsigned int nalign = kAlignment/sizeof(double);
+      fNColumns = ncols;
+      fNPoints = npoints;
+      fStride = ( (npoints + nalign - 1) / nalign ) * nalign;
+      // allocate an extra aligned block to be able to align the first column
+      fData.assign( size_t(fStride) * ncols + nalign, 0.);
+      size_t addr = reinterpret_cast<size_t>(&fData[0]);
+      fOffset = ( (kAlignment - addr % kAlignment) % kAlignment ) / sizeof(double);
+   }
+
+   /**
+      release the memory of the columns
+   */
+   void Clear() {
+      FData().swap(fData);
+      fNColumns = 0;
+      fNPoints = 0;
+      fStride = 0;
+      fOffset = 0;
+   }
+
+   /// number of columns
+   unsigned int NColumns() const { return fNColumns; }
+
+   /// number of points (values in each column)
+   unsigned int NPoints() const { return fNPoints; }
+
+   /**
+      access to the values of the column icol
+   */
+   const double * Column(unsigned int icol) const {
+      assert(icol < fNColumns);
+      return &fData[fOffset + size_t(fStride) * icol];
+   }
+   double * Column(unsigned int icol) {
+      assert(icol < fNColumns);
+      return &fData[fOffset + size_t(fStride) * icol];
+   }
+
+private:
+
+   typedef std::vector<double> FData;
+
+   unsigned int fNColumns;  // number of columns
+   unsigned int fNPoints;   // number of points in each column
+   unsigned int fStride;    // distance between two columns (number of points rounded to the alignment)
+   unsigned int fOffset;    // offset of the first aligned element in the data vector
+   FData fData;             // storage of all the columns
+};
+
+
 //       // usefule typedef's of DataVector
 //       class BinPoint;
 
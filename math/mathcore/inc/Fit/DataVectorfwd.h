@@ -27,6 +27,7 @@ namespace ROOT {
 
       class BinData;
       class UnBinData;
+      class DataColumns;
 
 
 
@@ -182,6 +182,12 @@ public:
    ///Apply Weight correction for error matrix computation
    bool UseWeightCorrection() const { return fWeightCorr; }
 
+   ///Evaluate the fit method function and its gradient in parallel (see FitUtilParallel)
+   bool UseParallel() const { return fParallel; }
+
+   ///Evaluate the model function in batches of points on a columnar copy of the data
+   bool UseBatchEvaluation() const { return fBatchEval; }
+
 
    /// return vector of parameter indeces for which the Minos Error will be computed
    const std::vector<unsigned int> & MinosParams() const { return fMinosParams; }
@@ -200,6 +206,14 @@ public:
    ///apply the weight correction for error matric computation
    void SetWeightCorrection(bool on = true) { fWeightCorr = on; }
 
+   ///evaluate the fit method function and its gradient in parallel using the implicit multi-threading pool
+   void SetParallel(bool on = true) { fParallel = on; }
+
+   ///build a columnar copy of the fit data (see BinData::BuildColumns) and evaluate the model function
+   ///in batches of points, when the function supports it (see IBaseFunctionMultiDim::HasEvalBatch).
+   ///The copy needs as much memory as the fit data
+   void SetBatchEvaluation(bool on = true) { fBatchEval = on; }
+
    /// set parameter indeces for running Minos
    /// this can be used for running Minos on a subset of parameters - otherwise is run on all of them
    /// if MinosErrors() is set
@@ -230,6 +244,8 @@ private:
    bool fMinosErrors;      // do full error analysis using Minos
    bool fUpdateAfterFit;   // update the configuration after a fit using the result
    bool fWeightCorr;       // apply correction to errors for weights fits
+   bool fParallel;         // evaluate the fit method function in parallel
+   bool fBatchEval;        // evaluate the model function in batches on a columnar copy of the data
 
    std::vector<ROOT::Fit::ParameterSettings> fSettings;  // vector with the parameter settings
    std::vector<unsigned int> fMinosParams;               // vector with the parameter indeces for running Minos
@@ -61,6 +61,14 @@ namespace FitUtil {
    */
    void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints);
 
+   /**
+       evaluate at the same time the Chi2 and its gradient given a model function and the data at the point x,
+       with a single loop on the data points.
+       return also nPoints as the effective number of used points in the Chi2 gradient evaluation.
+       The errors on the coordinates and the expected errors are not supported
+   */
+   double EvaluateChi2AndGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints);
+
    /**
        evaluate the LogL given a model function and the data at the point x.
        return also nPoints as the effective number of used points in the LogL evaluation
@@ -86,11 +94,50 @@ namespace FitUtil {
    */
    void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad);
 
-//    /**
-//        Parallel evaluate the Chi2 given a model function and the data at the point x.
-//        return also nPoints as the effective number of used points in the Chi2 evaluation
-//    */
-//    double ParallelEvalChi2(const IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints);
+   /** Partial sums over the data points in [begin, end).
+       They are used by the functions above and by the parallel evaluation in FitUtilParallel.
+       The sums are Kahan compensated. The function evaluating the values (not the gradients)
+       assume that the parameters x have already been set in the model function.
+   */
+
+   /**
+       evaluate the sum of the Chi2 residuals of the points in [begin,end)
+   */
+   double EvaluateChi2Sum(const IModelFunction & func, const BinData & data, const double * x, unsigned int begin, unsigned int end);
+
+   /**
+       evaluate the Chi2 gradient summing the points in [begin,end).
+       return also the number of points rejected because of overflows and, if chi2 is not null,
+       the sum of the Chi2 residuals computed in the same loop
+   */
+   void EvaluateChi2GradientSum(const IModelFunction & func, const BinData & data, const double * x, unsigned int begin, unsigned int end, double * grad, unsigned int & nRejected, double * chi2 = 0);
+
+   /**
+       evaluate the sum of the log of the pdf for the points in [begin,end) (the LogL without sign and extended term).
+       return also the sum of the weights and of the weight squares needed by the extended term
+   */
+   double EvaluateLogLSum(const IModelFunction & func, const UnBinData & data, const double * x, int iWeight, bool extended, unsigned int begin, unsigned int end, double & sumW, double & sumW2);
+
+   /**
+       evaluate the extended term to be added to the sum of the log of the pdf
+   */
+   double EvaluateLogLExtendedTerm(const IModelFunction & func, const UnBinData & data, const double * x, int iWeight, double sumW, double sumW2);
+
+   /**
+       evaluate the LogL gradient summing the points in [begin,end)
+   */
+   void EvaluateLogLGradientSum(const IModelFunction & func, const UnBinData & data, const double * x, unsigned int begin, unsigned int end, double * grad);
+
+   /**
+       evaluate the Poisson LogL summing the bins in [begin,end).
+       return also nPoints as the number of bins with non zero content
+   */
+   double EvaluatePoissonLogLSum(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int begin, unsigned int end, unsigned int & nPoints);
+
+   /**
+       evaluate the Poisson LogL gradient summing the bins in [begin,end)
+   */
+   void EvaluatePoissonLogLGradientSum(const IModelFunction & func, const BinData & data, const double * x, unsigned int begin, unsigned int end, double * grad);
 
    // methods required by dedicate minimizer like Fumili
 
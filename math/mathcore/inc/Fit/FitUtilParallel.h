@@ -8,20 +8,12 @@
  *                                                                    *
  **********************************************************************/
 
-// Header file for class FitUtil
+// Header file for class FitUtilParallel
 
 
 #ifndef ROOT_Fit_FitUtilParallel
 #define ROOT_Fit_FitUtilParallel
 
-#ifdef _WIN32  // no support for parallel fits on Win32
-#ifdef ROOT_FIT_PARALLEL
-#undef ROOT_FIT_PARALLEL
-#endif
-#endif
-
-#ifdef ROOT_FIT_PARALLEL
-
 #ifndef ROOT_Math_IParamFunctionfwd
 #include "Math/IParamFunctionfwd.h"
 #endif
@@ -36,37 +28,81 @@ namespace ROOT {
    namespace Fit {
 
 
-   typedef  ROOT::Math::IParamMultiFunction IModelFunction;
-
-
 /**
-   namespace defining free functions for Fitting parallel mode
+   namespace defining free functions for evaluating the fit method functions (chi2, likelihood, etc..)
+   and their gradients in parallel, using the tasks of the implicit multi-threading (IMT) pool.
 
-   Status: functions are not not completed and are still preliminary
+   The data points are split in chunks of a fixed size (see ChunkSize()), which does not depend
+   on the number of threads. The chunks are evaluated by separate tasks and their partial sums
+   are then reduced in a fixed order using a Kahan summation, so the result is the same
+   whatever is the number of threads used.
+   When ROOT is built without IMT support, or when IMT is not enabled (see ROOT::EnableImplicitMT),
+   the chunks are evaluated sequentially.
+
+   The model function is evaluated concurrently: it must be thread safe. Its parameter gradient is
+   evaluated concurrently only when the function declares it thread safe (see
+   ROOT::Math::IParamMultiGradFunction::HasThreadSafeParameterGradient); otherwise the chunks of
+   the gradient are evaluated sequentially, which gives the same result.
 
    @ingroup FitMain
 */
 namespace FitUtilParallel {
 
+   typedef  ROOT::Math::IParamMultiFunction IModelFunction;
 
+   /**
+       number of data points evaluated by each task
+   */
+   unsigned int ChunkSize();
 
    /**
        evaluate the Chi2 given a model function and the data at the point x.
        return also nPoints as the effective number of used points in the Chi2 evaluation
-       Use a parallel evaluation spawning multiple threads
+       The effective chi2 (with coordinate errors) is evaluated sequentially
+   */
+   double EvaluateChi2(const IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints);
+
+   /**
+       evaluate the Chi2 gradient given a model function and the data at the point x.
+       return also nPoints as the effective number of used points in the Chi2 evaluation
+   */
+   void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints);
+
+   /**
+       evaluate at the same time the Chi2 and its gradient given a model function and the data at the point x.
+       return also nPoints as the effective number of used points in the Chi2 gradient evaluation
+   */
+   double EvaluateChi2AndGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints);
+
+   /**
+       evaluate the LogL given a model function and the data at the point x.
+       return also nPoints as the effective number of used points in the LogL evaluation
    */
-   double EvaluateChi2(IModelFunction & func, const BinData & data, const double * x, unsigned int & nPoints);
+   double EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints);
 
+   /**
+       evaluate the LogL gradient given a model function and the data at the point x.
+       return also nPoints as the effective number of used points in the LogL evaluation
+   */
+   void EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints);
 
-   double EvaluateLogL(IModelFunction & func, const UnBinData & data, const double * p, unsigned int &nPoints);
+   /**
+       evaluate the Poisson LogL given a model function and the data at the point x.
+       return also nPoints as the effective number of used points in the LogL evaluation
+   */
+   double EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * x, int iWeight, bool extended, unsigned int & nPoints);
+
+   /**
+       evaluate the Poisson LogL gradient given a model function and the data at the point x.
+   */
+   void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad);
 
 
-} // end namespace FitUtil
+} // end namespace FitUtilParallel
 
    } // end namespace Fit
 
 } // end namespace ROOT
 
 
-#endif /* ROOT_FIT_PARALLEL */
-#endif /* ROOT_Fit_FitUtil */
+#endif /* ROOT_Fit_FitUtilParallel */
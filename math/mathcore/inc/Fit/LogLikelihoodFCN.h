@@ -29,11 +29,9 @@
 #include "Fit/FitUtil.h"
 #endif
 
-#ifdef ROOT_FIT_PARALLEL
 #ifndef ROOT_Fit_FitUtilParallel
 #include "Fit/FitUtilParallel.h"
 #endif
-#endif
 
 #include <memory>
 
@@ -65,11 +63,14 @@ public:
 
 
    /**
-      Constructor from unbin data set and model function (pdf)
+      Constructor from unbin data set and model function (pdf).
+      If parallel is true the likelihood and its gradient are evaluated in parallel
+      (see FitUtilParallel)
    */
-   LogLikelihoodFCN (const std::shared_ptr<UnBinData> & data, const std::shared_ptr<IModelFunction> & func, int weight = 0, bool extended = false) :
+   LogLikelihoodFCN (const std::shared_ptr<UnBinData> & data, const std::shared_ptr<IModelFunction> & func, int weight = 0, bool extended = false, bool parallel = false) :
       BaseFCN( data, func),
       fIsExtended(extended),
+      fParallel(parallel),
       fWeight(weight),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func->NPar() ) )
@@ -78,9 +79,10 @@ public:
       /**
       Constructor from unbin data set and model function (pdf) for object managed by users
    */
-   LogLikelihoodFCN (const UnBinData & data, const IModelFunction & func, int weight = 0, bool extended = false) :
+   LogLikelihoodFCN (const UnBinData & data, const IModelFunction & func, int weight = 0, bool extended = false, bool parallel = false) :
       BaseFCN(std::shared_ptr<UnBinData>(const_cast<UnBinData*>(&data), DummyDeleter<UnBinData>()), std::shared_ptr<IModelFunction>(dynamic_cast<IModelFunction*>(func.Clone() ) ) ),
       fIsExtended(extended),
+      fParallel(parallel),
       fWeight(weight),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func.NPar() ) )
@@ -97,6 +99,7 @@ public:
    LogLikelihoodFCN(const LogLikelihoodFCN & f) :
       BaseFCN(f.DataPtr(), f.ModelFunctionPtr() ),
       fIsExtended(f.fIsExtended ),
+      fParallel(f.fParallel ),
       fWeight( f.fWeight ),
       fNEffPoints( f.fNEffPoints ),
       fGrad( f.fGrad)
@@ -112,6 +115,7 @@ public:
       fNEffPoints = rhs.fNEffPoints;
       fGrad = rhs.fGrad; 
       fIsExtended = rhs.fIsExtended;
+      fParallel = rhs.fParallel;
       fWeight = rhs.fWeight; 
    }
 
@@ -119,6 +123,22 @@ public:
    /// clone the function (need to return Base for Windows)
    virtual BaseFunction * Clone() const { return  new LogLikelihoodFCN(*this); }
 
+   /**
+      clone the function with an independent clone of the model function (see
+      IBaseFunctionMultiDim::CloneForThread). Return 0 when the model function does not provide one
+   */
+   virtual BaseFunction * CloneForThread() const {
+      ::ROOT::Math::IBaseFunctionMultiDim * f = this->ModelFunction().CloneForThread();
+      IModelFunction * func = dynamic_cast<IModelFunction*>(f);
+      if (!func) {
+         delete f;
+         return 0;
+      }
+      LogLikelihoodFCN * fcn = new LogLikelihoodFCN(*this);
+      fcn->SetModelFunction(std::shared_ptr<IModelFunction>(func) );
+      return fcn;
+   }
+
 
    //using BaseObjFunction::operator();
 
@@ -135,7 +155,10 @@ public:
    // need to be virtual to be instantited
    virtual void Gradient(const double *x, double *g) const {
       // evaluate the chi2 gradient
-      FitUtil::EvaluateLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints);
+      if (fParallel)
+         FitUtilParallel::EvaluateLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints);
+      else
+         FitUtil::EvaluateLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g, fNEffPoints);
    }
 
    /// get type of fit method function
@@ -150,6 +173,12 @@ public:
       else fWeight = 1;
    }
 
+   /// return true if the evaluation is done in parallel
+   bool IsParallel() const { return fParallel; }
+
+   /// evaluate the likelihood and its gradient in parallel (see FitUtilParallel)
+   void SetParallel(bool on = true) { fParallel = on; }
+
 
 
 protected:
@@ -163,11 +192,9 @@ private:
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
 
-#ifdef ROOT_FIT_PARALLEL
-      return FitUtilParallel::EvaluateLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fNEffPoints);
-#else
+      if (fParallel)
+         return FitUtilParallel::EvaluateLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints);
       return FitUtil::EvaluateLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints);
-#endif
    }
 
    // for derivatives
@@ -179,6 +206,7 @@ private:
 
       //data member
    bool fIsExtended;  // flag for indicating if likelihood is extended
+   bool fParallel;    // flag to evaluate the likelihood and its gradient in parallel
    int  fWeight;  // flag to indicate if needs to evaluate using weight or weight squared (default weight = 0)
 
 
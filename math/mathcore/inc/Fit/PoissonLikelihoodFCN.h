@@ -30,14 +30,11 @@
 #endif
 
 
-#include <memory>
+#ifndef ROOT_Fit_FitUtilParallel
+#include "Fit/FitUtilParallel.h"
+#endif
 
-//#define PARALLEL
-// #ifdef PARALLEL
-// #ifndef ROOT_Fit_FitUtilParallel
-// #include "Fit/FitUtilParallel.h"
-// #endif
-// #endif
+#include <memory>
 
 namespace ROOT {
 
@@ -66,11 +63,14 @@ public:
 
 
    /**
-      Constructor from unbin data set and model function (pdf)
+      Constructor from unbin data set and model function (pdf).
+      If parallel is true the likelihood and its gradient are evaluated in parallel
+      (see FitUtilParallel)
    */
-   PoissonLikelihoodFCN (const std::shared_ptr<BinData> & data, const std::shared_ptr<IModelFunction> & func, int weight = 0, bool extended = true ) :
+   PoissonLikelihoodFCN (const std::shared_ptr<BinData> & data, const std::shared_ptr<IModelFunction> & func, int weight = 0, bool extended = true, bool parallel = false ) :
       BaseFCN( data, func),
       fIsExtended(extended),
+      fParallel(parallel),
       fWeight(weight),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func->NPar() ) )
@@ -79,9 +79,10 @@ public:
    /**
       Constructor from unbin data set and model function (pdf) managed by the users
    */
-   PoissonLikelihoodFCN (const BinData & data, const IModelFunction & func, int weight = 0, bool extended = true ) :
+   PoissonLikelihoodFCN (const BinData & data, const IModelFunction & func, int weight = 0, bool extended = true, bool parallel = false ) :
       BaseFCN(std::shared_ptr<BinData>(const_cast<BinData*>(&data), DummyDeleter<BinData>()), std::shared_ptr<IModelFunction>(dynamic_cast<IModelFunction*>(func.Clone() ) ) ),
       fIsExtended(extended),
+      fParallel(parallel),
       fWeight(weight),
       fNEffPoints(0),
       fGrad ( std::vector<double> ( func.NPar() ) )
@@ -99,6 +100,7 @@ public:
    PoissonLikelihoodFCN(const PoissonLikelihoodFCN & f) :
       BaseFCN(f.DataPtr(), f.ModelFunctionPtr() ),
       fIsExtended(f.fIsExtended ),
+      fParallel(f.fParallel ),
       fWeight( f.fWeight ),
       fNEffPoints( f.fNEffPoints ),
       fGrad( f.fGrad)
@@ -113,6 +115,7 @@ public:
       fNEffPoints = rhs.fNEffPoints;
       fGrad = rhs.fGrad; 
       fIsExtended = rhs.fIsExtended;
+      fParallel = rhs.fParallel;
       fWeight = rhs.fWeight; 
    }
 
@@ -120,6 +123,22 @@ public:
    /// clone the function (need to return Base for Windows)
    virtual BaseFunction * Clone() const { return new  PoissonLikelihoodFCN(*this); }
 
+   /**
+      clone the function with an independent clone of the model function (see
+      IBaseFunctionMultiDim::CloneForThread). Return 0 when the model function does not provide one
+   */
+   virtual BaseFunction * CloneForThread() const {
+      ::ROOT::Math::IBaseFunctionMultiDim * f = this->ModelFunction().CloneForThread();
+      IModelFunction * func = dynamic_cast<IModelFunction*>(f);
+      if (!func) {
+         delete f;
+         return 0;
+      }
+      PoissonLikelihoodFCN * fcn = new PoissonLikelihoodFCN(*this);
+      fcn->SetModelFunction(std::shared_ptr<IModelFunction>(func) );
+      return fcn;
+   }
+
    // effective points used in the fit
    virtual unsigned int NFitPoints() const { return fNEffPoints; }
 
@@ -132,7 +151,10 @@ public:
    /// evaluate gradient
    virtual void Gradient(const double *x, double *g) const {
       // evaluate the chi2 gradient
-      FitUtil::EvaluatePoissonLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g );
+      if (fParallel)
+         FitUtilParallel::EvaluatePoissonLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g );
+      else
+         FitUtil::EvaluatePoissonLogLGradient(BaseFCN::ModelFunction(), BaseFCN::Data(), x, g );
    }
 
    /// get type of fit method function
@@ -154,6 +176,12 @@ public:
       else fWeight = 1;
    }
 
+   /// return true if the evaluation is done in parallel
+   bool IsParallel() const { return fParallel; }
+
+   /// evaluate the likelihood and its gradient in parallel (see FitUtilParallel)
+   void SetParallel(bool on = true) { fParallel = on; }
+
 
 protected:
 
@@ -165,6 +193,8 @@ private:
     */
    virtual double DoEval (const double * x) const {
       this->UpdateNCalls();
+      if (fParallel)
+         return FitUtilParallel::EvaluatePoissonLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints);
       return FitUtil::EvaluatePoissonLogL(BaseFCN::ModelFunction(), BaseFCN::Data(), x, fWeight, fIsExtended, fNEffPoints);
    }
 
@@ -178,6 +208,7 @@ private:
       //data member
 
    bool fIsExtended; // flag to indicate if is extended (when false is a Multinomial lieklihood), default is true
+   bool fParallel;   // flag to evaluate the likelihood and its gradient in parallel
    int fWeight;  // flag to indicate if needs to evaluate using weight or weight squared (default weight = 0)
 
    mutable unsigned int fNEffPoints;  // number of effective points used in the fit
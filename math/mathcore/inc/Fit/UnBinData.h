@@ -335,6 +335,36 @@ public:
       return (fDataVector) ? fDataVector->Size() : 0;
    }
 
+   /**
+      build a columnar copy of the data (see DataColumns), with a contiguous array for
+      each coordinate and for the weights.
+      It is used by the fit method functions (see FitUtil) to evaluate the model function in
+      batches of points. It must be rebuilt after modifying the data.
+   */
+   void BuildColumns();
+
+   /**
+      query if a valid columnar copy of the data exists
+   */
+   bool HasColumns() const {
+      return fNPoints > 0 && fColumns.NPoints() == fNPoints;
+   }
+
+   /**
+      return the contiguous array of the coordinate icoord of all the points
+      (available only when HasColumns() is true)
+   */
+   const double * CoordColumn(unsigned int icoord) const {
+      assert(icoord < fDim);
+      return fColumns.Column(icoord);
+   }
+
+   /**
+      return the contiguous array of the weights of all the points (1 for unweighted data)
+      (available only when HasColumns() is true)
+   */
+   const double * WeightColumn() const { return fColumns.Column(fDim); }
+
 
 protected:
 
@@ -349,6 +379,8 @@ private:
    DataVector * fDataVector;     // pointer to internal data vector (null for external data)
    DataWrapper * fDataWrapper;   // pointer to structure wrapping external data (null when data are copied in)
 
+   DataColumns fColumns;         // columnar copy of the data (coordinates and weights)
+
 };
 
 
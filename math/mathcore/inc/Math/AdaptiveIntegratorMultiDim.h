@@ -72,6 +72,18 @@ namespace Math {
        Some analysis or suitable transformations of the integral prior to
        numerical work may contribute to numerical efficiency.
 
+   Parallel mode:
+
+      With SetParallelMode() (or the type IntegrationMultiDim::kADAPTIVEPARALLEL of the
+      IntegratorMultiDim factory) the integrator divides at each step the (up to 32) sub-regions
+      with the largest errors, instead of only one. The integrand is evaluated on all the nodes
+      of the rule of a sub-region at once, with the batch interface
+      IBaseFunctionMultiDim::EvalBatch, and the new sub-regions are computed in parallel
+      when the implicit multi-threading is enabled (ROOT::EnableImplicitMT()).
+      The integrand must then be thread-safe. The result does not depend on the number of threads,
+      but it differs slightly from the one of the sequential mode, which divides the sub-regions
+      in a different order.
+
    References:
 
      1.A.C. Genz and A.A. Malik, Remarks on algorithm 006:
@@ -161,6 +173,12 @@ public:
    ///set max points
    void SetMaxPts(unsigned int n) { fMaxPts = n; }
 
+   /// divide several sub-regions at each step, evaluating them with batches of nodes and in parallel
+   void SetParallelMode(bool on = true) { fParallel = on; }
+
+   /// return true if the parallel mode is used
+   bool IsParallelMode() const { return fParallel; }
+
    /// set the options
    void SetOptions(const ROOT::Math::IntegratorMultiDimOptions & opt);
 
@@ -172,6 +190,9 @@ protected:
    // internal function to compute the integral (if absVal is true compute abs value of function integral
    double DoIntegral(const double* xmin, const double * xmax, bool absVal = false);
 
+   // implementation of DoIntegral for the parallel mode
+   double DoIntegralParallel(const double* xmin, const double * xmax, bool absVal);
+
  private:
 
    unsigned int fDim;     // dimentionality of integrand
@@ -186,6 +207,7 @@ protected:
    double fRelError;      // Relative error
    int    fNEval;        // number of function evaluation
    int fStatus;   // status of algorithm (error if not zero)
+   bool fParallel;        // use the parallel mode
 
    const IMultiGenFunction* fFun;   // pointer to integrand function
 
@@ -58,11 +58,13 @@ namespace Math {
      <li>kPLAIN    MC integration
      <li>kMISER    MC integration
      <li>kVEGAS    MC integration
+     <li>kADAPTIVEPARALLEL : adaptive multi-dimensional integration dividing several sub-regions
+                             at each step, in parallel (see AdaptiveIntegratorMultiDim::SetParallelMode)
      </ul>
      @ingroup MCIntegration
      */
 
-     enum Type {kDEFAULT = -1, kADAPTIVE, kVEGAS, kMISER, kPLAIN};
+     enum Type {kDEFAULT = -1, kADAPTIVE, kVEGAS, kMISER, kPLAIN, kADAPTIVEPARALLEL};
 
   }
 
@@ -36,6 +36,8 @@
 #include "Math/IFunctionfwd.h"
 #endif
 
+#include <vector>
+
 
 namespace ROOT {
 namespace Math {
@@ -80,6 +82,14 @@ namespace Math {
       */
       virtual IBaseFunctionMultiDim * Clone() const = 0;
 
+      /**
+          Clone a function to evaluate it in another thread. Unlike Clone(), the copy must not
+          share any modifiable state with this function (e.g. the parameters of a wrapped TF1),
+          so that both can be evaluated at the same time.
+          The default implementation returns a null pointer: such a copy cannot be made
+      */
+      virtual IBaseFunctionMultiDim * CloneForThread() const { return 0; }
+
       /**
          Retrieve the dimension of the function
        */
@@ -93,6 +103,25 @@ namespace Math {
          return DoEval(x);
       }
 
+      /**
+         Evaluate the function for a batch of n points given in a columnar layout:
+         x[icoord] points to the n values of the coordinate icoord.
+         The function values are returned in the result array, which must have a size of at least n.
+         Used by the fit method functions when the data have a columnar copy (see ROOT::Fit::DataColumns)
+         and by the multi-dimensional adaptive integrator, which evaluates all the nodes of its
+         integration rule at once.
+         Use the virtual function DoEvalBatch to implement a vectorized evaluation.
+      */
+      void EvalBatch(const double * const * x, double * result, unsigned int n) const {
+         DoEvalBatch(x, result, n);
+      }
+
+      /**
+         Return true when the function re-implements DoEvalBatch. The fitter builds a columnar
+         copy of the fit data only for such functions, when requested (see ROOT::Fit::FitConfig::SetBatchEvaluation)
+      */
+      virtual bool HasEvalBatch() const { return false; }
+
 #ifdef LATER
       /**
          Template method to eveluate the function using the begin of an iterator
@@ -113,6 +142,21 @@ namespace Math {
       */
       virtual double DoEval(const double * x) const = 0;
 
+      /**
+         Implementation of the batch evaluation. The default implementation gathers the
+         coordinates of each point and evaluates the function point by point.
+         Re-implement it in derived classes which can evaluate many points at once
+      */
+      virtual void DoEvalBatch(const double * const * x, double * result, unsigned int n) const {
+         unsigned int ndim = NDim();
+         std::vector<double> xp(ndim);
+         for (unsigned int i = 0; i < n; ++i) {
+            for (unsigned int icoord = 0; icoord < ndim; ++icoord)
+               xp[icoord] = x[icoord][i];
+            result[i] = DoEval(&xp.front());
+         }
+      }
+
 
   };
 
@@ -27,6 +27,7 @@
 
 
 #include <cassert>
+#include <vector>
 
 /**
    @defgroup ParamFunc Parameteric Function Evaluation Interfaces.
@@ -128,6 +129,8 @@ public:
 
    using BaseFunc::operator();
 
+   // the batch evaluation EvalBatch(x, result, n) of the base class uses the cached parameter values
+
 
 private:
 
@@ -271,6 +274,13 @@ public:
       return DoParameterDerivative(x, Parameters() , ipar);
    }
 
+   /**
+      Return true when ParameterGradient(x,p,grad) does not modify the function object, so that
+      it can be called at the same time from several threads. The parallel fit method functions
+      (see ROOT::Fit::FitUtilParallel) evaluate the gradient sequentially otherwise
+   */
+   virtual bool HasThreadSafeParameterGradient() const { return false; }
+
 private:
 
 
@@ -65,6 +65,9 @@ namespace ROOT {
          }
          inline double operator() () { return Rndm_impl(); }
 
+         /// generate an array of random numbers in ]0,1]
+         void RndmArray(int n, double * array);
+
          unsigned int IntRndm() {
             // fSeed = (1103515245 * fSeed + 12345) & 0x7fffffffUL;
             // return fSeed;
@@ -75,6 +78,9 @@ namespace ROOT {
 
          double Rndm_impl();
 
+         /// generate the next numbers of the state
+         void GenerateState();
+
          
          uint32_t  fMt[624];
          int fCount624;
@@ -86,6 +86,15 @@ namespace ROOT {
          /// set the generator seed using a 64 bits integer
          void SetSeed64(uint64_t seed);
 
+         /**
+            set the generator state to the one of an independent stream identified by four 32 bits integers.
+            The state is obtained from a fixed state by skipping a number of steps computed from the IDs:
+            the streams are guaranteed not to overlap for at least 10^100 numbers if any bit of the IDs
+            is different. Use for example a different streamID for each thread (or each toy) to have
+            reproducible and independent sequences in a parallel generation
+         */
+         void SeedUniqueStream(unsigned int clusterID, unsigned int machineID, unsigned int runID, unsigned int streamID);
+
          ///set the full initial generator state and warm up generator by doing some iterations
          void SetState(const std::vector<StateInt_t> & state, bool warmup = true);
 
@@ -111,7 +120,8 @@ namespace ROOT {
          /// generate a double random number (faster interface)
          inline double operator() () { return Rndm_impl(); }
 
-         /// generate an array of random numbers 
+         /// generate an array of random numbers in ]0,1].
+         /// The numbers are generated in blocks of the size of the generator state (fastest for n multiple of Size()-1)
          void RndmArray (int n, double * array); 
 
          /// generate a 64  bit integer number
@@ -65,7 +65,7 @@ namespace Math {
          Function to preserve ROOT Trandom compatibility
       */
       void RndmArray(int n, double * array) {
-         fEngine.RandomArray(array, array+n);
+         fEngine.RndmArray(n, array);
       }
 
       /**
@@ -210,6 +210,22 @@ namespace Math {
          return fFunctions.UniformBase(a,b);
       }
 
+      /**
+         Generate n Gaussian numbers in the array x.
+         The uniform numbers are generated in a block with RndmArray and transformed
+         with the Box-Muller method: the sequence is different than the one of Gaus
+      */
+      void GausN(int n, double * x, double mean = 0, double sigma = 1) {
+         fFunctions.GausN(n, x, mean, sigma);
+      }
+
+      /**
+         Generate n exponential numbers in the array x (see GausN)
+      */
+      void ExpN(int n, double * x, double tau) {
+         fFunctions.ExpN(n, x, tau);
+      }
+
 
       RandomFunctions<Engine,EngineBaseType> & Functions() {
          return fFunctions;
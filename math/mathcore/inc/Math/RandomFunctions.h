@@ -48,6 +48,55 @@ namespace Math {
    //class DefaultEngineType {};  // for generic types
 
 
+   namespace Impl {
+
+      /**
+         Transform n (even) numbers u uniformly distributed in ]0,1] in n Gaussian
+         numbers x with the given mean and sigma, using the Box-Muller method on the
+         pairs (u[i],u[i+n/2]). The arrays u and x can be the same.
+         The loop is vectorised (it uses the VDT functions when available)
+      */
+      void GausBoxMuller(int n, const double * u, double * x, double mean, double sigma);
+
+      /**
+         Transform n numbers u uniformly distributed in ]0,1] in n numbers x
+         distributed as exp(-x/tau). The arrays u and x can be the same
+      */
+      void ExpFromUniform(int n, const double * u, double * x, double tau);
+
+      /**
+         Generate n Gaussian numbers in the array x using a generator with the
+         method RndmArray(n, x) returning n uniform numbers in ]0,1]
+      */
+      template <class Generator>
+      void GausN(Generator & rng, int n, double * x, double mean, double sigma) {
+         int n2 = n - n % 2;
+         if (n2 > 0) {
+            rng.RndmArray(n2, x);
+            GausBoxMuller(n2, x, x, mean, sigma);
+         }
+         if (n2 < n) {
+            double u[2];
+            rng.RndmArray(2, u);
+            GausBoxMuller(2, u, u, mean, sigma);
+            x[n2] = u[0];
+         }
+      }
+
+      /**
+         Generate n exponential numbers in the array x using a generator with the
+         method RndmArray(n, x) returning n uniform numbers in ]0,1]
+      */
+      template <class Generator>
+      void ExpN(Generator & rng, int n, double * x, double tau) {
+         if (n <= 0) return;
+         rng.RndmArray(n, x);
+         ExpFromUniform(n, x, x, tau);
+      }
+
+   } // end namespace Impl
+
+
 
       /**
       Definition of the generic impelmentation class for the RandomFunctions.
@@ -228,6 +277,18 @@ namespace Math {
          return fImpl.GausACR(mean,sigma);
       }
 
+      /// generate n Gaussian numbers in the array x.
+      /// The numbers are generated in a block with the Box-Muller method,
+      /// so the sequence is not the same as calling n times Gaus
+      void GausN(int n, double * x, double mean, double sigma) {
+         Impl::GausN(Rng(), n, x, mean, sigma);
+      }
+
+      /// generate n exponential numbers (exp(-t/tau)) in the array x
+      void ExpN(int n, double * x, double tau) {
+         Impl::ExpN(Rng(), n, x, tau);
+      }
+
 
       // /// re-implement Gaussian 
       // double GausBM2(double mean, double sigma) {
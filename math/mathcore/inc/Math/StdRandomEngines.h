@@ -57,6 +57,11 @@ namespace ROOT {
             return Rndm(); 
          }
 
+         /// generate an array of random numbers in ]0,1]
+         void RndmArray(int n, double * array) {
+            for (int i = 0; i < n; ++i) array[i] = Rndm();
+         }
+
          static uint64_t MaxInt() { return Generator::max(); }
 
       private:
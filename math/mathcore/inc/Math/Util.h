@@ -65,6 +65,54 @@ inline double EvalLog(double x) {
       return std::log(x);
 }
 
+
+/**
+   Kahan (compensated) summation of a sequence of values.
+   The rounding error of each addition is kept and fed back into the next one,
+   so that the accuracy of the result does not degrade with the number of terms.
+*/
+template<class T>
+class KahanSum {
+
+public:
+
+   KahanSum(T initialValue = T()) :
+      fSum(initialValue),
+      fCorrection(0)
+   {}
+
+   /// add a value to the sum
+   void Add(T x) {
+      T y = x - fCorrection;
+      T t = fSum + y;
+      fCorrection = (t - fSum) - y;
+      fSum = t;
+   }
+
+   KahanSum & operator+= (T x) {
+      Add(x);
+      return *this;
+   }
+
+   /// add another compensated sum
+   KahanSum & operator+= (const KahanSum & rhs) {
+      Add(rhs.fSum);
+      Add(-rhs.fCorrection);
+      return *this;
+   }
+
+   /// return the sum
+   T Result() const { return fSum; }
+
+   /// return the current correction (the part of the sum which was lost)
+   T Correction() const { return fCorrection; }
+
+private:
+
+   T fSum;         // running sum
+   T fCorrection;  // running compensation of the lost low order bits
+};
+
 }  // end namespace Util
 
 
@@ -96,6 +96,10 @@ public:
       return new WrappedParamFunction(fFunc, fDim, fParams.begin(), fParams.end());
    }
 
+   /// the clone has its own copy of the parameters: the wrapped function is assumed
+   /// to have no state
+   IMultiGenFunction * CloneForThread() const { return Clone(); }
+
    const double * Parameters() const {
       return  &(fParams.front());
    }
@@ -108,6 +112,8 @@ public:
 
    unsigned int NDim() const { return fDim; }
 
+   bool HasEvalBatch() const { return true; }
+
 
 private:
 
@@ -116,6 +122,18 @@ private:
       return (*fFunc)( x, p );
    }
 
+   /// evaluate the function with the cached parameters for n points given in columnar layout,
+   /// calling directly the wrapped function instead of going through DoEval for each point
+   void DoEvalBatch(const double * const * x, double * result, unsigned int n) const {
+      std::vector<double> xp(fDim > 0 ? fDim : 1);
+      const double * p = (fParams.size() > 0) ? &fParams.front() : 0;
+      for (unsigned int i = 0; i < n; ++i) {
+         for (unsigned int icoord = 0; icoord < fDim; ++icoord)
+            xp[icoord] = x[icoord][i];
+         result[i] = (*fFunc)( &xp.front(), p );
+      }
+   }
+
 
    FuncPtr fFunc;
    unsigned int fDim;
@@ -178,6 +178,17 @@ namespace TMath {
    inline Double_t SignalingNaN();
    inline Double_t Infinity();
 
+   /* ******************************************** */
+   /* * Array versions of the elementary functions * */
+   /* ******************************************** */
+   // evaluate the function for the n values of x (and y) and store the results in r,
+   // using the vectorisable functions of VDT when ROOT is built with it
+   void Exp(Long64_t n, const Double_t *x, Double_t *r);
+   void Log(Long64_t n, const Double_t *x, Double_t *r);
+   void Sin(Long64_t n, const Double_t *x, Double_t *r);
+   void Cos(Long64_t n, const Double_t *x, Double_t *r);
+   void ATan2(Long64_t n, const Double_t *y, const Double_t *x, Double_t *r);
+
    template <typename T>
    struct Limits {
       inline static T Min();
@@ -273,6 +284,7 @@ namespace TMath {
    Double_t FDist(Double_t F, Double_t N, Double_t M);
    Double_t FDistI(Double_t F, Double_t N, Double_t M);
    Double_t Gaus(Double_t x, Double_t mean=0, Double_t sigma=1, Bool_t norm=kFALSE);
+   void     Gaus(Long64_t n, const Double_t *x, Double_t *r, Double_t mean=0, Double_t sigma=1, Bool_t norm=kFALSE);
    Double_t KolmogorovProb(Double_t z);
    Double_t KolmogorovTest(Int_t na, const Double_t *a, Int_t nb, const Double_t *b, Option_t *option);
    Double_t Landau(Double_t x, Double_t mpv=0, Double_t sigma=1, Bool_t norm=kFALSE);
@@ -38,7 +38,9 @@ public:
    virtual  Double_t BreitWigner(Double_t mean=0, Double_t gamma=1);
    virtual  void     Circle(Double_t &x, Double_t &y, Double_t r);
    virtual  Double_t Exp(Double_t tau);
+   virtual  void     ExpN(Int_t n, Double_t *x, Double_t tau);
    virtual  Double_t Gaus(Double_t mean=0, Double_t sigma=1);
+   virtual  void     GausN(Int_t n, Double_t *x, Double_t mean=0, Double_t sigma=1);
    virtual  UInt_t   GetSeed() const {return fSeed;}
    virtual  UInt_t   Integer(UInt_t imax);
    virtual  Double_t Landau(Double_t mean=0, Double_t sigma=1);
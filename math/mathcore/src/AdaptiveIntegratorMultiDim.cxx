@@ -6,12 +6,157 @@
 #include "Math/IntegratorOptions.h"
 #include "Math/Error.h"
 
+#include "TROOT.h"
+
 #include <cmath>
 #include <algorithm>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#endif
 
 namespace ROOT {
 namespace Math {
 
+namespace {
+
+// constants of the integration rule of degree seven of Genz and Malik
+
+const double xl2 = 0.358568582800318073;//lambda_2
+const double xl4 = 0.948683298050513796;//lambda_4
+const double xl5 = 0.688247201611685289;//lambda_5
+const double w2  = 980./6561; //weights/2^n
+const double w4  = 200./19683;
+const double wp2 = 245./486;//error weights/2^n
+const double wp4 = 25./729;
+
+const double wn1[14] = {     -0.193872885230909911, -0.555606360818980835,
+                                    -0.876695625666819078, -1.15714067977442459,  -1.39694152314179743,
+                                    -1.59609815576893754,  -1.75461057765584494,  -1.87247878880251983,
+                                    -1.94970278920896201,  -1.98628257887517146,  -1.98221815780114818,
+                                    -1.93750952598689219,  -1.85215668343240347,  -1.72615963013768225};
+
+const double wn3[14] = {     0.0518213686937966768,  0.0314992633236803330,
+                                    0.0111771579535639891,-0.00914494741655235473,-0.0294670527866686986,
+                                    -0.0497891581567850424,-0.0701112635269013768, -0.0904333688970177241,
+                                    -0.110755474267134071, -0.131077579637250419,  -0.151399685007366752,
+                                    -0.171721790377483099, -0.192043895747599447,  -0.212366001117715794};
+
+const double wn5[14] = {         0.871183254585174982e-01,  0.435591627292587508e-01,
+                                        0.217795813646293754e-01,  0.108897906823146873e-01,  0.544489534115734364e-02,
+                                        0.272244767057867193e-02,  0.136122383528933596e-02,  0.680611917644667955e-03,
+                                        0.340305958822333977e-03,  0.170152979411166995e-03,  0.850764897055834977e-04,
+                                        0.425382448527917472e-04,  0.212691224263958736e-04,  0.106345612131979372e-04};
+
+const double wpn1[14] = {   -1.33196159122085045, -2.29218106995884763,
+                                   -3.11522633744855959, -3.80109739368998611, -4.34979423868312742,
+                                   -4.76131687242798352, -5.03566529492455417, -5.17283950617283939,
+                                   -5.17283950617283939, -5.03566529492455417, -4.76131687242798352,
+                                   -4.34979423868312742, -3.80109739368998611, -3.11522633744855959};
+
+const double wpn3[14] = {     0.0445816186556927292, -0.0240054869684499309,
+                                     -0.0925925925925925875, -0.161179698216735251,  -0.229766803840877915,
+                                     -0.298353909465020564,  -0.366941015089163228,  -0.435528120713305891,
+                                     -0.504115226337448555,  -0.572702331961591218,  -0.641289437585733882,
+                                     -0.709876543209876532,  -0.778463648834019195,  -0.847050754458161859};
+
+// sub-region of the parallel mode with the integral and error estimates of the rule
+struct Region {
+   std::vector<double> fCtr;  // center
+   std::vector<double> fWth;  // half-widths
+   double fVal;               // integral estimate
+   double fErr;               // error estimate
+   unsigned int fAxis;        // coordinate with the largest fourth difference (next division)
+};
+
+bool LessError(const Region & r1, const Region & r2) { return r1.fErr < r2.fErr; }
+
+// Evaluate the rule in the nreg regions: the nodes of all the regions are stored in columns
+// and the integrand is called once with the batch interface.
+// The nodes and the sums are in the same order as in the sequential algorithm
+void EvalRegions(const IMultiGenFunction & f, unsigned int n, bool absValue, Region * regions, unsigned int nreg)
+{
+   const unsigned int ncorners = 1u << n;
+   const unsigned int nnodes = ncorners + 2*n*(n+1) + 1;
+   const unsigned int ntot = nnodes*nreg;
+   std::vector<double> xcol(n*ntot);
+   std::vector<const double *> xptr(n);
+   for (unsigned int j = 0; j < n; j++) xptr[j] = &xcol[j*ntot];
+   std::vector<double> fval(ntot);
+
+   for (unsigned int ireg = 0; ireg < nreg; ireg++) {
+      const double * ctr = &regions[ireg].fCtr.front();
+      const double * wth = &regions[ireg].fWth.front();
+      unsigned int ip = ireg*nnodes;
+      // all nodes at the center, then the coordinates different from the center are set
+      for (unsigned int j = 0; j < n; j++)
+         std::fill(&xcol[j*ntot+ip], &xcol[j*ntot+ip+nnodes], ctr[j]);
+      ip++;
+      for (unsigned int j = 0; j < n; j++) {
+         double * xj = &xcol[j*ntot];
+         xj[ip++] = ctr[j] - xl2*wth[j];
+         xj[ip++] = ctr[j] + xl2*wth[j];
+         xj[ip++] = ctr[j] - xl4*wth[j];
+         xj[ip++] = ctr[j] + xl4*wth[j];
+      }
+      for (unsigned int j1 = 0; j1+1 < n; j1++) {
+         for (unsigned int k = j1+1; k < n; k++) {
+            for (unsigned int l = 0; l < 2; l++) {
+               for (unsigned int m = 0; m < 2; m++) {
+                  xcol[j1*ntot+ip] = ctr[j1] + (l ? 1 : -1)*xl4*wth[j1];
+                  xcol[k*ntot+ip]  = ctr[k]  + (m ? 1 : -1)*xl4*wth[k];
+                  ip++;
+               }
+            }
+         }
+      }
+      for (unsigned int ic = 0; ic < ncorners; ic++, ip++)
+         for (unsigned int j = 0; j < n; j++)
+            xcol[j*ntot+ip] = ctr[j] + ((ic >> j) & 1 ? 1 : -1)*xl5*wth[j];
+   }
+
+   f.EvalBatch(&xptr.front(), &fval.front(), ntot);
+   if (absValue)
+      for (unsigned int i = 0; i < ntot; i++) fval[i] = std::abs(fval[i]);
+
+   for (unsigned int ireg = 0; ireg < nreg; ireg++) {
+      Region & r = regions[ireg];
+      const double * fv = &fval[ireg*nnodes];
+      double rgnvol = std::pow(2.0,static_cast<int>(n));
+      for (unsigned int j = 0; j < n; j++) rgnvol *= r.fWth[j];
+
+      unsigned int ip = 0;
+      double sum1 = fv[ip++];
+      double sum2 = 0, sum3 = 0, sum4 = 0, sum5 = 0;
+      double difmax = 0;
+      r.fAxis = 0;
+      for (unsigned int j = 0; j < n; j++) {
+         double f2 = fv[ip]; f2 += fv[ip+1];
+         double f3 = fv[ip+2]; f3 += fv[ip+3];
+         ip += 4;
+         sum2 += f2;
+         sum3 += f3;
+         double dif = std::abs(7*f2-f3-12*sum1);
+         if (dif >= difmax) {
+            difmax = dif;
+            r.fAxis = j;
+         }
+      }
+      const unsigned int npairs = 2*n*(n-1);
+      for (unsigned int i = 0; i < npairs; i++) sum4 += fv[ip++];
+      for (unsigned int i = 0; i < ncorners; i++) sum5 += fv[ip++];
+
+      double rgncmp = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
+      double rgnval = wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5;
+      rgnval *= rgnvol;
+      r.fVal = rgnval;
+      r.fErr = std::abs(rgnval-rgncmp);
+   }
+}
+
+} // end anonymous namespace
+
 
 
 AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double relTol, unsigned int maxpts, unsigned int size):
@@ -25,6 +170,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fParallel(false),
    fFun(0)
 {
    // constructor - without passing a function
@@ -45,6 +191,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fParallel(false),
    fFun(&f)
 {
    // constructur passing a multi-dimensional function interface
@@ -83,6 +230,8 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    //   2.A. van Doren and L. de Ridder, An adaptive algorithm for numerical
    //     integration over an n-dimensional cube, J.Comput. Appl. Math. 2 (1976) 207-217.
 
+   if (fParallel) return DoIntegralParallel(xmin, xmax, absValue);
+
    //to be changed later
    unsigned int n=fDim;
    bool kFALSE = false;
@@ -98,44 +247,6 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
 
    double ctr[15], wth[15], wthl[15], z[15];
 
-   static const double xl2 = 0.358568582800318073;//lambda_2
-   static const double xl4 = 0.948683298050513796;//lambda_4
-   static const double xl5 = 0.688247201611685289;//lambda_5
-   static const double w2  = 980./6561; //weights/2^n
-   static const double w4  = 200./19683;
-   static const double wp2 = 245./486;//error weights/2^n
-   static const double wp4 = 25./729;
-
-   static const double wn1[14] = {     -0.193872885230909911, -0.555606360818980835,
-                                       -0.876695625666819078, -1.15714067977442459,  -1.39694152314179743,
-                                       -1.59609815576893754,  -1.75461057765584494,  -1.87247878880251983,
-                                       -1.94970278920896201,  -1.98628257887517146,  -1.98221815780114818,
-                                       -1.93750952598689219,  -1.85215668343240347,  -1.72615963013768225};
-
-   static const double wn3[14] = {     0.0518213686937966768,  0.0314992633236803330,
-                                       0.0111771579535639891,-0.00914494741655235473,-0.0294670527866686986,
-                                       -0.0497891581567850424,-0.0701112635269013768, -0.0904333688970177241,
-                                       -0.110755474267134071, -0.131077579637250419,  -0.151399685007366752,
-                                       -0.171721790377483099, -0.192043895747599447,  -0.212366001117715794};
-
-   static const double wn5[14] = {         0.871183254585174982e-01,  0.435591627292587508e-01,
-                                           0.217795813646293754e-01,  0.108897906823146873e-01,  0.544489534115734364e-02,
-                                           0.272244767057867193e-02,  0.136122383528933596e-02,  0.680611917644667955e-03,
-                                           0.340305958822333977e-03,  0.170152979411166995e-03,  0.850764897055834977e-04,
-                                           0.425382448527917472e-04,  0.212691224263958736e-04,  0.106345612131979372e-04};
-
-   static const double wpn1[14] = {   -1.33196159122085045, -2.29218106995884763,
-                                      -3.11522633744855959, -3.80109739368998611, -4.34979423868312742,
-                                      -4.76131687242798352, -5.03566529492455417, -5.17283950617283939,
-                                      -5.17283950617283939, -5.03566529492455417, -4.76131687242798352,
-                                      -4.34979423868312742, -3.80109739368998611, -3.11522633744855959};
-
-   static const double wpn3[14] = {     0.0445816186556927292, -0.0240054869684499309,
-                                        -0.0925925925925925875, -0.161179698216735251,  -0.229766803840877915,
-                                        -0.298353909465020564,  -0.366941015089163228,  -0.435528120713305891,
-                                        -0.504115226337448555,  -0.572702331961591218,  -0.641289437585733882,
-                                        -0.709876543209876532,  -0.778463648834019195,  -0.847050754458161859};
-
    double result = 0;
    double abserr = 0;
    fStatus  = 3;
@@ -381,6 +492,127 @@ L160: //to divide or not
 }
 
 
+double AdaptiveIntegratorMultiDim::DoIntegralParallel(const double* xmin, const double * xmax, bool absValue)
+{
+   // Same rule and stopping conditions as DoIntegral, but at each step the (up to kMaxDivisions)
+   // sub-regions with the largest errors are divided and the new sub-regions are evaluated
+   // in chunks, in parallel when the implicit multi-threading is enabled.
+   // The chunks and the order of the sums do not depend on the number of threads.
+
+   const unsigned int kMaxDivisions = 32;   // maximum number of sub-regions divided at each step
+   const unsigned int kNodesPerChunk = 512; // minimum number of nodes evaluated by a task
+
+   unsigned int n = fDim;
+   fStatus = 3;
+   if (n < 2 || n > 15) {
+      MATH_WARN_MSGVAL("AdaptiveIntegratorMultiDim::Integral","Wrong function dimension",n);
+      return 0;
+   }
+
+   double twondm = std::pow(2.0,static_cast<int>(n));
+   unsigned int irgnst = 2*n+3;
+   unsigned int irlcls = (unsigned int)(twondm) +2*n*(n+1)+1;//minimal number of nodes in n dim
+
+   unsigned int minpts = fMinPts;
+   unsigned int maxpts = std::max(fMaxPts, irlcls) ;//specified maximal number of function evaluations
+   if (minpts < 1)      minpts = irlcls;
+   if (maxpts < minpts) maxpts = 10*minpts;
+
+   // maximum number of sub-regions, corresponding to the size of the working array of DoIntegral
+   unsigned int iwk = std::max( fSize, irgnst*(1 +maxpts/irlcls)/2 );
+   unsigned int maxRegions = std::max(1u, iwk/irgnst);
+
+   // the sub-regions are kept in a heap ordered by their errors
+   std::vector<Region> regions(1);
+   regions[0].fCtr.resize(n);
+   regions[0].fWth.resize(n);
+   for (unsigned int j = 0; j < n; j++) {
+      regions[0].fCtr[j] = (xmax[j] + xmin[j])*0.5;
+      regions[0].fWth[j] = (xmax[j] - xmin[j])*0.5;
+   }
+   EvalRegions(*fFun, n, absValue, &regions[0], 1);
+
+   double result = regions[0].fVal;
+   double abserr = regions[0].fErr;
+   unsigned int ifncls = irlcls;
+   double relerr = 0;
+
+   std::vector<Region> newRegions;
+   for (;;) {
+      double aresult = std::abs(result);
+      relerr = abserr;
+      if (aresult != 0)  relerr = abserr/aresult;
+
+      fStatus = 3;
+      if (relerr < 1e-1 && aresult < 1e-20) fStatus = 0;
+      if (relerr < 1e-3 && aresult < 1e-10) fStatus = 0;
+      if (relerr < 1e-5 && aresult < 1e-5)  fStatus = 0;
+      if (regions.size() >= maxRegions) fStatus = 2;
+      if (ifncls+2*irlcls > maxpts) {
+         if (result == 0 && abserr == 0) {
+            fStatus = 0;
+            result = 0;
+         }
+         else
+            fStatus = 1;
+      }
+      if ( ( relerr < fRelTol || abserr < fAbsTol ) && ifncls >= minpts) fStatus = 0;
+      if (fStatus != 3) break;
+
+      // divide the sub-regions with the largest errors, within the limits of calls and size
+      unsigned int ndiv = std::min<unsigned int>(regions.size(), kMaxDivisions);
+      ndiv = std::min(ndiv, (maxpts-ifncls)/(2*irlcls));
+      ndiv = std::min<unsigned int>(ndiv, maxRegions-regions.size());
+      newRegions.resize(2*ndiv);
+      for (unsigned int idiv = 0; idiv < ndiv; idiv++) {
+         std::pop_heap(regions.begin(), regions.end(), LessError);
+         const Region & r = regions.back();
+         result -= r.fVal;
+         abserr -= r.fErr;
+         Region & r1 = newRegions[2*idiv];
+         Region & r2 = newRegions[2*idiv+1];
+         r1.fCtr = r.fCtr;
+         r1.fWth = r.fWth;
+         r1.fWth[r.fAxis] = 0.5*r.fWth[r.fAxis];
+         r1.fCtr[r.fAxis] -= r1.fWth[r.fAxis];
+         r2.fCtr = r1.fCtr;
+         r2.fWth = r1.fWth;
+         r2.fCtr[r.fAxis] += 2*r1.fWth[r.fAxis];
+         regions.pop_back();
+      }
+
+      unsigned int nnew = 2*ndiv;
+      unsigned int chunkSize = std::max(1u, kNodesPerChunk/irlcls);
+      unsigned int nchunks = (nnew + chunkSize - 1)/chunkSize;
+      auto evalChunk = [&](unsigned int ichunk) {
+         unsigned int begin = ichunk*chunkSize;
+         unsigned int end = std::min(begin+chunkSize, nnew);
+         EvalRegions(*fFun, n, absValue, &newRegions[begin], end-begin);
+      };
+#ifdef R__USE_IMT
+      if (nchunks > 1 && ROOT::IsImplicitMTEnabled())
+         tbb::parallel_for(0u, nchunks, evalChunk);
+      else
+#endif
+      for (unsigned int ichunk = 0; ichunk < nchunks; ichunk++)
+         evalChunk(ichunk);
+
+      for (unsigned int inew = 0; inew < nnew; inew++) {
+         result += newRegions[inew].fVal;
+         abserr += newRegions[inew].fErr;
+         regions.push_back(newRegions[inew]);
+         std::push_heap(regions.begin(), regions.end(), LessError);
+      }
+      ifncls += nnew*irlcls;
+   }
+
+   fResult = result;
+   fError = abserr;
+   fRelError = relerr;
+   fNEval = ifncls;
+   return result;
+}
+
 
 double AdaptiveIntegratorMultiDim::Integral(const IMultiGenFunction &f, const double* xmin, const double * xmax)
 {
@@ -397,17 +629,19 @@ ROOT::Math::IntegratorMultiDimOptions  AdaptiveIntegratorMultiDim::Options() con
    opt.SetRelTolerance(fRelTol);
    opt.SetNCalls(fMaxPts);
    opt.SetWKSize(fSize);
-   opt.SetIntegrator("ADAPTIVE");
+   opt.SetIntegrator(fParallel ? "ADAPTIVEPARALLEL" : "ADAPTIVE");
    return opt;
 }
 
 void AdaptiveIntegratorMultiDim::SetOptions(const ROOT::Math::IntegratorMultiDimOptions & opt)
 {
    //   set integration options
-   if (opt.IntegratorType() != IntegrationMultiDim::kADAPTIVE) {
+   if (opt.IntegratorType() != IntegrationMultiDim::kADAPTIVE &&
+       opt.IntegratorType() != IntegrationMultiDim::kADAPTIVEPARALLEL) {
       MATH_ERROR_MSG("AdaptiveIntegratorMultiDim::SetOptions","Invalid options");
       return;
    }
+   SetParallelMode( opt.IntegratorType() == IntegrationMultiDim::kADAPTIVEPARALLEL );
    SetAbsTolerance( opt.AbsTolerance() );
    SetRelTolerance( opt.RelTolerance() );
    SetMaxPts( opt.NCalls() );
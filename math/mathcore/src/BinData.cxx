@@ -162,7 +162,8 @@ BinData::BinData(const BinData & rhs) :
    fRefVolume(rhs.fRefVolume),
    fDataVector(0),
    fDataWrapper(0),
-   fBinEdge(rhs.fBinEdge)
+   fBinEdge(rhs.fBinEdge),
+   fColumns(rhs.fColumns)
 {
    // copy constructor (copy data vector or just the pointer)
    if (rhs.fDataVector != 0) fDataVector = new DataVector(*rhs.fDataVector);
@@ -190,6 +191,7 @@ BinData & BinData::operator= (const BinData & rhs) {
    fSumError2 = rhs.fSumError2;
    fBinEdge = rhs.fBinEdge;
    fRefVolume = rhs.fRefVolume;
+   fColumns = rhs.fColumns;
    // delete previous pointers
    if (fDataVector) delete fDataVector;
    if (fDataWrapper) delete fDataWrapper;
@@ -216,6 +218,7 @@ BinData::~BinData() {
 void BinData::Initialize(unsigned int maxpoints, unsigned int dim , ErrorType err  ) {
 //       preallocate a data set given size and dimension
 //       need to be initialized with the  right dimension before
+   fColumns.Clear();
    if (fDataWrapper) delete fDataWrapper;
    fDataWrapper = 0;
    unsigned int pointSize = GetPointSize(err,dim);
@@ -246,6 +249,7 @@ void BinData::Initialize(unsigned int maxpoints, unsigned int dim , ErrorType er
 void BinData::Resize(unsigned int npoints) {
    // resize vector to new points
    if (fPointSize == 0) return;
+   fColumns.Clear();
    if ( npoints > MaxSize() ) {
       MATH_ERROR_MSGVAL("BinData::Resize"," Invalid data size  ", npoints );
       return;
@@ -482,6 +486,9 @@ BinData & BinData::LogTransform() {
 
    if (fNPoints == 0) return *this;
 
+   // the columnar copy of the data is not valid anymore
+   fColumns.Clear();
+
    if (fDataVector) {
 
       ErrorType type = GetErrorType();
@@ -582,6 +589,32 @@ BinData & BinData::LogTransform() {
    return *this;
 }
 
+bool BinData::BuildColumns() {
+   // build the columnar copy of the data: coordinates, values and inverse errors
+
+   fColumns.Clear();
+   ErrorType type = GetErrorType();
+   if (type != kNoError && type != kValueError) {
+      MATH_ERROR_MSG("BinData::BuildColumns","Columnar data are not supported for data with coordinate errors");
+      return false;
+   }
+   if (fNPoints == 0) return false;
+
+   fColumns.Allocate(fDim + 2, fNPoints);
+   std::vector<double *> coords(fDim);
+   for (unsigned int icoord = 0; icoord < fDim; ++icoord)
+      coords[icoord] = fColumns.Column(icoord);
+   double * values = fColumns.Column(fDim);
+   double * invErrors = fColumns.Column(fDim+1);
+
+   for (unsigned int i = 0; i < fNPoints; ++i) {
+      const double * x = GetPoint(i, values[i], invErrors[i]);
+      for (unsigned int icoord = 0; icoord < fDim; ++icoord)
+         coords[icoord][i] = x[icoord];
+   }
+   return true;
+}
+
 
    } // end namespace Fit
 
@@ -44,6 +44,8 @@ FitConfig::FitConfig(unsigned int npar) :
    fMinosErrors(false),    // do full Minos error analysis for all parameters
    fUpdateAfterFit(true),    // update after fit
    fWeightCorr(false),
+   fParallel(false),
+   fBatchEval(false),
    fSettings(std::vector<ParameterSettings>(npar) )
 {
    // constructor implementation
@@ -69,6 +71,8 @@ FitConfig & FitConfig::operator = (const FitConfig &rhs) {
    fMinosErrors = rhs.fMinosErrors;
    fUpdateAfterFit = rhs.fUpdateAfterFit;
    fWeightCorr     = rhs.fWeightCorr;
+   fParallel       = rhs.fParallel;
+   fBatchEval      = rhs.fBatchEval;
 
    fSettings = rhs.fSettings;
    fMinosParams = rhs.fMinosParams;
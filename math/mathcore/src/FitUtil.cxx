@@ -325,6 +325,92 @@ namespace ROOT {
             }
          }
 
+         // number of points evaluated at once when the data have a columnar copy
+         const unsigned int kBatchSize = 64;
+
+         // evaluate the sum of the chi2 residuals for the points in [begin,end) using the columnar
+         // copy of the data. The model function is evaluated in batches of points with the cached
+         // parameters and the residuals are computed in loops which the compiler can vectorize
+         double EvaluateChi2Batches(const IModelFunction & func, const BinData & data, unsigned int begin, unsigned int end, double maxResValue) {
+
+            unsigned int ndim = data.NDim();
+            std::vector<const double *> x(ndim);
+            const double * y = data.ValueColumn();
+            const double * invError = data.InvErrorColumn();
+            double fval[kBatchSize];
+            double resval[kBatchSize];
+
+            ROOT::Math::Util::KahanSum<double> chi2;
+            for (unsigned int ib = begin; ib < end; ib += kBatchSize) {
+               unsigned int nb = std::min(kBatchSize, end - ib);
+               for (unsigned int icoord = 0; icoord < ndim; ++icoord)
+                  x[icoord] = data.CoordColumn(icoord) + ib;
+               func.EvalBatch(&x.front(), fval, nb);
+
+               const double * yb = y + ib;
+               const double * eb = invError + ib;
+               for (unsigned int i = 0; i < nb; ++i) {
+                  double tmp = ( yb[i] - fval[i] ) * eb[i];
+                  double r = tmp * tmp;
+                  // avoid inifinity or nan in chi2 values due to wrong function values
+                  r = ( r < maxResValue ) ? r : maxResValue;
+                  resval[i] = ( eb[i] > 0 ) ? r : 0;
+               }
+               for (unsigned int i = 0; i < nb; ++i)
+                  chi2 += resval[i];
+            }
+            return chi2.Result();
+         }
+
+         // evaluate the sum of the log of the pdf for the points in [begin,end) using the columnar
+         // copy of the data (see EvaluateChi2Batches)
+         double EvaluateLogLBatches(const IModelFunction & func, const UnBinData & data, int iWeight, bool extended,
+                                    unsigned int begin, unsigned int end, double & sumW, double & sumW2) {
+
+            unsigned int ndim = data.NDim();
+            std::vector<const double *> x(ndim);
+            const double * weight = data.WeightColumn();
+            double fval[kBatchSize];
+
+            ROOT::Math::Util::KahanSum<double> logl;
+            ROOT::Math::Util::KahanSum<double> sw;
+            ROOT::Math::Util::KahanSum<double> sw2;
+            for (unsigned int ib = begin; ib < end; ib += kBatchSize) {
+               unsigned int nb = std::min(kBatchSize, end - ib);
+               for (unsigned int icoord = 0; icoord < ndim; ++icoord)
+                  x[icoord] = data.CoordColumn(icoord) + ib;
+               func.EvalBatch(&x.front(), fval, nb);
+
+               // function EvalLog protects against negative or too small values of fval
+               for (unsigned int i = 0; i < nb; ++i)
+                  fval[i] = ROOT::Math::Util::EvalLog( fval[i] );
+
+               const double * wb = weight + ib;
+               if (iWeight == 2) {
+                  // use square of weights in likelihood
+                  for (unsigned int i = 0; i < nb; ++i)
+                     fval[i] *= wb[i] * wb[i];
+                  if (extended) {
+                     // needed sum of weights and sum of weight square if likelkihood is extended
+                     for (unsigned int i = 0; i < nb; ++i) {
+                        sw += wb[i];
+                        sw2 += wb[i] * wb[i];
+                     }
+                  }
+               }
+               else if (iWeight > 0) {
+                  for (unsigned int i = 0; i < nb; ++i)
+                     fval[i] *= wb[i];
+               }
+               for (unsigned int i = 0; i < nb; ++i)
+                  logl += fval[i];
+            }
+
+            sumW = sw.Result();
+            sumW2 = sw2.Result();
+            return logl.Result();
+         }
+
 
 
       } // end namespace  FitUtil
@@ -343,36 +429,56 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
 
    unsigned int n = data.Size();
 
-   double chi2 = 0;
-   nPoints = 0; // count the effective non-zero points
+#ifdef DEBUG
+   const DataOptions & fitOpt = data.Opt();
+   std::cout << "\n\nFit data size = " << n << std::endl;
+   std::cout << "evaluate chi2 using function " << &func << "  " << p << std::endl;
+   std::cout << "use empty bins  " << fitOpt.fUseEmpty << std::endl;
+   std::cout << "use integral    " << fitOpt.fIntegral << std::endl;
+   std::cout << "use all error=1 " << fitOpt.fErrors1 << std::endl;
+#endif
+
    // set parameters of the function to cache integral value
-#ifdef USE_PARAMCACHE
+   // do not cache parameter values in the loop (it is not thread safe)
    (const_cast<IModelFunction &>(func)).SetParameters(p);
+
+   double chi2 = EvaluateChi2Sum(func, data, p, 0, n);
+   nPoints=n;
+
+#ifdef DEBUG
+   std::cout << "chi2 = " << chi2 << " n = " << nPoints  /*<< " rejected = " << nRejected */ << std::endl;
 #endif
-   // do not cache parameter values (it is not thread safe)
-   //func.SetParameters(p);
 
 
+   return chi2;
+}
+
+double FitUtil::EvaluateChi2Sum(const IModelFunction & func, const BinData & data, const double * p, unsigned int begin, unsigned int end) {
+   // evaluate the sum of the chi2 residuals of the points in [begin,end)
+   // the parameters p must have been already set in the function
+
+   unsigned int n = data.Size();
+
    // get fit option and check case if using integral of bins
    const DataOptions & fitOpt = data.Opt();
    bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges();
    bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
    bool useExpErrors = (fitOpt.fExpErrors);
 
-#ifdef DEBUG
-   std::cout << "\n\nFit data size = " << n << std::endl;
-   std::cout << "evaluate chi2 using function " << &func << "  " << p << std::endl;
-   std::cout << "use empty bins  " << fitOpt.fUseEmpty << std::endl;
-   std::cout << "use integral    " << fitOpt.fIntegral << std::endl;
-   std::cout << "use all error=1 " << fitOpt.fErrors1 << std::endl;
-#endif
-
 #ifdef USE_PARAMCACHE
-   IntegralEvaluator<> igEval( func, 0, useBinIntegral); 
+   MATH_UNUSED(p);
+   IntegralEvaluator<> igEval( func, 0, useBinIntegral);
 #else
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
+   IntegralEvaluator<> igEval( func, p, useBinIntegral);
 #endif
    double maxResValue = std::numeric_limits<double>::max() /n;
+
+#ifdef USE_PARAMCACHE
+   // use the columnar copy of the data when available (see BinData::BuildColumns)
+   if (data.HasColumns() && !useBinIntegral && !useBinVolume && !useExpErrors)
+      return EvaluateChi2Batches(func, data, begin, end, maxResValue);
+#endif
+
    double wrefVolume = 1.0;
    std::vector<double> xc;
    if (useBinVolume) {
@@ -380,8 +486,8 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
       xc.resize(data.NDim() );
    }
 
-   (const_cast<IModelFunction &>(func)).SetParameters(p);
-   for (unsigned int i = 0; i < n; ++ i) {
+   ROOT::Math::Util::KahanSum<double> chi2;
+   for (unsigned int i = begin; i < end; ++ i) {
 
       double y = 0, invError = 1.;
 
@@ -441,7 +547,6 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
 
 
       if (invError > 0) {
-         nPoints++;
 
          double tmp = ( y -fval )* invError;
          double resval = tmp * tmp;
@@ -458,14 +563,8 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
 
 
    }
-   nPoints=n;
 
-#ifdef DEBUG
-   std::cout << "chi2 = " << chi2 << " n = " << nPoints  /*<< " rejected = " << nRejected */ << std::endl;
-#endif
-
-
-   return chi2;
+   return chi2.Result();
 }
 
 
@@ -708,19 +807,67 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
       MATH_ERROR_MSG("FitUtil::EvaluateChi2Residual","Error on the coordinates are not used in calculating Chi2 gradient");            return; // it will assert otherwise later in GetPoint
    }
 
+   unsigned int n = data.Size();
+   unsigned int npar = f.NPar();
+
+#ifdef DEBUG
+   std::cout << "\n\nFit data size = " << n << std::endl;
+   std::cout << "evaluate chi2 using function gradient " << &f << "  " << p << std::endl;
+#endif
+
    unsigned int nRejected = 0;
+   EvaluateChi2GradientSum(f, data, p, 0, n, grad, nRejected);
 
-   const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
-   assert (fg != 0); // must be called by a gradient function
+   // correct the number of points
+   nPoints = n;
+   if (nRejected != 0)  {
+      assert(nRejected <= n);
+      nPoints = n - nRejected;
+      if (nPoints < npar)  MATH_ERROR_MSG("FitUtil::EvaluateChi2Gradient","Error - too many points rejected for overflow in gradient calculation");
+   }
+
+}
+
+double FitUtil::EvaluateChi2AndGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int & nPoints) {
+   // evaluate at the same time the chi2 and its gradient, computing the model function
+   // and its parameter gradient only once for each point
+   //
+   // case of chi2 effective (errors on coordinate) and of expected errors are not supported
+
+   if ( data.HaveCoordErrors() || data.Opt().fExpErrors ) {
+      MATH_ERROR_MSG("FitUtil::EvaluateChi2AndGradient","Error on the coordinates or expected errors are not supported");
+      return 0;
+   }
 
-   const IGradModelFunction & func = *fg;
    unsigned int n = data.Size();
+   unsigned int npar = f.NPar();
 
+   unsigned int nRejected = 0;
+   double chi2 = 0;
+   EvaluateChi2GradientSum(f, data, p, 0, n, grad, nRejected, &chi2);
 
-#ifdef DEBUG
-   std::cout << "\n\nFit data size = " << n << std::endl;
-   std::cout << "evaluate chi2 using function gradient " << &func << "  " << p << std::endl;
-#endif
+   // correct the number of points
+   nPoints = n;
+   if (nRejected != 0)  {
+      assert(nRejected <= n);
+      nPoints = n - nRejected;
+      if (nPoints < npar)  MATH_ERROR_MSG("FitUtil::EvaluateChi2AndGradient","Error - too many points rejected for overflow in gradient calculation");
+   }
+
+   return chi2;
+}
+
+void FitUtil::EvaluateChi2GradientSum(const IModelFunction & f, const BinData & data, const double * p, unsigned int begin, unsigned int end, double * grad, unsigned int & nRejected, double * chi2) {
+   // evaluate the gradient of the chi2 function summing the points in [begin,end)
+   // and return in nRejected the number of points rejected for overflows
+   // if chi2 is not null return in it also the sum of the chi2 residuals (as in EvaluateChi2Sum)
+
+   nRejected = 0;
+
+   const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
+   assert (fg != 0); // must be called by a gradient function
+
+   const IGradModelFunction & func = *fg;
 
    const DataOptions & fitOpt = data.Opt();
    bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges();
@@ -735,16 +882,16 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
 
    IntegralEvaluator<> igEval( func, p, useBinIntegral);
 
-   //int nRejected = 0;
-   // set values of parameters
-
    unsigned int npar = func.NPar();
    //   assert (npar == NDim() );  // npar MUST be  Chi2 dimension
    std::vector<double> gradFunc( npar );
    // set all vector values to zero
-   std::vector<double> g( npar);
+   std::vector<ROOT::Math::Util::KahanSum<double> > g( npar);
 
-   for (unsigned int i = 0; i < n; ++ i) {
+   ROOT::Math::Util::KahanSum<double> chi2Sum;
+   double maxResValue = std::numeric_limits<double>::max() / data.Size();
+
+   for (unsigned int i = begin; i < end; ++ i) {
 
 
       double y, invError = 0;
@@ -786,6 +933,13 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
          std::cout << p[ipar] << "\t";
       std::cout << "\tfval = " << fval << std::endl;
 #endif
+      if (chi2 && invError > 0) {
+         double resval = ( y -fval )* invError;
+         resval *= resval;
+         // avoid inifinity or nan in chi2 values due to wrong function values
+         chi2Sum += (resval < maxResValue) ? resval : maxResValue;
+      }
+
       if ( !CheckValue(fval) ) {
          nRejected++;
          continue;
@@ -820,16 +974,10 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
 
    }
 
-   // correct the number of points
-   nPoints = n;
-   if (nRejected != 0)  {
-      assert(nRejected <= n);
-      nPoints = n - nRejected;
-      if (nPoints < npar)  MATH_ERROR_MSG("FitUtil::EvaluateChi2Gradient","Error - too many points rejected for overflow in gradient calculation");
-   }
-
    // copy result
-   std::copy(g.begin(), g.end(), grad);
+   for (unsigned int ipar = 0; ipar < npar; ++ipar)
+      grad[ipar] = g[ipar].Result();
+   if (chi2) *chi2 = chi2Sum.Result();
 
 }
 
@@ -901,38 +1049,56 @@ double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data
    std::cout << "func pointer is " << typeid(func).name() << std::endl;
 #endif
 
-   double logl = 0;
-   //unsigned int nRejected = 0;
-
    // set parameters of the function to cache integral value
 #ifdef USE_PARAMCACHE
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 #endif
 
-   // this is needed if function must be normalized 
-   bool normalizeFunc = false; 
-   double norm = 1.0;
-   if (normalizeFunc) {
-      // compute integral of the function
-      std::vector<double> xmin(data.NDim());
-      std::vector<double> xmax(data.NDim());
-      IntegralEvaluator<> igEval( func, p, true);
-      data.Range().GetRange(&xmin[0],&xmax[0]);
-      norm = igEval.Integral(&xmin[0],&xmax[0]);
-   }
-
    // needed to compue effective global weight in case of extended likelihood
    double sumW = 0;
    double sumW2 = 0;
 
-   for (unsigned int i = 0; i < n; ++ i) {
+   double logl = EvaluateLogLSum(func, data, p, iWeight, extended, 0, n, sumW, sumW2);
+
+   if (extended) {
+      // add Poisson extended term
+      logl += EvaluateLogLExtendedTerm(func, data, p, iWeight, sumW, sumW2);
+   }
+
+   // reset the number of fitting data points
+   nPoints = n;
+#ifdef DEBUG
+   std::cout << "Logl = " << logl << " np = " << nPoints << std::endl;
+#endif
+
+   return -logl;
+}
+
+double FitUtil::EvaluateLogLSum(const IModelFunction & func, const UnBinData & data, const double * p,
+                                int iWeight, bool extended, unsigned int begin, unsigned int end, double & sumW, double & sumW2) {
+   // evaluate the sum of the log of the pdf (not its negative) for the points in [begin,end)
+   // return also the sum of weights and weight square (needed for the extended term)
+   // the parameters p must have been already set in the function
+
+#ifdef USE_PARAMCACHE
+   MATH_UNUSED(p);
+
+   // use the columnar copy of the data when available (see UnBinData::BuildColumns)
+   if (data.HasColumns())
+      return EvaluateLogLBatches(func, data, iWeight, extended, begin, end, sumW, sumW2);
+#endif
+
+   ROOT::Math::Util::KahanSum<double> logl;
+   ROOT::Math::Util::KahanSum<double> sw;
+   ROOT::Math::Util::KahanSum<double> sw2;
+
+   for (unsigned int i = begin; i < end; ++ i) {
       const double * x = data.Coords(i);
 #ifdef USE_PARAMCACHE
        double fval = func ( x );
 #else
        double fval = func ( x, p );
 #endif
-      if (normalizeFunc) fval = fval / norm;
 
 #ifdef DEBUG
       std::cout << "x [ " << data.NDim() << " ] = ";
@@ -952,72 +1118,57 @@ double FitUtil::EvaluateLogL(const IModelFunction & func, const UnBinData & data
             logval *= weight; // use square of weights in likelihood
             if (extended) {
                // needed sum of weights and sum of weight square if likelkihood is extended
-               sumW += weight;
-               sumW2 += weight*weight;
+               sw += weight;
+               sw2 += weight*weight;
             }
          }
       }
       logl += logval;
    }
 
-   if (extended) {
-      // add Poisson extended term
-      double extendedTerm = 0; // extended term in likelihood
-      double nuTot = 0;
-      // nuTot is integral of function in the range
-      // if function has been normalized integral has been already computed
-      if (!normalizeFunc) {
-         IntegralEvaluator<> igEval( func, p, true);
-         std::vector<double> xmin(data.NDim());
-         std::vector<double> xmax(data.NDim());
-         data.Range().GetRange(&xmin[0],&xmax[0]);
-         nuTot = igEval.Integral( &xmin[0], &xmax[0]);
-         // force to be last parameter value
-         //nutot = p[func.NDim()-1];
-         if (iWeight != 2)
-            extendedTerm = - nuTot;  // no need to add in this case n log(nu) since is already computed before
-         else {
-            // case use weight square in likelihood : compute total effective weight = sw2/sw
-            // ignore for the moment case when sumW is zero
-            extendedTerm = - (sumW2 / sumW) * nuTot;
-         }
-
-      }
-      else {
-         nuTot = norm;
-         extendedTerm = - nuTot + double(n) *  ROOT::Math::Util::EvalLog( nuTot);
-         // in case of weights need to use here sum of weights (to be done)
-      }
-      logl += extendedTerm;
+   sumW = sw.Result();
+   sumW2 = sw2.Result();
+   return logl.Result();
+}
 
-#ifdef DEBUG
-      // for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
-      //    std::cout << p[ipar] << "\t";
-      // std::cout << std::endl;
-      std::cout << "fit is extended n = " << n << " nutot " << nuTot << " extended LL term = " <<  extendedTerm << " logl = " << logl
-                << std::endl;
-#endif
+double FitUtil::EvaluateLogLExtendedTerm(const IModelFunction & func, const UnBinData & data, const double * p,
+                                         int iWeight, double sumW, double sumW2) {
+   // evaluate the Poisson extended term to be added to the log likelihood
+   // nuTot is integral of function in the range
+
+   double extendedTerm = 0; // extended term in likelihood
+   IntegralEvaluator<> igEval( func, p, true);
+   std::vector<double> xmin(data.NDim());
+   std::vector<double> xmax(data.NDim());
+   data.Range().GetRange(&xmin[0],&xmax[0]);
+   double nuTot = igEval.Integral( &xmin[0], &xmax[0]);
+   // force to be last parameter value
+   //nutot = p[func.NDim()-1];
+   if (iWeight != 2)
+      extendedTerm = - nuTot;  // no need to add in this case n log(nu) since is already computed before
+   else {
+      // case use weight square in likelihood : compute total effective weight = sw2/sw
+      // ignore for the moment case when sumW is zero
+      extendedTerm = - (sumW2 / sumW) * nuTot;
    }
 
-   // reset the number of fitting data points
-   nPoints = n;
-//    if (nRejected != 0)  {
-//       assert(nRejected <= n);
-//       nPoints = n - nRejected;
-//       if ( nPoints < func.NPar() )
-//          MATH_ERROR_MSG("FitUtil::EvaluateLogL","Error too many points rejected because of bad pdf values");
-
-//    }
 #ifdef DEBUG
-   std::cout << "Logl = " << logl << " np = " << nPoints << std::endl;
+   std::cout << "fit is extended n = " << data.Size() << " nutot " << nuTot << " extended LL term = " <<  extendedTerm
+             << std::endl;
 #endif
 
-   return -logl;
+   return extendedTerm;
 }
 
 void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & data, const double * p, double * grad, unsigned int & ) {
    // evaluate the gradient of the log likelihood function
 
+   EvaluateLogLGradientSum(f, data, p, 0, data.Size(), grad);
+}
+
+void FitUtil::EvaluateLogLGradientSum(const IModelFunction & f, const UnBinData & data, const double * p, unsigned int begin, unsigned int end, double * grad) {
+   // evaluate the gradient of the log likelihood function summing the points in [begin,end)
+
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
    assert (fg != 0); // must be called by a grad function
    const IGradModelFunction & func = *fg;
@@ -1027,29 +1178,30 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & d
 
    unsigned int npar = func.NPar();
    std::vector<double> gradFunc( npar );
-   std::vector<double> g( npar);
+   std::vector<ROOT::Math::Util::KahanSum<double> > g( npar);
 
-   for (unsigned int i = 0; i < n; ++ i) {
+   for (unsigned int i = begin; i < end; ++ i) {
       const double * x = data.Coords(i);
       double fval = func ( x , p);
       func.ParameterGradient( x, p, &gradFunc[0] );
       for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
          if (fval > 0)
-            g[kpar] -= 1./fval * gradFunc[ kpar ];
+            g[kpar] += - 1./fval * gradFunc[ kpar ];
          else if (gradFunc [ kpar] != 0) {
             const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
             const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
             double gg = kdmax1 * gradFunc[ kpar ];
             if ( gg > 0) gg = std::min( gg, kdmax2);
             else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
+            g[kpar] += -gg;
          }
          // if func derivative is zero term is also zero so do not add in g[kpar]
       }
-
-    // copy result
-   std::copy(g.begin(), g.end(), grad);
    }
+
+   // copy result
+   for (unsigned int kpar = 0; kpar < npar; ++kpar)
+      grad[kpar] = g[kpar].Result();
 }
 //_________________________________________________________________________________________________
 // for binned log likelihood functions
@@ -1184,17 +1336,30 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
 #ifdef USE_PARAMCACHE
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 #endif
-   
-   double nloglike = 0;  // negative loglikelihood 
-   nPoints = 0;  // npoints
 
+   double nloglike = EvaluatePoissonLogLSum(func, data, p, iWeight, extended, 0, n, nPoints);
+
+#ifdef DEBUG
+   std::cout << "Loglikelihood  = " << nloglike << std::endl;
+#endif
+
+   return nloglike;
+}
+
+double FitUtil::EvaluatePoissonLogLSum(const IModelFunction & func, const BinData & data, const double * p,
+                                       int iWeight, bool extended, unsigned int begin, unsigned int end, unsigned int & nPoints) {
+   // evaluate the Poisson negative log likelihood summing the bins in [begin,end)
+   // nPoints returns the points where bin content is not zero
+   // the parameters p must have been already set in the function
+
+   nPoints = 0;  // npoints
 
    // get fit option and check case of using integral of bins
    const DataOptions & fitOpt = data.Opt();
    bool useBinIntegral = fitOpt.fIntegral && data.HasBinEdges();
    bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
    bool useW2 = (iWeight == 2);
-   
+
    // normalize if needed by a reference volume value
    double wrefVolume = 1.0;
    std::vector<double> xc;
@@ -1206,21 +1371,20 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
 #ifdef DEBUG
    std::cout << "Evaluate PoissonLogL for params = [ ";
    for (unsigned int j=0; j < func.NPar(); ++j) std::cout << p[j] << " , ";
-   std::cout << "]  - data size = " << n << " useBinIntegral " << useBinIntegral << " useBinVolume "
+   std::cout << "]  - data size = " << data.Size() << " useBinIntegral " << useBinIntegral << " useBinVolume "
              << useBinVolume << " useW2 " << useW2 << " wrefVolume = " << wrefVolume << std::endl;
 #endif
 
 #ifdef USE_PARAMCACHE
-   IntegralEvaluator<> igEval( func, 0, useBinIntegral); 
+   MATH_UNUSED(p);
+   IntegralEvaluator<> igEval( func, 0, useBinIntegral);
 #else
-   IntegralEvaluator<> igEval( func, p, useBinIntegral); 
+   IntegralEvaluator<> igEval( func, p, useBinIntegral);
 #endif
-   // double nuTot = 0; // total number of expected events (needed for non-extended fits)
-   // double wTot = 0; // sum of all weights
-   // double w2Tot = 0; // sum of weight squared  (these are needed for useW2)
 
+   ROOT::Math::Util::KahanSum<double> nloglike;  // negative loglikelihood
 
-   for (unsigned int i = 0; i < n; ++ i) {
+   for (unsigned int i = begin; i < end; ++ i) {
       const double * x1 = data.Coords(i);
       double y = data.Value(i);
 
@@ -1289,17 +1453,9 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
             double weight = (error*error)/y;  // this is the bin effective weight
             if (extended) {
                tmp = fval * weight;
-               // wTot  += weight;
-               // w2Tot += weight*weight;
             }
             tmp -= weight * y * ROOT::Math::Util::EvalLog( fval);
          }
-
-         //  need to compute total weight and weight-square
-         // if (extended ) {
-         //    nuTot += fval;
-         // }
-
       }
       else {
          // standard case no weights or iWeight=1
@@ -1317,33 +1473,18 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction & func, const BinData &
       nloglike +=  tmp;
    }
 
-   // if (notExtended) {
-   //    // not extended : remove from the Likelihood the global Poisson term
-   //    if (!useW2)
-   //       nloglike -= nuTot - yTot * ROOT::Math::Util::EvalLog( nuTot);
-   //    else {
-   //       // this needs to be checked
-   //       nloglike -= wTot* nuTot - wTot* yTot * ROOT::Math::Util::EvalLog( nuTot);
-   //    }
-
-   // }
-
-   // if (extended && useW2) {
-   //    // effective total weight is total sum of weight square / sum of weights
-   //    //nloglike += (w2Tot/wTot) * nuTot;
-   // }
-
-
-#ifdef DEBUG
-   std::cout << "Loglikelihood  = " << nloglike << std::endl;
-#endif
-
-   return nloglike;
+   return nloglike.Result();
 }
 
 void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad ) {
    // evaluate the gradient of the Poisson log likelihood function
 
+   EvaluatePoissonLogLGradientSum(f, data, p, 0, data.Size(), grad);
+}
+
+void FitUtil::EvaluatePoissonLogLGradientSum(const IModelFunction & f, const BinData & data, const double * p, unsigned int begin, unsigned int end, double * grad ) {
+   // evaluate the gradient of the Poisson log likelihood function summing the bins in [begin,end)
+
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
    assert (fg != 0); // must be called by a grad function
    const IGradModelFunction & func = *fg;
@@ -1365,9 +1506,9 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinDat
 
    unsigned int npar = func.NPar();
    std::vector<double> gradFunc( npar );
-   std::vector<double> g( npar);
+   std::vector<ROOT::Math::Util::KahanSum<double> > g( npar);
 
-   for (unsigned int i = 0; i < n; ++ i) {
+   for (unsigned int i = begin; i < end; ++ i) {
       const double * x1 = data.Coords(i);
       double y = data.Value(i);
       double fval = 0;
@@ -1415,13 +1556,14 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinDat
             double gg = kdmax1 * gradFunc[ kpar ];
             if ( gg > 0) gg = std::min( gg, kdmax2);
             else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
+            g[kpar] += -gg;
          }
       }
-
-      // copy result
-      std::copy(g.begin(), g.end(), grad);
    }
+
+   // copy result
+   for (unsigned int kpar = 0; kpar < npar; ++kpar)
+      grad[kpar] = g[kpar].Result();
 }
 
 }
@@ -8,9 +8,7 @@
  *                                                                    *
  **********************************************************************/
 
-// Implementation file for class FitUtil
-
-#ifdef ROOT_FIT_PARALLEL
+// Implementation file for class FitUtilParallel
 
 #include "Fit/FitUtilParallel.h"
 
@@ -19,282 +17,277 @@
 #include "Fit/FitUtil.h"
 
 #include "Math/IParamFunction.h"
+#include "Math/Error.h"
+#include "Math/Util.h"
+
+#include "TROOT.h"
 
-int ncalls = 0;
+#include <algorithm>
+#include <cassert>
+#include <vector>
 
-#include <limits>
-#include <cmath>
-#include <numeric>
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#endif
 
 //#define DEBUG
 #ifdef DEBUG
 #include <iostream>
 #endif
 
-#ifdef USE_PTHREAD
-
-#include <pthread.h>
-
-
-#define NUMBER_OF_THREADS 2
-
-#else
-#include <omp.h>
-// maximum number of threads for the array
-#define MAX_THREAD 8
-
-#endif
-
 namespace ROOT {
 
    namespace Fit {
 
       namespace FitUtilParallel {
 
-#ifdef USE_PTHREAD
-
-class ThreadData {
-
-public:
-
-   ThreadData() :
-      fBegin(0),fEnd(0) ,
-      fData(0),
-      fFunc(0)
-   {}
-
-   ThreadData(unsigned int i1, unsigned int i2, const BinData & data, IModelFunction &func) :
-      fBegin(i1), fEnd(i2),
-      fData(&data),
-      fFunc(&func)
-   {}
-
-   void Set(unsigned int nrej, double sum) {
-      fNRej = nrej;
-      fSum = sum;
-   }
-
-   const BinData & Data() const { return *fData; }
-
-   IModelFunction & Func() { return *fFunc; }
-
-   double Sum() const { return fSum; }
-
-   unsigned int NRej() const { return fNRej; }
-
-   unsigned int Begin() const { return fBegin; }
-   unsigned int End() const { return fEnd; }
-
-private:
-
-   const unsigned int fBegin;
-   const unsigned int fEnd;
-   const BinData * fData;
-   IModelFunction * fFunc;
-   double fSum;
-   unsigned int fNRej;
-};
-
-
-// function used by the threads
-void *EvaluateResidual(void * ptr) {
-
-   ThreadData * t = (ThreadData *) ptr;
-
-   unsigned int istart = t->Begin();
-   unsigned int iend = t->End();
-   double chi2 = 0;
-   unsigned int nRejected = 0;
-   const int nthreads = NUMBER_OF_THREADS;
-
-   const BinData & data = t->Data();
-   IModelFunction & func = t->Func();
-   for (unsigned int i = istart; i < iend; i+=nthreads) {
-      const double * x = data.Coords(i);
-      double y = data.Value(i);
-      double invError = data.InvError(i);
-      double fval = 0;
-      fval = func ( x );
-
-// #ifdef DEBUG
-//       std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
-//       for (int ipar = 0; ipar < func.NPar(); ++ipar)
-//          std::cout << p[ipar] << "\t";
-//       std::cout << "\tfval = " << fval << std::endl;
-// #endif
+         // number of data points in each chunk. It must not depend on the number of threads
+         // to have reproducible results
+         const unsigned int kChunkSize = 1024;
+
+         unsigned int NChunks(unsigned int n) {
+            return (n + kChunkSize - 1) / kChunkSize;
+         }
+
+         // evaluate func(ichunk, begin, end) for all the chunks of the n data points,
+         // in parallel when implicit multi-threading is enabled and parallel is true.
+         // The partial results do not depend on how the chunks are scheduled
+         template<class Func>
+         void ExecuteChunks(unsigned int n, const Func & func, bool parallel = true) {
+            unsigned int nchunks = NChunks(n);
+            auto evalChunk = [&](unsigned int ichunk) {
+               unsigned int begin = ichunk * kChunkSize;
+               unsigned int end = std::min(begin + kChunkSize, n);
+               func(ichunk, begin, end);
+            };
+#ifdef R__USE_IMT
+            if (parallel && nchunks > 1 && ROOT::IsImplicitMTEnabled()) {
+               tbb::parallel_for(0u, nchunks, evalChunk);
+               return;
+            }
+#endif
+            for (unsigned int ichunk = 0; ichunk < nchunks; ++ichunk)
+               evalChunk(ichunk);
+         }
+
+         // the gradient of the model function can be evaluated by concurrent tasks only when
+         // the function declares it: in general ParameterGradient sets the parameters of the
+         // function (e.g. in the TF1 of a WrappedMultiTF1) and it would be a data race
+         bool ParallelGradient(const IModelFunction & func) {
+            const ROOT::Math::IParamMultiGradFunction * gfunc = dynamic_cast<const ROOT::Math::IParamMultiGradFunction *>(&func);
+            return gfunc && gfunc->HasThreadSafeParameterGradient();
+         }
+
+         // reduce the partial sums of the chunks in their order
+         double SumChunks(const std::vector<double> & values) {
+            ROOT::Math::Util::KahanSum<double> sum;
+            for (auto v : values) sum += v;
+            return sum.Result();
+         }
+
+         // reduce the partial gradients (npar values per chunk) of the chunks in their order
+         void SumChunks(const std::vector<double> & values, unsigned int npar, double * grad) {
+            unsigned int nchunks = (npar > 0) ? values.size() / npar : 0;
+            for (unsigned int ipar = 0; ipar < npar; ++ipar) {
+               ROOT::Math::Util::KahanSum<double> sum;
+               for (unsigned int ichunk = 0; ichunk < nchunks; ++ichunk)
+                  sum += values[ichunk * npar + ipar];
+               grad[ipar] = sum.Result();
+            }
+         }
 
-      // avoid singularity in the function (infinity and nan ) in the chi2 sum
-      // eventually add possibility of excluding some points (like singularity)
-      if (fval > - std::numeric_limits<double>::max() && fval < std::numeric_limits<double>::max() ) {
-         // calculat chi2 point
-         double tmp = ( y -fval )* invError;
-         chi2 += tmp*tmp;
-      }
-      else
-         nRejected++;
+      } // end namespace FitUtilParallel
 
-   }
 
-#ifdef DEBUG
-   std::cout << "end loop " << istart << "  " << iend << " chi2 = " << chi2 << " nrej " << nRejected << std::endl;
-#endif
-   t->Set(nRejected,chi2);
-   return 0;
+unsigned int FitUtilParallel::ChunkSize() {
+   return kChunkSize;
 }
 
-double EvaluateChi2(IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints) {
+//___________________________________________________________________________________________________________________________
+// for chi2 functions
+//___________________________________________________________________________________________________________________________
+
+double FitUtilParallel::EvaluateChi2(const IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints) {
    // evaluate the chi2 given a  function reference  , the data and returns the value and also in nPoints
    // the actual number of used points
 
-   const int nthreads = NUMBER_OF_THREADS;
+   // the effective chi2 needs the derivatives w.r.t. the coordinates and is not parallelized
+   if (data.HaveCoordErrors() )
+      return FitUtil::EvaluateChi2Effective(func, data, p, nPoints);
 
    unsigned int n = data.Size();
 
-#ifdef DEBUG
-   std::cout << "\n\nFit data size = " << n << std::endl;
-#endif
-
-   func.SetParameters(p);
-
-   // start the threads
-   pthread_t   thread[nthreads];
-   ThreadData *  td[nthreads];
-   unsigned int istart = 0;
-   for (int ithread = 0; ithread < nthreads; ++ithread) {
-//       int n_th = n/nthreads;
-//       if (ithread == 0 ) n_th += n%nthreads;
-//       int iend = istart + n_th;
-      int iend = n;
-      istart = ithread;
-      td[ithread] = new ThreadData(istart,iend,data,func);
-      pthread_create(&thread[ithread], NULL, EvaluateResidual, td[ithread]);
-      //istart = iend;
-   }
-
-   for (int ithread = 0; ithread < nthreads; ++ithread)
-      pthread_join(thread[ithread], NULL);
-
-   // sum finally the results of the various threads
-
-   double chi2 = 0;
-   int nRejected = 0;
-   for (int ithread = 0; ithread < nthreads; ++ithread) {
-      nRejected += td[ithread]->NRej();
-      chi2 += td[ithread]->Sum();
-      delete td[ithread];
-   }
+   // set the parameters once, the tasks only read them
+   (const_cast<IModelFunction &>(func)).SetParameters(p);
 
+   std::vector<double> chi2(NChunks(n));
+   ExecuteChunks(n, [&](unsigned int ichunk, unsigned int begin, unsigned int end) {
+      chi2[ichunk] = FitUtil::EvaluateChi2Sum(func, data, p, begin, end);
+   });
+   nPoints = n;
 
 #ifdef DEBUG
-   std::cout << "chi2 = " << chi2 << " n = " << nRejected << std::endl;
+   std::cout << "chi2 = " << SumChunks(chi2) << " n = " << nPoints << " chunks = " << chi2.size() << std::endl;
 #endif
 
-   nPoints = n - nRejected;
-   return chi2;
-
+   return SumChunks(chi2);
 }
 
-//////////////////////////////////////////////////////////////////////////////////////////////////////////////
-// use open MP
-#else
+void FitUtilParallel::EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * p, double * grad, unsigned int & nPoints) {
+   // evaluate the gradient of the chi2 function
 
-double EvaluateChi2(IModelFunction & func, const BinData & data, const double * p, unsigned int & nPoints) {
-   return FitUtil::EvaluateChi2(func,data,p,nPoints);
+   if ( data.HaveCoordErrors() ) {
+      MATH_ERROR_MSG("FitUtilParallel::EvaluateChi2Gradient","Error on the coordinates are not used in calculating Chi2 gradient");
+      return;
+   }
+
+   unsigned int n = data.Size();
+   unsigned int npar = func.NPar();
+   unsigned int nchunks = NChunks(n);
+
+   std::vector<double> g(nchunks * npar);
+   std::vector<unsigned int> nRejected(nchunks);
+   ExecuteChunks(n, [&](unsigned int ichunk, unsigned int begin, unsigned int end) {
+      FitUtil::EvaluateChi2GradientSum(func, data, p, begin, end, &g[ichunk * npar], nRejected[ichunk]);
+   }, ParallelGradient(func));
+   SumChunks(g, npar, grad);
+
+   // correct the number of points
+   nPoints = n;
+   unsigned int nRej = 0;
+   for (auto nr : nRejected) nRej += nr;
+   if (nRej != 0)  {
+      assert(nRej <= n);
+      nPoints = n - nRej;
+      if (nPoints < npar)  MATH_ERROR_MSG("FitUtilParallel::EvaluateChi2Gradient","Error - too many points rejected for overflow in gradient calculation");
+   }
 }
 
+double FitUtilParallel::EvaluateChi2AndGradient(const IModelFunction & func, const BinData & data, const double * p, double * grad, unsigned int & nPoints) {
+   // evaluate at the same time the chi2 and its gradient
 
-// use openMP (log-likelihood calculation)
+   if ( data.HaveCoordErrors() || data.Opt().fExpErrors ) {
+      MATH_ERROR_MSG("FitUtilParallel::EvaluateChi2AndGradient","Error on the coordinates or expected errors are not supported");
+      return 0;
+   }
 
-inline double EvalLogF(double fval) {
-   // evaluate the log with a protections against negative argument to the log
-   // smooth linear extrapolation below function values smaller than  epsilon
-   // (better than a simple cut-off)
-   const static double epsilon = 2.*std::numeric_limits<double>::min();
-   if(fval<= epsilon)
-      return fval/epsilon + std::log(epsilon) - 1;
-   else
-      return std::log(fval);
+   unsigned int n = data.Size();
+   unsigned int npar = func.NPar();
+   unsigned int nchunks = NChunks(n);
+
+   std::vector<double> chi2(nchunks);
+   std::vector<double> g(nchunks * npar);
+   std::vector<unsigned int> nRejected(nchunks);
+   ExecuteChunks(n, [&](unsigned int ichunk, unsigned int begin, unsigned int end) {
+      FitUtil::EvaluateChi2GradientSum(func, data, p, begin, end, &g[ichunk * npar], nRejected[ichunk], &chi2[ichunk]);
+   }, ParallelGradient(func));
+   SumChunks(g, npar, grad);
+
+   // correct the number of points
+   nPoints = n;
+   unsigned int nRej = 0;
+   for (auto nr : nRejected) nRej += nr;
+   if (nRej != 0)  {
+      assert(nRej <= n);
+      nPoints = n - nRej;
+      if (nPoints < npar)  MATH_ERROR_MSG("FitUtilParallel::EvaluateChi2AndGradient","Error - too many points rejected for overflow in gradient calculation");
+   }
+
+   return SumChunks(chi2);
 }
 
+//______________________________________________________________________________________________________
+//
+//  Log Likelihood functions
+//_______________________________________________________________________________________________________
 
-double EvaluateLogL(IModelFunction & func, const UnBinData & data, const double * p, unsigned int &nPoints) {
+double FitUtilParallel::EvaluateLogL(const IModelFunction & func, const UnBinData & data, const double * p,
+                                     int iWeight, bool extended, unsigned int & nPoints) {
    // evaluate the LogLikelihood
 
    unsigned int n = data.Size();
+   unsigned int nchunks = NChunks(n);
+
+   // set the parameters once, the tasks only read them
+   (const_cast<IModelFunction &>(func)).SetParameters(p);
+
+   std::vector<double> logl(nchunks);
+   std::vector<double> sumW(nchunks);
+   std::vector<double> sumW2(nchunks);
+   ExecuteChunks(n, [&](unsigned int ichunk, unsigned int begin, unsigned int end) {
+      logl[ichunk] = FitUtil::EvaluateLogLSum(func, data, p, iWeight, extended, begin, end, sumW[ichunk], sumW2[ichunk]);
+   });
+
+   double result = SumChunks(logl);
+   if (extended) {
+      // add Poisson extended term
+      result += FitUtil::EvaluateLogLExtendedTerm(func, data, p, iWeight, SumChunks(sumW), SumChunks(sumW2));
+   }
 
+   nPoints = n;
 #ifdef DEBUG
-   std::cout << "\n\nFit data size = " << n << std::endl;
-   //std::cout << "func pointer is " << typeid(func).name() << std::endl;
-   std::cout << "\tpar = [ " << func.NPar() << " ] =  ";
-   for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
-      std::cout << p[ipar] << ", ";
-   std::cout <<"---------------------------\n";
+   std::cout << "Logl = " << result << " np = " << nPoints << std::endl;
 #endif
 
-   double logl = 0;
-   int nRejected = 0;
-//   func.SetParameters(p);
+   return -result;
+}
 
-   //std::vector<double> sum( MAX_THREAD );
+void FitUtilParallel::EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * p, double * grad, unsigned int & ) {
+   // evaluate the gradient of the log likelihood function
 
+   unsigned int n = data.Size();
+   unsigned int npar = func.NPar();
 
-#pragma omp parallel
-#pragma omp for reduction (+:logl,nRejected)
-//#pragma omp for reduction (+:logl,nRejected) schedule (static, 10)
-//#pragma omp reduction (+:nRejected)
+   std::vector<double> g(NChunks(n) * npar);
+   ExecuteChunks(n, [&](unsigned int ichunk, unsigned int begin, unsigned int end) {
+      FitUtil::EvaluateLogLGradientSum(func, data, p, begin, end, &g[ichunk * npar]);
+   }, ParallelGradient(func));
+   SumChunks(g, npar, grad);
+}
 
-   for (unsigned int i = 0; i < n; ++ i) {
+//_________________________________________________________________________________________________
+// for binned log likelihood functions
 
-      //int ith = omp_get_thread_num();
-      //func.SetParameters(p);
+double FitUtilParallel::EvaluatePoissonLogL(const IModelFunction & func, const BinData & data, const double * p,
+                                            int iWeight, bool extended, unsigned int & nPoints) {
+   // evaluate the Poisson Log Likelihood
+   // nPoints returns the points where bin content is not zero
 
-      const double * x = data.Coords(i);
-      double fval = func ( x, p  ); // this is thread safe passing the params
+   unsigned int n = data.Size();
+   unsigned int nchunks = NChunks(n);
 
-      if (fval < 0) {
-         nRejected++; // reject points with negative pdf (cannot exist)
-      }
-      else
-         //sum[ith] += EvalLogF( fval);
-         logl += EvalLogF( fval);
+   // set the parameters once, the tasks only read them
+   (const_cast<IModelFunction &>(func)).SetParameters(p);
 
-#ifdef DEBUG
-#pragma omp critical
-      {     std::cout << " ==== i = " << i << " thread " << omp_get_thread_num()
-                      << "fval = " << fval << " logl = " << logl << std::endl;}
-//       std::cout << "x [ " << data.PointSize() << " ] = ";
-//       for (unsigned int j = 0; j < data.PointSize(); ++j)
-//          std::cout << x[j] << "\t";
-#endif
-   }
+   std::vector<double> nloglike(nchunks);
+   std::vector<unsigned int> np(nchunks);
+   ExecuteChunks(n, [&](unsigned int ichunk, unsigned int begin, unsigned int end) {
+      nloglike[ichunk] = FitUtil::EvaluatePoissonLogLSum(func, data, p, iWeight, extended, begin, end, np[ichunk]);
+   });
 
-   // reset the number of fitting data points
-   if (nRejected != 0)  nPoints = n - nRejected;
+   nPoints = 0;
+   for (auto npc : np) nPoints += npc;
 
 #ifdef DEBUG
-   ncalls++;
-   int pr = std::cout.precision(15);
-   std::cout << "ncalls " << ncalls << " Logl = " << logl << " np = " << nPoints << std::endl;
-   std::cout.precision(pr);
-   assert(ncalls<3);
+   std::cout << "Loglikelihood  = " << SumChunks(nloglike) << std::endl;
 #endif
 
-   // logl = std::accumulate(sum.begin(), sum.end(),0. );
-
-   double result = - logl;
-   return result;
+   return SumChunks(nloglike);
 }
 
-#endif
+void FitUtilParallel::EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * p, double * grad ) {
+   // evaluate the gradient of the Poisson log likelihood function
 
+   unsigned int n = data.Size();
+   unsigned int npar = func.NPar();
 
-      } // end namespace FitUtilParallel
+   std::vector<double> g(NChunks(n) * npar);
+   ExecuteChunks(n, [&](unsigned int ichunk, unsigned int begin, unsigned int end) {
+      FitUtil::EvaluatePoissonLogLGradientSum(func, data, p, begin, end, &g[ichunk * npar]);
+   }, ParallelGradient(func));
+   SumChunks(g, npar, grad);
+}
 
    } // end namespace Fit
 
 } // end namespace ROOT
-
-
-
-
-#endif
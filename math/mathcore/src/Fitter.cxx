@@ -344,10 +344,19 @@ bool Fitter::DoLeastSquareFit() {
    fBinFit = true;
    fDataSize = data->Size();
 
+   // build a columnar copy of the data when requested, if the model function evaluates batches of
+   // points and the chi2 can use it (no bin integral, bin volume or expected errors, no coordinate errors)
+   const DataOptions & dopt = data->Opt();
+   BinData::ErrorType etype = data->GetErrorType();
+   if (fConfig.UseBatchEvaluation() && fFunc->HasEvalBatch() && !data->HasColumns() &&
+       !dopt.fIntegral && !dopt.fBinVolume && !dopt.fExpErrors &&
+       (etype == BinData::kNoError || etype == BinData::kValueError) )
+      data->BuildColumns();
+
    // check if fFunc provides gradient
    if (!fUseGradient) {
       // do minimzation without using the gradient
-      Chi2FCN<BaseFunc> chi2(data,fFunc);
+      Chi2FCN<BaseFunc> chi2(data,fFunc, fConfig.UseParallel());
       fFitType = chi2.Type();
       return DoMinimization (chi2);
    }
@@ -357,7 +366,7 @@ bool Fitter::DoLeastSquareFit() {
          MATH_INFO_MSG("Fitter::DoLeastSquareFit","use gradient from model function");
       std::shared_ptr<IGradModelFunction> gradFun = std::dynamic_pointer_cast<IGradModelFunction>(fFunc);
       if (gradFun) {
-         Chi2FCN<BaseGradFunc> chi2(data,gradFun);
+         Chi2FCN<BaseGradFunc> chi2(data,gradFun, fConfig.UseParallel());
          fFitType = chi2.Type();
          return DoMinimization (chi2);
       }
@@ -396,11 +405,11 @@ bool Fitter::DoBinnedLikelihoodFit(bool extended) {
    fDataSize = data->Size();
 
    // create a chi2 function to be used for the equivalent chi-square
-   Chi2FCN<BaseFunc> chi2(data,fFunc);
+   Chi2FCN<BaseFunc> chi2(data,fFunc, fConfig.UseParallel());
 
    if (!fUseGradient) {
       // do minimization without using the gradient
-      PoissonLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended);
+      PoissonLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended, fConfig.UseParallel());
       fFitType = logl.Type();
       // do minimization
       if (!DoMinimization (logl, &chi2) ) return false;
@@ -423,7 +432,7 @@ bool Fitter::DoBinnedLikelihoodFit(bool extended) {
       if (!extended) {
          MATH_WARN_MSG("Fitter::DoLikelihoodFit","Not-extended binned fit with gradient not yet supported - do an extended fit");
       }
-      PoissonLikelihoodFCN<BaseGradFunc> logl(data,gradFun, useWeight, true);
+      PoissonLikelihoodFCN<BaseGradFunc> logl(data,gradFun, useWeight, true, fConfig.UseParallel());
       fFitType = logl.Type();
       // do minimization
       if (!DoMinimization (logl, &chi2) ) return false;
@@ -458,6 +467,9 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended) {
    fBinFit = false;
    fDataSize = data->Size();
 
+   // build a columnar copy of the data when requested, if the model function evaluates batches of points
+   if (fConfig.UseBatchEvaluation() && fFunc->HasEvalBatch() && !data->HasColumns() ) data->BuildColumns();
+
 #ifdef DEBUG
    int ipar = 0;
    std::cout << "Fitter ParamSettings " << Config().ParamsSettings()[ipar].IsBound() << " lower limit " <<  Config().ParamsSettings()[ipar].LowerLimit() << " upper limit " <<  Config().ParamsSettings()[ipar].UpperLimit() << std::endl;
@@ -470,7 +482,7 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended) {
 
    if (!fUseGradient) {
       // do minimization without using the gradient
-      LogLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended);
+      LogLikelihoodFCN<BaseFunc> logl(data,fFunc, useWeight, extended, fConfig.UseParallel());
       fFitType = logl.Type();
       if (!DoMinimization (logl) ) return false;
       if (useWeight) {
@@ -488,7 +500,7 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended) {
          if (extended) {
             MATH_WARN_MSG("Fitter::DoLikelihoodFit","Extended unbinned fit with gradient not yet supported - do a not-extended fit");
          }
-         LogLikelihoodFCN<BaseGradFunc> logl(data,gradFun,useWeight, extended);
+         LogLikelihoodFCN<BaseGradFunc> logl(data,gradFun,useWeight, extended, fConfig.UseParallel());
          fFitType = logl.Type();
          if (!DoMinimization (logl) ) return false;
          if (useWeight) {
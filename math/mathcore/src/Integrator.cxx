@@ -81,6 +81,7 @@ IntegrationMultiDim::Type IntegratorMultiDim::GetType(const char *name) {
    std::string typeName(name);
    std::transform(typeName.begin(), typeName.end(), typeName.begin(), (int(*)(int)) toupper );
    if (typeName == "ADAPTIVE") return IntegrationMultiDim::kADAPTIVE;
+   if (typeName == "ADAPTIVEPARALLEL") return IntegrationMultiDim::kADAPTIVEPARALLEL;
    if (typeName == "VEGAS") return IntegrationMultiDim::kVEGAS;
    if (typeName == "MISER") return IntegrationMultiDim::kMISER;
    if (typeName == "PLAIN") return IntegrationMultiDim::kPLAIN;
@@ -91,6 +92,7 @@ IntegrationMultiDim::Type IntegratorMultiDim::GetType(const char *name) {
 std::string IntegratorMultiDim::GetName(IntegrationMultiDim::Type type) {
    if (type == IntegrationMultiDim::kDEFAULT) type = GetType(IntegratorMultiDimOptions::DefaultIntegrator().c_str() );
    if (type == IntegrationMultiDim::kADAPTIVE) return "ADAPTIVE";
+   if (type == IntegrationMultiDim::kADAPTIVEPARALLEL) return "ADAPTIVEPARALLEL";
    if (type == IntegrationMultiDim::kVEGAS) return "VEGAS";
    if (type == IntegrationMultiDim::kMISER) return "MISER";
    if (type == IntegrationMultiDim::kPLAIN) return "PLAIN";
@@ -179,12 +181,12 @@ VirtualIntegratorOneDim * IntegratorOneDim::CreateIntegrator(IntegrationOneDim::
 VirtualIntegratorMultiDim * IntegratorMultiDim::CreateIntegrator(IntegrationMultiDim::Type type , double absTol, double relTol, unsigned int ncall) {
    // create concrete class for multidimensional integration
 
+   if (type == IntegrationMultiDim::kDEFAULT) type = GetType(IntegratorMultiDimOptions::DefaultIntegrator().c_str());
+
 #ifndef R__HAS_MATHMORE
-   // when Mathmore is not built only possible type is ADAPTIVE. There is no other choice
-   type = IntegrationMultiDim::kADAPTIVE;
+   // when Mathmore is not built only possible types are ADAPTIVE and ADAPTIVEPARALLEL. There is no other choice
+   if (type != IntegrationMultiDim::kADAPTIVEPARALLEL) type = IntegrationMultiDim::kADAPTIVE;
 #endif
-
-   if (type == IntegrationMultiDim::kDEFAULT) type = GetType(IntegratorMultiDimOptions::DefaultIntegrator().c_str());
    if (absTol < 0) absTol = IntegratorMultiDimOptions::DefaultAbsTolerance();
    if (relTol < 0) relTol = IntegratorMultiDimOptions::DefaultRelTolerance();
    if (ncall  <= 0) ncall  = IntegratorMultiDimOptions::DefaultNCalls();
@@ -192,8 +194,11 @@ VirtualIntegratorMultiDim * IntegratorMultiDim::CreateIntegrator(IntegrationMult
 
 
    // no need for PM in the adaptive  case using Genz method (class is in MathCore)
-   if (type == IntegrationMultiDim::kADAPTIVE)
-      return new AdaptiveIntegratorMultiDim(absTol, relTol, ncall, size);
+   if (type == IntegrationMultiDim::kADAPTIVE || type == IntegrationMultiDim::kADAPTIVEPARALLEL) {
+      AdaptiveIntegratorMultiDim * ig = new AdaptiveIntegratorMultiDim(absTol, relTol, ncall, size);
+      ig->SetParallelMode(type == IntegrationMultiDim::kADAPTIVEPARALLEL);
+      return ig;
+   }
 
    // use now plugin-manager for creating the GSL integrator
 
@@ -16,6 +16,8 @@
 //
 #include "Math/MersenneTwisterEngine.h"
 
+#include <algorithm>
+
 
 namespace ROOT {
 namespace Math {
@@ -33,37 +35,76 @@ namespace Math {
       }
    }
 
+   /// generate the next 624 numbers of the state
+   void MersenneTwisterEngine::GenerateState() {
+
+      uint32_t y;
+
+      const int  kM = 397;
+      const int  kN = 624;
+      const uint32_t kUpperMask =       0x80000000;
+      const uint32_t kLowerMask =       0x7fffffff;
+      const uint32_t kMatrixA =         0x9908b0df;
+
+      int i;
+
+      for (i=0; i < kN-kM; i++) {
+         y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
+         fMt[i] = fMt[i+kM] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
+      }
+
+      for (   ; i < kN-1    ; i++) {
+         y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
+         fMt[i] = fMt[i+kM-kN] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
+      }
+
+      y = (fMt[kN-1] & kUpperMask) | (fMt[0] & kLowerMask);
+      fMt[kN-1] = fMt[kM-1] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
+      fCount624 = 0;
+   }
+
+   /// generate an array of random numbers.
+   /// The numbers available in the state are tempered in a single (vectorisable) loop
+   void MersenneTwisterEngine::RndmArray(int n, double * array) {
+
+      const int  kN = 624;
+      const uint32_t kTemperingMaskB =  0x9d2c5680;
+      const uint32_t kTemperingMaskC =  0xefc60000;
+
+      int k = 0;
+      while (k < n) {
+         if (fCount624 >= kN) GenerateState();
+         int m = std::min(n - k, kN - fCount624);
+         const uint32_t * mt = fMt + fCount624;
+         double * out = array + k;
+         for (int j = 0; j < m; ++j) {
+            uint32_t y = mt[j];
+            y ^=  (y >> 11);
+            y ^= ((y << 7 ) & kTemperingMaskB );
+            y ^= ((y << 15) & kTemperingMaskC );
+            y ^=  (y >> 18);
+            out[j] = (double) y * 2.3283064365386963e-10; // * Power(2,-32)
+         }
+         fCount624 += m;
+         k += m;
+      }
+      // zero is excluded (probability 2^-32)
+      for (int i = 0; i < n; ++i) {
+         if (array[i] == 0) array[i] = Rndm_impl();
+      }
+   }
+
    /// generate a random double number 
    double MersenneTwisterEngine::Rndm_impl() {
 
       
       uint32_t y;
       
-      const int  kM = 397;
       const int  kN = 624;
       const uint32_t kTemperingMaskB =  0x9d2c5680;
       const uint32_t kTemperingMaskC =  0xefc60000;
-      const uint32_t kUpperMask =       0x80000000;
-      const uint32_t kLowerMask =       0x7fffffff;
-      const uint32_t kMatrixA =         0x9908b0df;
       
-      if (fCount624 >= kN) {
-         int i;
-         
-         for (i=0; i < kN-kM; i++) {
-            y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-            fMt[i] = fMt[i+kM] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         }
-         
-         for (   ; i < kN-1    ; i++) {
-            y = (fMt[i] & kUpperMask) | (fMt[i+1] & kLowerMask);
-            fMt[i] = fMt[i+kM-kN] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         }
-         
-         y = (fMt[kN-1] & kUpperMask) | (fMt[0] & kLowerMask);
-         fMt[kN-1] = fMt[kM-1] ^ (y >> 1) ^ ((y & 0x1) ? kMatrixA : 0x0);
-         fCount624 = 0;
-      }
+      if (fCount624 >= kN) GenerateState();
       
       y = fMt[fCount624++];
       y ^=  (y >> 11);
@@ -20,8 +20,27 @@
 
 #include "TMath.h"
 
+#include "VdtFunctions.h"
+
 namespace ROOT {
 namespace Math {
+
+void Impl::GausBoxMuller(int n, const double * u, double * x, double mean, double sigma) {
+   const int h = n/2;
+   for (int i = 0; i < h; ++i) {
+      double radius = sigma * std::sqrt(-2 * Impl::FastMath::Log(u[i]));
+      double phi = u[h+i] * 6.28318530717958623;
+      double g1 = radius * Impl::FastMath::Cos(phi);
+      double g2 = radius * Impl::FastMath::Sin(phi);
+      x[i] = mean + g1;
+      x[h+i] = mean + g2;
+   }
+}
+
+void Impl::ExpFromUniform(int n, const double * u, double * x, double tau) {
+   for (int i = 0; i < n; ++i)
+      x[i] = -tau * Impl::FastMath::Log(u[i]);
+}
    
 
 Int_t RandomFunctionsImpl<TRandomEngine>::Binomial(Int_t ntot, Double_t prob)
@@ -29,6 +29,8 @@
 #include <Math/PdfFuncMathCore.h>
 #include <Math/ProbFuncMathCore.h>
 
+#include "VdtFunctions.h"
+
 //const Double_t
 //   TMath::Pi = 3.14159265358979323846,
 //   TMath::E  = 2.7182818284590452354;
@@ -106,6 +108,49 @@ Double_t TMath::Log2(Double_t x)
    return log(x)/log(2.0);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Array version of TMath::Exp: r[i] = exp(x[i]) for i < n.
+/// The functions of VDT (vectorisable, accurate to a few ULP) are used when
+/// ROOT is built with it, the ones of the standard library otherwise.
+/// The same holds for the array versions of Log, Sin, Cos and ATan2.
+
+void TMath::Exp(Long64_t n, const Double_t *x, Double_t *r)
+{
+   for (Long64_t i = 0; i < n; ++i) r[i] = ::ROOT::Math::Impl::FastMath::Exp(x[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Array version of TMath::Log: r[i] = log(x[i]) for i < n.
+
+void TMath::Log(Long64_t n, const Double_t *x, Double_t *r)
+{
+   for (Long64_t i = 0; i < n; ++i) r[i] = ::ROOT::Math::Impl::FastMath::Log(x[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Array version of TMath::Sin: r[i] = sin(x[i]) for i < n.
+
+void TMath::Sin(Long64_t n, const Double_t *x, Double_t *r)
+{
+   for (Long64_t i = 0; i < n; ++i) r[i] = ::ROOT::Math::Impl::FastMath::Sin(x[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Array version of TMath::Cos: r[i] = cos(x[i]) for i < n.
+
+void TMath::Cos(Long64_t n, const Double_t *x, Double_t *r)
+{
+   for (Long64_t i = 0; i < n; ++i) r[i] = ::ROOT::Math::Impl::FastMath::Cos(x[i]);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Array version of TMath::ATan2: r[i] = atan2(y[i], x[i]) for i < n.
+
+void TMath::ATan2(Long64_t n, const Double_t *y, const Double_t *x, Double_t *r)
+{
+   for (Long64_t i = 0; i < n; ++i) r[i] = ::ROOT::Math::Impl::FastMath::ATan2(y[i], x[i]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The DiLogarithm function
 /// Code translated by R.Brun from CERNLIB DILOG function C332
@@ -460,6 +505,26 @@ Double_t TMath::Gaus(Double_t x, Double_t mean, Double_t sigma, Bool_t norm)
    return res/(2.50662827463100024*sigma); //sqrt(2*Pi)=2.50662827463100024
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Array version of TMath::Gaus: compute the Gaus function for the n values
+/// of the array x and store the results in the array r.
+/// The exponential of VDT is used when ROOT is built with it.
+
+void TMath::Gaus(Long64_t n, const Double_t *x, Double_t *r, Double_t mean, Double_t sigma, Bool_t norm)
+{
+   if (sigma == 0) {
+      for (Long64_t i = 0; i < n; ++i) r[i] = 1.e30;
+      return;
+   }
+   const Double_t scale = (norm) ? 1./(2.50662827463100024*sigma) : 1.;
+   for (Long64_t i = 0; i < n; ++i) {
+      Double_t arg = (x[i]-mean)/sigma;
+      Double_t res = scale * ::ROOT::Math::Impl::FastMath::Exp(-0.5*arg*arg);
+      // for |arg| > 39  result is zero in double precision
+      r[i] = (arg < -39.0 || arg > 39.0) ? 0.0 : res;
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// The LANDAU function.
 /// mu is a location parameter and correspond approximately to the most probable value
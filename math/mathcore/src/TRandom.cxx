@@ -50,6 +50,11 @@ The following methods are provided to generate random numbers disctributed accor
 - `Poisson(mean)`
 - `Binomial(ntot,prob)`
 
+Arrays of numbers can be generated in a single call with `RndmArray(n,x)` (uniform),
+`GausN(n,x,mean,sigma)` and `ExpN(n,x,tau)`: the uniform numbers are generated in a block
+and transformed in a vectorised loop, which is much faster than n calls of the
+corresponding function for a large number of values.
+
 Random numbers distributed according to 1-d, 2-d or 3-d distributions contained in TF1, TF2 or TF3 objects can also be generated. 
 For example, to get a random number distributed following abs(sin(x)/x)*sqrt(x)
 you can do :
@@ -137,6 +142,7 @@ A TRandom object may be written to a Root file
 #include "TSystem.h"
 #include "TDirectory.h"
 #include "Math/QuantFuncMathCore.h"
+#include "Math/RandomFunctions.h"
 #include "TUUID.h"
 
 ClassImp(TRandom)
@@ -216,6 +222,15 @@ Double_t TRandom::Exp(Double_t tau)
    return t;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the array x with n exponential deviates, exp( -t/tau ).
+/// The uniform numbers are generated with RndmArray and transformed in a single loop.
+
+void TRandom::ExpN(Int_t n, Double_t *x, Double_t tau)
+{
+   ::ROOT::Math::Impl::ExpN(*this, n, x, tau);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Samples a random number from the standard Normal (Gaussian) Distribution
 /// with the given mean and sigma.
@@ -314,6 +329,17 @@ Double_t TRandom::Gaus(Double_t mean, Double_t sigma)
    return mean + sigma * result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the array x with n numbers from a Gaussian distribution with the given
+/// mean and sigma. The uniform numbers are generated with RndmArray and transformed
+/// with the Box-Muller method in a vectorised loop: the sequence is not the same
+/// as the one of n calls to Gaus.
+
+void TRandom::GausN(Int_t n, Double_t *x, Double_t mean, Double_t sigma)
+{
+   ::ROOT::Math::Impl::GausN(*this, n, x, mean, sigma);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns a random integer on [ 0, imax-1 ].
 
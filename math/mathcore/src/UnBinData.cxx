@@ -177,6 +177,7 @@ UnBinData::UnBinData(unsigned int n, const double * dataX, const double * dataY,
 
 void UnBinData::Initialize(unsigned int maxpoints, unsigned int dim, bool isWeighted ) {
    //   preallocate a data set given size and dimension
+   fColumns.Clear();
    unsigned int pointSize = (isWeighted) ? dim+1 : dim;
    if ( (dim != fDim || pointSize != fPointSize) && fDataVector) {
 //       MATH_INFO_MSGVAL("BinData::Initialize"," Reset amd re-initialize with a new fit point size of ",
@@ -200,6 +201,7 @@ void UnBinData::Initialize(unsigned int maxpoints, unsigned int dim, bool isWeig
 void UnBinData::Resize(unsigned int npoints) {
    // resize vector to new points
    if (fDim == 0) return;
+   fColumns.Clear();
    if ( npoints > MaxSize() ) {
       MATH_ERROR_MSGVAL("BinData::Resize"," Invalid data size  ", npoints );
       return;
@@ -221,6 +223,26 @@ void UnBinData::Resize(unsigned int npoints) {
       fDataVector = new DataVector( npoints*fPointSize);
 }
 
+void UnBinData::BuildColumns() {
+   // build the columnar copy of the data: coordinates and weights
+
+   fColumns.Clear();
+   if (fNPoints == 0) return;
+
+   fColumns.Allocate(fDim + 1, fNPoints);
+   std::vector<double *> coords(fDim);
+   for (unsigned int icoord = 0; icoord < fDim; ++icoord)
+      coords[icoord] = fColumns.Column(icoord);
+   double * weights = fColumns.Column(fDim);
+
+   for (unsigned int i = 0; i < fNPoints; ++i) {
+      const double * x = Coords(i);
+      for (unsigned int icoord = 0; icoord < fDim; ++icoord)
+         coords[icoord][i] = x[icoord];
+      weights[i] = Weight(i);
+   }
+}
+
 
 
    } // end namespace Fit
@@ -0,0 +1,101 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2005 , LCG ROOT MathLib Team                         *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// implementation of the array versions of the statistical functions (Math/VecFuncMathCore.h)
+
+#include "Math/VecFuncMathCore.h"
+#include "Math/Math.h"
+
+#include "VdtFunctions.h"
+
+#include <cmath>
+
+namespace ROOT {
+namespace Math {
+
+   // the loops avoid branches (the two alternatives are computed and one is selected)
+   // so they can be vectorised by the compiler
+
+   typedef Impl::FastMath M;
+
+   void gaussian_pdf(unsigned int n, const double * x, double * r, double sigma, double x0) {
+      const double norm = 1.0/(std::sqrt(2 * M_PI) * std::fabs(sigma));
+      for (unsigned int i = 0; i < n; ++i) {
+         double tmp = (x[i]-x0)/sigma;
+         r[i] = norm * M::Exp(-tmp*tmp/2);
+      }
+   }
+
+   void normal_pdf(unsigned int n, const double * x, double * r, double sigma, double x0) {
+      gaussian_pdf(n, x, r, sigma, x0);
+   }
+
+   void landau_pdf(unsigned int n, const double * x, double * r, double xi, double x0) {
+      if (xi <= 0) {
+         for (unsigned int i = 0; i < n; ++i) r[i] = 0;
+         return;
+      }
+      for (unsigned int i = 0; i < n; ++i)
+         r[i] = Impl::LandauDensity<M>((x[i] - x0)/xi)/xi;
+   }
+
+   void exponential_pdf(unsigned int n, const double * x, double * r, double lambda, double x0) {
+      for (unsigned int i = 0; i < n; ++i) {
+         double y = x[i] - x0;
+         double p = lambda * M::Exp(-lambda * y);
+         r[i] = (y < 0) ? 0.0 : p;
+      }
+   }
+
+   void lognormal_pdf(unsigned int n, const double * x, double * r, double m, double s, double x0) {
+      const double norm = 1.0 / (std::fabs(s) * std::sqrt(2 * M_PI));
+      for (unsigned int i = 0; i < n; ++i) {
+         double y = x[i] - x0;
+         double tmp = (M::Log(y) - m)/s;
+         double p = norm / y * M::Exp(-(tmp * tmp) /2);
+         r[i] = (y <= 0) ? 0.0 : p;
+      }
+   }
+
+   void breitwigner_pdf(unsigned int n, const double * x, double * r, double gamma, double x0) {
+      const double gammahalf = gamma/2.0;
+      for (unsigned int i = 0; i < n; ++i)
+         r[i] = gammahalf/(M_PI * ((x[i]-x0)*(x[i]-x0) + gammahalf*gammahalf));
+   }
+
+   void cauchy_pdf(unsigned int n, const double * x, double * r, double b, double x0) {
+      for (unsigned int i = 0; i < n; ++i)
+         r[i] = b/(M_PI * ((x[i]-x0)*(x[i]-x0) + b*b));
+   }
+
+   // the cumulative functions of the normal distribution use erf and erfc, which are not in VDT
+
+   void normal_cdf(unsigned int n, const double * x, double * r, double sigma, double x0) {
+      for (unsigned int i = 0; i < n; ++i) r[i] = normal_cdf(x[i], sigma, x0);
+   }
+
+   void normal_cdf_c(unsigned int n, const double * x, double * r, double sigma, double x0) {
+      for (unsigned int i = 0; i < n; ++i) r[i] = normal_cdf_c(x[i], sigma, x0);
+   }
+
+   void exponential_cdf(unsigned int n, const double * x, double * r, double lambda, double x0) {
+      // use expm1 as the scalar version to avoid errors at small x
+      for (unsigned int i = 0; i < n; ++i) r[i] = exponential_cdf(x[i], lambda, x0);
+   }
+
+   void exponential_cdf_c(unsigned int n, const double * x, double * r, double lambda, double x0) {
+      for (unsigned int i = 0; i < n; ++i) {
+         double y = x[i] - x0;
+         double p = M::Exp(- lambda * y);
+         r[i] = (y < 0) ? 1.0 : p;
+      }
+   }
+
+} // namespace Math
+} // namespace ROOT
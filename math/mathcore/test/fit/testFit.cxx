@@ -9,19 +9,24 @@
 #include "TRandom3.h"
 #include "TROOT.h"
 #include "TVirtualFitter.h"
+#include "TFitResult.h"
 
 #include "Fit/BinData.h"
 #include "Fit/UnBinData.h"
 #include "HFitInterface.h"
 #include "Fit/Fitter.h"
+#include "Fit/FitUtil.h"
 
 #include "Math/WrappedMultiTF1.h"
 #include "Math/WrappedParamFunction.h"
 #include "Math/WrappedTF1.h"
+#include "Math/MinimizerOptions.h"
+#include "Math/IOptions.h"
 //#include "Math/Polynomial.h"
 #include "RConfigure.h"
 
 #include <string>
+#include <vector>
 #include <iostream>
 #include <cmath>
 
@@ -914,6 +919,234 @@ int testGraphFit() {
 }
 
 
+double gausParamFunc(const double * x, const double * p) {
+   double t = (x[0] - p[1])/p[2];
+   return p[0] * std::exp(-0.5 * t * t);
+}
+
+int testColumnarData() {
+   // compare the fit method functions evaluated on the interleaved and on the columnar data
+
+   int iret = 0;
+
+   TF1 * func = (TF1*)gROOT->GetFunction("gaus");
+   ROOT::Math::WrappedMultiTF1 wf(*func);
+   ROOT::Math::IParamMultiFunction & f = wf;
+   double p[3] = {100,0.1,1.2};
+
+   TRandom3 rndm;
+
+   // binned data (values and errors)
+   int nbins = 1000;
+   ROOT::Fit::BinData bd(nbins);
+   for (int i = 0; i < nbins; ++i) {
+      double x = -5. + 10. * (i + 0.5)/nbins;
+      double y = rndm.Poisson(100. * std::exp(-0.5 * x * x) );
+      bd.Add(x, y, (y > 0) ? std::sqrt(y) : 1. );
+   }
+   unsigned int np = 0;
+   double chi2ref = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, p, np);
+   if (!bd.BuildColumns()) iret |= 1;
+   double chi2 = ROOT::Fit::FitUtil::EvaluateChi2(f, bd, p, np);
+   iret |= compareResult(chi2, chi2ref, "chi2 on columnar data", 1.E-12);
+
+   // unbinned data
+   int n = 10000;
+   ROOT::Fit::UnBinData ud(n);
+   for (int i = 0; i < n; ++i)
+      ud.Add( rndm.Gaus(0,1) );
+   p[0] = 1.;
+   double loglref = ROOT::Fit::FitUtil::EvaluateLogL(f, ud, p, 0, false, np);
+   ud.BuildColumns();
+   double logl = ROOT::Fit::FitUtil::EvaluateLogL(f, ud, p, 0, false, np);
+   iret |= compareResult(logl, loglref, "log-likelihood on columnar data", 1.E-12);
+
+   // the columns are invalidated when the data are modified
+   ud.Resize(n/2);
+   if (ud.HasColumns() ) iret |= 1;
+
+   // copies of the binned data keep the columns
+   ROOT::Fit::BinData bdCopy(bd);
+   if (!bdCopy.HasColumns() ) iret |= 1;
+   chi2 = ROOT::Fit::FitUtil::EvaluateChi2(f, bdCopy, p, np);
+   iret |= compareResult(chi2, ROOT::Fit::FitUtil::EvaluateChi2(f, bd, p, np), "chi2 on copied columnar data", 1.E-12);
+
+   // batch and point by point evaluation of the wrapped functions
+   ROOT::Math::WrappedParamFunction<> wpf(&gausParamFunc, 1, 3, p);
+   const double * xcol = bd.CoordColumn(0);
+   std::vector<double> fbatch(nbins);
+   wf.SetParameters(p);
+   wf.EvalBatch(&xcol, &fbatch.front(), nbins);
+   for (int i = 0; i < nbins; ++i)
+      iret |= (fbatch[i] != wf(&xcol[i]) );
+   wpf.EvalBatch(&xcol, &fbatch.front(), nbins);
+   for (int i = 0; i < nbins; ++i)
+      iret |= (fbatch[i] != wpf(&xcol[i]) );
+
+   // the fitter builds the columns for functions with batch evaluation only when requested;
+   // the minimum found must agree with the chi2 evaluated point by point on the interleaved data
+   ROOT::Fit::BinData bdFit(nbins);
+   ROOT::Fit::BinData bdRef(nbins);
+   for (int i = 0; i < nbins; ++i) {
+      double y, invErr;
+      const double * x = bd.GetPoint(i, y, invErr);
+      bdFit.Add(x[0], y, 1./invErr);
+      bdRef.Add(x[0], y, 1./invErr);
+   }
+   ROOT::Fit::Fitter fitter;
+   double p0[3] = {90,0.,1.};
+   fitter.Config().SetParamsSettings(3,p0);
+   fitter.Config().SetBatchEvaluation();
+   if (!fitter.Fit(bdFit, wpf) ) iret |= 1;
+   if (!bdFit.HasColumns() ) iret |= 1;
+   const ROOT::Fit::FitResult & result = fitter.Result();
+   chi2ref = ROOT::Fit::FitUtil::EvaluateChi2(f, bdRef, &result.Parameters().front(), np);
+   iret |= compareResult(result.MinFcnValue(), chi2ref, "chi2 minimum on columnar data", 1.E-8);
+
+   // by default the data are not copied
+   ROOT::Fit::Fitter fitterRef;
+   fitterRef.Config().SetParamsSettings(3,p0);
+   if (!fitterRef.Fit(bdRef, wpf) ) iret |= 1;
+   if (bdRef.HasColumns() ) iret |= 1;
+   iret |= compareResult(result.MinFcnValue(), fitterRef.Result().MinFcnValue(), "chi2 minimum with and without columnar data", 1.E-8);
+
+   return iret;
+}
+
+double gausTF1(double * x, double * p) {
+   return gausParamFunc(x, p);
+}
+
+// run the fit with implicit multi-threading disabled and with 4 threads:
+// the parallel fit method functions must give identical results
+template<typename FitFunc>
+int compareParallelFit(FitFunc fit, std::string s) {
+   std::vector<double> par1, par2;
+   double fval1 = 0, fval2 = 0;
+   bool ok = fit(par1, fval1);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   ok &= fit(par2, fval2);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+   if (ok && par1 == par2 && fval1 == fval2) return 0;
+   std::cerr << s << " Failed comparison of fit results with 1 and 4 threads \t fval = " << fval2
+             << "   it should be = " << fval1 << std::endl;
+   return 1;
+}
+
+int testParallelFit() {
+   // fit with the chi2 and the likelihoods evaluated in parallel (option MULTITHREAD), using
+   // the gradient of the model function. The data have many chunks of ROOT::Fit::FitUtilParallel::ChunkSize() points
+
+   int iret = 0;
+
+   TRandom3 rndm(111);
+   TH1D h1("h1par","h1par",20000,-5.,5.);
+   for (int i = 0; i < 1000000; ++i)
+      h1.Fill(rndm.Gaus(0.2,1.1) );
+
+   // exact formula gradient: it is evaluated in parallel
+   TF1 f1("f1par","[0]*exp(-0.5*((x-[1])/[2])^2)",-5.,5.);
+   if (!f1.GetFormula()->GenerateGradientPar() ) iret |= 1;
+   if (!ROOT::Math::WrappedMultiTF1(f1).HasThreadSafeParameterGradient() ) iret |= 1;
+   // numerical gradient, which modifies the TF1: it is evaluated sequentially
+   TF1 f2("f2par",gausTF1,-5.,5.,3);
+   if (ROOT::Math::WrappedMultiTF1(f2).HasThreadSafeParameterGradient() ) iret |= 1;
+
+   const char * fitOpt[2] = { "Q N G MULTITHREAD", "Q N G L MULTITHREAD" };
+   TF1 * funcs[2] = { &f1, &f2 };
+   for (int ifunc = 0; ifunc < 2; ++ifunc) {
+      for (int iopt = 0; iopt < 2; ++iopt) {
+         TF1 * func = funcs[ifunc];
+         const char * opt = fitOpt[iopt];
+         auto fit = [&](std::vector<double> & par, double & fval) {
+            // the numerical derivatives depend also on the parameter errors
+            double p0[3] = {40.,0.,1.};
+            double e0[3] = {0.,0.,0.};
+            func->SetParameters(p0);
+            func->SetParErrors(e0);
+            TFitResultPtr r = h1.Fit(func, TString(opt) + " S");
+            if (r->Status() != 0) return false;
+            par = r->Parameters();
+            fval = r->MinFcnValue();
+            return true;
+         };
+         iret |= compareParallelFit(fit, std::string("TH1::Fit ") + func->GetName() + " " + opt);
+      }
+   }
+
+   // unbinned likelihood fit
+   int n = 20000;
+   ROOT::Fit::UnBinData ud(n);
+   for (int i = 0; i < n; ++i)
+      ud.Add( rndm.Gaus(0.2,1.1) );
+   TF1 f3("f3par","exp(-0.5*((x-[0])/[1])^2)/(sqrt(2*pi)*[1])",-10.,10.);
+   f3.GetFormula()->GenerateGradientPar();
+   ROOT::Math::WrappedMultiTF1 wf3(f3);
+   auto fitUnBin = [&](std::vector<double> & par, double & fval) {
+      ROOT::Fit::Fitter fitter;
+      double p0[2] = {0.,1.};
+      fitter.Config().SetParamsSettings(2,p0);
+      fitter.Config().SetParallel(true);
+      fitter.SetFunction(wf3);
+      if (!fitter.LikelihoodFit(ud) ) return false;
+      par = fitter.Result().Parameters();
+      fval = fitter.Result().MinFcnValue();
+      return true;
+   };
+   iret |= compareParallelFit(fitUnBin, "Unbinned likelihood fit");
+
+   return iret;
+}
+
+int testGradientThreadsFit() {
+   // fit with the Minuit2 numerical gradient computed in threads (option "GradientNThreads"):
+   // each thread evaluates a copy of the chi2 with its own copy of the TF1
+
+   int iret = 0;
+
+   TRandom3 rndm(222);
+   TH1D h1("h1thr","h1thr",100,-5.,5.);
+   for (int i = 0; i < 10000; ++i)
+      h1.Fill(rndm.Gaus(0.2,1.1) );
+
+   TF1 f1("f1thr","gaus",-5.,5.);
+   ROOT::Math::WrappedMultiTF1 wf(f1);
+   ROOT::Math::IMultiGenFunction * wfCopy = wf.CloneForThread();
+   const ROOT::Math::WrappedMultiTF1 * wfc = dynamic_cast<const ROOT::Math::WrappedMultiTF1 *>(wfCopy);
+   if (!wfc || wfc->GetFunction() == &f1) iret |= 1;
+   delete wfCopy;
+
+   ROOT::Fit::BinData data;
+   ROOT::Fit::FillData(data, &h1);
+   double fval[2];
+   std::vector<double> par[2];
+   for (int i = 0; i < 2; ++i) {
+      ROOT::Math::MinimizerOptions::Default("Minuit2").SetValue("GradientNThreads", (i == 0) ? 0 : 4);
+      ROOT::Fit::Fitter fitter;
+      fitter.Config().SetMinimizer("Minuit2");
+      double p0[3] = {300.,0.,1.};
+      fitter.Config().SetParamsSettings(3,p0);
+      // use the numerical gradient of Minuit2
+      fitter.SetFunction(wf, false);
+      if (!fitter.Fit(data) ) iret |= 1;
+      fval[i] = fitter.Result().MinFcnValue();
+      par[i] = fitter.Result().Parameters();
+   }
+   ROOT::Math::MinimizerOptions::Default("Minuit2").SetValue("GradientNThreads", 0);
+   if (fval[0] != fval[1] || par[0] != par[1]) {
+      std::cerr << "Minuit2 fit with gradient threads Failed comparison of fit results \t chi2 = " << fval[1]
+                << "   it should be = " << fval[0] << std::endl;
+      iret |= 1;
+   }
+
+   return iret;
+}
+
+
 template<typename Test>
 int testFit(Test t, std::string name) {
    std::cout << name << "\n\t\t";
@@ -934,6 +1167,9 @@ int main() {
    iret |= testFit( testHisto2DFit, "Histogram2D Gradient Fit");
    iret |= testFit( testUnBin1DFit, "Unbin 1D Fit");
    iret |= testFit( testGraphFit, "Graph 1D Fit");
+   iret |= testFit( testColumnarData, "Columnar Fit Data");
+   iret |= testFit( testParallelFit, "Parallel Fit");
+   iret |= testFit( testGradientThreadsFit, "Gradient Threads Fit");
 
    std::cout << "\n******************************\n";
    if (iret) std::cerr << "\n\t testFit FAILED !!!!!!!!!!!!!!!! \n";
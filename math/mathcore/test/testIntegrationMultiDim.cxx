@@ -12,8 +12,11 @@
 #include "TStopwatch.h"
 #include <cmath>
 #include <iostream>
+#include <vector>
+#include <algorithm>
 
 #include "Math/Integrator.h"
+#include "Math/IntegratorMultiDim.h"
 #include "Math/Functor.h"
 #include "Math/IFunction.h"
 #include "Math/WrappedParamFunction.h"
@@ -138,6 +141,52 @@ double integral_TF1(unsigned int dim, double* a, double* b, double* p)
   return timeTF1;
 }
 
+  // ################################################################
+  //
+  //      testing the parallel mode of AdaptiveIntegratorMultiDim
+  //
+  // ################################################################
+int testParallel()
+{
+  // compare the results of the ADAPTIVE and ADAPTIVEPARALLEL integrators,
+  // which divide the sub-regions in a different order
+  int iret = 0;
+  std::cout << "Testing parallel mode of AdaptiveIntegratorMultiDim\n";
+  std::cout << "N dim \t Adaptive time \t ParallelAdaptive time \t rel. difference\n";
+  for (int N = 2; N <= NMAX; N++) {
+     std::vector<double> a(N, -1.);
+     std::vector<double> b(N, 1.);
+     double p[1];
+     p[0] = N;
+     ROOT::Math::WrappedParamFunction<> func(&SimpleFun, N, p, p+1);
+
+     TStopwatch timer;
+     ROOT::Math::IntegratorMultiDim ig1(func, ROOT::Math::IntegrationMultiDim::kADAPTIVE, 1.E-5, 1.E-5, 1000000);
+     timer.Start();
+     double r1 = ig1.Integral(a.data(), b.data());
+     timer.Stop();
+     double t1 = timer.RealTime();
+
+     ROOT::Math::IntegratorMultiDim ig2(func, ROOT::Math::IntegrationMultiDim::kADAPTIVEPARALLEL, 1.E-5, 1.E-5, 1000000);
+     timer.Start();
+     double r2 = ig2.Integral(a.data(), b.data());
+     timer.Stop();
+     double t2 = timer.RealTime();
+
+     // both results are within the requested tolerance
+     double diff = std::abs(r2 - r1) / std::max(std::abs(r1), 1.E-10);
+     bool ok = (diff < 1.E-4 || std::abs(r2 - r1) < 1.E-8) && ig2.Status() == ig1.Status();
+     std::cout << N << " " << t1 << "\t" << t2 << "\t" << diff << (ok ? "" : "\tFAILED") << std::endl;
+     if (verbose) {
+        std::cout.precision(12);
+        std::cout << "result adaptive:  \t" << r1 << "\t" << "error: \t" << ig1.Error() << std::endl;
+        std::cout << "result parallel:  \t" << r2 << "\t" << "error: \t" << ig2.Error() << std::endl;
+     }
+     if (!ok) iret = 1;
+  }
+  return iret;
+}
+
 void performance()
 {
   //dimensionality
@@ -229,6 +278,8 @@ int main(int argc, char **argv)
 
    performance();
 
+   int iret = testParallel();
+
    if ( showGraphics )
    {
       theApp->Run();
@@ -236,6 +287,6 @@ int main(int argc, char **argv)
       theApp = 0;
    }
 
-   return 0;
+   return iret;
 
 }
@@ -164,6 +164,86 @@ bool test2() {
    return ret; 
 }
 
+bool test3() {
+
+   bool ret = true;
+
+   std::cout << "\nTesting bulk generation (GausN, ExpN) vs single generation" << std::endl;
+
+   Random<MixMaxEngine> rmx(3333);
+   Random<MersenneTwisterEngine> rmt(4444);
+
+   std::vector<double> x(NR);
+   std::vector<double> y(NR);
+
+   TStopwatch w; w.Start();
+   rmx.GausN(NR, x.data(), 0, 1);
+   w.Stop();
+   std::cout << "time for GausN filled for " << typeid(rmx).name();
+   w.Print();
+   for (int i = 0; i < NR; ++i) {
+      x[i] = ROOT::Math::normal_cdf(x[i],1);
+      y[i] = ROOT::Math::normal_cdf(rmt.Gaus(0,1),1);
+   }
+   ret &= testCompatibility(x,y);
+
+   TRandom3 r3(5555);
+   r3.ExpN(NR, x.data(), 2.);
+   for (int i = 0; i < NR; ++i) {
+      x[i] = ROOT::Math::exponential_cdf(x[i],0.5);
+      y[i] = ROOT::Math::exponential_cdf(rmt.Exp(2.),0.5);
+   }
+   ret &= testCompatibility(x,y);
+
+   // the array of the MT engine is the same as the sequence of single numbers
+   MersenneTwisterEngine mt1(1234);
+   MersenneTwisterEngine mt2(1234);
+   mt1.RndmArray(1000, x.data());
+   for (int i = 0; i < 1000; ++i) {
+      if (x[i] != mt2()) {
+         std::cout << "MT RndmArray differs from the sequence at " << i << std::endl;
+         ret = false;
+         break;
+      }
+   }
+   return ret;
+}
+
+bool test4() {
+
+   bool ret = true;
+
+   std::cout << "\nTesting MIXMAX independent streams" << std::endl;
+
+   // the same stream gives the same sequence, different streams are compatible and different
+   std::vector<double> x(NR);
+   std::vector<double> y(NR);
+   std::vector<double> z(1000);
+
+   MixMaxEngine s1; s1.SeedUniqueStream(0,0,1,1);
+   MixMaxEngine s2; s2.SeedUniqueStream(0,0,1,2);
+   MixMaxEngine s1b; s1b.SeedUniqueStream(0,0,1,1);
+
+   s1.RndmArray(NR, x.data());
+   s2.RndmArray(NR, y.data());
+   s1b.RndmArray(1000, z.data());
+   int nequal = 0;
+   for (int i = 0; i < 1000; ++i) {
+      if (z[i] != x[i]) {
+         std::cout << "stream is not reproducible at " << i << std::endl;
+         ret = false;
+         break;
+      }
+      if (x[i] == y[i]) ++nequal;
+   }
+   if (nequal > 0) {
+      std::cout << "streams 1 and 2 have " << nequal << " equal numbers" << std::endl;
+      ret = false;
+   }
+   ret &= testCompatibility(x,y);
+   return ret;
+}
+
 
 bool testMathRandom() {
 
@@ -181,6 +261,8 @@ bool testMathRandom() {
 
    ret &= test1(); 
    ret &= test2(); 
+   ret &= test3();
+   ret &= test4();
 
    if (!ret) Error("testMathRandom","Test Failed");
    else
@@ -0,0 +1,126 @@
+// test of the array versions of the functions of TMath and of the statistical functions
+// (Math/VecFuncMathCore.h): the results are compared with the scalar versions and the
+// accuracy and the time per value are printed as a table
+
+#include "TMath.h"
+#include "Math/VecFuncMathCore.h"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+const int N = 1000000;
+const int NLOOP = 10;
+
+bool showTable = true;
+
+// maximum relative difference, using an absolute difference for values smaller than 1
+double MaxRelDiff(const std::vector<double> & a, const std::vector<double> & b) {
+   double dmax = 0;
+   for (unsigned int i = 0; i < a.size(); ++i) {
+      double d = std::abs(a[i] - b[i]) / std::max(1., std::abs(b[i]));
+      dmax = std::max(dmax, d);
+   }
+   return dmax;
+}
+
+// compare the array version fvec with the scalar version fscal and print a line of the table
+template <class FScal, class FVec>
+int Compare(const std::string & name, const std::vector<double> & x, FScal fscal, FVec fvec, double tol) {
+   std::vector<double> rs(x.size()), rv(x.size());
+
+   auto t0 = std::chrono::high_resolution_clock::now();
+   for (int l = 0; l < NLOOP; ++l)
+      for (unsigned int i = 0; i < x.size(); ++i) rs[i] = fscal(x[i]);
+   auto t1 = std::chrono::high_resolution_clock::now();
+   for (int l = 0; l < NLOOP; ++l)
+      fvec(x.size(), x.data(), rv.data());
+   auto t2 = std::chrono::high_resolution_clock::now();
+
+   double ns = 1.E9 / (double(NLOOP) * x.size());
+   double tscal = std::chrono::duration<double>(t1 - t0).count() * ns;
+   double tvec = std::chrono::duration<double>(t2 - t1).count() * ns;
+   double diff = MaxRelDiff(rv, rs);
+   bool ok = (diff <= tol);
+
+   if (showTable) {
+      std::cout << std::left << std::setw(24) << "function" << std::setw(16) << "max rel. diff."
+                << std::setw(14) << "scalar (ns)" << std::setw(14) << "array (ns)" << std::endl;
+      showTable = false;
+   }
+   std::cout << std::left << std::setw(24) << name << std::setw(16) << std::setprecision(2) << diff
+             << std::setw(14) << std::fixed << std::setprecision(1) << tscal
+             << std::setw(14) << tvec << std::defaultfloat << (ok ? "" : "  FAILED") << std::endl;
+   return ok ? 0 : 1;
+}
+
+int testVecFuncMathCore() {
+   std::mt19937_64 gen(4357);
+   std::uniform_real_distribution<double> uwide(-20., 20.);
+   std::uniform_real_distribution<double> upos(1.E-3, 50.);
+   std::uniform_real_distribution<double> uangle(-10., 10.);
+   std::uniform_real_distribution<double> ulandau(-10., 500.);
+
+   std::vector<double> xw(N), xp(N), xa(N), ya(N), xl(N);
+   for (int i = 0; i < N; ++i) {
+      xw[i] = uwide(gen);
+      xp[i] = upos(gen);
+      xa[i] = uangle(gen);
+      ya[i] = uangle(gen);
+      xl[i] = ulandau(gen);
+   }
+
+   // VDT is accurate to a few ULP
+   const double tol = 1.E-14;
+
+   int iret = 0;
+
+   // TMath
+   iret |= Compare("TMath::Exp", xw, [](double x) { return TMath::Exp(x); },
+                   [](int n, const double * x, double * r) { TMath::Exp(n, x, r); }, tol);
+   iret |= Compare("TMath::Log", xp, [](double x) { return TMath::Log(x); },
+                   [](int n, const double * x, double * r) { TMath::Log(n, x, r); }, tol);
+   iret |= Compare("TMath::Sin", xa, [](double x) { return TMath::Sin(x); },
+                   [](int n, const double * x, double * r) { TMath::Sin(n, x, r); }, tol);
+   iret |= Compare("TMath::Cos", xa, [](double x) { return TMath::Cos(x); },
+                   [](int n, const double * x, double * r) { TMath::Cos(n, x, r); }, tol);
+   // the scalar function is called with a reference to the element of xa, giving its index in ya
+   const double * yy = ya.data();
+   iret |= Compare("TMath::ATan2", xa, [&](const double & x) { return TMath::ATan2(yy[&x - xa.data()], x); },
+                   [&](int n, const double * x, double * r) { TMath::ATan2(n, yy, x, r); }, tol);
+   iret |= Compare("TMath::Gaus", xw, [](double x) { return TMath::Gaus(x, 1., 3., true); },
+                   [](int n, const double * x, double * r) { TMath::Gaus(n, x, r, 1., 3., true); }, tol);
+
+   // statistical functions
+   iret |= Compare("gaussian_pdf", xw, [](double x) { return ROOT::Math::gaussian_pdf(x, 3., 1.); },
+                   [](int n, const double * x, double * r) { ROOT::Math::gaussian_pdf(n, x, r, 3., 1.); }, tol);
+   iret |= Compare("landau_pdf", xl, [](double x) { return ROOT::Math::landau_pdf(x, 1.5, 2.); },
+                   [](int n, const double * x, double * r) { ROOT::Math::landau_pdf(n, x, r, 1.5, 2.); }, tol);
+   iret |= Compare("exponential_pdf", xw, [](double x) { return ROOT::Math::exponential_pdf(x, 0.5, -10.); },
+                   [](int n, const double * x, double * r) { ROOT::Math::exponential_pdf(n, x, r, 0.5, -10.); }, tol);
+   iret |= Compare("lognormal_pdf", xw, [](double x) { return ROOT::Math::lognormal_pdf(x, 1., 0.5, -1.); },
+                   [](int n, const double * x, double * r) { ROOT::Math::lognormal_pdf(n, x, r, 1., 0.5, -1.); }, tol);
+   iret |= Compare("breitwigner_pdf", xw, [](double x) { return ROOT::Math::breitwigner_pdf(x, 2., 1.); },
+                   [](int n, const double * x, double * r) { ROOT::Math::breitwigner_pdf(n, x, r, 2., 1.); }, tol);
+   iret |= Compare("cauchy_pdf", xw, [](double x) { return ROOT::Math::cauchy_pdf(x, 2., 1.); },
+                   [](int n, const double * x, double * r) { ROOT::Math::cauchy_pdf(n, x, r, 2., 1.); }, tol);
+   iret |= Compare("normal_cdf", xw, [](double x) { return ROOT::Math::normal_cdf(x, 3., 1.); },
+                   [](int n, const double * x, double * r) { ROOT::Math::normal_cdf(n, x, r, 3., 1.); }, tol);
+   iret |= Compare("exponential_cdf_c", xw, [](double x) { return ROOT::Math::exponential_cdf_c(x, 0.5, -10.); },
+                   [](int n, const double * x, double * r) { ROOT::Math::exponential_cdf_c(n, x, r, 0.5, -10.); }, tol);
+
+   if (iret != 0)
+      std::cerr << "testVecFuncMathCore: FAILED" << std::endl;
+   else
+      std::cout << "testVecFuncMathCore: OK" << std::endl;
+   return iret;
+}
+
+int main() {
+   return testVecFuncMathCore();
+}
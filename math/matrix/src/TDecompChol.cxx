@@ -26,6 +26,7 @@
 
 #include "TDecompChol.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 ClassImp(TDecompChol)
 
@@ -112,32 +113,42 @@ Bool_t TDecompChol::Decompose()
       return kFALSE;
    }
 
-   Int_t i,j,icol,irow;
+   // The rows of U are computed by panels of kPanel rows. The contributions of the
+   // rows above a panel are subtracted at once with the tiled (and multi-threaded)
+   // matrix multiplication kernel, then the panel is factorized row by row.
+   // The operations on each element are done in the same order as in the
+   // unblocked algorithm, so the result does not depend on the blocking.
+   const Int_t kPanel = 64;
+
+   Int_t j,icol,irow;
    const Int_t     n  = fU.GetNrows();
          Double_t *pU = fU.GetMatrixArray();
-   for (icol = 0; icol < n; icol++) {
-      const Int_t rowOff = icol*n;
-
-      //Compute fU(j,j) and test for non-positive-definiteness.
-      Double_t ujj = pU[rowOff+icol];
-      for (irow = 0; irow < icol; irow++) {
-         const Int_t pos_ij = irow*n+icol;
-         ujj -= pU[pos_ij]*pU[pos_ij];
-      }
-      if (ujj <= 0) {
-         Error("Decompose()","matrix not positive definite");
-         return kFALSE;
-      }
-      ujj = TMath::Sqrt(ujj);
-      pU[rowOff+icol] = ujj;
-
-      if (icol < n-1) {
-         for (j = icol+1; j < n; j++) {
-            for (i = 0; i < icol; i++) {
-               const Int_t rowOff2 = i*n;
-               pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
-            }
+   for (Int_t p = 0; p < n; p += kPanel) {
+      const Int_t pe = TMath::Min(p+kPanel,n);
+
+      // U(p:pe,p:n) -= U(0:p,p:pe)^T * U(0:p,p:n)
+      TMatrixTKernels::MultAdd(pe-p,n-p,p,-1.0,pU+p,1,n,pU+p,n,pU+p*n+p,n);
+
+      for (icol = p; icol < pe; icol++) {
+         const Int_t rowOff = icol*n;
+
+         // subtract the contributions of the rows of the panel above icol
+         for (irow = p; irow < icol; irow++) {
+            const Int_t rowOff2 = irow*n;
+            const Double_t uic = pU[rowOff2+icol];
+            for (j = icol; j < n; j++)
+               pU[rowOff+j] -= uic*pU[rowOff2+j];
          }
+
+         //Compute fU(j,j) and test for non-positive-definiteness.
+         Double_t ujj = pU[rowOff+icol];
+         if (ujj <= 0) {
+            Error("Decompose()","matrix not positive definite");
+            return kFALSE;
+         }
+         ujj = TMath::Sqrt(ujj);
+         pU[rowOff+icol] = ujj;
+
          for (j = icol+1; j < n; j++)
             pU[rowOff+j] /= ujj;
       }
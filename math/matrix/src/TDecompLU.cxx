@@ -11,6 +11,7 @@
 
 #include "TDecompLU.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 ClassImp(TDecompLU)
 
@@ -595,6 +596,12 @@ TDecompLU &TDecompLU::operator=(const TDecompLU &source)
 /// and L is in multiplier form in the subdiagionals .
 /// Row permutations are mapped out in fIndex. fSign, used for calculating the
 /// determinant, is +/- 1 for even/odd row permutations. .
+///
+/// The columns are processed by panels of kPanel columns: the contributions of the
+/// columns on the left of a panel are subtracted with the tiled (and multi-threaded)
+/// matrix multiplication kernel, before the columns of the panel are computed one by one.
+/// The operations on each element are done in the same order as in the unblocked
+/// algorithm, so the result does not depend on the blocking.
 
 Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
                                    Double_t tol,Int_t &nrZeros)
@@ -624,13 +631,38 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
       scale[i] = (max == 0.0 ? 0.0 : 1.0/max);
    }
 
+   const Int_t kPanel = 64;
+
    for (Int_t j = 0; j < n; j++) {
       const Int_t off_j = j*n;
+
+      // Start of a panel [jb,je): subtract the contributions of the columns k < jb
+      const Int_t jb = j-j%kPanel;
+      if (j == jb) {
+         const Int_t je = TMath::Min(jb+kPanel,n);
+         // rows i < jb (elements of U): L(i,0:i) is applied by blocks of rows
+         for (Int_t ib = 0; ib < jb; ib += kPanel) {
+            const Int_t ie = TMath::Min(ib+kPanel,jb);
+            TMatrixTKernels::MultAdd(ie-ib,je-jb,ib,-1.0,pLU+ib*n,n,1,pLU+jb,n,pLU+ib*n+jb,n);
+            for (Int_t i = ib+1; i < ie; i++) {
+               const Int_t off_i = i*n;
+               for (Int_t k = ib; k < i; k++) {
+                  const Int_t off_k = k*n;
+                  const Double_t lik = pLU[off_i+k];
+                  for (Int_t jj = jb; jj < je; jj++)
+                     pLU[off_i+jj] -= lik*pLU[off_k+jj];
+               }
+            }
+         }
+         // rows i >= jb: LU(jb:n,jb:je) -= L(jb:n,0:jb) * U(0:jb,jb:je)
+         TMatrixTKernels::MultAdd(n-jb,je-jb,jb,-1.0,pLU+jb*n,n,1,pLU+jb,n,pLU+jb*n+jb,n);
+      }
+
       // Run down jth column from top to diag, to form the elements of U.
-      for (Int_t i = 0; i < j; i++) {
+      for (Int_t i = jb; i < j; i++) {
          const Int_t off_i = i*n;
          Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < i; k++) {
+         for (Int_t k = jb; k < i; k++) {
             const Int_t off_k = k*n;
             r -= pLU[off_i+k]*pLU[off_k+j];
          }
@@ -647,7 +679,7 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
       for (Int_t i = j; i < n; i++) {
          const Int_t off_i = i*n;
          Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < j; k++) {
+         for (Int_t k = jb; k < j; k++) {
             const Int_t off_k = k*n;
             r -= pLU[off_i+k]*pLU[off_k+j];
          }
@@ -25,6 +25,9 @@
 
 #include "TMatrixDSymEigen.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
+
+#include <vector>
 
 ClassImp(TMatrixDSymEigen)
 
@@ -67,6 +70,10 @@ TMatrixDSymEigen::TMatrixDSymEigen(const TMatrixDSymEigen &another)
 /// This is derived from the Algol procedures tred2 by Bowdler, Martin, Reinsch, and
 /// Wilkinson, Handbook for Auto. Comp., Vol.ii-Linear Algebra, and the corresponding
 /// Fortran subroutine in EISPACK.
+///
+/// The O(n^3) loops run on blocks of kBlock rows or columns, in parallel for large
+/// matrices when the implicit multi-threading is enabled. Each element is computed
+/// with the same sequence of operations as in the original column by column loops.
 
 void TMatrixDSymEigen::MakeTridiagonal(TMatrixD &v,TVectorD &d,TVectorD &e)
 {
@@ -75,6 +82,7 @@ void TMatrixDSymEigen::MakeTridiagonal(TMatrixD &v,TVectorD &d,TVectorD &e)
    Double_t *pE = e.GetMatrixArray();
 
    const Int_t n = v.GetNrows();
+   const Int_t kBlock = 64;
 
    Int_t i,j,k;
    Int_t off_n1 = (n-1)*n;
@@ -116,23 +124,31 @@ void TMatrixDSymEigen::MakeTridiagonal(TMatrixD &v,TVectorD &d,TVectorD &e)
          pE[i]   = scale*g;
          h       = h-f*g;
          pD[i-1] = f-g;
-         for (j = 0; j < i; j++)
-            pE[j] = 0.0;
 
          // Apply similarity transformation to remaining columns.
-
-         for (j = 0; j < i; j++) {
-            const Int_t off_j = j*n;
-            f = pD[j];
-            pV[off_j+i] = f;
-            g = pE[j]+pV[off_j+j]*f;
-            for (k = j+1; k <= i-1; k++) {
-               const Int_t off_k = k*n;
-               g += pV[off_k+j]*pD[k];
-               pE[k] += pV[off_k+j]*f;
+         // pE[j] is the sum of the terms of row j left of the diagonal, of the
+         // diagonal and of column j below the diagonal, added in this order.
+
+         TMatrixTKernels::ForBlocks(i,kBlock,Double_t(i)*i,[&](Int_t j0,Int_t j1) {
+            Double_t gj[kBlock];
+            for (Int_t jj = j0; jj < j1; jj++) {
+               const Int_t off_j = jj*n;
+               Double_t r = 0.0;
+               for (Int_t kk = 0; kk < jj; kk++)
+                  r += pV[off_j+kk]*pD[kk];
+               gj[jj-j0] = r+pV[off_j+jj]*pD[jj];
             }
-            pE[j] = g;
-         }
+            for (Int_t kk = j0+1; kk < i; kk++) {
+               const Int_t off_k = kk*n;
+               const Int_t jend  = TMath::Min(j1,kk);
+               for (Int_t jj = j0; jj < jend; jj++)
+                  gj[jj-j0] += pV[off_k+jj]*pD[kk];
+            }
+            for (Int_t jj = j0; jj < j1; jj++)
+               pE[jj] = gj[jj-j0];
+         });
+         for (j = 0; j < i; j++)
+            pV[j*n+i] = pD[j];
          f = 0.0;
          for (j = 0; j < i; j++) {
             pE[j] /= h;
@@ -141,13 +157,16 @@ void TMatrixDSymEigen::MakeTridiagonal(TMatrixD &v,TVectorD &d,TVectorD &e)
          Double_t hh = f/(h+h);
          for (j = 0; j < i; j++)
             pE[j] -= hh*pD[j];
-         for (j = 0; j < i; j++) {
-            f = pD[j];
-            g = pE[j];
-            for (k = j; k <= i-1; k++) {
-               const Int_t off_k = k*n;
-               pV[off_k+j] -= (f*pE[k]+g*pD[k]);
+         TMatrixTKernels::ForBlocks(i,kBlock,Double_t(i)*i/2,[&](Int_t k0,Int_t k1) {
+            for (Int_t kk = k0; kk < k1; kk++) {
+               const Int_t off_k = kk*n;
+               const Double_t ek = pE[kk];
+               const Double_t dk = pD[kk];
+               for (Int_t jj = 0; jj <= kk; jj++)
+                  pV[off_k+jj] -= (pD[jj]*ek+pE[jj]*dk);
             }
+         });
+         for (j = 0; j < i; j++) {
             pD[j] = pV[off_i1+j];
             pV[off_i+j] = 0.0;
          }
@@ -167,17 +186,23 @@ void TMatrixDSymEigen::MakeTridiagonal(TMatrixD &v,TVectorD &d,TVectorD &e)
             const Int_t off_k = k*n;
             pD[k] = pV[off_k+i+1]/h;
          }
-         for (j = 0; j <= i; j++) {
-            Double_t g = 0.0;
-            for (k = 0; k <= i; k++) {
-               const Int_t off_k = k*n;
-               g += pV[off_k+i+1]*pV[off_k+j];
+         TMatrixTKernels::ForBlocks(i+1,kBlock,2.0*(i+1)*(i+1),[&](Int_t j0,Int_t j1) {
+            Double_t g[kBlock];
+            for (Int_t jj = j0; jj < j1; jj++)
+               g[jj-j0] = 0.0;
+            for (Int_t kk = 0; kk <= i; kk++) {
+               const Int_t off_k = kk*n;
+               const Double_t vk = pV[off_k+i+1];
+               for (Int_t jj = j0; jj < j1; jj++)
+                  g[jj-j0] += vk*pV[off_k+jj];
             }
-            for (k = 0; k <= i; k++) {
-               const Int_t off_k = k*n;
-               pV[off_k+j] -= g*pD[k];
+            for (Int_t kk = 0; kk <= i; kk++) {
+               const Int_t off_k = kk*n;
+               const Double_t dk = pD[kk];
+               for (Int_t jj = j0; jj < j1; jj++)
+                  pV[off_k+jj] -= g[jj-j0]*dk;
             }
-         }
+         });
       }
       for (k = 0; k <= i; k++) {
          const Int_t off_k = k*n;
@@ -197,6 +222,10 @@ void TMatrixDSymEigen::MakeTridiagonal(TMatrixD &v,TVectorD &d,TVectorD &e)
 /// This is derived from the Algol procedures tql2, by Bowdler, Martin, Reinsch, and
 /// Wilkinson, Handbook for Auto. Comp., Vol.ii-Linear Algebra, and the corresponding
 /// Fortran subroutine in EISPACK.
+///
+/// The rotations of each QL sweep are stored and applied afterwards to the rows of
+/// the eigenvector matrix, which are independent and processed in parallel for large
+/// matrices when the implicit multi-threading is enabled.
 
 void TMatrixDSymEigen::MakeEigenVectors(TMatrixD &v,TVectorD &d,TVectorD &e)
 {
@@ -205,6 +234,12 @@ void TMatrixDSymEigen::MakeEigenVectors(TMatrixD &v,TVectorD &d,TVectorD &e)
    Double_t *pE = e.GetMatrixArray();
 
    const Int_t n = v.GetNrows();
+   const Int_t kRowBlock = 16;
+
+   // cosines and sines of the rotations of a sweep
+   std::vector<Double_t> rot(2*n);
+   Double_t * const pC = rot.data();
+   Double_t * const pS = pC+n;
 
    Int_t i,j,k,l;
    for (i = 1; i < n; i++)
@@ -276,16 +311,24 @@ void TMatrixDSymEigen::MakeEigenVectors(TMatrixD &v,TVectorD &d,TVectorD &e)
                c = p/r;
                p = c*pD[i]-s*g;
                pD[i+1] = h+s*(c*g+s*pD[i]);
+               pC[i] = c;
+               pS[i] = s;
+            }
 
-               // Accumulate transformation.
-
-               for (k = 0; k < n; k++) {
-                  const Int_t off_k = k*n;
-                  h = pV[off_k+i+1];
-                  pV[off_k+i+1] = s*pV[off_k+i]+c*h;
-                  pV[off_k+i]   = c*pV[off_k+i]-s*h;
+            // Accumulate transformation.
+
+            TMatrixTKernels::ForBlocks(n,kRowBlock,4.0*n*(m-l),[&](Int_t k0,Int_t k1) {
+               for (Int_t ii = m-1; ii >= l; ii--) {
+                  const Double_t ci = pC[ii];
+                  const Double_t si = pS[ii];
+                  for (Int_t kk = k0; kk < k1; kk++) {
+                     Double_t * const pVk = pV+kk*n;
+                     const Double_t hk = pVk[ii+1];
+                     pVk[ii+1] = si*pVk[ii]+ci*hk;
+                     pVk[ii]   = ci*pVk[ii]-si*hk;
+                  }
                }
-            }
+            });
             p = -s*s2*c3*el1*pE[l]/dl1;
             pE[l] = s*p;
             pD[l] = c*p;
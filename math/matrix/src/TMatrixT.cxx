@@ -19,6 +19,8 @@
 
 #include <iostream>
 #include <typeinfo>
+#include <algorithm>
+#include <vector>
 
 #include "TMatrixT.h"
 #include "TBuffer.h"
@@ -29,6 +31,7 @@
 #include "TMatrixDEigen.h"
 #include "TClass.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 templateClassImp(TMatrixT)
 
@@ -3072,25 +3075,20 @@ TMatrixT<Element> &ElementDiv(TMatrixT<Element> &target,const TMatrixTSym<Elemen
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B
+///
+/// The loops are tiled for the caches and run on several threads for large
+/// matrices when the implicit multi-threading is enabled (ROOT::EnableImplicitMT()).
+/// Each element is accumulated in the same order as in the plain triple loop,
+/// so the result does not depend on the number of threads.
 
 template<class Element>
 void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *arp0 = ap;                     // Pointer to  A[i,0];
-   while (arp0 < ap+na) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *arp = arp0;                       // Pointer to the i-th row of A, reset to A[i,0]
-         Element cij = 0;
-         while (bcp < bp+nb) {                     // Scan the i-th row of A and
-            cij += *arp++ * *bcp;                   // the j-th col of B
-            bcp += ncolsb;
-         }
-         *cp++ = cij;
-         bcp -= nb-1;                              // Set bcp to the (j+1)-th col
-      }
-      arp0 += ncolsa;                             // Set ap to the (i+1)-th row
-   }
+   const Int_t nrowsa = (ncolsa > 0) ? na/ncolsa : 0;
+   const Int_t nrowsb = (ncolsb > 0) ? nb/ncolsb : 0;
+   std::fill(cp,cp+nrowsa*ncolsb,Element(0));
+   TMatrixTKernels::MultAdd(nrowsa,ncolsb,nrowsb,Element(1),ap,ncolsa,1,bp,ncolsb,cp,ncolsb);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3100,21 +3098,9 @@ template<class Element>
 void AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *acp0 = ap;           // Pointer to  A[i,0];
-   while (acp0 < ap+ncolsa) {
-      for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
-         const Element *acp = acp0;                       // Pointer to the i-th column of A, reset to A[0,i]
-         Element cij = 0;
-         while (bcp < bp+nb) {           // Scan the i-th column of A and
-            cij += *acp * *bcp;           // the j-th col of B
-            acp += ncolsa;
-            bcp += ncolsb;
-         }
-         *cp++ = cij;
-         bcp -= nb-1;                    // Set bcp to the (j+1)-th col
-      }
-      acp0++;                           // Set acp0 to the (i+1)-th col
-   }
+   const Int_t nrowsb = (ncolsb > 0) ? nb/ncolsb : 0;
+   std::fill(cp,cp+ncolsa*ncolsb,Element(0));
+   TMatrixTKernels::MultAdd(ncolsa,ncolsb,nrowsb,Element(1),ap,1,ncolsa,bp,ncolsb,cp,ncolsb);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -3124,20 +3110,17 @@ template<class Element>
 void AMultBt(const Element * const ap,Int_t na,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
-   const Element *arp0 = ap;                    // Pointer to  A[i,0];
-   while (arp0 < ap+na) {
-      const Element *brp0 = bp;                  // Pointer to  B[j,0];
-      while (brp0 < bp+nb) {
-         const Element *arp = arp0;               // Pointer to the i-th row of A, reset to A[i,0]
-         const Element *brp = brp0;               // Pointer to the j-th row of B, reset to B[j,0]
-         Element cij = 0;
-         while (brp < brp0+ncolsb)                 // Scan the i-th row of A and
-            cij += *arp++ * *brp++;                 // the j-th row of B
-         *cp++ = cij;
-         brp0 += ncolsb;                           // Set brp0 to the (j+1)-th row
-      }
-      arp0 += ncolsa;                             // Set arp0 to the (i+1)-th row
-   }
+   const Int_t nrowsa = (ncolsa > 0) ? na/ncolsa : 0;
+   const Int_t nrowsb = (ncolsb > 0) ? nb/ncolsb : 0;
+
+   // B^T is copied so that the inner loop runs on contiguous elements
+   std::vector<Element> bt(nb);
+   for (Int_t irow = 0; irow < nrowsb; irow++)
+      for (Int_t icol = 0; icol < ncolsb; icol++)
+         bt[icol*nrowsb+irow] = bp[irow*ncolsb+icol];
+
+   std::fill(cp,cp+nrowsa*nrowsb,Element(0));
+   TMatrixTKernels::MultAdd(nrowsa,nrowsb,ncolsb,Element(1),ap,ncolsa,1,bt.data(),nrowsb,cp,nrowsb);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
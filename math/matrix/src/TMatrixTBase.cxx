@@ -51,6 +51,15 @@
  Since TMatrixT et al. are fully integrated in ROOT, they of course
  can be stored in a ROOT database.
 
+ The dense matrix multiplications and the LU (Crout), Cholesky and
+ symmetric eigen-value decompositions of large matrices are computed
+ by blocks fitting in the caches, and the blocks run on several threads
+ when the implicit multi-threading is enabled (ROOT::EnableImplicitMT()).
+ The results do not depend on the number of threads and are identical
+ to the ones of the unblocked algorithms. When ROOT is configured with
+ the cblas option, the matrix products are computed by the CBLAS
+ library found at configure time (e.g. OpenBLAS).
+
  For usage examples see $ROOTSYS/test/stressLinear.cxx
 
  ### Acknowledgements
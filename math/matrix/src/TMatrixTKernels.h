@@ -0,0 +1,166 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2000, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// internal header of the matrix package with the kernels shared by the heavy
+// operations (multiplication, Cholesky, LU, symmetric eigen):
+// the loops over independent blocks of rows/columns run in parallel with TBB when
+// the implicit multi-threading is enabled (ROOT::EnableImplicitMT()) and the amount
+// of work is large enough. Each block always computes the same elements with the same
+// sequence of operations, so the results do not depend on the number of threads.
+// When ROOT is configured with the cblas option (R__USE_CBLAS), the matrix products
+// are delegated to the CBLAS library found at configure time.
+
+#ifndef ROOT_TMatrixTKernels
+#define ROOT_TMatrixTKernels
+
+#include "RConfigure.h"
+#include "Rtypes.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#endif
+
+#ifdef R__USE_CBLAS
+#include <cblas.h>
+#endif
+
+namespace TMatrixTKernels {
+
+   // minimum number of multiply-adds for which a loop is split among threads
+   const Double_t kMinWork = 1.E6;
+
+   // block sizes of the tiled matrix multiplication: a tile of kIBlock x kJBlock elements
+   // of C is computed from blocks of kKBlock rows of B (256 kB for doubles), which stay
+   // in the cache while they are used for all the rows of the tile
+   const Int_t kIBlock = 16;
+   const Int_t kJBlock = 256;
+   const Int_t kKBlock = 128;
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Call f(begin,end) for the nblocks consecutive ranges of size blockSize covering [0,n).
+   /// The calls run in parallel if the implicit multi-threading is enabled and the total
+   /// amount of work (number of multiply-adds) is at least kMinWork.
+
+   template <class F>
+   void ForBlocks(Int_t n, Int_t blockSize, Double_t work, F f)
+   {
+      if (n <= 0) return;
+      const Int_t nblocks = (n + blockSize - 1) / blockSize;
+      auto evalBlock = [&](Int_t iblock) {
+         const Int_t begin = iblock * blockSize;
+         const Int_t end   = (begin + blockSize < n) ? begin + blockSize : n;
+         f(begin, end);
+      };
+#ifdef R__USE_IMT
+      if (nblocks > 1 && work >= kMinWork && ROOT::IsImplicitMTEnabled()) {
+         tbb::parallel_for(0, nblocks, evalBlock);
+         return;
+      }
+#else
+      (void) work;
+#endif
+      for (Int_t iblock = 0; iblock < nblocks; ++iblock)
+         evalBlock(iblock);
+   }
+
+#ifdef R__USE_CBLAS
+   ////////////////////////////////////////////////////////////////////////////////
+   /// C += alpha * op(A) * B with the xGEMM routines of CBLAS (row-major storage)
+
+   inline void Gemm(Bool_t transa, Int_t m, Int_t n, Int_t k, Double_t alpha, const Double_t *a, Int_t lda,
+                    const Double_t *b, Int_t ldb, Double_t *c, Int_t ldc)
+   {
+      cblas_dgemm(CblasRowMajor, transa ? CblasTrans : CblasNoTrans, CblasNoTrans, m, n, k,
+                  alpha, a, lda, b, ldb, 1.0, c, ldc);
+   }
+
+   inline void Gemm(Bool_t transa, Int_t m, Int_t n, Int_t k, Float_t alpha, const Float_t *a, Int_t lda,
+                    const Float_t *b, Int_t ldb, Float_t *c, Int_t ldc)
+   {
+      cblas_sgemm(CblasRowMajor, transa ? CblasTrans : CblasNoTrans, CblasNoTrans, m, n, k,
+                  alpha, a, lda, b, ldb, 1.0f, c, ldc);
+   }
+#endif
+
+   ////////////////////////////////////////////////////////////////////////////////
+   /// Compute C += sign * A * B, where C is m x n (row stride ldc), A is m x k with
+   /// A(i,l) = a[i*ars + l*acs] and B is k x n (row stride ldb); sign is 1 or -1.
+   /// The products are accumulated in C in increasing order of l, as in the
+   /// plain triple loop, with a vectorisable inner loop on the columns of C.
+   /// The loops are tiled and the tiles of C are computed in parallel.
+   /// With R__USE_CBLAS the product is computed by the xGEMM routine of the BLAS library.
+
+   template <class Element>
+   void MultAdd(Int_t m, Int_t n, Int_t k, Element sign,
+                const Element *a, Int_t ars, Int_t acs,
+                const Element *b, Int_t ldb, Element *c, Int_t ldc)
+   {
+      if (m <= 0 || n <= 0 || k <= 0) return;
+
+#ifdef R__USE_CBLAS
+      if (acs == 1) { Gemm(kFALSE, m, n, k, sign, a, ars, b, ldb, c, ldc); return; }
+      if (ars == 1) { Gemm(kTRUE,  m, n, k, sign, a, acs, b, ldb, c, ldc); return; }
+#endif
+
+      // C is divided in tiles of kIBlock rows and kJBlock columns, computed independently
+      const Int_t nib = (m + kIBlock - 1) / kIBlock;
+      const Int_t njb = (n + kJBlock - 1) / kJBlock;
+      auto evalTiles = [&](Int_t t0, Int_t t1) {
+         for (Int_t t = t0; t < t1; t++) {
+            const Int_t i0 = (t / njb) * kIBlock;
+            const Int_t i1 = (i0 + kIBlock < m) ? i0 + kIBlock : m;
+            const Int_t j0 = (t % njb) * kJBlock;
+            const Int_t j1 = (j0 + kJBlock < n) ? j0 + kJBlock : n;
+            for (Int_t l0 = 0; l0 < k; l0 += kKBlock) {
+               const Int_t l1 = (l0 + kKBlock < k) ? l0 + kKBlock : k;
+               Int_t i = i0;
+               // four rows of C at a time, so that each element of B is loaded once for them
+               for (; i + 4 <= i1; i += 4) {
+                  Element * const c0 = c + i * ldc;
+                  Element * const c1 = c0 + ldc;
+                  Element * const c2 = c1 + ldc;
+                  Element * const c3 = c2 + ldc;
+                  const Element * const arow = a + i * ars;
+                  for (Int_t l = l0; l < l1; l++) {
+                     const Element a0 = sign * arow[l * acs];
+                     const Element a1 = sign * arow[ars + l * acs];
+                     const Element a2 = sign * arow[2 * ars + l * acs];
+                     const Element a3 = sign * arow[3 * ars + l * acs];
+                     const Element * const brow = b + l * ldb;
+                     for (Int_t j = j0; j < j1; j++) {
+                        const Element blj = brow[j];
+                        c0[j] += a0 * blj;
+                        c1[j] += a1 * blj;
+                        c2[j] += a2 * blj;
+                        c3[j] += a3 * blj;
+                     }
+                  }
+               }
+               for (; i < i1; i++) {
+                  Element * const crow = c + i * ldc;
+                  const Element * const arow = a + i * ars;
+                  for (Int_t l = l0; l < l1; l++) {
+                     const Element ail = sign * arow[l * acs];
+                     const Element * const brow = b + l * ldb;
+                     for (Int_t j = j0; j < j1; j++)
+                        crow[j] += ail * brow[j];
+                  }
+               }
+            }
+         }
+      };
+
+      ForBlocks(nib * njb, 1, Double_t(m) * n * k, evalTiles);
+   }
+
+} // namespace TMatrixTKernels
+
+#endif
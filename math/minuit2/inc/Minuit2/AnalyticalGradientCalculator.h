@@ -11,6 +11,9 @@
 #define ROOT_Minuit2_AnalyticalGradientCalculator
 
 #include "Minuit2/GradientCalculator.h"
+#include "Minuit2/MnMatrix.h"
+
+#include <vector>
 
 namespace ROOT {
 
@@ -36,8 +39,14 @@ public:
 
   virtual bool CheckGradient() const;
 
+  /// compute the gradient and return in fval the function value, with a single call to the FCN
+  FunctionGradient ValueAndGradient(const MnAlgebraicVector& x, double& fval) const;
+
 private:
 
+  /// transform the gradient w.r.t. the external parameters in the internal one
+  FunctionGradient InternalGradient(const MnAlgebraicVector& x, const std::vector<double>& grad) const;
+
   const FCNGradientBase& fGradCalc;
   const MnUserTransformation& fTransformation;
 };
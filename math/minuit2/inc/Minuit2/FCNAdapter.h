@@ -36,10 +36,13 @@ public:
 
    FCNAdapter(const Function & f, double up = 1.) :
       fFunc(f) ,
-      fUp (up)
+      fUp (up),
+      fOwnedFunc(0)
    {}
 
-   ~FCNAdapter() {}
+   ~FCNAdapter() {
+      if (fOwnedFunc) delete fOwnedFunc;
+   }
 
 
    double operator()(const std::vector<double>& v) const {
@@ -52,14 +55,39 @@ public:
 
    void SetErrorDef(double up) { fUp = up; }
 
+   /// return an adapter using an independent clone of the wrapped function
+   /// (see ROOT::Math::IBaseFunctionMultiDim::CloneForThread), or 0 if the function does not provide one
+   FCNBase * Clone() const {
+      auto fc = fFunc.CloneForThread();
+      Function * f = dynamic_cast<Function *>(fc);
+      if (!f) {
+         delete fc;
+         return 0;
+      }
+      return new FCNAdapter(f, fUp);
+   }
+
    //virtual std::vector<double> Gradient(const std::vector<double>&) const;
 
    // forward interface
    //virtual double operator()(int npar, double* params,int iflag = 4) const;
 
 private:
+
+   // constructor taking ownership of the function (used by Clone)
+   FCNAdapter(Function * f, double up) :
+      fFunc(*f),
+      fUp(up),
+      fOwnedFunc(f)
+   {}
+
+   // copy is not allowed (the wrapped function can be owned)
+   FCNAdapter(const FCNAdapter &);
+   FCNAdapter & operator=(const FCNAdapter &);
+
    const Function & fFunc;
    double fUp;
+   Function * fOwnedFunc;  // function owned by the adapter (when created by Clone)
 };
 
    } // end namespace Minuit2
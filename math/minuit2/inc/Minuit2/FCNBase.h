@@ -113,6 +113,16 @@ public:
    */
    virtual void SetErrorDef(double ) {};
 
+   /**
+       return a copy of the function, owned by the caller, which can be evaluated
+       concurrently with the original one (e.g. by the threads computing the numerical gradient,
+       see MnStrategy::SetGradientNThreads). The copy must not share any modifiable state
+       with the original, like the parameters of a model function.
+       The default implementation returns a null pointer: the function cannot be copied and the
+       gradient is computed sequentially.
+   */
+   virtual FCNBase * Clone() const { return 0; }
+
 };
 
   }  // namespace Minuit2
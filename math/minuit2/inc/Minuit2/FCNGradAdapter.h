@@ -69,6 +69,13 @@ public:
 #endif
       return fGrad;
    }
+   double ValueAndGradient(const std::vector<double>& v, std::vector<double>& grad) const {
+      // use the combined evaluation of the function and its gradient
+      double fval = 0;
+      grad.resize(fGrad.size());
+      fFunc.FdF(&v[0], fval, &grad[0]);
+      return fval;
+   }
    // forward interface
    //virtual double operator()(int npar, double* params,int iflag = 4) const;
    bool CheckGradient() const { return false; }
@@ -37,6 +37,17 @@ public:
 
    virtual std::vector<double> Gradient(const std::vector<double>&) const = 0;
 
+   /**
+      Compute at the same time the function value, which is returned, and the Gradient.
+      The default implementation calls separately operator() and Gradient(). It can be
+      overridden when both can be computed more efficiently together (e.g. in a single
+      loop on the data of a fit).
+    */
+   virtual double ValueAndGradient(const std::vector<double>& x, std::vector<double>& grad) const {
+      grad = Gradient(x);
+      return (*this)(x);
+   }
+
    virtual bool CheckGradient() const {return true;}
 
 };
@@ -290,6 +290,12 @@ public:
    ///                     = 0 : store only first and last state to save memory
    void SetStorageLevel(int level);
 
+   /// set the number of threads used to compute the numerical gradient (default is 0 = no threads).
+   /// Each thread evaluates a copy of the objective function (see IBaseFunctionMultiDim::CloneForThread);
+   /// the gradient is computed sequentially when the function does not provide one.
+   /// It can also be set with the extra option "GradientNThreads"
+   void SetGradientNThreads(unsigned int n) { fGradNThreads = n; }
+
    /// return the minimizer state (containing values, step size , etc..)
    const ROOT::Minuit2::MnUserParameterState & State() { return fState; }
 
@@ -312,6 +318,7 @@ private:
 
    unsigned int fDim;       // dimension of the function to be minimized
    bool fUseFumili;
+   unsigned int fGradNThreads;  // number of threads used for the numerical gradient
 
    ROOT::Minuit2::MnUserParameterState fState;
    // std::vector<ROOT::Minuit2::MinosError> fMinosErrors;
@@ -42,6 +42,9 @@ public:
   virtual double operator()(const MnAlgebraicVector&) const;
   unsigned int NumOfCalls() const {return fNumCall;}
 
+  /// add to the counter the calls done on copies of the function (e.g. by other threads)
+  void AddNumOfCalls(unsigned int n) const {fNumCall += n;}
+
   //
   //forward interface
   //
@@ -54,6 +54,9 @@ public:
 
   MnParabolaPoint operator()(const MnFcn&, const MinimumParameters&, const MnAlgebraicVector&, double, const MnMachinePrecision&, bool debug = false) const;
 
+  /// line search when the function value f1 at the full step (st + step) is already known
+  MnParabolaPoint operator()(const MnFcn&, const MinimumParameters&, const MnAlgebraicVector&, double gdel, double f1, const MnMachinePrecision&, bool debug = false) const;
+
 #ifdef USE_OTHER_LS
   MnParabolaPoint CubicSearch(const MnFcn&, const MinimumParameters&, const MnAlgebraicVector&, double, double, const MnMachinePrecision&, bool debug = false) const;
 
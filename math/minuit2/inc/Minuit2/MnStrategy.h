@@ -49,6 +49,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   unsigned int GradientNThreads() const {return fGradNThreads;}
+
    bool IsLow() const {return fStrategy == 0;}
    bool IsMedium() const {return fStrategy == 1;}
    bool IsHigh() const {return fStrategy >= 2;}
@@ -69,6 +71,11 @@ public:
    // set storage level of iteration quantities
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
+
+   // set number of threads used to compute the numerical gradient
+   // (0 or 1 = sequential computation, the default)
+   // The FCN must support copies (FCNBase::Clone), each thread evaluates its own copy
+   void SetGradientNThreads(unsigned int n) { fGradNThreads = n; }
 private:
 
    unsigned int fStrategy;
@@ -81,6 +88,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   unsigned int fGradNThreads;
 };
 
   }  // namespace Minuit2
@@ -18,6 +18,10 @@
 #include "Minuit2/GradientCalculator.h"
 #endif
 
+#ifndef ROOT_Minuit2_MnMatrix
+#include "Minuit2/MnMatrix.h"
+#endif
+
 #include <vector>
 
 namespace ROOT {
@@ -31,7 +35,11 @@ class MnMachinePrecision;
 class MnStrategy;
 
 /**
-   class performing the numerical gradient calculation
+   class performing the numerical gradient calculation.
+   The derivatives with respect to the different parameters can be computed in parallel threads
+   when MnStrategy::GradientNThreads() is larger than one. In that case each thread evaluates
+   its own copy of the FCN (see FCNBase::Clone). If the FCN cannot be copied the gradient is
+   computed sequentially.
  */
 
 class Numerical2PGradientCalculator : public GradientCalculator {
@@ -69,6 +77,17 @@ public:
 
 private:
 
+  // compute the derivative for the parameter i (internal index), updating grd, g2 and gstep
+  void ParameterGradient(const MnFcn& fcn, unsigned int i, MnAlgebraicVector& x,
+                         double fcnmin, double dfmin, double vrysml,
+                         MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep) const;
+
+  // compute the derivatives of all the parameters using nthreads threads.
+  // Return false if the FCN cannot be copied for the threads
+  bool ThreadedGradient(unsigned int nthreads, const MinimumParameters& par,
+                        double dfmin, double vrysml,
+                        MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep) const;
+
   const MnFcn& fFcn;
   const MnUserTransformation& fTransformation;
   const MnStrategy& fStrategy;
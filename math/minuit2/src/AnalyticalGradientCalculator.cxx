@@ -22,16 +22,28 @@ FunctionGradient AnalyticalGradientCalculator::operator()(const MinimumParameter
    // evaluate analytical gradient. take care of parameter transformations
 
    std::vector<double> grad = fGradCalc.Gradient(fTransformation(par.Vec()));
+   return InternalGradient(par.Vec(), grad);
+}
+
+FunctionGradient AnalyticalGradientCalculator::ValueAndGradient(const MnAlgebraicVector& x, double& fval) const {
+   // evaluate at the same time the function value and the analytical gradient
+   std::vector<double> grad;
+   fval = fGradCalc.ValueAndGradient(fTransformation(x), grad);
+   return InternalGradient(x, grad);
+}
+
+FunctionGradient AnalyticalGradientCalculator::InternalGradient(const MnAlgebraicVector& x, const std::vector<double>& grad) const {
+   // take care of parameter transformations
    assert(grad.size() == fTransformation.Parameters().size());
 
-   MnAlgebraicVector v(par.Vec().size());
-   for(unsigned int i = 0; i < par.Vec().size(); i++) {
+   MnAlgebraicVector v(x.size());
+   for(unsigned int i = 0; i < x.size(); i++) {
       unsigned int ext = fTransformation.ExtOfInt(i);
       if(fTransformation.Parameter(ext).HasLimits()) {
          //double dd = (fTransformation.Parameter(ext).Upper() - fTransformation.Parameter(ext).Lower())*0.5*cos(par.Vec()(i));
          //       const ParameterTransformation * pt = fTransformation.transformation(ext);
          //       double dd = pt->dInt2ext(par.Vec()(i), fTransformation.Parameter(ext).Lower(), fTransformation.Parameter(ext).Upper() );
-         double dd = fTransformation.DInt2Ext(i, par.Vec()(i));
+         double dd = fTransformation.DInt2Ext(i, x(i));
          v(i) = dd*grad[ext];
       } else {
          v(i) = grad[ext];
@@ -82,6 +82,7 @@ void RestoreGlobalPrintLevel(int value) {
 Minuit2Minimizer::Minuit2Minimizer(ROOT::Minuit2::EMinimizerType type ) :
    Minimizer(),
    fDim(0),
+   fGradNThreads(0),
    fMinimizer(0),
    fMinuitFCN(0),
    fMinimum(0)
@@ -93,6 +94,7 @@ Minuit2Minimizer::Minuit2Minimizer(ROOT::Minuit2::EMinimizerType type ) :
 Minuit2Minimizer::Minuit2Minimizer(const char *  type ) :
    Minimizer(),
    fDim(0),
+   fGradNThreads(0),
    fMinimizer(0),
    fMinuitFCN(0),
    fMinimum(0)
@@ -456,6 +458,10 @@ bool Minuit2Minimizer::Minimize() {
       bool ret = minuit2Opt->GetValue("StorageLevel",storageLevel);
       if (ret) SetStorageLevel(storageLevel);
 
+      int nGradThreads = fGradNThreads;
+      ret = minuit2Opt->GetValue("GradientNThreads",nGradThreads);
+      if (ret && nGradThreads >= 0) SetGradientNThreads(nGradThreads);
+
       if (printLevel > 0) {
          std::cout << "Minuit2Minimizer::Minuit  - Changing default options" << std::endl;
          minuit2Opt->Print();
@@ -463,6 +469,7 @@ bool Minuit2Minimizer::Minimize() {
 
 
    }
+   strategy.SetGradientNThreads(fGradNThreads);
 
    // set a minimizer tracer object (default for printlevel=10, from gROOT for printLevel=11)
    // use some special print levels
@@ -1037,7 +1044,9 @@ bool Minuit2Minimizer::Hesse( ) {
    // set the precision if needed
    if (Precision() > 0) fState.SetPrecision(Precision());
 
-   ROOT::Minuit2::MnHesse hesse( strategy );
+   ROOT::Minuit2::MnStrategy hessStrategy( strategy );
+   hessStrategy.SetGradientNThreads(fGradNThreads);
+   ROOT::Minuit2::MnHesse hesse( hessStrategy );
 
 
    // case when function minimum exists
@@ -47,6 +47,12 @@ namespace ROOT {
 */
 
 MnParabolaPoint MnLineSearch::operator()(const MnFcn& fcn, const MinimumParameters& st, const MnAlgebraicVector& step, double gdel, const MnMachinePrecision& prec, bool debug) const {
+   // the first step is always = 1
+   return (*this)(fcn, st, step, gdel, fcn(st.Vec()+step), prec, debug);
+}
+
+MnParabolaPoint MnLineSearch::operator()(const MnFcn& fcn, const MinimumParameters& st, const MnAlgebraicVector& step, double gdel, double f1, const MnMachinePrecision& prec, bool debug) const {
+   // line search using the function value f1 at st + step, computed by the caller
 
    //*-*-*-*-*-*-*-*-*-*Perform a line search from position st along step   *-*-*-*-*-*-*-*
    //*-*                =========================================
@@ -86,7 +92,7 @@ MnParabolaPoint MnLineSearch::operator()(const MnFcn& fcn, const MinimumParamete
    slamin *= prec.Eps2();
 
    double f0 = st.Fval();
-   double f1 = fcn(st.Vec()+step);
+   // f1 = fcn(st.Vec()+step) is given
    niter++;
    double fvmin = st.Fval();
    double xvmin = 0.;
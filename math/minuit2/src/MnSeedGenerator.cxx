@@ -134,12 +134,14 @@ MinimumSeed MnSeedGenerator::operator()(const MnFcn& fcn, const AnalyticalGradie
    // initial starting values
    MnAlgebraicVector x(n);
    for(unsigned int i = 0; i < n; i++) x(i) = st.IntParameters()[i];
-   double fcnmin = fcn(x);
+   // compute the function value and the gradient with a single FCN call
+   double fcnmin = 0;
+   FunctionGradient grd = gc.ValueAndGradient(x, fcnmin);
+   fcn.AddNumOfCalls(1);
    MinimumParameters pa(x, fcnmin);
 
    InitialGradientCalculator igc(fcn, st.Trafo(), stra);
    FunctionGradient tmp = igc(pa);
-   FunctionGradient grd = gc(pa);
    FunctionGradient dgrad(grd.Grad(), tmp.G2(), tmp.Gstep());
 
    if(gc.CheckGradient()) {
@@ -15,6 +15,8 @@
 #include "Minuit2/MinimumParameters.h"
 #include "Minuit2/FunctionGradient.h"
 #include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnUserFcn.h"
+#include "Minuit2/FCNBase.h"
 
 
 //#define DEBUG
@@ -30,9 +32,18 @@
 #endif
 
 #include <math.h>
+#include <algorithm>
 
 #include "Minuit2/MPIProcess.h"
 
+// the threaded gradient needs a thread safe memory allocation and
+// it is not used when the OpenMP or MPI parallelization is enabled
+#if !defined(_OPENMP) && !defined(MPIPROC) && !defined(_MN_NO_THREAD_SAVE_)
+#define USE_GRADIENT_THREADS
+#include <thread>
+#include <memory>
+#endif
+
 namespace ROOT {
 
    namespace Minuit2 {
@@ -94,12 +105,18 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    //    std::cout << " ncycle " << Ncycle() << std::endl;
 
    unsigned int n = (par.Vec()).size();
-   unsigned int ncycle = Ncycle();
    //   MnAlgebraicVector vgrd(n), vgrd2(n), vgstp(n);
    MnAlgebraicVector grd = Gradient.Grad();
    MnAlgebraicVector g2 = Gradient.G2();
    MnAlgebraicVector gstep = Gradient.Gstep();
 
+#ifdef USE_GRADIENT_THREADS
+   // compute the derivatives of the different parameters in parallel threads if requested
+   unsigned int nthreads = std::min(Strategy().GradientNThreads(), n);
+   if (nthreads > 1 && ThreadedGradient(nthreads, par, dfmin, vrysml, grd, g2, gstep) )
+      return FunctionGradient(grd, g2, gstep);
+#endif
+
 #ifndef _OPENMP
    MPIProcess mpiproc(n,0);
 #endif
@@ -142,62 +159,7 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
       MnAlgebraicVector x = par.Vec();
 #endif
 
-      double xtf = x(i);
-      double epspri = eps2 + fabs(grd(i)*eps2);
-      double stepb4 = 0.;
-      for(unsigned int j = 0; j < ncycle; j++)  {
-         double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
-         double step = std::max(optstp, fabs(0.1*gstep(i)));
-         //       std::cout<<"step: "<<step;
-         if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
-            if(step > 0.5) step = 0.5;
-         }
-         double stpmax = 10.*fabs(gstep(i));
-         if(step > stpmax) step = stpmax;
-         //       std::cout<<" "<<step;
-         double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
-         if(step < stpmin) step = stpmin;
-         //       std::cout<<" "<<step<<std::endl;
-         //       std::cout<<"step: "<<step<<std::endl;
-         if(fabs((step-stepb4)/step) < StepTolerance()) {
-            //    std::cout<<"(step-stepb4)/step"<<std::endl;
-            //    std::cout<<"j= "<<j<<std::endl;
-            //    std::cout<<"step= "<<step<<std::endl;
-            break;
-         }
-         gstep(i) = step;
-         stepb4 = step;
-         //       MnAlgebraicVector pstep(n);
-         //       pstep(i) = step;
-         //       double fs1 = Fcn()(pstate + pstep);
-         //       double fs2 = Fcn()(pstate - pstep);
-
-         x(i) = xtf + step;
-         double fs1 = Fcn()(x);
-         x(i) = xtf - step;
-         double fs2 = Fcn()(x);
-         x(i) = xtf;
-
-         double grdb4 = grd(i);
-         grd(i) = 0.5*(fs1 - fs2)/step;
-         g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
-
-#ifdef DEBUG
-         pr = std::cout.precision(13);
-         std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
-                   << " grd " << grd(i) << " g2 " << g2(i) << std::endl;
-         std::cout.precision(pr);
-#endif
-
-         if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
-            //    std::cout<<"j= "<<j<<std::endl;
-            //    std::cout<<"step= "<<step<<std::endl;
-            //    std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
-            //    std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
-            break;
-         }
-      }
-
+      ParameterGradient(Fcn(), i, x, fcnmin, dfmin, vrysml, grd, g2, gstep);
 
 #ifdef DEBUG_MP
 #pragma omp critical
@@ -228,6 +190,129 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    return FunctionGradient(grd, g2, gstep);
 }
 
+void Numerical2PGradientCalculator::ParameterGradient(const MnFcn& fcn, unsigned int i, MnAlgebraicVector& x,
+                                                      double fcnmin, double dfmin, double vrysml,
+                                                      MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep) const {
+   // compute the derivative with respect to the parameter i using the function fcn
+   // x must contain the point where the gradient is computed, it is restored at the end
+
+   double eps2 = Precision().Eps2();
+   unsigned int ncycle = Ncycle();
+
+   double xtf = x(i);
+   double epspri = eps2 + fabs(grd(i)*eps2);
+   double stepb4 = 0.;
+   for(unsigned int j = 0; j < ncycle; j++)  {
+      double optstp = sqrt(dfmin/(fabs(g2(i))+epspri));
+      double step = std::max(optstp, fabs(0.1*gstep(i)));
+      //       std::cout<<"step: "<<step;
+      if(Trafo().Parameter(Trafo().ExtOfInt(i)).HasLimits()) {
+         if(step > 0.5) step = 0.5;
+      }
+      double stpmax = 10.*fabs(gstep(i));
+      if(step > stpmax) step = stpmax;
+      //       std::cout<<" "<<step;
+      double stpmin = std::max(vrysml, 8.*fabs(eps2*x(i)));
+      if(step < stpmin) step = stpmin;
+      //       std::cout<<" "<<step<<std::endl;
+      //       std::cout<<"step: "<<step<<std::endl;
+      if(fabs((step-stepb4)/step) < StepTolerance()) {
+         //    std::cout<<"(step-stepb4)/step"<<std::endl;
+         //    std::cout<<"j= "<<j<<std::endl;
+         //    std::cout<<"step= "<<step<<std::endl;
+         break;
+      }
+      gstep(i) = step;
+      stepb4 = step;
+      //       MnAlgebraicVector pstep(n);
+      //       pstep(i) = step;
+      //       double fs1 = Fcn()(pstate + pstep);
+      //       double fs2 = Fcn()(pstate - pstep);
+
+      x(i) = xtf + step;
+      double fs1 = fcn(x);
+      x(i) = xtf - step;
+      double fs2 = fcn(x);
+      x(i) = xtf;
+
+      double grdb4 = grd(i);
+      grd(i) = 0.5*(fs1 - fs2)/step;
+      g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
+
+#ifdef DEBUG
+      int pr = std::cout.precision(13);
+      std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
+                << " grd " << grd(i) << " g2 " << g2(i) << std::endl;
+      std::cout.precision(pr);
+#endif
+
+      if(fabs(grdb4-grd(i))/(fabs(grd(i))+dfmin/step) < GradTolerance())  {
+         //    std::cout<<"j= "<<j<<std::endl;
+         //    std::cout<<"step= "<<step<<std::endl;
+         //    std::cout<<"fs1, fs2: "<<fs1<<" "<<fs2<<std::endl;
+         //    std::cout<<"fs1-fs2: "<<fs1-fs2<<std::endl;
+         break;
+      }
+   }
+}
+
+bool Numerical2PGradientCalculator::ThreadedGradient(unsigned int nthreads, const MinimumParameters& par,
+                                                     double dfmin, double vrysml,
+                                                     MnAlgebraicVector& grd, MnAlgebraicVector& g2, MnAlgebraicVector& gstep) const {
+   // compute the derivatives of all the parameters using nthreads threads.
+   // Each thread uses its own copy of the FCN and computes the derivatives of the parameters
+   // i = ithread, ithread + nthreads, ....  The threads write different elements of the vectors.
+
+#ifdef USE_GRADIENT_THREADS
+   const MnUserFcn * userFcn = dynamic_cast<const MnUserFcn *>(&Fcn());
+
+   // create the copies of the FCN (one per thread)
+   std::vector<std::unique_ptr<FCNBase> > fcnCopies(nthreads);
+   std::vector<std::unique_ptr<MnFcn> > mnFcns(nthreads);
+   for (unsigned int ith = 0; ith < nthreads; ++ith) {
+      fcnCopies[ith].reset( Fcn().Fcn().Clone() );
+      if (!fcnCopies[ith]) {
+#ifdef WARNINGMSG
+         MN_INFO_MSG("Numerical2PGradientCalculator: the FCN cannot be copied - compute the gradient sequentially");
+#endif
+         return false;
+      }
+      if (userFcn)
+         mnFcns[ith].reset( new MnUserFcn(*fcnCopies[ith], Trafo() ) );
+      else
+         mnFcns[ith].reset( new MnFcn(*fcnCopies[ith]) );
+   }
+
+   unsigned int n = (par.Vec()).size();
+   double fcnmin = par.Fval();
+
+   auto computeGradient = [&](unsigned int ith) {
+      MnAlgebraicVector x = par.Vec();
+      for (unsigned int i = ith; i < n; i += nthreads)
+         ParameterGradient(*mnFcns[ith], i, x, fcnmin, dfmin, vrysml, grd, g2, gstep);
+   };
+
+   // the first block of parameters is computed in the calling thread
+   std::vector<std::thread> threads;
+   threads.reserve(nthreads-1);
+   for (unsigned int ith = 1; ith < nthreads; ++ith)
+      threads.push_back( std::thread(computeGradient, ith) );
+   computeGradient(0);
+   for (auto & t : threads) t.join();
+
+   // count the function calls done by the copies
+   unsigned int ncalls = 0;
+   for (unsigned int ith = 0; ith < nthreads; ++ith)
+      ncalls += mnFcns[ith]->NumOfCalls();
+   Fcn().AddNumOfCalls(ncalls);
+
+   return true;
+#else
+   (void)nthreads; (void)par; (void)dfmin; (void)vrysml; (void)grd; (void)g2; (void)gstep;
+   return false;
+#endif
+}
+
 const MnMachinePrecision& Numerical2PGradientCalculator::Precision() const {
    // return global precision (set in transformation)
    return fTransformation.Precision();
@@ -9,6 +9,7 @@
 
 #include "Minuit2/VariableMetricBuilder.h"
 #include "Minuit2/GradientCalculator.h"
+#include "Minuit2/AnalyticalGradientCalculator.h"
 #include "Minuit2/MinimumState.h"
 #include "Minuit2/MinimumError.h"
 #include "Minuit2/FunctionGradient.h"
@@ -266,6 +267,10 @@ FunctionMinimum VariableMetricBuilder::Minimum(const MnFcn& fcn, const GradientC
    MinimumState s0 = result.back();
    assert(s0.IsValid() ); 
 
+   // with an analytical gradient the function value and the gradient at the full Newton step,
+   // which is accepted by the line search in most of the iterations, are computed with one FCN call
+   const AnalyticalGradientCalculator * agc = dynamic_cast<const AnalyticalGradientCalculator *>(&gc);
+
    do {
 
       //MinimumState s0 = result.back();
@@ -317,7 +322,17 @@ FunctionMinimum VariableMetricBuilder::Minimum(const MnFcn& fcn, const GradientC
          }
       }
       
-      MnParabolaPoint pp = lsearch(fcn, s0.Parameters(), step, gdel, prec);
+      FunctionGradient g1(step.size());
+      MnParabolaPoint pp(0., 0.);
+      if (agc) {
+         double f1 = 0;
+         MnAlgebraicVector x1 = s0.Vec() + step;
+         g1 = agc->ValueAndGradient(x1, f1);
+         fcn.AddNumOfCalls(1);
+         pp = lsearch(fcn, s0.Parameters(), step, gdel, f1, prec);
+      }
+      else
+         pp = lsearch(fcn, s0.Parameters(), step, gdel, prec);
 
       // <= needed for case 0 <= 0
       if(fabs(pp.Y() - s0.Fval()) <=  fabs(s0.Fval())*prec.Eps() ) {
@@ -347,7 +362,8 @@ FunctionMinimum VariableMetricBuilder::Minimum(const MnFcn& fcn, const GradientC
       MinimumParameters p(s0.Vec() + pp.X()*step, pp.Y());
 
 
-      FunctionGradient g = gc(p, s0.Gradient());
+      // the gradient is already known when the full step has been accepted
+      FunctionGradient g = (agc && pp.X() == 1.) ? g1 : gc(p, s0.Gradient());
 
 
       edm = Estimator().Estimate(g, s0.Error());
@@ -17,6 +17,16 @@
 #include "Minuit2/MnPlot.h"
 #include "Minuit2/MinosError.h"
 #include "Minuit2/FCNBase.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnFcn.h"
+#include "Minuit2/Numerical2PGradientCalculator.h"
+#include "Minuit2/FunctionGradient.h"
+#include "Minuit2/FCNAdapter.h"
+#include "Minuit2/Minuit2Minimizer.h"
+#include "Fit/BinData.h"
+#include "Fit/Chi2FCN.h"
+#include "Math/WrappedParamFunction.h"
+#include <memory>
 #include <cmath>
 #include <iostream>
 
@@ -24,14 +34,19 @@
 // to speed up the result
 // define the environment variable OMP_NUM_THREADS to the number of desired threads
 // By default it will have thenumber of core of the machine
+// When OpenMP is not used the fit is repeated computing the gradient with threads
+// (see MnStrategy::SetGradientNThreads), and the results are compared.
+// The gradient of a ROOT::Fit::Chi2FCN is also computed with and without threads, and the chi2
+// is minimized with Minuit2Minimizer with and without gradient threads.
 // The default number of dimension is 20 (fit in 40 parameters) on 1000 data events.
-// One can change the dimension and the number of events by doing:
-// ./test_Minuit2_Parallel    ndim  nevents
+// One can change the dimension, the number of events and the number of threads by doing:
+// ./test_Minuit2_Parallel    ndim  nevents  nthreads
 
 using namespace ROOT::Minuit2;
 
 const int default_ndim = 20;
 const int default_ndata = 1000;
+const int default_nthreads = 4;
 
 
 double GaussPdf(double x, double x0, double sigma) {
@@ -67,10 +82,87 @@ struct LogLikeFCN  : public FCNBase {
       return logl;
    }
    double Up() const { return 0.5; }
+   // the copies share the (read-only) data
+   FCNBase * Clone() const { return new LogLikeFCN(fData); }
    const Data & fData;
 };
 
-int doFit(int ndim, int ndata) {
+double GaussModel(const double * x, const double * p) {
+   double tmp = (x[0]-p[1])/p[2];
+   return p[0] * std::exp(-tmp*tmp/2);
+}
+
+int testChi2Gradient(int ndata, int nthreads) {
+
+   // fill the binned data with a gaussian shape
+   std::shared_ptr<ROOT::Fit::BinData> data(new ROOT::Fit::BinData(ndata) );
+   GaussRandomGen rndm(0.,1.);
+   for (int i = 0; i < ndata; ++i) {
+      double x = -5. + 10. * (i + 0.5)/ndata;
+      double y = 100. * std::exp(-x*x/2) * (1. + 0.1 * rndm() );
+      data->Add(x, y, std::sqrt(std::fabs(y) ) + 1. );
+   }
+
+   // the FCN adapter used by Minuit2Minimizer: its copies for the gradient threads
+   // get an independent clone of the chi2 and of its model function
+   double p0[3] = {90., 0.2, 1.3};
+   std::shared_ptr<ROOT::Math::IParamMultiFunction> model(new ROOT::Math::WrappedParamFunction<>(&GaussModel, 1, 3, p0) );
+   ROOT::Fit::Chi2FCN<ROOT::Math::IMultiGenFunction> chi2(data, model);
+   FCNAdapter<ROOT::Math::IMultiGenFunction> fcn(chi2);
+   std::unique_ptr<FCNBase> fcnCopy(fcn.Clone() );
+
+   std::vector<double> par(p0, p0+3);
+   std::vector<double> err(3, 0.1);
+   MnUserParameterState state(par, err);
+   MnFcn mfcn(fcn);
+
+   MnStrategy strategy(1);
+   Numerical2PGradientCalculator gc1(mfcn, state.Trafo(), strategy);
+   FunctionGradient g1 = gc1(state.IntParameters() );
+
+   MnStrategy threadStrategy(1);
+   threadStrategy.SetGradientNThreads(nthreads);
+   Numerical2PGradientCalculator gc2(mfcn, state.Trafo(), threadStrategy);
+   FunctionGradient g2 = gc2(state.IntParameters() );
+
+   int iret = 0;
+   for (unsigned int i = 0; i < par.size(); ++i) {
+      if (g1.Grad()(i) != g2.Grad()(i) || g1.G2()(i) != g2.G2()(i) ) {
+         std::cerr << "threaded chi2 gradient differs for parameter " << i << " : " << g2.Grad()(i)
+                   << " instead of " << g1.Grad()(i) << std::endl;
+         iret = 1;
+      }
+   }
+   if (!fcnCopy) {
+      std::cerr << "the chi2 FCN adapter cannot be copied: the gradient has not been computed in threads" << std::endl;
+      iret = 1;
+   }
+
+   // full minimization through Minuit2Minimizer
+   double fval[2];
+   std::vector<double> xmin[2];
+   for (int i = 0; i < 2; ++i) {
+      ROOT::Minuit2::Minuit2Minimizer minimizer;
+      minimizer.SetFunction(chi2);
+      minimizer.SetVariable(0, "norm", p0[0], 1.);
+      minimizer.SetVariable(1, "mean", p0[1], 0.1);
+      minimizer.SetVariable(2, "sigma", p0[2], 0.1);
+      if (i == 1) minimizer.SetGradientNThreads(nthreads);
+      if (!minimizer.Minimize() ) iret = 1;
+      fval[i] = minimizer.MinValue();
+      xmin[i].assign(minimizer.X(), minimizer.X() + 3);
+   }
+   if (fval[0] != fval[1] || xmin[0] != xmin[1]) {
+      std::cerr << "Minuit2Minimizer minimum with gradient threads differs: " << fval[1]
+                << " instead of " << fval[0] << std::endl;
+      iret = 1;
+   }
+
+   std::cout << "chi2 gradient using " << nthreads << " threads: " << ((iret == 0) ? "OK" : "FAILED") << std::endl;
+   return iret;
+}
+
+int doFit(int ndim, int ndata, int nthreads) {
 
   // generate the data (1000 data points) in 100 dimension
 
@@ -116,6 +208,24 @@ int doFit(int ndim, int ndata) {
   // output
   std::cout<<"minimum: "<<min<<std::endl;
 
+  int iret = 0;
+#ifndef _OPENMP
+  // repeat the minimization computing the gradient in parallel threads
+  MnUserParameterState state(init_par, init_err);
+  MnStrategy strategy(1);
+  FunctionMinimum min1 = fMinimizer.Minimize(fcn, state, strategy);
+  strategy.SetGradientNThreads(nthreads);
+  FunctionMinimum min2 = fMinimizer.Minimize(fcn, state, strategy);
+  std::cout << "minimum using " << nthreads << " threads for the gradient: " << min2.Fval()
+            << " ncalls " << min2.NFcn() << std::endl;
+  if (min2.IsValid() != min1.IsValid() || min2.Fval() != min1.Fval() || min2.NFcn() != min1.NFcn() ) {
+     std::cerr << "threaded gradient gives a different minimum " << min2.Fval() << " instead of " << min1.Fval() << std::endl;
+     iret = 1;
+  }
+#else
+  (void) nthreads;
+#endif
+
 
 //     // create MINOS Error factory
 //     MnMinos Minos(fFCN, min);
@@ -141,7 +251,7 @@ int doFit(int ndim, int ndata) {
 //   }
 
 
-  return 0;
+  return iret;
 }
 
 int main(int argc, char **argv) {
@@ -153,6 +263,12 @@ int main(int argc, char **argv) {
    if (argc > 2) {
       ndata = atoi(argv[2] );
    }
+   int nthreads = default_nthreads;
+   if (argc > 3) {
+      nthreads = atoi(argv[3] );
+   }
    std::cout << "do fit of " << ndim << " dimensional data on " << ndata << " events " << std::endl;
-   doFit(ndim,ndata);
+   int iret = doFit(ndim,ndata,nthreads);
+   iret |= testChi2Gradient(ndata,nthreads);
+   return iret;
 }
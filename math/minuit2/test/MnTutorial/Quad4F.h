@@ -79,6 +79,29 @@ private:
 
 };
 
+// same function computing value and derivatives in a single call, which
+// counts how often the minimizer uses it
+class Quad4FValueGrad : public Quad4FGrad {
+
+public:
+
+  Quad4FValueGrad() : fNCalls(0) {}
+
+  ~Quad4FValueGrad() {}
+
+  double ValueAndGradient(const std::vector<double>& par, std::vector<double>& grad) const {
+    fNCalls++;
+    grad = Gradient(par);
+    return (*this)(par);
+  }
+
+  int NCalls() const {return fNCalls;}
+
+private:
+
+  mutable int fNCalls;
+};
+
 
   }  // namespace Minuit2
 
@@ -13,6 +13,7 @@
 #include "Minuit2/MnHesse.h"
 #include "Minuit2/MnUserParameters.h"
 #include "Minuit2/MnPrint.h"
+#include <cmath>
 // #include "TimingUtilities/PentiumTimer.h"
 
 // StackAllocator gStackAllocator;
@@ -61,6 +62,35 @@ int main() {
      hesse( gfcn, min);
      std::cout<<"minimum after hesse: "<<min<<std::endl;
   }
+  {
+     // value and derivatives computed together in every Migrad iteration
+     Quad4FGrad gfcn;
+     Quad4FValueGrad vgfcn;
+
+     MnUserParameters upar;
+     upar.Add("x", 1., 0.1);
+     upar.Add("y", 1., 0.1);
+     upar.Add("z", 1., 0.1);
+     upar.Add("w", 1., 0.1);
+
+     MnMigrad migrad1(gfcn, upar);
+     FunctionMinimum min1 = migrad1();
+     MnMigrad migrad2(vgfcn, upar);
+     FunctionMinimum min2 = migrad2();
+     std::cout<<"minimum with value and grad calculation : "<<min2<<std::endl;
+
+     // one call for the seed and at least one per iteration
+     if (!min2.IsValid() || vgfcn.NCalls() < 2) {
+        std::cout<<"ValueAndGradient not used in the iterations, calls = "<<vgfcn.NCalls()<<std::endl;
+        return 1;
+     }
+     for (unsigned int i = 0; i < upar.Params().size(); ++i) {
+        if (std::abs(min1.UserState().Value(i) - min2.UserState().Value(i)) > 1.E-6) {
+           std::cout<<"different minimum with ValueAndGradient for parameter "<<i<<std::endl;
+           return 1;
+        }
+     }
+  }
 
 //   stop = stopwatch.lap().ticks();
 //   std::cout<<"stop-start: "<<stop - start<<std::endl;
@@ -27,6 +27,10 @@
 #include <cmath>
 #include <algorithm>
 
+#ifndef ROOT_Math_SLanes
+#include "Math/SLanes.h"
+#endif
+
 namespace ROOT {
 
    namespace Math {
@@ -41,6 +45,9 @@ namespace CholeskyDecompHelpers {
    template<class F, class V> struct _solverGenDim;
    template<class F, unsigned N, class V> struct _solver;
    template<typename G> class PackedArrayAdapter;
+   // unqualified sqrt calls use std::sqrt for scalars, and the lane-wise
+   // overload (found by argument dependent lookup) for SLanes
+   using std::sqrt;
 }
 
 /// class to compute the Cholesky decomposition of a matrix
@@ -567,8 +574,8 @@ namespace CholeskyDecompHelpers {
             // keep truncation error small
             tmpdiag = src(i, i) - tmpdiag;
             // check if positive definite
-            if (tmpdiag <= F(0.0)) return false;
-            else base1[i] = std::sqrt(F(1.0) / tmpdiag);
+            if (IsAnyNonPositive(tmpdiag)) return false;
+            else base1[i] = sqrt(F(1.0) / tmpdiag);
          }
          return true;
       }
@@ -666,38 +673,38 @@ namespace CholeskyDecompHelpers {
       /// method to do the decomposition
       bool operator()(F* dst, const M& src) const
       {
-         if (src(0,0) <= F(0.0)) return false;
-         dst[0] = std::sqrt(F(1.0) / src(0,0));
+         if (IsAnyNonPositive(src(0,0))) return false;
+         dst[0] = sqrt(F(1.0) / src(0,0));
          dst[1] = src(1,0) * dst[0];
          dst[2] = src(1,1) - dst[1] * dst[1];
-         if (dst[2] <= F(0.0)) return false;
-         else dst[2] = std::sqrt(F(1.0) / dst[2]);
+         if (IsAnyNonPositive(dst[2])) return false;
+         else dst[2] = sqrt(F(1.0) / dst[2]);
          dst[3] = src(2,0) * dst[0];
          dst[4] = (src(2,1) - dst[1] * dst[3]) * dst[2];
          dst[5] = src(2,2) - (dst[3] * dst[3] + dst[4] * dst[4]);
-         if (dst[5] <= F(0.0)) return false;
-         else dst[5] = std::sqrt(F(1.0) / dst[5]);
+         if (IsAnyNonPositive(dst[5])) return false;
+         else dst[5] = sqrt(F(1.0) / dst[5]);
          dst[6] = src(3,0) * dst[0];
          dst[7] = (src(3,1) - dst[1] * dst[6]) * dst[2];
          dst[8] = (src(3,2) - dst[3] * dst[6] - dst[4] * dst[7]) * dst[5];
          dst[9] = src(3,3) - (dst[6] * dst[6] + dst[7] * dst[7] + dst[8] * dst[8]);
-         if (dst[9] <= F(0.0)) return false;
-         else dst[9] = std::sqrt(F(1.0) / dst[9]);
+         if (IsAnyNonPositive(dst[9])) return false;
+         else dst[9] = sqrt(F(1.0) / dst[9]);
          dst[10] = src(4,0) * dst[0];
          dst[11] = (src(4,1) - dst[1] * dst[10]) * dst[2];
          dst[12] = (src(4,2) - dst[3] * dst[10] - dst[4] * dst[11]) * dst[5];
          dst[13] = (src(4,3) - dst[6] * dst[10] - dst[7] * dst[11] - dst[8] * dst[12]) * dst[9];
          dst[14] = src(4,4) - (dst[10]*dst[10]+dst[11]*dst[11]+dst[12]*dst[12]+dst[13]*dst[13]);
-         if (dst[14] <= F(0.0)) return false;
-         else dst[14] = std::sqrt(F(1.0) / dst[14]);
+         if (IsAnyNonPositive(dst[14])) return false;
+         else dst[14] = sqrt(F(1.0) / dst[14]);
          dst[15] = src(5,0) * dst[0];
          dst[16] = (src(5,1) - dst[1] * dst[15]) * dst[2];
          dst[17] = (src(5,2) - dst[3] * dst[15] - dst[4] * dst[16]) * dst[5];
          dst[18] = (src(5,3) - dst[6] * dst[15] - dst[7] * dst[16] - dst[8] * dst[17]) * dst[9];
          dst[19] = (src(5,4) - dst[10] * dst[15] - dst[11] * dst[16] - dst[12] * dst[17] - dst[13] * dst[18]) * dst[14];
          dst[20] = src(5,5) - (dst[15]*dst[15]+dst[16]*dst[16]+dst[17]*dst[17]+dst[18]*dst[18]+dst[19]*dst[19]);
-         if (dst[20] <= F(0.0)) return false;
-         else dst[20] = std::sqrt(F(1.0) / dst[20]);
+         if (IsAnyNonPositive(dst[20])) return false;
+         else dst[20] = sqrt(F(1.0) / dst[20]);
          return true;
       }
    };
@@ -707,30 +714,30 @@ namespace CholeskyDecompHelpers {
       /// method to do the decomposition
       bool operator()(F* dst, const M& src) const
       {
-         if (src(0,0) <= F(0.0)) return false;
-         dst[0] = std::sqrt(F(1.0) / src(0,0));
+         if (IsAnyNonPositive(src(0,0))) return false;
+         dst[0] = sqrt(F(1.0) / src(0,0));
          dst[1] = src(1,0) * dst[0];
          dst[2] = src(1,1) - dst[1] * dst[1];
-         if (dst[2] <= F(0.0)) return false;
-         else dst[2] = std::sqrt(F(1.0) / dst[2]);
+         if (IsAnyNonPositive(dst[2])) return false;
+         else dst[2] = sqrt(F(1.0) / dst[2]);
          dst[3] = src(2,0) * dst[0];
          dst[4] = (src(2,1) - dst[1] * dst[3]) * dst[2];
          dst[5] = src(2,2) - (dst[3] * dst[3] + dst[4] * dst[4]);
-         if (dst[5] <= F(0.0)) return false;
-         else dst[5] = std::sqrt(F(1.0) / dst[5]);
+         if (IsAnyNonPositive(dst[5])) return false;
+         else dst[5] = sqrt(F(1.0) / dst[5]);
          dst[6] = src(3,0) * dst[0];
          dst[7] = (src(3,1) - dst[1] * dst[6]) * dst[2];
          dst[8] = (src(3,2) - dst[3] * dst[6] - dst[4] * dst[7]) * dst[5];
          dst[9] = src(3,3) - (dst[6] * dst[6] + dst[7] * dst[7] + dst[8] * dst[8]);
-         if (dst[9] <= F(0.0)) return false;
-         else dst[9] = std::sqrt(F(1.0) / dst[9]);
+         if (IsAnyNonPositive(dst[9])) return false;
+         else dst[9] = sqrt(F(1.0) / dst[9]);
          dst[10] = src(4,0) * dst[0];
          dst[11] = (src(4,1) - dst[1] * dst[10]) * dst[2];
          dst[12] = (src(4,2) - dst[3] * dst[10] - dst[4] * dst[11]) * dst[5];
          dst[13] = (src(4,3) - dst[6] * dst[10] - dst[7] * dst[11] - dst[8] * dst[12]) * dst[9];
          dst[14] = src(4,4) - (dst[10]*dst[10]+dst[11]*dst[11]+dst[12]*dst[12]+dst[13]*dst[13]);
-         if (dst[14] <= F(0.0)) return false;
-         else dst[14] = std::sqrt(F(1.0) / dst[14]);
+         if (IsAnyNonPositive(dst[14])) return false;
+         else dst[14] = sqrt(F(1.0) / dst[14]);
          return true;
       }
    };
@@ -740,23 +747,23 @@ namespace CholeskyDecompHelpers {
       /// method to do the decomposition
       bool operator()(F* dst, const M& src) const
       {
-         if (src(0,0) <= F(0.0)) return false;
-         dst[0] = std::sqrt(F(1.0) / src(0,0));
+         if (IsAnyNonPositive(src(0,0))) return false;
+         dst[0] = sqrt(F(1.0) / src(0,0));
          dst[1] = src(1,0) * dst[0];
          dst[2] = src(1,1) - dst[1] * dst[1];
-         if (dst[2] <= F(0.0)) return false;
-         else dst[2] = std::sqrt(F(1.0) / dst[2]);
+         if (IsAnyNonPositive(dst[2])) return false;
+         else dst[2] = sqrt(F(1.0) / dst[2]);
          dst[3] = src(2,0) * dst[0];
          dst[4] = (src(2,1) - dst[1] * dst[3]) * dst[2];
          dst[5] = src(2,2) - (dst[3] * dst[3] + dst[4] * dst[4]);
-         if (dst[5] <= F(0.0)) return false;
-         else dst[5] = std::sqrt(F(1.0) / dst[5]);
+         if (IsAnyNonPositive(dst[5])) return false;
+         else dst[5] = sqrt(F(1.0) / dst[5]);
          dst[6] = src(3,0) * dst[0];
          dst[7] = (src(3,1) - dst[1] * dst[6]) * dst[2];
          dst[8] = (src(3,2) - dst[3] * dst[6] - dst[4] * dst[7]) * dst[5];
          dst[9] = src(3,3) - (dst[6] * dst[6] + dst[7] * dst[7] + dst[8] * dst[8]);
-         if (dst[9] <= F(0.0)) return false;
-         else dst[9] = std::sqrt(F(1.0) / dst[9]);
+         if (IsAnyNonPositive(dst[9])) return false;
+         else dst[9] = sqrt(F(1.0) / dst[9]);
          return true;
       }
    };
@@ -766,17 +773,17 @@ namespace CholeskyDecompHelpers {
       /// method to do the decomposition
       bool operator()(F* dst, const M& src) const
       {
-         if (src(0,0) <= F(0.0)) return false;
-         dst[0] = std::sqrt(F(1.0) / src(0,0));
+         if (IsAnyNonPositive(src(0,0))) return false;
+         dst[0] = sqrt(F(1.0) / src(0,0));
          dst[1] = src(1,0) * dst[0];
          dst[2] = src(1,1) - dst[1] * dst[1];
-         if (dst[2] <= F(0.0)) return false;
-         else dst[2] = std::sqrt(F(1.0) / dst[2]);
+         if (IsAnyNonPositive(dst[2])) return false;
+         else dst[2] = sqrt(F(1.0) / dst[2]);
          dst[3] = src(2,0) * dst[0];
          dst[4] = (src(2,1) - dst[1] * dst[3]) * dst[2];
          dst[5] = src(2,2) - (dst[3] * dst[3] + dst[4] * dst[4]);
-         if (dst[5] <= F(0.0)) return false;
-         else dst[5] = std::sqrt(F(1.0) / dst[5]);
+         if (IsAnyNonPositive(dst[5])) return false;
+         else dst[5] = sqrt(F(1.0) / dst[5]);
          return true;
       }
    };
@@ -786,12 +793,12 @@ namespace CholeskyDecompHelpers {
       /// method to do the decomposition
       bool operator()(F* dst, const M& src) const
       {
-         if (src(0,0) <= F(0.0)) return false;
-         dst[0] = std::sqrt(F(1.0) / src(0,0));
+         if (IsAnyNonPositive(src(0,0))) return false;
+         dst[0] = sqrt(F(1.0) / src(0,0));
          dst[1] = src(1,0) * dst[0];
          dst[2] = src(1,1) - dst[1] * dst[1];
-         if (dst[2] <= F(0.0)) return false;
-         else dst[2] = std::sqrt(F(1.0) / dst[2]);
+         if (IsAnyNonPositive(dst[2])) return false;
+         else dst[2] = sqrt(F(1.0) / dst[2]);
          return true;
       }
    };
@@ -801,8 +808,8 @@ namespace CholeskyDecompHelpers {
       /// method to do the decomposition
       bool operator()(F* dst, const M& src) const
       {
-         if (src(0,0) <= F(0.0)) return false;
-         dst[0] = std::sqrt(F(1.0) / src(0,0));
+         if (IsAnyNonPositive(src(0,0))) return false;
+         dst[0] = sqrt(F(1.0) / src(0,0));
          return true;
       }
    };
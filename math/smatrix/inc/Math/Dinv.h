@@ -39,6 +39,10 @@
 #include "Math/CholeskyDecomp.h"
 #endif
 
+#ifndef ROOT_Math_SLanes
+#include "Math/SLanes.h"
+#endif
+
 #ifndef ROOT_Math_MatrixRepresentationsStatic
 #include "Math/MatrixRepresentationsStatic.h"
 #endif
@@ -191,7 +195,7 @@ public:
   template <class MatrixRep>
   static bool Dinv(MatrixRep& rhs) {
 
-    if (rhs[0] == 0.) {
+    if (IsAnyZero(rhs[0])) {
       return false;
     }
     rhs[0] = 1. / rhs[0];
@@ -219,7 +223,7 @@ public:
     typedef typename MatrixRep::value_type T;
     T det = rhs[0] * rhs[3] - rhs[2] * rhs[1];
 
-    if (det == T(0.) ) { return false; }
+    if (IsAnyZero(det)) { return false; }
 
     T s = T(1.0) / det;
 
@@ -244,7 +248,7 @@ public:
     T det = rhs[0] * rhs[2] - rhs[1] * rhs[1];
 
 
-    if (det == T(0.)) { return false; }
+    if (IsAnyZero(det)) { return false; }
 
     T s = T(1.0) / det;
     T c11 = s * rhs[2];
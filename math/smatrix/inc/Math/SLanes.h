@@ -0,0 +1,201 @@
+// @(#)root/smatrix:$Id$
+
+#ifndef ROOT_Math_SLanes
+#define ROOT_Math_SLanes
+
+/** @file
+ * header file defining the SLanes class, a small fixed-size pack of
+ * scalars which can be used as element type of SMatrix and SVector to
+ * operate on N independent matrices at the same time (e.g. for the
+ * batched Kalman filter of N tracks).
+ *
+ * Each arithmetic operation of an SMatrix<SLanes<T,N>,D1,D2> is a loop
+ * on the N lanes with a constant trip count, which the compiler maps
+ * to SIMD instructions. The same code is therefore vectorised for
+ * every matrix size (e.g. 3, 4, 5 and 6), for the multiplication, the
+ * Similarity, the Cholesky decomposition and inversion and the Cramer
+ * inversion, without any architecture specific code.
+ *
+ * The functions IsAnyZero and IsAnyNonPositive are used by the
+ * inversion routines to check for singular matrices: for SLanes the
+ * inversion fails (and returns false) when it fails for any of the
+ * lanes. The inversions using pivoting (LU or Bunch-Kaufman, i.e.
+ * SMatrix::Invert for dimensions larger than 5) are not available for
+ * SLanes: use SMatrix::InvertFast or SMatrix::InvertChol.
+ */
+
+#include <cmath>
+
+namespace ROOT {
+
+   namespace Math {
+
+template <class T, unsigned int D> class SVector;
+
+/**
+   Pack of N values of type T processed together by the SMatrix operations.
+   N must be a power of 2 (e.g. the SIMD width, 4 for double with AVX),
+   the lanes are aligned accordingly.
+
+   usage example:
+   @code
+   typedef ROOT::Math::SLanes<double,4> Lanes;
+   ROOT::Math::SMatrix<Lanes,5,5,ROOT::Math::MatRepSym<Lanes,5> > cov;
+   // fill the lanes of cov from 4 track covariance matrices
+   for (int i = 0; i < 4; ++i) ROOT::Math::SetLane(cov, i, track[i].Covariance());
+   // invert the 4 matrices at once
+   if (!cov.InvertChol()) { ... at least one matrix is not positive definite }
+   @endcode
+
+   @ingroup SMatrixGroup
+*/
+template <class T, unsigned int N>
+class SLanes {
+
+   static_assert(N > 0 && (N & (N - 1)) == 0, "the number of lanes must be a power of 2");
+
+public:
+
+   typedef T value_type;
+
+   enum { kSize = N };
+
+   /// default constructor (lanes are zero)
+   SLanes() {
+      for (unsigned int i = 0; i < N; ++i) fLanes[i] = T(0);
+   }
+
+   /// constructor broadcasting a scalar to all lanes
+   SLanes(const T & value) {
+      for (unsigned int i = 0; i < N; ++i) fLanes[i] = value;
+   }
+
+   /// constructor from an array of N values
+   explicit SLanes(const T * values) {
+      for (unsigned int i = 0; i < N; ++i) fLanes[i] = values[i];
+   }
+
+   /// access to the lane i
+   T & operator[](unsigned int i) { return fLanes[i]; }
+   const T & operator[](unsigned int i) const { return fLanes[i]; }
+
+   /// number of lanes
+   static unsigned int Size() { return N; }
+
+   SLanes & operator+=(const SLanes & rhs) {
+      for (unsigned int i = 0; i < N; ++i) fLanes[i] += rhs.fLanes[i];
+      return *this;
+   }
+   SLanes & operator-=(const SLanes & rhs) {
+      for (unsigned int i = 0; i < N; ++i) fLanes[i] -= rhs.fLanes[i];
+      return *this;
+   }
+   SLanes & operator*=(const SLanes & rhs) {
+      for (unsigned int i = 0; i < N; ++i) fLanes[i] *= rhs.fLanes[i];
+      return *this;
+   }
+   SLanes & operator/=(const SLanes & rhs) {
+      for (unsigned int i = 0; i < N; ++i) fLanes[i] /= rhs.fLanes[i];
+      return *this;
+   }
+
+   friend SLanes operator+(const SLanes & a) { return a; }
+   friend SLanes operator-(const SLanes & a) {
+      SLanes r;
+      for (unsigned int i = 0; i < N; ++i) r.fLanes[i] = -a.fLanes[i];
+      return r;
+   }
+
+   friend SLanes operator+(SLanes a, const SLanes & b) { return a += b; }
+   friend SLanes operator-(SLanes a, const SLanes & b) { return a -= b; }
+   friend SLanes operator*(SLanes a, const SLanes & b) { return a *= b; }
+   friend SLanes operator/(SLanes a, const SLanes & b) { return a /= b; }
+
+   /// lane-wise square root
+   friend SLanes sqrt(const SLanes & a) {
+      SLanes r;
+      for (unsigned int i = 0; i < N; ++i) r.fLanes[i] = std::sqrt(a.fLanes[i]);
+      return r;
+   }
+
+   /// lane-wise absolute value
+   friend SLanes abs(const SLanes & a) {
+      SLanes r;
+      for (unsigned int i = 0; i < N; ++i) r.fLanes[i] = std::abs(a.fLanes[i]);
+      return r;
+   }
+
+private:
+
+   alignas(N * sizeof(T)) T fLanes[N];
+
+};
+
+
+/**
+   return true if the value (or one of its lanes for SLanes) is zero.
+   Used by the inversion routines to detect singular matrices
+*/
+template <class T>
+inline bool IsAnyZero(const T & x) { return x == T(0); }
+
+template <class T, unsigned int N>
+inline bool IsAnyZero(const SLanes<T,N> & x) {
+   bool ret = false;
+   for (unsigned int i = 0; i < N; ++i) ret |= (x[i] == T(0));
+   return ret;
+}
+
+/**
+   return true if the value (or one of its lanes for SLanes) is negative or zero.
+   Used by the Cholesky decomposition to detect non positive-definite matrices
+*/
+template <class T>
+inline bool IsAnyNonPositive(const T & x) { return x <= T(0); }
+
+template <class T, unsigned int N>
+inline bool IsAnyNonPositive(const SLanes<T,N> & x) {
+   bool ret = false;
+   for (unsigned int i = 0; i < N; ++i) ret |= (x[i] <= T(0));
+   return ret;
+}
+
+
+/**
+   copy the matrix m in the lane i of the SLanes matrix lm.
+   The two matrices must have the same dimensions and representation
+   (e.g. SMatrix<SLanes<double,4>,5,5,MatRepSym<SLanes<double,4>,5> > and SMatrixSym5D)
+*/
+template <class LaneMatrix, class Matrix>
+inline void SetLane(LaneMatrix & lm, unsigned int i, const Matrix & m) {
+   static_assert(int(LaneMatrix::rep_type::kSize) == int(Matrix::rep_type::kSize), "the matrices must have the same size");
+   for (unsigned int k = 0; k < LaneMatrix::rep_type::kSize; ++k) lm.Array()[k][i] = m.Array()[k];
+}
+
+/**
+   copy the lane i of the SLanes matrix lm in the matrix m.
+*/
+template <class LaneMatrix, class Matrix>
+inline void GetLane(const LaneMatrix & lm, unsigned int i, Matrix & m) {
+   static_assert(int(LaneMatrix::rep_type::kSize) == int(Matrix::rep_type::kSize), "the matrices must have the same size");
+   for (unsigned int k = 0; k < LaneMatrix::rep_type::kSize; ++k) m.Array()[k] = lm.Array()[k][i];
+}
+
+/// copy the vector v in the lane i of the SLanes vector lv
+template <class T, unsigned int N, unsigned int D>
+inline void SetLane(SVector<SLanes<T,N>,D> & lv, unsigned int i, const SVector<T,D> & v) {
+   for (unsigned int k = 0; k < D; ++k) lv[k][i] = v[k];
+}
+
+/// copy the lane i of the SLanes vector lv in the vector v
+template <class T, unsigned int N, unsigned int D>
+inline void GetLane(const SVector<SLanes<T,N>,D> & lv, unsigned int i, SVector<T,D> & v) {
+   for (unsigned int k = 0; k < D; ++k) v[k] = lv[k][i];
+}
+
+
+   }  // namespace Math
+
+}  // namespace ROOT
+
+#endif /* ROOT_Math_SLanes */
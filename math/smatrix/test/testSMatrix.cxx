@@ -1,6 +1,7 @@
 #include <cmath>
 #include "Math/SVector.h"
 #include "Math/SMatrix.h"
+#include "Math/SLanes.h"
 
 #include <iostream>
 #include <vector>
@@ -1464,6 +1465,61 @@ int test25() {
 }
 
 
+int test26() {
+   // test of the SLanes mode: operations on matrices of lanes must give
+   // the same result as the operations on the matrices of each lane
+   typedef SLanes<double,4> Lanes;
+   SMatrix<double,5>  m[4];
+   SMatrix<double,5,5,MatRepSym<double,5> >  s[4];
+   SMatrix<Lanes,5> lm;
+   SMatrix<Lanes,5,5,MatRepSym<Lanes,5> > ls;
+   for (int l = 0; l < 4; ++l) {
+      for (int i = 0; i < 5; ++i) {
+         for (int j = 0; j < 5; ++j) m[l](i,j) = (i == j) ? 2. + l : 0.1 * (i + 2*j - l);
+         for (int j = 0; j <= i; ++j) s[l](i,j) = (i == j) ? 4. + l : 0.2 * (i - j + l);
+      }
+      SetLane(lm, l, m[l]);
+      SetLane(ls, l, s[l]);
+   }
+
+   SMatrix<Lanes,5> lprod = lm * lm;
+   SMatrix<Lanes,5,5,MatRepSym<Lanes,5> > lsim = Similarity(lm, ls);
+   SMatrix<Lanes,5> linv = lm;
+   SMatrix<Lanes,5,5,MatRepSym<Lanes,5> > lchol = ls;
+
+   int iret = 0;
+   iret |= compare(linv.InvertFast(), true);
+   iret |= compare(lchol.InvertChol(), true);
+
+   for (int l = 0; l < 4; ++l) {
+      SMatrix<double,5> prod = m[l] * m[l];
+      SMatrix<double,5,5,MatRepSym<double,5> > sim = Similarity(m[l], s[l]);
+      SMatrix<double,5> inv = m[l];
+      inv.InvertFast();
+      SMatrix<double,5,5,MatRepSym<double,5> > chol = s[l];
+      chol.InvertChol();
+
+      SMatrix<double,5> r;
+      SMatrix<double,5,5,MatRepSym<double,5> > rs;
+      GetLane(lprod, l, r);
+      iret |= compare(r == prod, true);
+      GetLane(lsim, l, rs);
+      iret |= compare(rs == sim, true);
+      GetLane(linv, l, r);
+      iret |= compare(r == inv, true);
+      GetLane(lchol, l, rs);
+      iret |= compare(rs == chol, true);
+   }
+
+   // inversion fails if one of the matrices is singular
+   SMatrix<double,5> zero;
+   SetLane(linv, 2, zero);
+   iret |= compare(linv.InvertFast(), false);
+
+   return iret;
+}
+
+
 #define TEST(N)                                                                 \
   itest = N;                                                                    \
   if (test##N() == 0) std::cerr << " Test " << itest << "  OK " << std::endl; \
@@ -1502,6 +1558,7 @@ int testSMatrix() {
   TEST(23);
   TEST(24);
   TEST(25);
+  TEST(26);
 
   return iret;
 }
@@ -20,6 +20,10 @@
 #include "THttpCallArg.h"
 #endif
 
+#ifndef ROOT_TRWLock
+#include "TRWLock.h"
+#endif
+
 #include <mutex>
 
 class THttpEngine;
@@ -50,9 +54,17 @@ protected:
    std::mutex   fMutex;       //! mutex to protect list with arguments
    TList        fCallArgs;    //! submitted arguments
 
+   Bool_t       fMultiThreaded; //! when true, read-only requests processed directly in engine threads
+   std::mutex   fSnifferMutex;  //! serializes access to sniffer hierarchy and its current call arg
+   TRWLock      fObjLock;       //! read lock for engine threads, write lock for main thread
+
    // Here any request can be processed
    virtual void ProcessRequest(THttpCallArg *arg);
 
+   Bool_t IsReadRequest(THttpCallArg *arg) const;
+
+   void ProcessReadRequest(THttpCallArg *arg);
+
    static Bool_t VerifyFilePath(const char *fname);
 
 public:
@@ -99,6 +111,16 @@ public:
 
    void SetTimer(Long_t milliSec = 100, Bool_t mode = kTRUE);
 
+   void SetMultiThreaded(Bool_t on = kTRUE);
+
+   Bool_t IsMultiThreaded() const { return fMultiThreaded; }
+
+   /** Lock registered objects against concurrent reading from engine threads */
+   void LockObjects() { fObjLock.WriteLock(); }
+
+   /** Release lock, acquired with LockObjects() */
+   void UnlockObjects() { fObjLock.WriteUnLock(); }
+
    /** Check if file is requested, thread safe */
    Bool_t  IsFileRequested(const char *uri, TString &res) const;
 
@@ -12,6 +12,11 @@
 #include "TList.h"
 #endif
 
+#include <mutex>
+#include <map>
+#include <deque>
+#include <string>
+
 class TFolder;
 class TMemFile;
 class TBufferFile;
@@ -128,6 +133,10 @@ protected:
    TString        fCurrentAllowedMethods;  //! list of allowed methods, extracted when analyzed object restrictions
    TList          fRestrictions;    //! list of restrictions for different locations
    TString        fAutoLoad;        //! scripts names, which are add as _autoload parameter to h.json request
+   Int_t          fJsonCacheSize;   //! maximal number of JSON results kept in the cache, 0 - no caching
+   std::mutex     fJsonCacheMutex;  //! protects JSON cache, which could be accessed from several threads
+   std::map<std::string, TString> fJsonCache; //! produced JSON, key includes hash of the object content
+   std::deque<std::string> fJsonCacheOrder;   //! keys in the order they were added to the cache
 
    void ScanObjectMembers(TRootSnifferScanRec &rec, TClass *cl, char *ptr);
 
@@ -234,6 +243,12 @@ public:
 
    Bool_t ProduceJson(const char *path, const char *options, TString &res);
 
+   Bool_t ConvertToJson(void *obj_ptr, TClass *obj_cl, TDataMember *member, Int_t compact, TString &res);
+
+   void SetJsonCacheSize(Int_t nentries = 100);
+
+   Int_t GetJsonCacheSize() const { return fJsonCacheSize; }
+
    Bool_t ProduceXml(const char *path, const char *options, TString &res);
 
    Bool_t ProduceBinary(const char *path, const char *options, void *&ptr, Long_t &length);
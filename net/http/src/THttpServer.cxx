@@ -17,6 +17,7 @@
 #include "THttpEngine.h"
 #include "TRootSniffer.h"
 #include "TRootSnifferStore.h"
+#include "TUrl.h"
 
 #include <string>
 #include <cstdlib>
@@ -99,6 +100,13 @@ public:
 // enable monitoring flag in the browser - than objects view            //
 // will be regularly updated.                                           //
 //                                                                      //
+// By default all requests are processed in the main ROOT thread.       //
+// With serv->SetMultiThreaded() read-only requests (h.json, h.xml,     //
+// get.xml, root.json, item.json, item.xml) are processed directly in   //
+// the engine threads. Requests from main thread hold write lock, which //
+// can be also acquired by analysis code with serv->LockObjects() when  //
+// registered objects are modified outside ProcessEvents() call.        //
+//                                                                      //
 // More information: http://root.cern.ch/drupal/content/users-guide     //
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
@@ -122,7 +130,10 @@ THttpServer::THttpServer(const char *engine) :
    fDefaultPageCont(),
    fDrawPage(),
    fDrawPageCont(),
-   fCallArgs()
+   fCallArgs(),
+   fMultiThreaded(kFALSE),
+   fSnifferMutex(),
+   fObjLock()
 {
    // As argument, one specifies engine kind which should be
    // created like "http:8080". One could specify several engines
@@ -378,6 +389,32 @@ void THttpServer::SetTimer(Long_t milliSec, Bool_t mode)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable processing of read-only requests in engine threads
+///
+/// Requests for objects hierarchy (h.json, h.xml, get.xml) and objects
+/// data (root.json, item.json, item.xml) do not modify any object and
+/// are processed without submitting them to the main ROOT thread.
+/// All other requests (images, commands, file access) are still processed
+/// in the main thread, holding write lock on the registered objects.
+/// If analysis code modifies registered objects outside of
+/// gSystem->ProcessEvents(), it should do this between LockObjects()
+/// and UnlockObjects() calls. Lock should not be kept when
+/// gSystem->ProcessEvents() is called. Only read-only server can
+/// process requests in parallel.
+
+void THttpServer::SetMultiThreaded(Bool_t on)
+{
+   if (on && !IsReadOnly()) {
+      Error("SetMultiThreaded", "Only read-only server can process requests in multiple threads");
+      return;
+   }
+
+   if (on) TThread::Initialize();
+
+   fMultiThreaded = on;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Checked that filename does not contains relative path below current directory
 /// Used to prevent access to files below current directory
@@ -465,6 +502,12 @@ Bool_t THttpServer::ExecuteHttp(THttpCallArg *arg)
       return kTRUE;
    }
 
+   if (fMultiThreaded && IsReadRequest(arg)) {
+      // request does not modify any object, process it in the current thread
+      ProcessReadRequest(arg);
+      return kTRUE;
+   }
+
    // add call arg to the list
    std::unique_lock<std::mutex> lk(fMutex);
    fCallArgs.Add(arg);
@@ -502,6 +545,11 @@ void THttpServer::ProcessRequests()
 
       if (arg == 0) break;
 
+      if (fMultiThreaded) {
+         fObjLock.WriteLock();
+         fSnifferMutex.lock();
+      }
+
       fSniffer->SetCurrentCallArg(arg);
 
       try {
@@ -511,6 +559,11 @@ void THttpServer::ProcessRequests()
          fSniffer->SetCurrentCallArg(0);
       }
 
+      if (fMultiThreaded) {
+         fSnifferMutex.unlock();
+         fObjLock.WriteUnLock();
+      }
+
       arg->fCond.notify_one();
    }
 
@@ -521,6 +574,80 @@ void THttpServer::ProcessRequests()
       engine->Process();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns true if request only reads objects data or objects hierarchy
+/// Such requests can be processed outside main thread, see SetMultiThreaded()
+
+Bool_t THttpServer::IsReadRequest(THttpCallArg *arg) const
+{
+   if ((strcmp(arg->GetMethod(), "GET") != 0) || !IsReadOnly()) return kFALSE;
+
+   TString filename = arg->fFileName;
+   if (filename.EndsWith(".gz")) filename.Resize(filename.Length() - 3);
+
+   return (filename == "h.json") || (filename == "h.xml") || (filename == "get.xml") ||
+          (filename == "root.json") || (filename == "item.json") || (filename == "item.xml");
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Process read-only request in the calling thread
+/// Objects are protected with read lock, sniffer is used exclusively only
+/// to locate object - most time consuming JSON conversion runs in parallel
+
+void THttpServer::ProcessReadRequest(THttpCallArg *arg)
+{
+   fObjLock.ReadLock();
+
+   TString filename = arg->fFileName;
+   Bool_t iszip = kFALSE;
+   if (filename.EndsWith(".gz")) {
+      filename.Resize(filename.Length() - 3);
+      iszip = kTRUE;
+   }
+
+   if (filename == "root.json") {
+      TClass *obj_cl(0);
+      TDataMember *member(0);
+      void *obj_ptr(0);
+
+      {
+         std::lock_guard<std::mutex> lk(fSnifferMutex);
+         fSniffer->SetCurrentCallArg(arg);
+         const char *path = arg->fPathName.Data();
+         if (*path == '/') path++;
+         if (*path != 0) obj_ptr = fSniffer->FindInHierarchy(path, &obj_cl, &member);
+         fSniffer->SetCurrentCallArg(0);
+      }
+
+      TUrl url;
+      url.SetOptions(arg->fQuery.Data());
+      url.ParseOptions();
+      Int_t compact = 0;
+      if (url.GetValueFromOptions("compact"))
+         compact = url.GetIntValueFromOptions("compact");
+
+      if ((obj_ptr == 0) || ((obj_cl == 0) && (member == 0)) ||
+          !fSniffer->ConvertToJson(obj_ptr, obj_cl, member, compact >= 0 ? compact : 0, arg->fContent)) {
+         arg->Set404();
+      } else {
+         arg->SetContentType(GetMimeType(filename.Data()));
+         if (iszip) arg->SetZipping(3);
+         arg->AddHeader("Cache-Control", "private, no-cache, no-store, must-revalidate, max-age=0, proxy-revalidate, s-maxage=0");
+      }
+   } else {
+      std::lock_guard<std::mutex> lk(fSnifferMutex);
+      fSniffer->SetCurrentCallArg(arg);
+      try {
+         ProcessRequest(arg);
+      } catch (...) {
+         arg->Set404();
+      }
+      fSniffer->SetCurrentCallArg(0);
+   }
+
+   fObjLock.ReadUnLock();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Process single http request
 /// Depending from requested path and filename different actions will be performed.
@@ -747,6 +874,9 @@ void THttpServer::ProcessRequest(THttpCallArg *arg)
 
 Bool_t THttpServer::Register(const char *subfolder, TObject *obj)
 {
+   std::unique_lock<std::mutex> lk(fSnifferMutex, std::defer_lock);
+   if (fMultiThreaded) lk.lock();
+
    return fSniffer->RegisterObject(subfolder, obj);
 }
 
@@ -757,6 +887,9 @@ Bool_t THttpServer::Register(const char *subfolder, TObject *obj)
 
 Bool_t THttpServer::Unregister(TObject *obj)
 {
+   std::unique_lock<std::mutex> lk(fSnifferMutex, std::defer_lock);
+   if (fMultiThreaded) lk.lock();
+
    return fSniffer->UnregisterObject(obj);
 }
 
@@ -767,6 +900,9 @@ Bool_t THttpServer::Unregister(TObject *obj)
 
 void THttpServer::Restrict(const char *path, const char* options)
 {
+   std::unique_lock<std::mutex> lk(fSnifferMutex, std::defer_lock);
+   if (fMultiThreaded) lk.lock();
+
    fSniffer->Restrict(path, options);
 }
 
@@ -800,6 +936,9 @@ void THttpServer::Restrict(const char *path, const char* options)
 
 Bool_t THttpServer::RegisterCommand(const char *cmdname, const char *method, const char *icon)
 {
+   std::unique_lock<std::mutex> lk(fSnifferMutex, std::defer_lock);
+   if (fMultiThreaded) lk.lock();
+
    return fSniffer->RegisterCommand(cmdname, method, icon);
 }
 
@@ -826,6 +965,9 @@ Bool_t THttpServer::SetIcon(const char *fullname, const char *iconname)
 
 Bool_t THttpServer::CreateItem(const char *fullname, const char *title)
 {
+   std::unique_lock<std::mutex> lk(fSnifferMutex, std::defer_lock);
+   if (fMultiThreaded) lk.lock();
+
    return fSniffer->CreateItem(fullname, title);
 }
 
@@ -833,6 +975,9 @@ Bool_t THttpServer::CreateItem(const char *fullname, const char *title)
 
 Bool_t THttpServer::SetItemField(const char *fullname, const char *name, const char *value)
 {
+   std::unique_lock<std::mutex> lk(fSnifferMutex, std::defer_lock);
+   if (fMultiThreaded) lk.lock();
+
    return fSniffer->SetItemField(fullname, name, value);
 }
 
@@ -840,6 +985,9 @@ Bool_t THttpServer::SetItemField(const char *fullname, const char *name, const c
 
 const char *THttpServer::GetItemField(const char *fullname, const char *name)
 {
+   std::unique_lock<std::mutex> lk(fSnifferMutex, std::defer_lock);
+   if (fMultiThreaded) lk.lock();
+
    return fSniffer->GetItemField(fullname, name);
 }
 
@@ -427,7 +427,8 @@ TRootSniffer::TRootSniffer(const char *name, const char *objpath) :
    fCurrentRestrict(0),
    fCurrentAllowedMethods(0),
    fRestrictions(),
-   fAutoLoad()
+   fAutoLoad(),
+   fJsonCacheSize(0)
 {
    fRestrictions.SetOwner(kTRUE);
 }
@@ -1149,9 +1150,78 @@ Bool_t TRootSniffer::ProduceJson(const char *path, const char *options,
    void *obj_ptr = FindInHierarchy(path, &obj_cl, &member);
    if ((obj_ptr == 0) || ((obj_cl == 0) && (member == 0))) return kFALSE;
 
-   res = TBufferJSON::ConvertToJSON(obj_ptr, obj_cl, compact >= 0 ? compact : 0, member ? member->GetName() : 0);
+   return ConvertToJson(obj_ptr, obj_cl, member, compact >= 0 ? compact : 0, res);
+}
 
-   return res.Length() > 0;
+////////////////////////////////////////////////////////////////////////////////
+/// convert object (or object member) into JSON, using TBufferJSON
+/// When JSON cache is enabled (see SetJsonCacheSize()), objects are first
+/// streamed into binary buffer, which is much faster than JSON conversion.
+/// Hash of binary data identifies current version of the object -
+/// if object was not changed since previous request, cached JSON is returned.
+/// Method does not use any sniffer state and can be called from several threads
+
+Bool_t TRootSniffer::ConvertToJson(void *obj_ptr, TClass *obj_cl, TDataMember *member, Int_t compact, TString &res)
+{
+   if ((fJsonCacheSize <= 0) || (member != 0) || (obj_cl == 0)) {
+      res = TBufferJSON::ConvertToJSON(obj_ptr, obj_cl, compact, member ? member->GetName() : 0);
+      return res.Length() > 0;
+   }
+
+   TBufferFile sbuf(TBuffer::kWrite);
+   sbuf.WriteObjectAny(obj_ptr, obj_cl);
+
+   // FNV-1a hash of object content
+   ULong64_t hash = 14695981039346656037ULL;
+   const unsigned char *data = (const unsigned char *) sbuf.Buffer();
+   for (Int_t n = 0; n < sbuf.Length(); n++) {
+      hash ^= data[n];
+      hash *= 1099511628211ULL;
+   }
+
+   std::string key = TString::Format("%s;%d;%d;%llx", obj_cl->GetName(), compact, sbuf.Length(), hash).Data();
+
+   {
+      std::lock_guard<std::mutex> lk(fJsonCacheMutex);
+      std::map<std::string, TString>::iterator it = fJsonCache.find(key);
+      if (it != fJsonCache.end()) {
+         res = it->second;
+         return res.Length() > 0;
+      }
+   }
+
+   res = TBufferJSON::ConvertToJSON(obj_ptr, obj_cl, compact);
+   if (res.Length() == 0) return kFALSE;
+
+   std::lock_guard<std::mutex> lk(fJsonCacheMutex);
+   if (fJsonCache.find(key) == fJsonCache.end()) {
+      fJsonCache[key] = res;
+      fJsonCacheOrder.push_back(key);
+      while ((Int_t) fJsonCacheOrder.size() > fJsonCacheSize) {
+         fJsonCache.erase(fJsonCacheOrder.front());
+         fJsonCacheOrder.pop_front();
+      }
+   }
+
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// configure number of entries in JSON cache
+/// Produced JSON is kept in the cache until object content changes,
+/// repeated requests for the same object do not require new conversion.
+/// 0 disables caching (default)
+
+void TRootSniffer::SetJsonCacheSize(Int_t nentries)
+{
+   std::lock_guard<std::mutex> lk(fJsonCacheMutex);
+
+   fJsonCacheSize = nentries > 0 ? nentries : 0;
+
+   while ((Int_t) fJsonCacheOrder.size() > fJsonCacheSize) {
+      fJsonCache.erase(fJsonCacheOrder.front());
+      fJsonCacheOrder.pop_front();
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -53,6 +53,8 @@ private:
    char    *fBufCompCur;  //Current position in compressed buffer
    char    *fCompPos;     //Position of fBufCur when message was compressed
    Bool_t   fEvolution;   //True if support for schema evolution required
+   char    *fPoolBuf;     //Receive buffer borrowed from the buffer pool
+   Int_t    fPoolBufSize; //Capacity of fPoolBuf
 
    static Bool_t fgEvolution;  //True if global support for schema evolution required
 
@@ -62,6 +64,11 @@ private:
 
    // used by friend TSocket
    Bool_t TestBitNumber(UInt_t bitnumber) const { return fBitsPIDs.TestBitNumber(bitnumber); }
+   void   DetachPoolBuffer() { fPoolBuf = 0; fPoolBufSize = 0; }
+   void   SetPoolBuffer(char *buf, Int_t capacity) { fPoolBuf = buf; fPoolBufSize = capacity; }
+
+   static char *AllocBuffer(Int_t size, Int_t &capacity);
+   static void  ReleaseBuffer(char *buf, Int_t capacity);
 
 protected:
    TMessage(void *buf, Int_t bufsize);   // only called by T(P)Socket::Recv()
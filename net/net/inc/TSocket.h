@@ -122,6 +122,9 @@ protected:
    Bool_t       RecvStreamerInfos(TMessage *mess);
    void         SendProcessIDs(const TMessage &mess);
    Bool_t       RecvProcessIDs(TMessage *mess);
+   TMessage    *PrepareStreamerInfos(const TMessage &mess);
+   TMessage    *PrepareProcessIDs(const TMessage &mess);
+   void         PrepareForSend(const TMessage &mess, const void *&buf, Int_t &len);
 
 private:
    TSocket&      operator=(const TSocket &);  // not implemented
@@ -26,9 +26,19 @@
 #include "TFile.h"
 #include "TProcessID.h"
 #include "RZip.h"
+#include "TVirtualMutex.h"
 
 Bool_t TMessage::fgEvolution = kFALSE;
 
+// Pool of receive buffers recycled by TMessage::AllocBuffer() and
+// TMessage::ReleaseBuffer(), to avoid a malloc/free pair per received message
+static const Int_t kMaxPoolBuffers  = 16;                // max number of pooled buffers
+static const Int_t kMaxPoolBufSize  = 4 * 1024 * 1024;   // larger buffers are not pooled
+static char       *gPoolBuf[kMaxPoolBuffers];
+static Int_t       gPoolBufSize[kMaxPoolBuffers];
+static Int_t       gPoolBufN = 0;
+static TVirtualMutex *gPoolMutex = 0;
+
 
 ClassImp(TMessage)
 
@@ -60,6 +70,8 @@ TMessage::TMessage(UInt_t what, Int_t bufsiz) :
    fCompPos    = 0;
    fInfos      = 0;
    fEvolution  = kFALSE;
+   fPoolBuf    = 0;
+   fPoolBufSize = 0;
 
    SetBit(kCannotHandleMemberWiseStreaming);
 }
@@ -81,6 +93,8 @@ TMessage::TMessage(void *buf, Int_t bufsize) : TBufferFile(TBuffer::kRead, bufsi
    fCompPos    = 0;
    fInfos      = 0;
    fEvolution  = kFALSE;
+   fPoolBuf    = 0;
+   fPoolBufSize = 0;
 
    if (fWhat & kMESS_ZIP) {
       // if buffer has kMESS_ZIP set, move it to fBufComp and uncompress
@@ -101,14 +115,79 @@ TMessage::TMessage(void *buf, Int_t bufsize) : TBufferFile(TBuffer::kRead, bufsi
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Clean up compression buffer.
+/// Clean up compression buffer. A receive buffer obtained from the buffer
+/// pool is given back to the pool instead of being deleted.
 
 TMessage::~TMessage()
 {
+   if (fPoolBuf) {
+      if (fBuffer == fPoolBuf && TestBit(kIsOwner)) {
+         fBuffer = 0;
+         ReleaseBuffer(fPoolBuf, fPoolBufSize);
+      } else if (fBufComp == fPoolBuf) {
+         fBufComp = 0;
+         ReleaseBuffer(fPoolBuf, fPoolBufSize);
+      }
+   }
    delete [] fBufComp;
    delete fInfos;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Static function returning a buffer of at least size bytes. The buffer
+/// is taken from the pool of released receive buffers when one of
+/// sufficient capacity is available, otherwise a new one is allocated.
+/// The actual capacity is returned in capacity. The buffer must be given
+/// back with ReleaseBuffer() or adopted by a TMessage via SetPoolBuffer().
+/// Used by TSocket::Recv() and friends.
+
+char *TMessage::AllocBuffer(Int_t size, Int_t &capacity)
+{
+   if (size <= kMaxPoolBufSize) {
+      R__LOCKGUARD2(gPoolMutex);
+      Int_t best = -1;
+      for (Int_t i = 0; i < gPoolBufN; i++) {
+         if (gPoolBufSize[i] >= size && (best < 0 || gPoolBufSize[i] < gPoolBufSize[best]))
+            best = i;
+      }
+      if (best >= 0) {
+         char *buf = gPoolBuf[best];
+         capacity  = gPoolBufSize[best];
+         gPoolBufN--;
+         gPoolBuf[best]     = gPoolBuf[gPoolBufN];
+         gPoolBufSize[best] = gPoolBufSize[gPoolBufN];
+         return buf;
+      }
+   }
+
+   // round up to a multiple of the initial buffer size to improve reuse
+   capacity = size;
+   if (size <= kMaxPoolBufSize)
+      capacity = ((size + kInitialSize - 1) / kInitialSize) * kInitialSize;
+   return new char[capacity];
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Static function giving back to the pool a buffer obtained with
+/// AllocBuffer(). The buffer is deleted when the pool is full or
+/// when it is too large to be kept around.
+
+void TMessage::ReleaseBuffer(char *buf, Int_t capacity)
+{
+   if (!buf) return;
+
+   if (capacity <= kMaxPoolBufSize) {
+      R__LOCKGUARD2(gPoolMutex);
+      if (gPoolBufN < kMaxPoolBuffers) {
+         gPoolBuf[gPoolBufN]     = buf;
+         gPoolBufSize[gPoolBufN] = capacity;
+         gPoolBufN++;
+         return;
+      }
+   }
+   delete [] buf;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static function enabling or disabling the automatic schema evolution.
 /// By default schema evolution support is off.
@@ -144,6 +223,8 @@ void TMessage::ForceWriteInfo(TVirtualStreamerInfo *info, Bool_t /* force */)
 void TMessage::Forward()
 {
    if (IsReading()) {
+      // the buffer may be expanded (i.e. reallocated) from now on
+      DetachPoolBuffer();
       SetWriteMode();
       SetBufferOffset(fBufSize);
       SetBit(kCannotHandleMemberWiseStreaming);
@@ -174,6 +255,7 @@ void TMessage::Reset()
    ResetMap();
 
    if (fBufComp) {
+      if (fBufComp == fPoolBuf) DetachPoolBuffer();
       delete [] fBufComp;
       fBufComp    = 0;
       fBufCompCur = 0;
@@ -232,6 +314,7 @@ void TMessage::SetCompressionAlgorithm(Int_t algorithm)
       newCompress = 100 * algorithm + level;
    }
    if (newCompress != fCompress && fBufComp) {
+      if (fBufComp == fPoolBuf) DetachPoolBuffer();
       delete [] fBufComp;
       fBufComp    = 0;
       fBufCompCur = 0;
@@ -255,6 +338,7 @@ void TMessage::SetCompressionLevel(Int_t level)
       newCompress = 100 * algorithm + level;
    }
    if (newCompress != fCompress && fBufComp) {
+      if (fBufComp == fPoolBuf) DetachPoolBuffer();
       delete [] fBufComp;
       fBufComp    = 0;
       fBufCompCur = 0;
@@ -268,6 +352,7 @@ void TMessage::SetCompressionLevel(Int_t level)
 void TMessage::SetCompressionSettings(Int_t settings)
 {
    if (settings != fCompress && fBufComp) {
+      if (fBufComp == fPoolBuf) DetachPoolBuffer();
       delete [] fBufComp;
       fBufComp    = 0;
       fBufCompCur = 0;
@@ -287,6 +372,10 @@ Int_t TMessage::Compress()
 {
    Int_t compressionLevel = GetCompressionLevel();
    Int_t compressionAlgorithm = GetCompressionAlgorithm();
+
+   // the compressed buffer may be deleted or replaced below
+   if (fBufComp && fBufComp == fPoolBuf)
+      DetachPoolBuffer();
    if (compressionLevel <= 0) {
       // no compression specified
       if (fBufComp) {
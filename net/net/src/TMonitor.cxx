@@ -19,6 +19,9 @@
 // TSocket objects and call TMonitor::Select(). Select() returns the    //
 // socket object which has data waiting. TSocket objects can be added,  //
 // removed, (temporary) enabled or disabled.                            //
+// On Linux the event loop can monitor the sockets via epoll, so that   //
+// thousands of sockets can be handled at a cost proportional to the    //
+// number of active ones (see Root.UseEpoll in system.rootrc).          //
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
@@ -189,6 +192,9 @@ void TMonitor::SetInterest(TSocket *sock, Int_t interest)
    while ((s = (TSocketHandler *) next())) {
       if (sock == s->GetSocket()) {
          s->SetInterest(interest);
+         // let the system event loop pick up the new interest
+         if (fMainLoop)
+            s->Add();
          return;
       }
    }
@@ -651,14 +651,16 @@ oncemore:
    }
    len = net2host(len);  //from network to host byte order
 
-   char *buf = new char[len+sizeof(UInt_t)];
+   Int_t bufcap;
+   char *buf = TMessage::AllocBuffer(len+sizeof(UInt_t), bufcap);
    if ((n = RecvRaw(buf+sizeof(UInt_t), len, kDefault)) <= 0) {
-      delete [] buf;
+      TMessage::ReleaseBuffer(buf, bufcap);
       mess = 0;
       return n;
    }
 
    mess = new TMessage(buf, len+sizeof(UInt_t));
+   mess->SetPoolBuffer(buf, bufcap);
 
    // receive any streamer infos
    if (RecvStreamerInfos(mess))
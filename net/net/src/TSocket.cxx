@@ -528,30 +528,35 @@ Int_t TSocket::Send(const TMessage &mess)
       return -1;
    }
 
-   // send streamer infos in case schema evolution is enabled in the TMessage
-   SendStreamerInfos(mess);
-
-   // send the process id's so TRefs work
-   SendProcessIDs(mess);
-
-   mess.SetLength();   //write length in first word of buffer
-
-   if (GetCompressionLevel() > 0 && mess.GetCompressionLevel() == 0)
-      const_cast<TMessage&>(mess).SetCompressionSettings(fCompress);
-
-   if (mess.GetCompressionLevel() > 0)
-      const_cast<TMessage&>(mess).Compress();
-
-   char *mbuf = mess.Buffer();
-   Int_t mlen = mess.Length();
-   if (mess.CompBuffer()) {
-      mbuf = mess.CompBuffer();
-      mlen = mess.CompLength();
+   // streamer infos (in case schema evolution is enabled in the TMessage) and
+   // process id's (so TRefs work) not yet sent through this socket go out as
+   // separate messages just ahead of this one, all in a single gather write
+   TMessage *messinfo = PrepareStreamerInfos(mess);
+   TMessage *messpid  = PrepareProcessIDs(mess);
+
+   const void *bufs[3];
+   Int_t       lens[3];
+   Int_t       nbuf = 0, npre = 0;
+   if (messinfo) {
+      PrepareForSend(*messinfo, bufs[nbuf], lens[nbuf]);
+      npre += lens[nbuf++];
    }
+   if (messpid) {
+      PrepareForSend(*messpid, bufs[nbuf], lens[nbuf]);
+      npre += lens[nbuf++];
+   }
+   PrepareForSend(mess, bufs[nbuf], lens[nbuf]);
+   nbuf++;
 
    ResetBit(TSocket::kBrokenConn);
    Int_t nsent;
-   if ((nsent = gSystem->SendRaw(fSocket, mbuf, mlen, 0)) <= 0) {
+   if (nbuf == 1)
+      nsent = gSystem->SendRaw(fSocket, bufs[0], lens[0], 0);
+   else
+      nsent = gSystem->SendRawv(fSocket, bufs, lens, nbuf, 0);
+   delete messinfo;
+   delete messpid;
+   if (nsent <= 0) {
       if (nsent == -5) {
          // Connection reset by peer or broken
          SetBit(TSocket::kBrokenConn);
@@ -562,6 +567,7 @@ Int_t TSocket::Send(const TMessage &mess)
 
    fBytesSent  += nsent;
    fgBytesSent += nsent;
+   nsent       -= npre;
 
    // If acknowledgement is desired, wait for it
    if (mess.What() & kMESS_ACK) {
@@ -642,12 +648,51 @@ Int_t TSocket::SendRaw(const void *buffer, Int_t length, ESendRecvOptions opt)
    return nsent;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Set the message length and, if required, compress the message. Returns
+/// in buf and len the buffer, possibly the compressed one, that has to be
+/// written to the socket.
+
+void TSocket::PrepareForSend(const TMessage &mess, const void *&buf, Int_t &len)
+{
+   mess.SetLength();   //write length in first word of buffer
+
+   if (GetCompressionLevel() > 0 && mess.GetCompressionLevel() == 0)
+      const_cast<TMessage&>(mess).SetCompressionSettings(fCompress);
+
+   if (mess.GetCompressionLevel() > 0)
+      const_cast<TMessage&>(mess).Compress();
+
+   buf = mess.Buffer();
+   len = mess.Length();
+   if (mess.CompBuffer()) {
+      buf = mess.CompBuffer();
+      len = mess.CompLength();
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Check if TStreamerInfo must be sent. The list of TStreamerInfo of classes
 /// in the object in the message is in the fInfos list of the message.
 /// We send only the TStreamerInfos not yet sent on this socket.
 
 void TSocket::SendStreamerInfos(const TMessage &mess)
+{
+   TMessage *messinfo = PrepareStreamerInfos(mess);
+   if (messinfo) {
+      if (Send(*messinfo) < 0)
+         Warning("SendStreamerInfos", "problems sending TStreamerInfo's ...");
+      delete messinfo;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the kMESS_STREAMERINFO message carrying the TStreamerInfos used by
+/// the object in mess which have not yet been sent on this socket. They are
+/// marked as sent. Returns 0 if there is nothing to send, otherwise the
+/// message, which must be deleted by the caller.
+
+TMessage *TSocket::PrepareStreamerInfos(const TMessage &mess)
 {
    if (mess.fInfos && mess.fInfos->GetEntries()) {
       TIter next(mess.fInfos);
@@ -666,15 +711,15 @@ void TSocket::SendStreamerInfos(const TMessage &mess)
          minilist->Add(info);
       }
       if (minilist) {
-         TMessage messinfo(kMESS_STREAMERINFO);
-         messinfo.WriteObject(minilist);
+         TMessage *messinfo = new TMessage(kMESS_STREAMERINFO);
+         messinfo->WriteObject(minilist);
          delete minilist;
-         if (messinfo.fInfos)
-            messinfo.fInfos->Clear();
-         if (Send(messinfo) < 0)
-            Warning("SendStreamerInfos", "problems sending TStreamerInfo's ...");
+         if (messinfo->fInfos)
+            messinfo->fInfos->Clear();
+         return messinfo;
       }
    }
+   return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -683,6 +728,22 @@ void TSocket::SendStreamerInfos(const TMessage &mess)
 /// We send only the TProcessIDs not yet send on this socket.
 
 void TSocket::SendProcessIDs(const TMessage &mess)
+{
+   TMessage *messpid = PrepareProcessIDs(mess);
+   if (messpid) {
+      if (Send(*messpid) < 0)
+         Warning("SendProcessIDs", "problems sending TProcessID's ...");
+      delete messpid;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create the kMESS_PROCESSID message carrying the TProcessIDs referenced by
+/// the object in mess which have not yet been sent on this socket. Returns 0
+/// if there is nothing to send, otherwise the message, which must be deleted
+/// by the caller.
+
+TMessage *TSocket::PrepareProcessIDs(const TMessage &mess)
 {
    if (mess.TestBitNumber(0)) {
       TObjArray *pids = TProcessID::GetPIDs();
@@ -709,13 +770,13 @@ void TSocket::SendProcessIDs(const TMessage &mess)
          minilist->Add(pid);
       }
       if (minilist) {
-         TMessage messpid(kMESS_PROCESSID);
-         messpid.WriteObject(minilist);
+         TMessage *messpid = new TMessage(kMESS_PROCESSID);
+         messpid->WriteObject(minilist);
          delete minilist;
-         if (Send(messpid) < 0)
-            Warning("SendProcessIDs", "problems sending TProcessID's ...");
+         return messpid;
       }
    }
+   return 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -840,14 +901,17 @@ oncemore:
    len = net2host(len);  //from network to host byte order
 
    ResetBit(TSocket::kBrokenConn);
-   char *buf = new char[len+sizeof(UInt_t)];
+   // the message is deserialized directly from the receive buffer, which
+   // is recycled via the TMessage buffer pool when the message is deleted
+   Int_t bufcap;
+   char *buf = TMessage::AllocBuffer(len+sizeof(UInt_t), bufcap);
    if ((n = gSystem->RecvRaw(fSocket, buf+sizeof(UInt_t), len, 0)) <= 0) {
       if (n == 0 || n == -5) {
          // Connection closed, reset or broken
          SetBit(TSocket::kBrokenConn);
          Close();
       }
-      delete [] buf;
+      TMessage::ReleaseBuffer(buf, bufcap);
       mess = 0;
       return n;
    }
@@ -856,6 +920,7 @@ oncemore:
    fgBytesRecv += n + sizeof(UInt_t);
 
    mess = new TMessage(buf, len+sizeof(UInt_t));
+   mess->SetPoolBuffer(buf, bufcap);
 
    // receive any streamer infos
    if (RecvStreamerInfos(mess))
@@ -18,6 +18,7 @@
 
 class RooRealVar;
 class RooArgList ;
+class RooFlatFunc ;
 
 namespace RooStats{
 namespace HistFactory{
@@ -43,7 +44,7 @@ namespace HistFactory{
 
     void setInterpCode(RooAbsReal& param, int code);
     void setAllInterpCodes(int code);
-    void setGlobalBoundary(double boundary) {_interpBoundary = boundary;}
+    void setGlobalBoundary(double boundary) {_interpBoundary = boundary; _logInit = kFALSE; _cacheValid = kFALSE;}
     void setNominal(Double_t newNominal);
     void setLow(RooAbsReal& param, Double_t newLow);
     void setHigh(RooAbsReal& param, Double_t newHigh);
@@ -56,9 +57,14 @@ namespace HistFactory{
     virtual void printMultiline(std::ostream& os, Int_t contents, Bool_t verbose = kFALSE, TString indent = "") const;
     virtual void printFlexibleInterpVars(std::ostream& os) const;
 
+    static Int_t translateFlat(RooFlatFunc& prog, const RooAbsReal& node);
+
   private:
 
     double PolyInterpValue(int i, double x) const;
+    void applyInterpolation(int i, double x, Double_t& total) const;
+    Bool_t isMultiplicative(int i) const { return _interpCode[i]==1 || _interpCode[i]==4 ; }
+    static Double_t flatKernel(const Double_t* x, const void* self);
 
   protected:
 
@@ -74,6 +80,10 @@ namespace HistFactory{
     mutable Bool_t         _logInit ;            //! flag used for chaching polynomial coefficients
     mutable std::vector< double>  _polCoeff;     //! cached polynomial coefficients
 
+    mutable Bool_t         _cacheValid ;         //! flag used for caching the interpolation terms
+    mutable std::vector<double> _cacheParams ;   //! parameter values of the cached terms
+    mutable std::vector<double> _cacheTerms ;    //! cached interpolation terms of the parameters
+
     Double_t evaluate() const;
 
     ClassDef(RooStats::HistFactory::FlexibleInterpVar,2) // flexible interpolation
@@ -105,6 +105,8 @@ protected:
   Int_t addParamSet( const RooArgList& params );
   static Int_t GetNumBins( const RooArgSet& vars );
   Double_t evaluate() const;
+  virtual Bool_t canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const ;
+  virtual void evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const ;
 
   ClassDef(ParamHistFunc,5) // Sum of RooAbsReal objects
 };
@@ -21,9 +21,12 @@
 #include "RooListProxy.h"
 
 #include "RooObjCacheManager.h"
+#include <vector>
 
 class RooRealVar;
 class RooArgList ;
+class RooFlatFunc ;
+class RooHistFunc ;
 
 class PiecewiseInterpolation : public RooAbsReal {
 public:
@@ -59,6 +62,8 @@ public:
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const ; 
   virtual Bool_t isBinnedDistribution(const RooArgSet& obs) const ;
 
+  static Int_t translateFlat(RooFlatFunc& prog, const RooAbsReal& node) ;
+
 protected:
 
   class CacheElem : public RooAbsCacheElement {
@@ -88,7 +93,26 @@ protected:
 
   std::vector<int> _interpCode;
 
+  // Incremental evaluation: interpolation terms of the parameters in each bin of a histogram nominal
+  mutable Int_t _cacheStatus ;                  //! -1: not initialized, 0: disabled, 1: enabled
+  mutable std::vector<Double_t> _cacheParams ;  //! Parameter values of the cached terms, per bin
+  mutable std::vector<Double_t> _cacheTerms ;   //! Cached interpolation terms, per bin
+  mutable std::vector<Double_t> _cacheNominal ; //! Nominal values, per bin
+  mutable std::vector<Bool_t> _cacheFilled ;    //! Terms of the bin have been calculated
+  mutable ULong64_t _cacheVersion ;             //! Sum of the content versions of the histograms of the cached terms
+
   Double_t evaluate() const;
+  Double_t evaluateBin(Int_t bin, const Double_t* const* inputs=0, Int_t event=0) const;
+  virtual Bool_t canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const ;
+  virtual void evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const ;
+  void initCache() const;
+  void checkCache() const;
+  ULong64_t histContentVersion() const;
+  void clearCache() ;
+  static Bool_t sameBinning(const RooHistFunc& h1, const RooHistFunc& h2) ;
+  virtual Bool_t redirectServersHook(const RooAbsCollection& newServerList, Bool_t mustReplaceAll, Bool_t nameChange, Bool_t isRecursive) ;
+  Double_t positiveSum(Double_t sum) const;
+  static Double_t flatKernel(const Double_t* x, const void* self);
 
   ClassDef(PiecewiseInterpolation,3) // Sum of RooAbsReal objects
 };
@@ -30,6 +30,7 @@ END_HTML
 #include "RooArgList.h"
 #include "RooMsgService.h"
 #include "RooTrace.h"
+#include "RooFlatFunc.h"
 
 #include "TMath.h"
 
@@ -51,6 +52,7 @@ FlexibleInterpVar::FlexibleInterpVar()
   _nominal = 0;
   _interpBoundary=1.;
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
   TRACE_CREATE
 }
 
@@ -65,6 +67,7 @@ FlexibleInterpVar::FlexibleInterpVar(const char* name, const char* title,
   _nominal(nominal), _low(low), _high(high), _interpBoundary(1.)
 {
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
   _paramIter = _paramList.createIterator() ;
 
 
@@ -112,6 +115,7 @@ FlexibleInterpVar::FlexibleInterpVar(const char* name, const char* title,
   
   
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
   _paramIter = _paramList.createIterator() ;
 
 
@@ -151,6 +155,7 @@ FlexibleInterpVar::FlexibleInterpVar(const char* name, const char* title,
   _nominal(nominal), _low(low), _high(high), _interpCode(code), _interpBoundary(1.)
 {
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
   _paramIter = _paramList.createIterator() ;
 
 
@@ -185,6 +190,7 @@ FlexibleInterpVar::FlexibleInterpVar(const char* name, const char* title) :
   _nominal(0), _interpBoundary(1.)
 {
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
   _paramIter = _paramList.createIterator() ;
   TRACE_CREATE
 }
@@ -199,6 +205,7 @@ FlexibleInterpVar::FlexibleInterpVar(const FlexibleInterpVar& other, const char*
 {
   // Copy constructor
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
   _paramIter = _paramList.createIterator() ;
   TRACE_CREATE
   
@@ -229,6 +236,7 @@ void FlexibleInterpVar::setInterpCode(RooAbsReal& param, int code){
   }
   // GHL: Adding suggestion by Swagato:
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
   setValueDirty();
 }
 
@@ -240,6 +248,7 @@ void FlexibleInterpVar::setAllInterpCodes(int code){
   }
   // GHL: Adding suggestion by Swagato:
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
   setValueDirty();
 
 }
@@ -251,6 +260,7 @@ void FlexibleInterpVar::setNominal(Double_t newNominal){
   _nominal = newNominal;
 
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
 
   setValueDirty();
 }
@@ -269,6 +279,7 @@ void FlexibleInterpVar::setLow(RooAbsReal& param, Double_t newLow){
   }
 
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
 
   setValueDirty();
 }
@@ -287,6 +298,7 @@ void FlexibleInterpVar::setHigh(RooAbsReal& param, Double_t newHigh){
   }
 
   _logInit = kFALSE ;
+  _cacheValid = kFALSE ;
   setValueDirty();
 }
 
@@ -386,6 +398,17 @@ double FlexibleInterpVar::PolyInterpValue(int i, double x) const {
 
 Double_t FlexibleInterpVar::evaluate() const 
 {
+  // The interpolation terms of the parameters are cached and only the terms of
+  // the parameters whose values changed since the last call are recalculated.
+  // The terms are applied in the order of the parameters as before, so that the
+  // result does not depend on the caching
+  const int n = _paramList.getSize() ;
+  if (int(_cacheTerms.size())!=n) {
+    _cacheParams.resize(n) ;
+    _cacheTerms.resize(n) ;
+    _cacheValid = kFALSE ;
+  }
+
   Double_t total(_nominal) ;
   _paramIter->Reset() ;
 
@@ -393,88 +416,124 @@ Double_t FlexibleInterpVar::evaluate() const
   //const RooArgSet* nset = _paramList.nset() ;
   int i=0;
 
-  // TString name = GetName();
-  // if (name == TString("ZHWW_ll12_vzll_epsilon") )
-  //    //    std::cout << "evaluate flexible interp var - init flag is " << _logInit << std::endl;
-
   while((param=(RooAbsReal*)_paramIter->Next())) {
-    //    param->Print("v");
+    double x = param->getVal() ;
+    if (!_cacheValid || x!=_cacheParams[i]) {
+      Double_t term = isMultiplicative(i) ? 1 : 0 ;
+      applyInterpolation(i, x, term) ;
+      _cacheParams[i] = x ;
+      _cacheTerms[i] = term ;
+    }
+    if (isMultiplicative(i)) {
+      total *= _cacheTerms[i] ;
+    } else {
+      total += _cacheTerms[i] ;
+    }
+    ++i;
+  }
+  _cacheValid = kTRUE ;
 
+  if(total<=0) {
+     total= TMath::Limits<double>::Min();
+  }    
 
-    Int_t icode = _interpCode[i] ;
+  return total;
+}
 
-    switch(icode) {
 
-    case 0: {
-      // piece-wise linear
-      if(param->getVal()>0)
-	total +=  param->getVal()*(_high[i] - _nominal );
-      else
-	total += param->getVal()*(_nominal - _low[i]);
-      break ;
-    }
-    case 1: {
-      // pice-wise log
-      if(param->getVal()>=0)
-	total *= pow(_high[i]/_nominal, +param->getVal());
-      else
-	total *= pow(_low[i]/_nominal,  -param->getVal());
-      break ;
-    }
-    case 2: {
-      // parabolic with linear
-      double a = 0.5*(_high[i]+_low[i])-_nominal;
-      double b = 0.5*(_high[i]-_low[i]);
-      double c = 0;
-      if(param->getVal()>1 ){
-	total += (2*a+b)*(param->getVal()-1)+_high[i]-_nominal;
-      } else if(param->getVal()<-1 ) {
-	total += -1*(2*a-b)*(param->getVal()+1)+_low[i]-_nominal;
-      } else {
-	total +=  a*pow(param->getVal(),2) + b*param->getVal()+c;
-      }
-      break ;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Apply the interpolation of the i-th parameter, with value x, to the total
+
+void FlexibleInterpVar::applyInterpolation(int i, double x, Double_t& total) const
+{
+  Int_t icode = _interpCode[i] ;
+
+  switch(icode) {
+
+  case 0: {
+    // piece-wise linear
+    if(x>0)
+	total +=  x*(_high[i] - _nominal );
+    else
+	total += x*(_nominal - _low[i]);
+    break ;
+  }
+  case 1: {
+    // pice-wise log
+    if(x>=0)
+	total *= pow(_high[i]/_nominal, +x);
+    else
+	total *= pow(_low[i]/_nominal,  -x);
+    break ;
+  }
+  case 2: {
+    // parabolic with linear
+    double a = 0.5*(_high[i]+_low[i])-_nominal;
+    double b = 0.5*(_high[i]-_low[i]);
+    double c = 0;
+    if(x>1 ){
+	total += (2*a+b)*(x-1)+_high[i]-_nominal;
+    } else if(x<-1 ) {
+	total += -1*(2*a-b)*(x+1)+_low[i]-_nominal;
+    } else {
+	total +=  a*pow(x,2) + b*x+c;
     }
-    case 3: {
-      //parabolic version of log-normal
-      double a = 0.5*(_high[i]+_low[i])-_nominal;
-      double b = 0.5*(_high[i]-_low[i]);
-      double c = 0;
-      if(param->getVal()>1 ){
-	total += (2*a+b)*(param->getVal()-1)+_high[i]-_nominal;
-      } else if(param->getVal()<-1 ) {
-	total += -1*(2*a-b)*(param->getVal()+1)+_low[i]-_nominal;
-      } else {
-	total +=  a*pow(param->getVal(),2) + b*param->getVal()+c;
-      }
-      break ;
+    break ;
+  }
+  case 3: {
+    //parabolic version of log-normal
+    double a = 0.5*(_high[i]+_low[i])-_nominal;
+    double b = 0.5*(_high[i]-_low[i]);
+    double c = 0;
+    if(x>1 ){
+	total += (2*a+b)*(x-1)+_high[i]-_nominal;
+    } else if(x<-1 ) {
+	total += -1*(2*a-b)*(x+1)+_low[i]-_nominal;
+    } else {
+	total +=  a*pow(x,2) + b*x+c;
     }
+    break ;
+  }
 
-    case 4: {
-      double boundary = _interpBoundary;
-      double x = param->getVal(); 
-      //std::cout << icode << " param " << param->GetName() << "  " << param->getVal() << " boundary " << boundary << std::endl;
+  case 4: {
+    double boundary = _interpBoundary;
+    //std::cout << icode << " param " << _paramList.at(i)->GetName() << "  " << x << " boundary " << boundary << std::endl;
 
-      if(x >= boundary)
-      {
-         total *= std::pow(_high[i]/_nominal, +param->getVal());
-      }
-      else if (x <= -boundary)
-      {
-         total *= std::pow(_low[i]/_nominal, -param->getVal());
-      }
-      else if (x != 0)
-      {
-         total *= PolyInterpValue(i, x);
-      }
-      break ;
+    if(x >= boundary)
+    {
+       total *= std::pow(_high[i]/_nominal, +x);
     }
-    default: {
-      coutE(InputArguments) << "FlexibleInterpVar::evaluate ERROR:  " << param->GetName() 
-			    << " with unknown interpolation code" << endl ;
+    else if (x <= -boundary)
+    {
+       total *= std::pow(_low[i]/_nominal, -x);
     }
+    else if (x != 0)
+    {
+       total *= PolyInterpValue(i, x);
     }
-    ++i;
+    break ;
+  }
+  default: {
+    coutE(InputArguments) << "FlexibleInterpVar::evaluate ERROR:  " << _paramList.at(i)->GetName() 
+			    << " with unknown interpolation code" << endl ;
+  }
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Kernel of the flattened evaluation program: value of the FlexibleInterpVar
+/// 'self' for the parameter values x
+
+Double_t FlexibleInterpVar::flatKernel(const Double_t* x, const void* self)
+{
+  const FlexibleInterpVar* var = static_cast<const FlexibleInterpVar*>(self) ;
+  Double_t total(var->_nominal) ;
+  const int n = var->_paramList.getSize() ;
+  for (int i=0 ; i<n ; i++) {
+    var->applyInterpolation(i, x[i], total) ;
   }
 
   if(total<=0) {
@@ -484,6 +543,28 @@ Double_t FlexibleInterpVar::evaluate() const
   return total;
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translate node into a call of flatKernel() in a RooFlatFunc program
+
+Int_t FlexibleInterpVar::translateFlat(RooFlatFunc& prog, const RooAbsReal& node)
+{
+  const FlexibleInterpVar& var = static_cast<const FlexibleInterpVar&>(node) ;
+  std::vector<Int_t> inputs ;
+  RooFIter iter = var._paramList.fwdIterator() ;
+  RooAbsArg* param ;
+  while((param=iter.next())) {
+    inputs.push_back(prog.input(static_cast<const RooAbsReal&>(*param))) ;
+  }
+  return prog.addKernel(inputs, &FlexibleInterpVar::flatKernel, &var) ;
+}
+
+namespace {
+  Bool_t registerFlatTranslator = RooFlatFunc::registerTranslator("RooStats::HistFactory::FlexibleInterpVar",
+								  &FlexibleInterpVar::translateFlat) ;
+}
+
 void FlexibleInterpVar::printMultiline(ostream& os, Int_t contents, 
 				       Bool_t verbose, TString indent) const
 {
@@ -37,6 +37,8 @@ END_HTML
 
 #include "RooConstVar.h"
 #include "RooBinning.h"
+#include "RooFlatFunc.h"
+#include "RooBatchData.h"
 #include "RooErrorHandler.h"
 
 #include "RooGaussian.h"
@@ -689,6 +691,90 @@ Double_t ParamHistFunc::evaluate() const
 }
 
 
+
+////////////////////////////////////////////////////////////////////////////////
+/// The function can be evaluated for batches of events if its observables are
+/// real-valued and can be evaluated for batches of events, and the parameters
+/// do not depend on the observables of the batch
+
+Bool_t ParamHistFunc::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  RooFIter varIter = _dataSet.get()->fwdIterator() ;
+  RooAbsArg* var ;
+  while((var=varIter.next())) {
+    RooAbsReal* obs = dynamic_cast<RooAbsReal*>(_dataVars.find(var->GetName())) ;
+    if (!dynamic_cast<RooAbsRealLValue*>(var) || !obs || !obs->canEvaluateBatch(batch)) return kFALSE ;
+  }
+
+  RooFIter paramIter = _paramSet.fwdIterator() ;
+  RooAbsArg* param ;
+  while((param=paramIter.next())) {
+    if (batch.dependsOnObservables(*param)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): look up the parameters of the bins of the events.
+/// When the observables are read directly from the columns of the batch, the
+/// parameter indices are calculated once for each range of events.
+
+void ParamHistFunc::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  const Int_t n = batch.size() ;
+  Bool_t filled ;
+  Int_t* gammaIndex = batch.indices(this,filled) ;
+
+  std::vector<const Double_t*> values ;
+  Bool_t fromColumns(kTRUE) ;
+  RooFIter varIter = _dataSet.get()->fwdIterator() ;
+  RooAbsArg* var ;
+  while((var=varIter.next())) {
+    RooAbsReal* obs = (RooAbsReal*) _dataVars.find(var->GetName()) ;
+    if (!batch.column(obs)) fromColumns = kFALSE ;
+    values.push_back(obs->getValBatch(batch)) ;
+  }
+
+  if (!filled || !fromColumns) {
+    _dataSet.getBinIndices(values,n,gammaIndex) ;
+    for (Int_t k=0 ; k<n ; k++) {
+      std::map<Int_t,Int_t>::const_iterator iter = _binMap.find(gammaIndex[k]) ;
+      if (iter==_binMap.end()) {
+	// Report the bin without parameter and throw, as getParameter() does
+	getParameter(gammaIndex[k]) ;
+      }
+      gammaIndex[k] = iter->second ;
+    }
+  }
+
+  std::vector<Double_t> paramVal(_paramSet.getSize()) ;
+  for (Int_t i=0 ; i<_paramSet.getSize() ; i++) {
+    paramVal[i] = ((RooAbsReal&)_paramSet[i]).getVal() ;
+  }
+  for (Int_t k=0 ; k<n ; k++) {
+    output[k] = paramVal[gammaIndex[k]] ;
+  }
+}
+
+
+
+namespace {
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Translate a ParamHistFunc into the parameter of the current bin. The
+  /// observables must not change while the RooFlatFunc program is used.
+
+  Int_t translateParamHistFunc(RooFlatFunc& prog, const RooAbsReal& node)
+  {
+    return prog.input(static_cast<const ParamHistFunc&>(node).getParameter()) ;
+  }
+
+  Bool_t registerFlatTranslator = RooFlatFunc::registerTranslator("ParamHistFunc",translateParamHistFunc) ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Advertise that all integrals can be handled internally.
 
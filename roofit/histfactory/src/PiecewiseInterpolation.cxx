@@ -26,6 +26,11 @@
 #include "RooMsgService.h"
 #include "RooNumIntConfig.h"
 #include "RooTrace.h"
+#include "RooFlatFunc.h"
+#include "RooHistFunc.h"
+#include "RooDataHist.h"
+#include "RooAbsBinning.h"
+#include "RooBatchData.h"
 
 #include <exception>
 #include <math.h>
@@ -41,6 +46,8 @@ ClassImp(PiecewiseInterpolation)
 PiecewiseInterpolation::PiecewiseInterpolation()
 {
   _positiveDefinite=false;
+  _cacheStatus=-1;
+  _cacheVersion=0;
   TRACE_CREATE
 }
 
@@ -58,7 +65,9 @@ PiecewiseInterpolation::PiecewiseInterpolation(const char* name, const char* tit
   _lowSet("!lowSet","low-side variation",this),
   _highSet("!highSet","high-side variation",this),
   _paramSet("!paramSet","high-side variation",this),
-  _positiveDefinite(false)
+  _positiveDefinite(false),
+  _cacheStatus(-1),
+  _cacheVersion(0)
 
 {
   // Constructor with two set of RooAbsReals. The value of the function will be
@@ -134,7 +143,9 @@ PiecewiseInterpolation::PiecewiseInterpolation(const PiecewiseInterpolation& oth
   _highSet("!highSet",this,other._highSet),
   _paramSet("!paramSet",this,other._paramSet),
   _positiveDefinite(other._positiveDefinite),
-  _interpCode(other._interpCode)
+  _interpCode(other._interpCode),
+  _cacheStatus(-1),
+  _cacheVersion(0)
 {
   // Member _ownedList is intentionally not copy-constructed -- ownership is not transferred
   TRACE_CREATE
@@ -153,148 +164,454 @@ PiecewiseInterpolation::~PiecewiseInterpolation()
 
 
 
-////////////////////////////////////////////////////////////////////////////////
-/// Calculate and return current value of self
-
-Double_t PiecewiseInterpolation::evaluate() const 
-{
-  ///////////////////
-  Double_t nominal = _nominal;
-  Double_t sum(nominal) ;
-
-  RooAbsReal* param ;
-  RooAbsReal* high ;
-  RooAbsReal* low ;
-  int i=0;
+namespace {
 
-  RooFIter lowIter(_lowSet.fwdIterator()) ;
-  RooFIter highIter(_highSet.fwdIterator()) ;
-  RooFIter paramIter(_paramSet.fwdIterator()) ;
-
-  while((param=(RooAbsReal*)paramIter.next())) {
-    low = (RooAbsReal*)lowIter.next() ;
-    high = (RooAbsReal*)highIter.next() ;
-
-    Int_t icode = _interpCode[i] ;
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Apply the interpolation with code icode of a parameter with value x to sum.
+  /// The low and high variations are passed as functors, so that they are only
+  /// evaluated when needed. Return false if the interpolation code is unknown.
 
+  template <class Low, class High>
+  inline Bool_t interpolate(int icode, double x, const Low& low, const High& high, double nominal, Double_t& sum)
+  {
     switch(icode) {
     case 0: {
       // piece-wise linear
-      if(param->getVal()>0)
-	sum +=  param->getVal()*(high->getVal() - nominal );
+      if(x>0)
+	  sum +=  x*(high() - nominal );
       else
-	sum += param->getVal()*(nominal - low->getVal());
+	  sum += x*(nominal - low());
       break ;
     }
     case 1: {
       // pice-wise log
-      if(param->getVal()>=0)
-	sum *= pow(high->getVal()/nominal, +param->getVal());
+      if(x>=0)
+	  sum *= pow(high()/nominal, +x);
       else
-	sum *= pow(low->getVal()/nominal,  -param->getVal());
+	  sum *= pow(low()/nominal,  -x);
       break ;
     }
     case 2: {
       // parabolic with linear
-      double a = 0.5*(high->getVal()+low->getVal())-nominal;
-      double b = 0.5*(high->getVal()-low->getVal());
+      double a = 0.5*(high()+low())-nominal;
+      double b = 0.5*(high()-low());
       double c = 0;
-      if(param->getVal()>1 ){
-	sum += (2*a+b)*(param->getVal()-1)+high->getVal()-nominal;
-      } else if(param->getVal()<-1 ) {
-	sum += -1*(2*a-b)*(param->getVal()+1)+low->getVal()-nominal;
+      if(x>1 ){
+	  sum += (2*a+b)*(x-1)+high()-nominal;
+      } else if(x<-1 ) {
+	  sum += -1*(2*a-b)*(x+1)+low()-nominal;
       } else {
-	sum +=  a*pow(param->getVal(),2) + b*param->getVal()+c;
+	  sum +=  a*pow(x,2) + b*x+c;
       }
       break ;
     }
     case 3: {
       //parabolic version of log-normal
-      double a = 0.5*(high->getVal()+low->getVal())-nominal;
-      double b = 0.5*(high->getVal()-low->getVal());
+      double a = 0.5*(high()+low())-nominal;
+      double b = 0.5*(high()-low());
       double c = 0;
-      if(param->getVal()>1 ){
-	sum += (2*a+b)*(param->getVal()-1)+high->getVal()-nominal;
-      } else if(param->getVal()<-1 ) {
-	sum += -1*(2*a-b)*(param->getVal()+1)+low->getVal()-nominal;
+      if(x>1 ){
+	  sum += (2*a+b)*(x-1)+high()-nominal;
+      } else if(x<-1 ) {
+	  sum += -1*(2*a-b)*(x+1)+low()-nominal;
       } else {
-	sum +=  a*pow(param->getVal(),2) + b*param->getVal()+c;
+	  sum +=  a*pow(x,2) + b*x+c;
       }
       break ;
     }
     case 4: {
-      
+    
       // WVE ****************************************************************
       // WVE *** THIS CODE IS CRITICAL TO HISTFACTORY FIT CPU PERFORMANCE ***
       // WVE *** Do not modify unless you know what you are doing...      ***
       // WVE ****************************************************************
 
-      double x  = param->getVal();      
       if (x>1) {
-	sum += x*(high->getVal() - nominal );
+	  sum += x*(high() - nominal );
       } else if (x<-1) {
-	sum += x*(nominal - low->getVal());
+	  sum += x*(nominal - low());
       } else {
-	double eps_plus = high->getVal() - nominal;
-	double eps_minus = nominal - low->getVal();
-	double S = 0.5 * (eps_plus + eps_minus);
-	double A = 0.0625 * (eps_plus - eps_minus);
+	  double eps_plus = high() - nominal;
+	  double eps_minus = nominal - low();
+	  double S = 0.5 * (eps_plus + eps_minus);
+	  double A = 0.0625 * (eps_plus - eps_minus);
 	
-	//fcns+der+2nd_der are eq at bd
+	  //fcns+der+2nd_der are eq at bd
 
         double val = nominal + x * (S + x * A * ( 15 + x * x * (-10 + x * x * 3  ) ) ); 
 
 
-	if (val < 0) val = 0;
-	sum += val-nominal;
+	  if (val < 0) val = 0;
+	  sum += val-nominal;
       }
       break ;
 
       // WVE ****************************************************************
     }
     case 5: {
-      
+    
       double x0 = 1.0;//boundary;
-      double x  = param->getVal();
 
       if (x > x0 || x < -x0)
       {
-	if(x>0)
-	  sum += x*(high->getVal() - nominal );
-	else
-	  sum += x*(nominal - low->getVal());
+	  if(x>0)
+	    sum += x*(high() - nominal );
+	  else
+	    sum += x*(nominal - low());
       }
       else if (nominal != 0)
       {
-	double eps_plus = high->getVal() - nominal;
-	double eps_minus = nominal - low->getVal();
-	double S = (eps_plus + eps_minus)/2;
-	double A = (eps_plus - eps_minus)/2;
+	  double eps_plus = high() - nominal;
+	  double eps_minus = nominal - low();
+	  double S = (eps_plus + eps_minus)/2;
+	  double A = (eps_plus - eps_minus)/2;
 
-	//fcns+der are eq at bd
-	double a = S;
-	double b = 3*A/(2*x0);
-	//double c = 0;
-	double d = -A/(2*x0*x0*x0);
+	  //fcns+der are eq at bd
+	  double a = S;
+	  double b = 3*A/(2*x0);
+	  //double c = 0;
+	  double d = -A/(2*x0*x0*x0);
 
-	double val = nominal + a*x + b*pow(x, 2) + 0/*c*pow(x, 3)*/ + d*pow(x, 4);
-	if (val < 0) val = 0;
+	  double val = nominal + a*x + b*pow(x, 2) + 0/*c*pow(x, 3)*/ + d*pow(x, 4);
+	  if (val < 0) val = 0;
 
-	//cout << "Using interp code 5, val = " << val << endl;
+	  //cout << "Using interp code 5, val = " << val << endl;
 
-	sum += val-nominal;
+	  sum += val-nominal;
       }
       break ;
     }
-    default: {
+    default:
+      return kFALSE ;
+    }
+    return kTRUE ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate and return current value of self
+
+Double_t PiecewiseInterpolation::evaluate() const 
+{
+  if (_cacheStatus<0) initCache() ;
+  if (_cacheStatus>0) {
+    checkCache() ;
+    Int_t bin = static_cast<const RooHistFunc&>(_nominal.arg()).getBin() ;
+    if (bin>=0) return evaluateBin(bin) ;
+  }
+
+  ///////////////////
+  Double_t nominal = _nominal;
+  Double_t sum(nominal) ;
+
+  RooAbsReal* param ;
+  RooAbsReal* high ;
+  RooAbsReal* low ;
+  int i=0;
+
+  RooFIter lowIter(_lowSet.fwdIterator()) ;
+  RooFIter highIter(_highSet.fwdIterator()) ;
+  RooFIter paramIter(_paramSet.fwdIterator()) ;
+
+  while((param=(RooAbsReal*)paramIter.next())) {
+    low = (RooAbsReal*)lowIter.next() ;
+    high = (RooAbsReal*)highIter.next() ;
+
+    Int_t icode = _interpCode[i] ;
+
+    if (!interpolate(icode, param->getVal(), [low]() { return low->getVal() ; }, [high]() { return high->getVal() ; }, nominal, sum)) {
       coutE(InputArguments) << "PiecewiseInterpolation::evaluate ERROR:  " << param->GetName() 
 			    << " with unknown interpolation code" << icode << endl ;
-      break ;
-    }
     }
     ++i;
   }
   
+  return positiveSum(sum) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the value in the given bin of the nominal histogram from the
+/// interpolation terms cached for this bin. Only the terms of the parameters
+/// whose values changed since the last evaluation in this bin are recalculated,
+/// so that a change of a single parameter, as in the steps of a numerical
+/// gradient, does not need the low and high variations of the other parameters.
+/// The terms are applied in the same order as in the full calculation, so that
+/// the result is identical.
+///
+/// In the batch evaluation, 'inputs' holds the values of the nominal and of the
+/// low and high variations (nominal, low_0, high_0, low_1, ...) for the events of
+/// the batch, and 'event' is the index of the event in the batch.
+
+Double_t PiecewiseInterpolation::evaluateBin(Int_t bin, const Double_t* const* inputs, Int_t event) const
+{
+  const Int_t n = _interpCode.size() ;
+  Double_t* params = n>0 ? &_cacheParams[bin*n] : 0 ;
+  Double_t* terms = n>0 ? &_cacheTerms[bin*n] : 0 ;
+  Bool_t filled = _cacheFilled[bin] ;
+  if (!filled) {
+    _cacheNominal[bin] = inputs ? inputs[0][event] : _nominal ;
+    _cacheFilled[bin] = kTRUE ;
+  }
+  const Double_t nominal = _cacheNominal[bin] ;
+  Double_t sum(nominal) ;
+
+  RooFIter lowIter(_lowSet.fwdIterator()) ;
+  RooFIter highIter(_highSet.fwdIterator()) ;
+  RooFIter paramIter(_paramSet.fwdIterator()) ;
+
+  for (Int_t i=0 ; i<n ; i++) {
+    const RooAbsReal* param = (const RooAbsReal*)paramIter.next() ;
+    const RooAbsReal* low = (const RooAbsReal*)lowIter.next() ;
+    const RooAbsReal* high = (const RooAbsReal*)highIter.next() ;
+    const Int_t icode = _interpCode[i] ;
+    const Double_t x = param->getVal() ;
+
+    if (!filled || x!=params[i]) {
+      // multiplicative term for the log interpolation, additive otherwise
+      Double_t term = (icode==1) ? 1 : 0 ;
+      Bool_t ok ;
+      if (inputs) {
+	const Double_t* lowVal = inputs[1+2*i] ;
+	const Double_t* highVal = inputs[2+2*i] ;
+	ok = interpolate(icode, x, [lowVal,event]() { return lowVal[event] ; }, [highVal,event]() { return highVal[event] ; }, nominal, term) ;
+      } else {
+	ok = interpolate(icode, x, [low]() { return low->getVal() ; }, [high]() { return high->getVal() ; }, nominal, term) ;
+      }
+      if (!ok) {
+	coutE(InputArguments) << "PiecewiseInterpolation::evaluate ERROR:  " << param->GetName() 
+			      << " with unknown interpolation code" << icode << endl ;
+      }
+      params[i] = x ;
+      terms[i] = term ;
+    }
+
+    if (icode==1) {
+      sum *= terms[i] ;
+    } else {
+      sum += terms[i] ;
+    }
+  }
+
+  return positiveSum(sum) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// The interpolation can be evaluated for batches of events if the parameters do
+/// not depend on the observables of the batch, all interpolation codes are known
+/// and the nominal and the variations can be evaluated for batches of events
+
+Bool_t PiecewiseInterpolation::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  if (_lowSet.getSize()!=Int_t(_interpCode.size()) || _highSet.getSize()!=Int_t(_interpCode.size())) return kFALSE ;
+  for (UInt_t i=0 ; i<_interpCode.size() ; i++) {
+    if (_interpCode[i]<0 || _interpCode[i]>5) return kFALSE ;
+  }
+  if (!_nominal.arg().canEvaluateBatch(batch,_nominal.nset())) return kFALSE ;
+
+  RooFIter lowIter(_lowSet.fwdIterator()) ;
+  RooFIter highIter(_highSet.fwdIterator()) ;
+  RooFIter paramIter(_paramSet.fwdIterator()) ;
+  RooAbsReal* param ;
+  while((param=(RooAbsReal*)paramIter.next())) {
+    RooAbsReal* low = (RooAbsReal*)lowIter.next() ;
+    RooAbsReal* high = (RooAbsReal*)highIter.next() ;
+    if (batch.dependsOnObservables(*param) || !low->canEvaluateBatch(batch) || !high->canEvaluateBatch(batch)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(). Events in the bins of a histogram nominal use
+/// the per bin cache of evaluateBin(), the others the full calculation.
+
+void PiecewiseInterpolation::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  const Int_t n = batch.size() ;
+  const Int_t np = _interpCode.size() ;
+
+  std::vector<const Double_t*> inputs(1+2*np) ;
+  std::vector<Double_t> x(np) ;
+  inputs[0] = _nominal.arg().getValBatch(batch,_nominal.nset()) ;
+
+  RooFIter lowIter(_lowSet.fwdIterator()) ;
+  RooFIter highIter(_highSet.fwdIterator()) ;
+  RooFIter paramIter(_paramSet.fwdIterator()) ;
+  for (Int_t i=0 ; i<np ; i++) {
+    x[i] = ((RooAbsReal*)paramIter.next())->getVal() ;
+    inputs[1+2*i] = ((RooAbsReal*)lowIter.next())->getValBatch(batch) ;
+    inputs[2+2*i] = ((RooAbsReal*)highIter.next())->getValBatch(batch) ;
+  }
+
+  if (_cacheStatus<0) initCache() ;
+  if (_cacheStatus>0) checkCache() ;
+  const Int_t* bins = (_cacheStatus>0) ? static_cast<const RooHistFunc&>(_nominal.arg()).getBinBatch(batch) : 0 ;
+
+  for (Int_t k=0 ; k<n ; k++) {
+    if (bins && bins[k]>=0) {
+      output[k] = evaluateBin(bins[k],&inputs[0],k) ;
+      continue ;
+    }
+
+    const Double_t nominal = inputs[0][k] ;
+    Double_t sum(nominal) ;
+    for (Int_t i=0 ; i<np ; i++) {
+      const Double_t* lowVal = inputs[1+2*i] ;
+      const Double_t* highVal = inputs[2+2*i] ;
+      interpolate(_interpCode[i], x[i], [lowVal,k]() { return lowVal[k] ; }, [highVal,k]() { return highVal[k] ; }, nominal, sum) ;
+    }
+    output[k] = positiveSum(sum) ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Enable the per bin cache of evaluateBin() if the nominal value and all variations
+/// are histograms without interpolation with the same binning, whose values only
+/// depend on the bin of the observables
+
+void PiecewiseInterpolation::initCache() const
+{
+  _cacheStatus = 0 ;
+
+  const RooHistFunc* nominal = dynamic_cast<const RooHistFunc*>(&_nominal.arg()) ;
+  if (!nominal || nominal->getInterpolationOrder()!=0) return ;
+  if (_lowSet.getSize()!=Int_t(_interpCode.size()) || _highSet.getSize()!=Int_t(_interpCode.size())) return ;
+
+  RooFIter lowIter(_lowSet.fwdIterator()) ;
+  RooFIter highIter(_highSet.fwdIterator()) ;
+  for (UInt_t i=0 ; i<_interpCode.size() ; i++) {
+    const RooHistFunc* low = dynamic_cast<const RooHistFunc*>(lowIter.next()) ;
+    const RooHistFunc* high = dynamic_cast<const RooHistFunc*>(highIter.next()) ;
+    if (!low || !high || !sameBinning(*nominal,*low) || !sameBinning(*nominal,*high)) return ;
+  }
+
+  const Int_t nBins = nominal->dataHist().numEntries() ;
+  _cacheParams.assign(nBins*_interpCode.size(),0.) ;
+  _cacheTerms.assign(nBins*_interpCode.size(),0.) ;
+  _cacheNominal.assign(nBins,0.) ;
+  _cacheFilled.assign(nBins,kFALSE) ;
+  _cacheVersion = histContentVersion() ;
+  _cacheStatus = 1 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the sum of the content versions of the nominal and variation histograms,
+/// which changes whenever the contents of one of them are modified
+
+ULong64_t PiecewiseInterpolation::histContentVersion() const
+{
+  ULong64_t version = static_cast<const RooHistFunc&>(_nominal.arg()).dataHist().contentVersion() ;
+  RooFIter lowIter(_lowSet.fwdIterator()) ;
+  RooFIter highIter(_highSet.fwdIterator()) ;
+  for (UInt_t i=0 ; i<_interpCode.size() ; i++) {
+    version += static_cast<const RooHistFunc*>(lowIter.next())->dataHist().contentVersion() ;
+    version += static_cast<const RooHistFunc*>(highIter.next())->dataHist().contentVersion() ;
+  }
+  return version ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the cached nominal values and interpolation terms of all bins if the
+/// contents of the nominal or variation histograms changed since they were cached
+
+void PiecewiseInterpolation::checkCache() const
+{
+  const ULong64_t version = histContentVersion() ;
+  if (version!=_cacheVersion) {
+    _cacheFilled.assign(_cacheFilled.size(),kFALSE) ;
+    _cacheVersion = version ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the cached interpolation terms
+
+void PiecewiseInterpolation::clearCache()
+{
+  _cacheStatus = -1 ;
+  _cacheParams.clear() ;
+  _cacheTerms.clear() ;
+  _cacheNominal.clear() ;
+  _cacheFilled.clear() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the two histogram functions depend on the same observables
+/// and have the same bins
+
+Bool_t PiecewiseInterpolation::sameBinning(const RooHistFunc& h1, const RooHistFunc& h2)
+{
+  if (h2.getInterpolationOrder()!=0) return kFALSE ;
+  if (h1.dataHist().numEntries()!=h2.dataHist().numEntries()) return kFALSE ;
+
+  RooArgSet* vars1 = h1.getVariables() ;
+  RooArgSet* vars2 = h2.getVariables() ;
+  Bool_t same = vars1->equals(*vars2) ;
+  delete vars1 ;
+  delete vars2 ;
+  if (!same) return kFALSE ;
+
+  const RooArgSet* obs1 = h1.dataHist().get() ;
+  const RooArgSet* obs2 = h2.dataHist().get() ;
+  if (obs1->getSize()!=obs2->getSize()) return kFALSE ;
+  RooFIter iter1 = obs1->fwdIterator() ;
+  RooFIter iter2 = obs2->fwdIterator() ;
+  RooAbsArg* arg1 ;
+  while ((arg1 = iter1.next())) {
+    RooAbsArg* arg2 = iter2.next() ;
+    RooAbsLValue* lv1 = dynamic_cast<RooAbsLValue*>(arg1) ;
+    RooAbsLValue* lv2 = dynamic_cast<RooAbsLValue*>(arg2) ;
+    if (!lv1 || !lv2 || lv1->numBins()!=lv2->numBins()) return kFALSE ;
+    RooRealVar* rv1 = dynamic_cast<RooRealVar*>(arg1) ;
+    RooRealVar* rv2 = dynamic_cast<RooRealVar*>(arg2) ;
+    if (!rv1 != !rv2) return kFALSE ;
+    if (rv1) {
+      const Double_t* b1 = rv1->getBinning().array() ;
+      const Double_t* b2 = rv2->getBinning().array() ;
+      for (Int_t i=0 ; i<=lv1->numBins() ; i++) {
+	if (b1[i]!=b2[i]) return kFALSE ;
+      }
+    }
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the cached interpolation terms when the servers are replaced
+
+Bool_t PiecewiseInterpolation::redirectServersHook(const RooAbsCollection& /*newServerList*/, Bool_t /*mustReplaceAll*/, 
+						   Bool_t /*nameChange*/, Bool_t /*isRecursive*/)
+{
+  clearCache() ;
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Apply the positive definite protection to the interpolated value sum
+
+Double_t PiecewiseInterpolation::positiveSum(Double_t sum) const
+{
   if(_positiveDefinite && (sum<0)){
     sum = 1e-6;
     sum = 0;
@@ -309,6 +626,55 @@ Double_t PiecewiseInterpolation::evaluate() const
 
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Kernel of the flattened evaluation program: value of the PiecewiseInterpolation
+/// 'self' for the input values x = (nominal, param_0, low_0, high_0, param_1, ...)
+
+Double_t PiecewiseInterpolation::flatKernel(const Double_t* x, const void* self)
+{
+  const PiecewiseInterpolation* pi = static_cast<const PiecewiseInterpolation*>(self) ;
+  const Double_t nominal = x[0] ;
+  Double_t sum(nominal) ;
+  const int n = pi->_interpCode.size() ;
+  for (int i=0 ; i<n ; i++) {
+    const Double_t* in = x + 1 + 3*i ;
+    if (!interpolate(pi->_interpCode[i], in[0], [in]() { return in[1] ; }, [in]() { return in[2] ; }, nominal, sum)) {
+      oocoutE(pi,InputArguments) << "PiecewiseInterpolation::evaluate ERROR:  " << pi->_paramSet.at(i)->GetName() 
+				  << " with unknown interpolation code" << pi->_interpCode[i] << endl ;
+    }
+  }
+  return pi->positiveSum(sum) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translate node into a call of flatKernel() in a RooFlatFunc program
+
+Int_t PiecewiseInterpolation::translateFlat(RooFlatFunc& prog, const RooAbsReal& node)
+{
+  const PiecewiseInterpolation& pi = static_cast<const PiecewiseInterpolation&>(node) ;
+  std::vector<Int_t> inputs ;
+  inputs.push_back(prog.input(pi._nominal.arg())) ;
+  RooFIter lowIter(pi._lowSet.fwdIterator()) ;
+  RooFIter highIter(pi._highSet.fwdIterator()) ;
+  RooFIter paramIter(pi._paramSet.fwdIterator()) ;
+  RooAbsArg* param ;
+  while((param=paramIter.next())) {
+    inputs.push_back(prog.input(static_cast<const RooAbsReal&>(*param))) ;
+    inputs.push_back(prog.input(static_cast<const RooAbsReal&>(*lowIter.next()))) ;
+    inputs.push_back(prog.input(static_cast<const RooAbsReal&>(*highIter.next()))) ;
+  }
+  return prog.addKernel(inputs, &PiecewiseInterpolation::flatKernel, &pi) ;
+}
+
+namespace {
+  Bool_t registerFlatTranslator = RooFlatFunc::registerTranslator("PiecewiseInterpolation",
+								  &PiecewiseInterpolation::translateFlat) ;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Bool_t PiecewiseInterpolation::setBinIntegrator(RooArgSet& allVars) 
@@ -616,6 +982,7 @@ void PiecewiseInterpolation::setInterpCode(RooAbsReal& param, int code){
 			    << " is now " << code << endl ;
     _interpCode.at(index) = code;
   }
+  clearCache() ;
 }
 
 
@@ -625,6 +992,7 @@ void PiecewiseInterpolation::setAllInterpCodes(int code){
   for(unsigned int i=0; i<_interpCode.size(); ++i){
     _interpCode.at(i) = code;
   }
+  clearCache() ;
 }
 
 
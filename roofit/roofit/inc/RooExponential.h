@@ -39,6 +39,8 @@ protected:
   RooRealProxy c;
 
   Double_t evaluate() const;
+  virtual Bool_t canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const ;
+  virtual void evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const ;
 
 private:
   ClassDef(RooExponential,1) // Exponential PDF
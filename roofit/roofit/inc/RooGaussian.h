@@ -46,6 +46,8 @@ protected:
   RooRealProxy sigma ;
   
   Double_t evaluate() const ;
+  virtual Bool_t canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const ;
+  virtual void evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const ;
 
 private:
 
@@ -49,6 +49,8 @@ protected:
   mutable std::vector<Double_t> _wksp; //! do not persist
 
   Double_t evaluate() const;
+  virtual Bool_t canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const ;
+  virtual void evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const ;
 
   ClassDef(RooPolynomial,1) // Polynomial PDF
 };
@@ -30,6 +30,8 @@ Exponential p.d.f
 
 #include "RooExponential.h"
 #include "RooRealVar.h"
+#include "RooBatchData.h"
+#include "TMath.h"
 
 using namespace std;
 
@@ -63,6 +65,30 @@ Double_t RooExponential::evaluate() const{
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// The exponential can be evaluated for batches of events if x and c can
+
+Bool_t RooExponential::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  return x.arg().canEvaluateBatch(batch,x.nset()) && c.arg().canEvaluateBatch(batch,c.nset()) ;
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(), using the vectorised TMath::Exp()
+
+void RooExponential::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  const Double_t* xVal = x.arg().getValBatch(batch,x.nset()) ;
+  const Double_t* cVal = c.arg().getValBatch(batch,c.nset()) ;
+  const Int_t n = batch.size() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    output[i] = cVal[i]*xVal[i] ;
+  }
+  TMath::Exp(n,output,output) ;
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooExponential::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
@@ -33,6 +33,8 @@ Plain Gaussian p.d.f
 #include "RooRealVar.h"
 #include "RooRandom.h"
 #include "RooMath.h"
+#include "RooBatchData.h"
+#include "TMath.h"
 
 using namespace std;
 
@@ -78,6 +80,36 @@ Double_t RooGaussian::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// The Gaussian can be evaluated for batches of events if x, mean and sigma can
+
+Bool_t RooGaussian::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  return x.arg().canEvaluateBatch(batch,x.nset()) && mean.arg().canEvaluateBatch(batch,mean.nset()) &&
+    sigma.arg().canEvaluateBatch(batch,sigma.nset()) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(), using the vectorised TMath::Exp()
+
+void RooGaussian::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  const Double_t* xVal = x.arg().getValBatch(batch,x.nset()) ;
+  const Double_t* meanVal = mean.arg().getValBatch(batch,mean.nset()) ;
+  const Double_t* sigmaVal = sigma.arg().getValBatch(batch,sigma.nset()) ;
+  const Int_t n = batch.size() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    const Double_t arg = xVal[i] - meanVal[i] ;
+    const Double_t sig = sigmaVal[i] ;
+    output[i] = -0.5*arg*arg/(sig*sig) ;
+  }
+  TMath::Exp(n,output,output) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// calculate and return the negative log-likelihood of the Poisson                                                                                                                                    
 
@@ -28,11 +28,13 @@ less than polynomial functions due to the normalization condition
 
 #include <cmath>
 #include <cassert>
+#include <algorithm>
 
 #include "RooPolynomial.h"
 #include "RooAbsReal.h"
 #include "RooArgList.h"
 #include "RooMsgService.h"
+#include "RooBatchData.h"
 
 #include "TError.h"
 
@@ -137,6 +139,53 @@ Double_t RooPolynomial::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// The polynomial can be evaluated for batches of events if x can
+/// and the coefficients do not depend on the observables
+
+Bool_t RooPolynomial::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  RooFIter it = _coefList.fwdIterator();
+  RooAbsArg* c;
+  while ((c = it.next())) {
+    if (batch.dependsOnObservables(*c)) return kFALSE;
+  }
+  return _x.arg().canEvaluateBatch(batch, _x.nset());
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): the coefficients are the same for all the events
+
+void RooPolynomial::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  const Int_t n = batch.size();
+  const unsigned sz = _coefList.getSize();
+  const int lowestOrder = _lowestOrder;
+  if (!sz) {
+    std::fill(output, output + n, lowestOrder ? 1. : 0.);
+    return;
+  }
+  _wksp.clear();
+  _wksp.reserve(sz);
+  {
+    const RooArgSet* nset = _coefList.nset();
+    RooFIter it = _coefList.fwdIterator();
+    RooAbsReal* c;
+    while ((c = (RooAbsReal*) it.next())) _wksp.push_back(c->getVal(nset));
+  }
+  const Double_t* xVal = _x.arg().getValBatch(batch, _x.nset());
+  for (Int_t k = 0; k < n; k++) {
+    const Double_t x = xVal[k];
+    Double_t retVal = _wksp[sz - 1];
+    for (unsigned i = sz - 1; i--; ) retVal = _wksp[i] + x * retVal;
+    output[k] = retVal * std::pow(x, lowestOrder) + (lowestOrder ? 1.0 : 0.0);
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooPolynomial::getAnalyticalIntegral(RooArgSet& allVars, RooArgSet& analVars, const char* /*rangeName*/) const 
@@ -84,7 +84,7 @@ ROOFITCOREH4   := RooConstraintSum.h RooRecursiveFraction.h RooDataWeightedAvera
                   RooMinimizer.h RooMinimizerFcn.h RooMoment.h RooStudyManager.h RooAbsStudy.h \
                   RooGenFitStudy.h RooProofDriverSelector.h RooStudyPackage.h RooCompositeDataStore.h \
 		  RooRangeBoolean.h RooVectorDataStore.h RooUnitTest.h RooExtendedBinding.h \
-                  RooAbsMoment.h RooFirstMoment.h RooSecondMoment.h
+                  RooAbsMoment.h RooFirstMoment.h RooSecondMoment.h RooFlatFunc.h
 
 ROOFITCOREH1   := $(patsubst %,$(MODDIRI)/%,$(ROOFITCOREH1))
 ROOFITCOREH2   := $(patsubst %,$(MODDIRI)/%,$(ROOFITCOREH2))
@@ -118,7 +118,7 @@ $(ROOFITCORELIB): $(ROOFITCOREO) $(ROOFITCOREDO) $(ORDER_) $(MAINLIBS) \
 		@$(MAKELIB) $(PLATFORM) $(LD) "$(LDFLAGS)" \
 		   "$(SOFLAGS)" libRooFitCore.$(SOEXT) $@ \
 		   "$(ROOFITCOREO) $(ROOFITCOREDO)" \
-		   "$(ROOFITCORELIBEXTRA) $(OSTHREADLIBDIR) $(OSTHREADLIB)"
+		   "$(ROOFITCORELIBEXTRA) $(OSTHREADLIBDIR) $(OSTHREADLIB) $(TBBLIBDIR) $(TBBLIB)"
 
 $(call pcmrule,ROOFITCORE)
 	$(noop)
@@ -148,3 +148,8 @@ distclean::     distclean-$(MODNAME)
 
 # Optimize dictionary with stl containers.
 $(ROOFITCOREDO): NOOPT = $(OPT)
+
+##### extra rules ######
+ifeq ($(BUILDTBB),yes)
+$(ROOFITCOREO): CXXFLAGS += $(TBBINCDIR:%=-I%)
+endif
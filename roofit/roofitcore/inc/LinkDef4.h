@@ -33,6 +33,7 @@
 #pragma link C++ class RooFunctor+ ;
 #pragma link C++ class RooGenFunction+ ;
 #pragma link C++ class RooMultiGenFunction+ ;
+#pragma link C++ class RooFlatFunc- ;
 #pragma link C++ class RooTFoamBinding+ ;
 #pragma link C++ class RooAdaptiveIntegratorND+ ;
 #pragma link C++ class RooAbsNumGenerator+ ;
@@ -52,6 +53,8 @@
 #pragma link C++ class RooVectorDataStore::RealVector- ;
 #pragma link C++ class RooVectorDataStore::RealFullVector- ;
 #pragma link C++ class RooVectorDataStore::CatVector- ;
+#pragma read sourceClass="RooVectorDataStore::CatVector" targetClass="RooVectorDataStore::CatVector" version="[1]" source="std::vector<RooCatType> _vec" target="_vec" \
+  code="{ _vec.resize(onfile._vec.size()) ; for (UInt_t i=0 ; i<onfile._vec.size() ; i++) { _vec[i] = onfile._vec[i].getVal() ; } }"
 #pragma link C++ class std::pair<std::string,RooAbsData*>+ ;
 #pragma link C++ class std::pair<int,RooLinkedListElem*>+ ;
 #pragma link C++ class RooUnitTest+ ;
@@ -265,6 +265,8 @@ protected:
   RooDataSet *generate(RooAbsGenContext& context, const RooArgSet& whatVars, const RooDataSet* prototype,
 		       Double_t nEvents, Bool_t verbose, Bool_t randProtoOrder, Bool_t resampleProto, Bool_t skipInit=kFALSE, 
 		       Bool_t extended=kFALSE) const ;
+  RooDataSet *generateMultiProcess(const RooArgSet &whatVars, Double_t nEvents, Bool_t verbose, Bool_t autoBinned,
+				   const char* binnedTag, Bool_t extended, Int_t nCPU) const ;
 
   // Implementation version
   virtual RooPlot* paramOn(RooPlot* frame, const RooArgSet& params, Bool_t showConstants=kFALSE,
@@ -296,6 +298,9 @@ protected:
 
   virtual Bool_t syncNormalization(const RooArgSet* dset, Bool_t adjustProxies=kTRUE) const ;
 
+  virtual Bool_t canNormalizeBatch(RooBatchData& batch, const RooArgSet* set) const ;
+  virtual void getValBatchV(Double_t* output, RooBatchData& batch, const RooArgSet* set) const ;
+
   friend class RooAbsAnaConvPdf ;
   mutable Double_t _rawValue ;
   mutable RooAbsReal* _norm   ;      //! Normalization integral (owned by _normMgr)
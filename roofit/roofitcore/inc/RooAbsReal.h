@@ -40,6 +40,7 @@ class RooFitResult ;
 class RooAbsMoment ;
 class RooDerivative ;
 class RooVectorDataStore ;
+class RooBatchData ;
 
 class TH1;
 class TH1F;
@@ -73,6 +74,10 @@ public:
 
   virtual Double_t getValV(const RooArgSet* set=0) const ;
 
+  // Batch evaluation for a range of events
+  const Double_t* getValBatch(RooBatchData& batch, const RooArgSet* set=0) const ;
+  Bool_t canEvaluateBatch(RooBatchData& batch, const RooArgSet* set=0) const ;
+
   Double_t getPropagatedError(const RooFitResult& fr) ;
 
   Bool_t operator==(Double_t value) const ;
@@ -372,6 +377,12 @@ protected:
   }
   virtual Double_t evaluate() const = 0 ;
 
+  // Batch evaluation interface for derived classes
+  virtual Bool_t canEvaluateBatchV(RooBatchData& batch, const RooArgSet* set) const ;
+  virtual Bool_t canNormalizeBatch(RooBatchData& batch, const RooArgSet* set) const ;
+  virtual void getValBatchV(Double_t* output, RooBatchData& batch, const RooArgSet* set) const ;
+  virtual void evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* set) const ;
+
   // Hooks for RooDataSet interface
   friend class RooRealIntegral ;
   friend class RooVectorDataStore ;
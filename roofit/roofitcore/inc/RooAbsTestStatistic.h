@@ -22,6 +22,7 @@
 #include "RooRealProxy.h"
 #include "TStopwatch.h"
 #include <string>
+#include <vector>
 
 class RooArgSet ;
 class RooAbsData ;
@@ -64,6 +65,9 @@ public:
   virtual Double_t offset() const { return _offset ; }
   virtual Double_t offsetCarry() const { return _offsetCarry; }
 
+  static void setMultiThreaded(Bool_t flag) ;
+  static Bool_t isMultiThreaded() ;
+
 protected:
 
   virtual void printCompactTreeHook(std::ostream& os, const char* indent="") ;
@@ -96,9 +100,9 @@ protected:
   
   RooSetProxy _paramSet ;          // Parameters of the test statistic (=parameters of the input function)
 
-  enum GOFOpMode { SimMaster,MPMaster,Slave } ;
+  enum GOFOpMode { SimMaster,MPMaster,Slave,MTMaster } ;
   GOFOpMode operMode() const { 
-    // Return test statistic operation mode of this instance (SimMaster, MPMaster or Slave)
+    // Return test statistic operation mode of this instance (SimMaster, MPMaster, Slave or MTMaster)
     return _gofOpMode ; 
   }
 
@@ -122,6 +126,8 @@ protected:
   Bool_t initialize() ;
   void initSimMode(RooSimultaneous* pdf, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;    
   void initMPMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName) ;
+  void syncMTParameters() const ;
 
   mutable Bool_t _init ;          //! Is object initialized  
   GOFOpMode   _gofOpMode ;        // Operation mode of test statistic instance 
@@ -140,6 +146,12 @@ protected:
   Int_t          _nCPU ;      //  Number of processors to use in parallel calculation mode
   pRooRealMPFE*  _mpfeArray ; //! Array of parallel execution frond ends
 
+  // Multi-threaded mode data (the thread test statistics are stored in _gofArray)
+  std::vector<RooAbsData*> _mtDataArray ; //! Copies of the dataset owned for the thread test statistics
+  std::vector<RooArgSet*> _mtParamArray ; //! Copies of the parameters owned for the thread test statistics
+  mutable Bool_t _mtSerialEval ; //! Evaluate the thread test statistics serially in the next calculation
+  static Bool_t _multiThreaded ;  // Use threads instead of processes in parallel calculation mode
+
   RooFit::MPSplit        _mpinterl ; // Use interleaving strategy rather than N-wise split for partioning of dataset for multiprocessor-split
   Bool_t         _doOffset ; // Apply interval value offset to control numeric precision?
   mutable Double_t _offset ; //! Offset
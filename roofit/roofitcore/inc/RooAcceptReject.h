@@ -19,16 +19,18 @@
 #include "RooAbsNumGenerator.h"
 #include "RooPrintable.h"
 #include "RooArgSet.h"
+#include <vector>
 
 class RooAbsReal;
 class RooRealVar;
 class RooDataSet;
 class RooRealBinding;
 class RooNumGenFactory ;
+class RooBatchData ;
 
 class RooAcceptReject : public RooAbsNumGenerator {
 public:
-  RooAcceptReject() : _nextCatVar(0), _nextRealVar(0) {
+  RooAcceptReject() : _nextCatVar(0), _nextRealVar(0), _blockSize(1), _batch(0) {
     // coverity[UNINIT_CTOR]
   } ; 
   RooAcceptReject(const RooAbsReal &func, const RooArgSet &genVars, const RooNumGenConfig& config, Bool_t verbose=kFALSE, const RooAbsReal* maxFuncVal=0);
@@ -53,6 +55,7 @@ protected:
   static void registerSampler(RooNumGenFactory& fact) ;	
 
   void addEventToCache();
+  void addEventsToCache(Long64_t nEvents);
   const RooArgSet *nextAcceptedEvent();
 
   Double_t _maxFuncVal, _funcSum;      // Maximum function value found, and sum of all samples made
@@ -65,6 +68,10 @@ protected:
 
   UInt_t _minTrialsArray[4];           // Minimum number of trials samples for 1,2,3 dimensional problems
 
+  UInt_t _blockSize ;                                // Number of trial events evaluated together by the batch evaluation, 1 (default) for event by event
+  RooBatchData* _batch ;                             //! Batch evaluation of the function for blocks of trial events
+  std::vector<std::vector<Double_t> > _trialValues ; //! Values of the real variables in a block of trial events
+
   ClassDef(RooAcceptReject,0) // Context for generating a dataset from a PDF
 };
 
@@ -0,0 +1,79 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ *    File: $Id$
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_BATCH_DATA
+#define ROO_BATCH_DATA
+
+#include <map>
+#include <vector>
+#include <utility>
+#include "Rtypes.h"
+#include "RooArgSet.h"
+
+class RooAbsArg ;
+
+class RooBatchData {
+public:
+
+  RooBatchData(const RooArgSet& observables) ;
+  ~RooBatchData() ;
+
+  // Range of events of the current batch
+  void setRange(Int_t firstEvent, Int_t nEvents) ;
+  Int_t firstEvent() const {
+    // Return index of the first event of the current batch
+    return _first ;
+  }
+  Int_t size() const {
+    // Return number of events in the current batch
+    return _size ;
+  }
+
+  // Columns of values of the observables
+  void addColumn(const RooAbsArg* arg, const Double_t* values) ;
+  const Double_t* column(const RooAbsArg* arg) const ;
+  const RooArgSet& observables() const {
+    // Return the set of observables whose values change from event to event
+    return _obs ;
+  }
+  Bool_t dependsOnObservables(const RooAbsArg& arg) ;
+
+  // Results and work space of the nodes of the expression
+  Double_t* makeBuffer() ;
+  const Double_t* values(const RooAbsArg* arg, const RooArgSet* nset) const ;
+  void setValues(const RooAbsArg* arg, const RooArgSet* nset, const Double_t* values) ;
+  Int_t batchStatus(const RooAbsArg* arg, const RooArgSet* nset) const ;
+  void setBatchStatus(const RooAbsArg* arg, const RooArgSet* nset, Bool_t canBatch) ;
+
+  // Integer data of the nodes calculated from the columns, kept for all batches
+  Int_t* indices(const RooAbsArg* arg, Bool_t& filled) ;
+  void clearIndices() ;
+
+protected:
+
+  typedef std::pair<const RooAbsArg*,const RooArgSet*> NodeKey ;
+  typedef std::pair<const RooAbsArg*,std::pair<Int_t,Int_t> > RangeKey ;
+
+  RooArgSet _obs ;                                     // Observables of the columns
+  Int_t _first ;                                       // First event of the current batch
+  Int_t _size ;                                        // Number of events of the current batch
+  std::map<const RooAbsArg*,const Double_t*> _columns ; // Column of each observable, starting at event 0
+  std::map<const RooAbsArg*,Bool_t> _depends ;         // Observable dependence of the nodes
+  std::map<NodeKey,Bool_t> _canBatch ;                 // Batch capability of the nodes, per normalization set
+  std::map<NodeKey,const Double_t*> _values ;          // Values of the nodes in the current batch
+  std::vector<std::vector<Double_t>*> _buffers ;       // Work buffers
+  std::map<RangeKey,std::vector<Int_t> > _indices ;    // Integer data of the nodes, per range of events
+  UInt_t _nUsedBuffers ;                               // Number of buffers used in the current batch
+
+private:
+  RooBatchData(const RooBatchData&) ;
+  RooBatchData& operator=(const RooBatchData&) ;
+} ;
+
+#endif
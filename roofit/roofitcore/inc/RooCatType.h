@@ -62,6 +62,12 @@ public:
     _value = other._value ; 
   } 
 
+  inline void assignFast(Int_t value) { 
+    // Fast assignment of the index value, as assignFast(const RooCatType&)
+    _label[0] = 0 ;
+    _value = value ; 
+  } 
+
   inline Bool_t operator==(const RooCatType& other) {
     // Equality operator with other RooCatType
     return (_value==other._value) ;
@@ -89,6 +89,11 @@ public:
   }
   virtual Bool_t isNonPoissonWeighted() const ;
 
+  ULong64_t contentVersion() const { 
+    // Return a counter that changes each time the bin contents are modified
+    return _contentVersion ; 
+  }
+
   Double_t sum(Bool_t correctForBinSize, Bool_t inverseCorr=kFALSE) const ;
   Double_t sum(const RooArgSet& sumSet, const RooArgSet& sliceSet, Bool_t correctForBinSize, Bool_t inverseCorr=kFALSE) ;
   Double_t sum(const RooArgSet& sumSet, const RooArgSet& sliceSet, Bool_t correctForBinSize, Bool_t inverseCorr, const std::map<const RooAbsArg*, std::pair<Double_t, Double_t> >& ranges);
@@ -127,6 +132,12 @@ public:
   void SetNameTitle(const char *name, const char* title) ;
 
   Int_t getIndex(const RooArgSet& coord, Bool_t fast=kFALSE) ;
+  Bool_t getBinIndices(const std::vector<const Double_t*>& values, Int_t n, Int_t* indices) const ;
+  const Double_t* weightArray() const {
+    // Return the array of the weights of the bins, indexed as getIndex()
+    checkInit() ;
+    return _wgt ;
+  }
 
   void removeSelfFromDir() { removeFromDir(this) ; }
   
@@ -187,6 +198,7 @@ protected:
 
   mutable Int_t _cache_sum_valid ; //! Is cache sum valid
   mutable Double_t _cache_sum ; //! Cache for sum of entries ;
+  ULong64_t _contentVersion ; //! Number of changes of the bin contents
 
 
 private:
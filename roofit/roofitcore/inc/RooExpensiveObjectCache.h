@@ -40,6 +40,21 @@ public:
 
   void importCacheObjects(RooExpensiveObjectCache& other, const char* ownerName, Bool_t verbose=kFALSE) ;
 
+  // Persistent store of numeric values, shared between jobs through a ROOT file
+  Bool_t setPersistentFile(const char* fileName) ;
+  const char* persistentFile() const { 
+    // Return name of the file of the persistent store, or zero if it is not active
+    return _persistFile.Length()>0 ? _persistFile.Data() : 0 ; 
+  }
+  Bool_t writePersistentFile() ;
+  Bool_t retrieveValue(const char* key, Double_t& value) ;
+  void registerValue(const char* key, Double_t value) ;
+  Int_t numPersistentHits() const { 
+    // Return number of values retrieved from the persistent store
+    return _persistHits ; 
+  }
+  static TString contentKey(const char* contents) ;
+
   static RooExpensiveObjectCache& instance() ;
 
   Int_t size() const { return _map.size() ; }
@@ -83,6 +98,14 @@ protected:
   static RooExpensiveObjectCache* _instance ;  //!
 
   std::map<TString,ExpensiveObject*> _map ;
+
+  Bool_t readPersistentFile(std::map<TString,Double_t>& values) const ;
+
+  TString _persistFile ;                        //! Name of the file of the persistent store
+  std::map<TString,Double_t> _persistValues ;   //! Values of the persistent store
+  std::map<TString,Double_t> _persistNew ;      //! Values added since the store was last written
+  Int_t _persistHits ;                          //! Number of values retrieved from the persistent store
+  Int_t _persistPid ;                           //! Process that selected the persistent store
  
   
   ClassDef(RooExpensiveObjectCache,2) // Singleton class that serves as session repository for expensive objects
@@ -0,0 +1,127 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ *    File: $Id$
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+#ifndef ROO_FLAT_FUNC
+#define ROO_FLAT_FUNC
+
+#include <map>
+#include <string>
+#include <vector>
+#include "Math/IFunction.h"
+#include "RooArgList.h"
+#include "TString.h"
+
+class RooAbsReal ;
+class RooAbsRealLValue ;
+class RooArgSet ;
+
+class RooFlatFunc : public ROOT::Math::IMultiGenFunction {
+
+public:
+
+  // Function of the values of the inputs of a node, with node specific data
+  typedef Double_t (*Kernel)(const Double_t* inputs, const void* data) ;
+  // Translation of a node into instructions, returning the slot of its value or -1
+  typedef Int_t (*Translator)(RooFlatFunc& prog, const RooAbsReal& node) ;
+
+  RooFlatFunc(const RooAbsReal& func, const RooArgList& params, const RooArgSet* nset=0) ;
+  RooFlatFunc(const RooFlatFunc& other) ;
+  virtual ~RooFlatFunc() ;
+
+  virtual ROOT::Math::IBaseFunctionMultiDim* Clone() const {
+    return new RooFlatFunc(*this) ;
+  }
+  unsigned int NDim() const { return _params.getSize() ; }
+
+  const RooArgList& params() const {
+    // Return parameters corresponding to the elements of the input array
+    return _params ;
+  }
+  Int_t numInstructions() const {
+    // Return number of instructions of the program
+    return _instr.size() ;
+  }
+  Int_t numFallbacks() const {
+    // Return number of nodes evaluated through the expression tree
+    return _nGraph ;
+  }
+
+  // Interface for the translators
+  Int_t input(const RooAbsReal& arg) ;
+  Int_t addConstant(Double_t value) ;
+  Int_t addSum(const std::vector<Int_t>& inputs) ;
+  Int_t addProduct(const std::vector<Int_t>& inputs) ;
+  Int_t addKernel(const std::vector<Int_t>& inputs, Kernel kernel, const void* data) ;
+  const RooArgSet* normSet() const {
+    // Return normalization set of the function
+    return _nset ;
+  }
+
+  // Translation of the events of a dataset
+  void setObservables(const RooArgSet* obs) ;
+  void nextEvent() ;
+  Bool_t eventFailed() const {
+    // Return true if a node depending on the observables could not be translated
+    return _eventFailed ;
+  }
+  void truncate(Int_t numInstr) ;
+
+  static Bool_t registerTranslator(const char* className, Translator translator) ;
+
+  // Code generation
+  TString generateCode(const char* funcName) const ;
+  Bool_t compile() ;
+  Bool_t isCompiled() const {
+    // Return true if the program is executed as compiled code
+    return _compiled!=0 ;
+  }
+
+  static Double_t evalNode(const void* node, const void* nset) ;
+
+protected:
+
+  enum OpCode { Param, Const, Sum, Prod, Call, Graph } ;
+  struct Instr {
+    Int_t _op ;            // Operation
+    Int_t _first ;         // Index of the first input in _args (Sum, Prod, Call) or of the parameter (Param)
+    Int_t _n ;             // Number of inputs
+    Double_t _value ;      // Value of a constant
+    Kernel _kernel ;       // Function of a Call
+    const void* _data ;    // Data of a Call or node of a Graph instruction
+  } ;
+
+  typedef Double_t (*CompiledFunc)(const Double_t* params) ;
+
+  Int_t addInstr(Int_t op, const std::vector<Int_t>& inputs) ;
+  Bool_t dependsOnObservables(const RooAbsReal& arg) ;
+  void syncParams(const Double_t* x) const ;
+  static std::map<std::string,Translator>& translators() ;
+
+  double DoEval(const double* x) const ;
+
+  RooArgList _params ;                         //! Parameters, in the order of the input array
+  std::vector<RooAbsRealLValue*> _lvalues ;    //! Parameters, for fast access
+  const RooArgSet* _nset ;                     //! Normalization set of the function
+  std::vector<Instr> _instr ;                  //! Program, in the order of execution
+  std::vector<Int_t> _args ;                   //! Inputs of the instructions
+  std::map<const RooAbsReal*,Int_t> _slots ;   //! Slot of the value of each translated node
+  const RooArgSet* _obs ;                      //! Observables of the events being translated
+  std::map<const RooAbsReal*,Int_t> _eventSlots ; //! Slot of the value of the nodes depending on the observables
+  std::map<const RooAbsReal*,Bool_t> _obsDep ; //! Dependence of the nodes on the observables
+  Bool_t _eventFailed ;                        //! A node depending on the observables could not be translated
+  Int_t _result ;                              //! Slot of the function value
+  Int_t _nGraph ;                              //! Number of Graph instructions
+  mutable std::vector<Double_t> _values ;      //! Values of the instructions
+  mutable std::vector<Double_t> _callArgs ;    //! Work space for the inputs of Call instructions
+  CompiledFunc _compiled ;                     //! Compiled program
+
+  ClassDef(RooFlatFunc,0) // Flattened evaluation program of a RooAbsReal expression
+};
+
+#endif
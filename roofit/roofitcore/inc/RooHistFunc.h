@@ -74,12 +74,18 @@ public:
   virtual std::list<Double_t>* plotSamplingHint(RooAbsRealLValue& obs, Double_t xlo, Double_t xhi) const ; 
   virtual Bool_t isBinnedDistribution(const RooArgSet&) const { return _intOrder==0 ; }
 
+  Int_t getBin() const ;
+  const Int_t* getBinBatch(RooBatchData& batch) const ;
+
 protected:
 
   Bool_t importWorkspaceHook(RooWorkspace& ws) ;
   Bool_t areIdentical(const RooDataHist& dh1, const RooDataHist& dh2) ;
 
   Double_t evaluate() const;
+  Bool_t transferObservables() const ;
+  virtual Bool_t canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const ;
+  virtual void evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const ;
   Double_t totalVolume() const ;
   friend class RooAbsCachedReal ;
   Double_t totVolume() const ;
@@ -49,6 +49,7 @@ public:
   void optimizeConst(Int_t flag) ;
   void setEvalErrorWall(Bool_t flag) { fitterFcn()->SetEvalErrorWall(flag); }
   void setOffsetting(Bool_t flag) ;
+  void setFlatEvaluation(Bool_t flag, Bool_t compile=kFALSE) ;
   void setMaxIterations(Int_t n) ;
   void setMaxFunctionCalls(Int_t n) ; 
 
@@ -29,6 +29,7 @@
 #include <fstream>
 
 class RooMinimizer;
+class RooFlatFunc;
 
 class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
 
@@ -52,6 +53,7 @@ class RooMinimizerFcn : public ROOT::Math::IBaseFunctionMultiDim {
   Bool_t SetLogFile(const char* inLogfile);
   std::ofstream* GetLogFile() { return _logfile; }
   void SetVerbose(Bool_t flag=kTRUE) { _verbose = flag ; }
+  void SetFlatEvaluation(Bool_t flag, Bool_t compile) { _doFlat = flag ; _compileFlat = compile ; }
 
   Double_t& GetMaxFCN() { return _maxFCN; }
   Int_t GetNumInvalidNLL() { return _numBadNLL; }
@@ -95,6 +97,10 @@ private:
   std::ofstream *_logfile;
   bool _verbose;
 
+  Bool_t _doFlat;              // Evaluate the function with a RooFlatFunc program
+  Bool_t _compileFlat;         // Compile the program
+  mutable RooFlatFunc* _flat;  // Program, built at the first evaluation
+
   RooArgList* _floatParamList;
   std::vector<RooAbsArg*> _floatParamVec ;
   RooArgList* _constParamList;
@@ -22,12 +22,14 @@
 #include <vector>
 
 class RooRealSumPdf ;
+class RooBatchData ;
+class RooFlatFunc ;
 
 class RooNLLVar : public RooAbsOptTestStatistic {
 public:
 
   // Constructors, assignment etc
-  RooNLLVar() { _first = kTRUE ; }
+  RooNLLVar() { _first = kTRUE ; _binnedBatchStatus = -1 ; _binnedBatch = 0 ; }
   RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbsData& data,
 	    const RooCmdArg& arg1=RooCmdArg::none(), const RooCmdArg& arg2=RooCmdArg::none(),const RooCmdArg& arg3=RooCmdArg::none(),
 	    const RooCmdArg& arg4=RooCmdArg::none(), const RooCmdArg& arg5=RooCmdArg::none(),const RooCmdArg& arg6=RooCmdArg::none(),
@@ -58,14 +60,28 @@ public:
 
   virtual Double_t defaultErrorLevel() const { return 0.5 ; }
 
+  static void setBatchEvaluation(Bool_t flag) ;
+  static Bool_t batchEvaluation() ;
+
+  static Int_t translateFlat(RooFlatFunc& prog, const RooAbsReal& node) ;
+
 protected:
 
   virtual Bool_t processEmptyDataSets() const { return _extended ; }
+  virtual Bool_t setDataSlave(RooAbsData& data, Bool_t cloneData=kTRUE, Bool_t ownNewDataAnyway=kFALSE) ;
 
   static RooArgSet _emptySet ; // Supports named argument constructor
 
   Bool_t _extended ;
   virtual Double_t evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t stepSize) const ;
+  Bool_t evaluateBatchPartition(Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry,
+				Double_t& sumWeight, Double_t& sumWeightCarry) const ;
+  Bool_t evaluateBinnedBatchPartition(Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry,
+				      Double_t& sumWeight, Double_t& sumWeightCarry) const ;
+  void initBinnedBatch() const ;
+  void clearBinnedBatch() ;
+  static Double_t flatBinKernel(const Double_t* in, const void* self) ;
+  static Bool_t _batchEvaluation ; // Use the batch evaluation of the p.d.f when it is supported
   Bool_t _weightSq ; // Apply weights squared?
   mutable Bool_t _first ; //!
   Double_t _offsetSaveW2; //!
@@ -73,6 +89,14 @@ protected:
 
   mutable std::vector<Double_t> _binw ; //!
   mutable RooRealSumPdf* _binnedPdf ; //!
+
+  // Batch evaluation of the binned likelihood
+  mutable Int_t _binnedBatchStatus ; //! -1: not initialized, 0: not supported, 1: enabled
+  mutable RooBatchData* _binnedBatch ; //! Observable values and cached bin indices of the p.d.f
+  mutable std::vector<Double_t> _binnedObs ; //! Value of the observable in each bin
+  mutable std::vector<Double_t> _binnedWeight ; //! Observed events in each bin
+  mutable std::vector<Double_t> _binnedLnGamma ; //! LnGamma(N+1) of each bin
+  mutable std::vector<Bool_t> _binnedValid ; //! Bin is valid in the dataset
    
   ClassDef(RooNLLVar,2) // Function representing (extended) -log(L) of p.d.f and dataset
 };
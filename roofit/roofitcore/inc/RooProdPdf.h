@@ -153,6 +153,10 @@ protected:
   RooAbsReal* specializeRatio(RooFormulaVar& input, const char* targetRangeName) const ;
   Double_t calculate(const RooProdPdf::CacheElem& cache, Bool_t verbose=kFALSE) const ;
   Double_t calculate(const RooArgList* partIntList, const RooLinkedList* normSetList) const ;
+  CacheElem* getCacheElem(const RooArgSet* nset) const ;
+
+  virtual Bool_t canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const ;
+  virtual void evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const ;
 
  
   friend class RooProdGenContext ;
@@ -82,6 +82,7 @@ protected:
   mutable Bool_t _valid;
 
   const RooArgSet& parameters() const ;
+  TString persistentCacheKey() const ;
 
   enum IntOperMode { Hybrid, Analytic, PassThrough } ;
   //friend class RooAbsPdf ;
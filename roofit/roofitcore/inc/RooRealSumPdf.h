@@ -81,6 +81,8 @@ protected:
   } ;
   mutable RooObjCacheManager _normIntMgr ; // The integration cache manager
 
+  virtual Bool_t canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const ;
+  virtual void evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const ;
 
   Bool_t _haveLastCoef ;
 
@@ -34,6 +34,7 @@ class RooArgList ;
 class TTree ;
 class RooFormulaVar ;
 class RooArgSet ;
+class RooBatchData ;
 
 class RooVectorDataStore : public RooAbsDataStore {
 public:
@@ -110,6 +111,10 @@ public:
 
   const RooVectorDataStore* cache() const { return _cache ; }
 
+  // Columnar access for the batch evaluation of functions (see RooAbsReal::getValBatch())
+  void addBatchColumns(RooBatchData& batch) const ;
+  const Double_t* weightArray() const ;
+
   void loadValues(const RooAbsDataStore *tds, const RooFormulaVar* select=0, const char* rangeName=0, Int_t nStart=0, Int_t nStop=2000000000) ;
   
   void dump() ;
@@ -135,12 +140,12 @@ public:
   class RealVector {
   public:
     RealVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _float(kFALSE), _nativeReal(0), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _fvec0(0), _tracker(0), _nset(0) { 
       _vec.reserve(initialCapacity);
     }
 
     RealVector(RooAbsReal* arg, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Double_t))) : 
-      _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _tracker(0), _nset(0) { 
+      _float(kFALSE), _nativeReal(arg), _real(0), _buf(0), _nativeBuf(0), _vec0(0), _fvec0(0), _tracker(0), _nset(0) { 
       _vec.reserve(initialCapacity);
     }
 
@@ -150,8 +155,9 @@ public:
     }
 
     RealVector(const RealVector& other, RooAbsReal* real=0) : 
-      _vec(other._vec), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0)   {
-      _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      _vec(other._vec), _fvec(other._fvec), _float(other._float), _nativeReal(real?real:other._nativeReal), _real(real?real:other._real), 
+      _buf(other._buf), _nativeBuf(other._nativeBuf), _nset(0)   {
+      updateVecPointers() ;
       if (other._tracker) {
 	_tracker = new RooChangeTracker(Form("track_%s",_nativeReal->GetName()),"tracker",other._tracker->parameters()) ;
       } else {
@@ -168,17 +174,29 @@ public:
       _real = other._real;
       _buf = other._buf;
       _nativeBuf = other._nativeBuf;
-      if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
-	std::vector<Double_t> tmp;
-	tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(Double_t)));
-	tmp.assign(other._vec.begin(), other._vec.end());
-	_vec.swap(tmp);
-      } else {
-	_vec = other._vec;
-      }
-      _vec0 = _vec.size()>0 ? &_vec.front() : 0;
+      _float = other._float;
+      assignVector(_vec, other._vec);
+      assignVector(_fvec, other._fvec);
+      updateVecPointers();
       return *this;
     }
+
+    // Store the values with float precision, converting the values already stored.
+    // Float columns are not handed out as arrays for the batch evaluation (see
+    // RooVectorDataStore::addBatchColumns()) and cannot hold the event weights
+    void setFloatPrecision() {
+      if (_float) return ;
+      _fvec.reserve(_vec.capacity()) ;
+      _fvec.assign(_vec.begin(),_vec.end()) ;
+      std::vector<Double_t> tmp ;
+      _vec.swap(tmp) ;
+      _float = kTRUE ;
+      updateVecPointers() ;
+    }
+
+    Bool_t isFloat() const { return _float ; }
+
+    Double_t value(Int_t idx) const { return _float ? _fvec[idx] : _vec[idx] ; }
     
     void setNset(RooArgSet* newNset) { _nset = newNset ? new RooArgSet(*newNset) : 0 ; }
 
@@ -212,12 +230,21 @@ public:
     }
 
     void fill() { 
+      if (_float) {
+	_fvec.push_back(*_buf) ;
+	_fvec0 = &_fvec.front() ;
+	return ;
+      }
       _vec.push_back(*_buf) ; 
       _vec0 = &_vec.front() ;
     } ;
 
     void write(Int_t i) {
 /*         std::cout << "write(" << this << ") [" << i << "] nativeReal = " << _nativeReal << " = " << _nativeReal->GetName() << " real = " << _real << " buf = " << _buf << " value = " << *_buf << " native getVal() = " << _nativeReal->getVal() << " getVal() = " << _real->getVal() << std::endl ;  */
+      if (_float) {
+	_fvec[i] = *_buf ;
+	return ;
+      }
       _vec[i] = *_buf ;
     }
     
@@ -225,42 +252,92 @@ public:
       // make sure the vector releases the underlying memory
       std::vector<Double_t> tmp;
       _vec.swap(tmp);
+      std::vector<Float_t> ftmp;
+      _fvec.swap(ftmp);
       _vec0 = 0;
+      _fvec0 = 0;
     }
 
     inline void get(Int_t idx) const { 
-      *_buf = *(_vec0+idx) ; 
+      *_buf = _float ? *(_fvec0+idx) : *(_vec0+idx) ; 
     }
 
     inline void getNative(Int_t idx) const { 
-      *_nativeBuf = *(_vec0+idx) ; 
+      *_nativeBuf = _float ? *(_fvec0+idx) : *(_vec0+idx) ; 
     }
 
-    Int_t size() const { return _vec.size() ; }
+    Int_t size() const { return _float ? _fvec.size() : _vec.size() ; }
 
     void resize(Int_t siz) {
-      if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Double_t))) {
+      if (_float) {
+	resizeVector(_fvec, siz);
+      } else {
+	resizeVector(_vec, siz);
+      }
+      updateVecPointers();
+    }
+
+    void reserve(Int_t siz) {
+      if (_float) {
+	_fvec.reserve(siz);
+      } else {
+	_vec.reserve(siz);
+      }
+      updateVecPointers();
+    }
+
+    void append(const RealVector& other, Int_t n) {
+      if (_float) {
+	if (other._float) {
+	  _fvec.insert(_fvec.end(), other._fvec.begin(), other._fvec.begin() + n);
+	} else {
+	  _fvec.insert(_fvec.end(), other._vec.begin(), other._vec.begin() + n);
+	}
+      } else {
+	if (other._float) {
+	  _vec.insert(_vec.end(), other._fvec.begin(), other._fvec.begin() + n);
+	} else {
+	  _vec.insert(_vec.end(), other._vec.begin(), other._vec.begin() + n);
+	}
+      }
+      updateVecPointers();
+    }
+
+  protected:
+    template<class T> static void resizeVector(std::vector<T>& vec, Int_t siz) {
+      if (siz < Int_t(vec.capacity()) / 2 && vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(T))) {
 	// do an expensive copy, if we save at least a factor 2 in size
-	std::vector<Double_t> tmp;
-	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(Double_t))));
-	if (!_vec.empty())
-	    tmp.assign(_vec.begin(), std::min(_vec.end(), _vec.begin() + siz));
+	std::vector<T> tmp;
+	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(T))));
+	if (!vec.empty())
+	    tmp.assign(vec.begin(), std::min(vec.end(), vec.begin() + siz));
 	if (Int_t(tmp.size()) != siz) 
 	    tmp.resize(siz);
-	_vec.swap(tmp);
+	vec.swap(tmp);
       } else {
-	_vec.resize(siz);
+	vec.resize(siz);
       }
-      _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
     }
 
-    void reserve(Int_t siz) {
-      _vec.reserve(siz);
+    template<class T> static void assignVector(std::vector<T>& vec, const std::vector<T>& other) {
+      if (other.size() <= vec.capacity() / 2 && vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(T))) {
+	std::vector<T> tmp;
+	tmp.reserve(std::max(other.size(), VECTOR_BUFFER_SIZE / sizeof(T)));
+	tmp.assign(other.begin(), other.end());
+	vec.swap(tmp);
+      } else {
+	vec = other;
+      }
+    }
+
+    void updateVecPointers() {
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
+      _fvec0 = _fvec.size() > 0 ? &_fvec.front() : 0;
     }
 
-  protected:
     std::vector<Double_t> _vec ;
+    std::vector<Float_t> _fvec ; // Values of float precision columns
+    Bool_t _float ; // Values are stored with float precision
 
   private:
     friend class RooVectorDataStore ;
@@ -269,9 +346,10 @@ public:
     Double_t* _buf ; //!
     Double_t* _nativeBuf ; //!
     Double_t* _vec0 ; //!
+    Float_t* _fvec0 ; //!
     RooChangeTracker* _tracker ; //
     RooArgSet* _nset ; //! 
-    ClassDef(RealVector,1) // STL-vector-based Data Storage class
+    ClassDef(RealVector,2) // STL-vector-based Data Storage class
   } ;
   
 
@@ -427,7 +505,7 @@ public:
 	    tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(Double_t))));
 	    if (!vlist[i]->empty())
 		tmp.assign(vlist[i]->begin(),
-			std::min(_vec.end(), _vec.begin() + siz));
+			std::min(vlist[i]->end(), vlist[i]->begin() + siz));
 	    if (Int_t(tmp.size()) != siz) 
 		tmp.resize(siz);
 	    vlist[i]->swap(tmp);
@@ -445,6 +523,13 @@ public:
       if (_vecEH) _vecEH->reserve(siz);
     }
 
+    void append(const RealFullVector& other, Int_t n) {
+      RealVector::append(other, n);
+      if (_vecE) _vecE->insert(_vecE->end(), other._vecE->begin(), other._vecE->begin() + n);
+      if (_vecEL) _vecEL->insert(_vecEL->end(), other._vecEL->begin(), other._vecEL->begin() + n);
+      if (_vecEH) _vecEH->insert(_vecEH->end(), other._vecEH->begin(), other._vecEH->begin() + n);
+    }
+
   private:
     friend class RooVectorDataStore ;
     Double_t *_bufE ; //!
@@ -460,13 +545,15 @@ public:
 
   class CatVector {
   public:
-    CatVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(RooCatType))) : 
+    // The categories are stored by index only: the label of a RooCatType is not
+    // copied by the assignment operators either
+    CatVector(UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Int_t))) : 
       _cat(0), _buf(0), _nativeBuf(0), _vec0(0)
     {
       _vec.reserve(initialCapacity);
     }
 
-    CatVector(RooAbsCategory* cat, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(RooCatType))) : 
+    CatVector(RooAbsCategory* cat, UInt_t initialCapacity=(VECTOR_BUFFER_SIZE / sizeof(Int_t))) : 
       _cat(cat), _buf(0), _nativeBuf(0), _vec0(0)
     {
       _vec.reserve(initialCapacity);
@@ -486,9 +573,9 @@ public:
       _cat = other._cat;
       _buf = other._buf;
       _nativeBuf = other._nativeBuf;
-      if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(RooCatType))) {
-	std::vector<RooCatType> tmp;
-	tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(RooCatType)));
+      if (other._vec.size() <= _vec.capacity() / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Int_t))) {
+	std::vector<Int_t> tmp;
+	tmp.reserve(std::max(other._vec.size(), VECTOR_BUFFER_SIZE / sizeof(Int_t)));
 	tmp.assign(other._vec.begin(), other._vec.end());
 	_vec.swap(tmp);
       } else {
@@ -508,15 +595,15 @@ public:
     }
     
     void fill() { 
-      _vec.push_back(*_buf) ; 
+      _vec.push_back(_buf->getVal()) ; 
       _vec0 = &_vec.front() ;
     } ;
     void write(Int_t i) { 
-      _vec[i]=*_buf ; 
+      _vec[i]=_buf->getVal() ; 
     } ;
     void reset() { 
       // make sure the vector releases the underlying memory
-      std::vector<RooCatType> tmp;
+      std::vector<Int_t> tmp;
       _vec.swap(tmp);
       _vec0 = 0;
     }
@@ -529,10 +616,10 @@ public:
     Int_t size() const { return _vec.size() ; }
 
     void resize(Int_t siz) {
-      if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(RooCatType))) {
+      if (siz < Int_t(_vec.capacity()) / 2 && _vec.capacity() > (VECTOR_BUFFER_SIZE / sizeof(Int_t))) {
 	// do an expensive copy, if we save at least a factor 2 in size
-	std::vector<RooCatType> tmp;
-	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(RooCatType))));
+	std::vector<Int_t> tmp;
+	tmp.reserve(std::max(siz, Int_t(VECTOR_BUFFER_SIZE / sizeof(Int_t))));
 	if (!_vec.empty())
 	    tmp.assign(_vec.begin(), std::min(_vec.end(), _vec.begin() + siz));
 	if (Int_t(tmp.size()) != siz) 
@@ -549,6 +636,11 @@ public:
       _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
     }
 
+    void append(const CatVector& other, Int_t n) {
+      _vec.insert(_vec.end(), other._vec.begin(), other._vec.begin() + n);
+      _vec0 = _vec.size() > 0 ? &_vec.front() : 0;
+    }
+
     void setBufArg(RooAbsCategory* arg) { _cat = arg; }
     const RooAbsCategory* bufArg() const { return _cat; }
 
@@ -557,9 +649,9 @@ public:
     RooAbsCategory* _cat ;
     RooCatType* _buf ;  //!
     RooCatType* _nativeBuf ;  //!
-    std::vector<RooCatType> _vec ;
-    RooCatType* _vec0 ; //!
-    ClassDef(CatVector,1) // STL-vector-based Data Storage class
+    std::vector<Int_t> _vec ; // Category indices
+    Int_t* _vec0 ; //!
+    ClassDef(CatVector,2) // STL-vector-based Data Storage class
   } ;
   
 
@@ -572,6 +664,8 @@ public:
   std::vector<RealFullVector*>& realfStoreList() { return _realfStoreList ; }
   std::vector<CatVector*>& catStoreList() { return _catStoreList ; }
 
+  Bool_t appendColumns(RooAbsDataStore& other) ;
+
   CatVector* addCategory(RooAbsCategory* cat) {
 
     CatVector* cv(0) ;
@@ -623,6 +717,9 @@ public:
     // If nothing found this will make an entry
     _realStoreList.push_back(new RealVector(real)) ;
     _nReal++ ;
+    if (real->getAttribute("StoreAsFloat")) {
+      _realStoreList.back()->setFloatPrecision() ;
+    }
 
     // Update cached ptr to first element as push_back may have reallocated
     _firstReal = &_realStoreList.front() ;
@@ -707,6 +804,9 @@ public:
     // If nothing found this will make an entry
     _realfStoreList.push_back(new RealFullVector(real)) ;
     _nRealF++ ;
+    if (real->getAttribute("StoreAsFloat")) {
+      _realfStoreList.back()->setFloatPrecision() ;
+    }
 
     // Update cached ptr to first element as push_back may have reallocated
     _firstRealF = &_realfStoreList.front() ;
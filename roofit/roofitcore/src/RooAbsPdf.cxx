@@ -157,7 +157,12 @@ the proxy holds a function, and will trigger an assert
 #include "RooMinimizer.h"
 #include "RooRealIntegral.h"
 #include "Math/CholeskyDecomp.h"
+#include "RooBatchData.h"
+#include "TProcPool.h"
 #include <string>
+#include <limits>
+#include <algorithm>
+#include <cstdlib>
 
 using namespace std;
 
@@ -311,6 +316,63 @@ Double_t RooAbsPdf::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the normalization integral over the observables in 'nset' does not
+/// depend on the observables of 'batch', so that getValBatchV() can divide all the
+/// events by the same value. This is not the case for p.d.f.s with conditional
+/// observables, e.g. a RooGaussian whose width is a per-event observable.
+
+Bool_t RooAbsPdf::canNormalizeBatch(RooBatchData& batch, const RooArgSet* nset) const
+{
+  if (!nset) return kTRUE ;
+
+  if (nset!=_normSet || _norm==0) {
+    syncNormalization(nset) ;
+  }
+
+  return !_norm->dependsOnValue(batch.observables()) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of getValV(): calculate the values of the p.d.f for the events of the
+/// current batch with evaluateBatch() and divide them by the normalization integral
+/// over the observables in 'nset', which is constant in the batch (see canNormalizeBatch()).
+/// Events for which the raw value is negative or NaN, or for which the normalization
+/// integral is not positive, get NaN as value; they are evaluation errors in getValV().
+
+void RooAbsPdf::getValBatchV(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const
+{
+  const Int_t n = batch.size() ;
+  const Double_t nan = std::numeric_limits<Double_t>::quiet_NaN() ;
+
+  // Special handling of case without normalization set (used in numeric integration of pdfs)
+  if (!nset) {
+    evaluateBatch(output,batch,0) ;
+    for (Int_t i=0 ; i<n ; i++) {
+      output[i] = (output[i]<0) ? nan : output[i] ;
+    }
+    return ;
+  }
+
+  if (nset!=_normSet || _norm==0) {
+    syncNormalization(nset) ;
+  }
+
+  evaluateBatch(output,batch,nset) ;
+
+  Double_t normVal(_norm->getVal()) ;
+  if (normVal<=0.) normVal = nan ;
+
+  for (Int_t i=0 ; i<n ; i++) {
+    // NaN values stay NaN in the division
+    output[i] = (output[i]<0) ? nan : output[i] / normVal ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Analytical integral with normalization (see RooAbsReal::analyticalIntegralWN() for further information)
 ///
@@ -1735,6 +1797,9 @@ RooDataSet *RooAbsPdf::generate(const RooArgSet& whatVars, Int_t nEvents, const
 ///                                       Binned generation cannot be used when prototype data is supplied
 /// Extended()                         -- The actual number of events generated will be sampled from a Poisson distribution
 ///                                       with mu=nevt. For use with extended maximum likelihood fits
+/// NumCPU(int num)                    -- Generate the events in num parallel worker processes, or in as many processes
+///                                       as there are cores if num is negative (see generateMultiProcess()).
+///                                       Not used with prototype data or expected data
 /// ProtoData(const RooDataSet& data,  -- Use specified dataset as prototype dataset. If randOrder is set to true
 ///                 Bool_t randOrder,     the order of the events in the dataset will be read in a random order
 ///                 Bool_t resample)      if the requested number of events to be generated does not match the
@@ -1766,6 +1831,7 @@ RooDataSet *RooAbsPdf::generate(const RooArgSet& whatVars, const RooCmdArg& arg1
   pc.defineInt("expectedData","ExpectedData",0,0) ;
   pc.defineDouble("nEventsD","NumEventsD",0,-1.) ;
   pc.defineString("binnedTag","GenBinned",0,"") ;
+  pc.defineInt("nCPU","NumCPU",0,1) ;
   pc.defineMutex("GenBinned","ProtoData") ;
     
   // Process and check varargs 
@@ -1787,6 +1853,7 @@ RooDataSet *RooAbsPdf::generate(const RooArgSet& whatVars, const RooCmdArg& arg1
   Double_t nEventsD = pc.getInt("nEventsD") ;
   //Bool_t verbose = pc.getInt("verbose") ;
   Bool_t expectedData = pc.getInt("expectedData") ;
+  Int_t nCPU = pc.getInt("nCPU") ;
 
   Double_t nEvents = (nEventsD>0) ? nEventsD : Double_t(nEventsI); 
 
@@ -1819,12 +1886,14 @@ RooDataSet *RooAbsPdf::generate(const RooArgSet& whatVars, const RooCmdArg& arg1
   RooDataSet* data ;
   if (protoData) {
     data = generate(whatVars,*protoData,Int_t(nEvents),verbose,randProto,resampleProto) ;
+  } else if (nCPU!=1 && !expectedData) {
+    data = generateMultiProcess(whatVars,nEvents,verbose,autoBinned,binnedTag,extended,nCPU) ;
   } else {
      data = generate(whatVars,nEvents,verbose,autoBinned,binnedTag,expectedData, extended) ;
   }
 
   // Rename dataset to given name if supplied
-  if (dsetName && strlen(dsetName)>0) {
+  if (data && dsetName && strlen(dsetName)>0) {
     data->SetName(dsetName) ;
   }
 
@@ -1982,6 +2051,100 @@ RooDataSet *RooAbsPdf::generate(const RooArgSet &whatVars, Double_t nEvents, Boo
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Generate the events in worker processes forked with TProcPool: nCPU processes,
+/// or as many as there are cores if nCPU is negative. This is called by generate()
+/// for the NumCPU() option. The number of events, fluctuated here in extended mode,
+/// is split among the workers, each of which generates its share with its own copy
+/// of the p.d.f and of the generator context and with a random seed drawn here from
+/// RooRandom. The result is thus reproducible for a given seed and number of workers,
+/// but differs from the one of a single process. The datasets of the workers are
+/// appended in the order of the workers.
+///
+/// Worker processes are used instead of threads because the evaluation of RooFit
+/// objects is not thread safe.
+
+RooDataSet *RooAbsPdf::generateMultiProcess(const RooArgSet &whatVars, Double_t nEvents, Bool_t verbose, Bool_t autoBinned, 
+					    const char* binnedTag, Bool_t extended, Int_t nCPU) const 
+{
+  // Number of events to generate in total
+  if (nEvents<=0) {
+    if (extendMode()==CanNotBeExtended) {
+      // Let the generator context report the error
+      return generate(whatVars,nEvents,verbose,autoBinned,binnedTag,kFALSE,extended) ;
+    }
+    nEvents = expectedEvents(&whatVars) ;
+  }
+  Int_t nTotal = Int_t(TMath::Ceil(nEvents)) ;
+  if (extended) {
+    nTotal = RooRandom::randomGenerator()->Poisson(nEvents) ;
+    cxcoutI(Generation) << " Extended mode active, number of events generated (" << nTotal << ") is Poisson fluctuation on " 
+			<< GetName() << "::expectedEvents() = " << nEvents << endl ;
+    if (nTotal==0) {
+      return new RooDataSet("emptyData","emptyData",whatVars) ;
+    }
+  }
+
+  TProcPool pool(nCPU>0 ? nCPU : 0) ;
+  Int_t nTasks = pool.GetNWorkers() ;
+  if (nTasks>nTotal) nTasks = nTotal ;
+  if (nTasks<2) {
+    return generate(whatVars,nTotal,verbose,autoBinned,binnedTag,kFALSE,kFALSE) ;
+  }
+
+  // Draw the seeds of the workers here, so that the result is reproducible
+  std::vector<UInt_t> tasks(nTasks) ;
+  std::vector<UInt_t> seeds(nTasks) ;
+  for (Int_t i=0 ; i<nTasks ; i++) {
+    tasks[i] = i ;
+    // Seeds are in [1,UINT_MAX]: a seed of 0 would make SetSeed() take the seed from the clock
+    seeds[i] = 1 + RooRandom::randomGenerator()->Integer(TMath::Limits<UInt_t>::Max()) ;
+  }
+
+  coutI(Generation) << "RooAbsPdf::generate(" << GetName() << ") generating " << nTotal << " events in " 
+		    << nTasks << " worker processes" << endl ;
+
+  // Executed in the worker processes. The name of the returned dataset is prefixed
+  // with the task number, and is empty if the generation failed.
+  auto genTask = [&](UInt_t task) -> RooDataSet* {
+    RooRandom::randomGenerator()->SetSeed(seeds[task]) ;
+    Int_t n = nTotal/nTasks + (Int_t(task)<nTotal%nTasks ? 1 : 0) ;
+    RooDataSet* data = generate(whatVars,n,verbose,autoBinned,binnedTag,kFALSE,kFALSE) ;
+    if (!data) data = new RooDataSet("","",whatVars) ;
+    data->SetName(TString::Format("%u:%s",task,data->GetName())) ;
+    return data ;
+  } ;
+  std::vector<RooDataSet*> outputs = pool.Map(genTask,tasks) ;
+
+  std::sort(outputs.begin(),outputs.end(),[](const RooDataSet* a, const RooDataSet* b) {
+    return atoi(a->GetName()) < atoi(b->GetName()) ;
+  }) ;
+
+  Bool_t ok = (Int_t(outputs.size())==nTasks) ;
+  RooDataSet* output(0) ;
+  for (UInt_t i=0 ; i<outputs.size() ; i++) {
+    const char* sep = strchr(outputs[i]->GetName(),':') ;
+    TString name(sep ? sep+1 : "") ;
+    if (name.Length()==0) ok = kFALSE ;
+    if (!output) {
+      output = outputs[i] ;
+      output->SetName(name) ;
+    } else {
+      output->append(*outputs[i]) ;
+      delete outputs[i] ;
+    }
+  }
+
+  if (!ok) {
+    coutE(Generation) << "RooAbsPdf::generate(" << GetName() << ") ERROR: event generation failed in a worker process" << endl ;
+    delete output ;
+    return 0 ;
+  }
+  return output ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal method  
 
@@ -40,6 +40,7 @@
 
 #include "RooAbsReal.h"
 #include "RooAbsReal.h"
+#include "RooBatchData.h"
 #include "RooArgSet.h"
 #include "RooArgList.h"
 #include "RooBinning.h"
@@ -103,8 +104,12 @@
 #include "TF3.h"
 #include "TMatrixD.h"
 #include "TVector.h"
+#include "TROOT.h"
+#include "TVirtualMutex.h"
 
 #include <sstream>
+#include <limits>
+#include <algorithm>
 
 using namespace std ;
 
@@ -266,6 +271,116 @@ Double_t RooAbsReal::getValV(const RooArgSet* nset) const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of this object for the events of the current batch of 'batch',
+/// as an array of batch.size() values owned by 'batch', valid until its next range.
+///
+/// Observables are read from the columns of 'batch', objects that do not depend
+/// on the observables are evaluated once with getVal(), and all other objects are
+/// calculated for the whole batch by getValBatchV(). Each object is evaluated only
+/// once per batch and normalization set. The batch evaluation must be supported by
+/// all the objects of the expression, check this first with canEvaluateBatch().
+///
+/// The values of events for which the evaluation fails are set to NaN, without
+/// logging an evaluation error: recalculate them with getVal() to get the error
+/// messages and the error handling of the event-by-event evaluation.
+
+const Double_t* RooAbsReal::getValBatch(RooBatchData& batch, const RooArgSet* nset) const
+{
+  const Double_t* values = batch.column(this) ;
+  if (values) return values ;
+
+  values = batch.values(this,nset) ;
+  if (values) return values ;
+
+  Double_t* output = batch.makeBuffer() ;
+  if (batch.dependsOnObservables(*this)) {
+    getValBatchV(output,batch,nset) ;
+  } else {
+    std::fill(output,output+batch.size(),getVal(nset)) ;
+  }
+  batch.setValues(this,nset,output) ;
+  return output ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if this object and all the objects it depends on can be evaluated
+/// with getValBatch() for the observables of 'batch' and normalization set 'nset'.
+/// The result is remembered by 'batch'.
+
+Bool_t RooAbsReal::canEvaluateBatch(RooBatchData& batch, const RooArgSet* nset) const
+{
+  if (batch.column(this) || !batch.dependsOnObservables(*this)) return kTRUE ;
+
+  Int_t status = batch.batchStatus(this,nset) ;
+  if (status>=0) return status==1 ;
+
+  Bool_t ret = canEvaluateBatchV(batch,nset) && canNormalizeBatch(batch,nset) ;
+  batch.setBatchStatus(this,nset,ret) ;
+  return ret ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if this object can calculate its values for a batch of events with
+/// evaluateBatch() and all its inputs can be evaluated with getValBatch().
+/// Classes implementing evaluateBatch() must override this function. This default
+/// implementation returns false.
+
+Bool_t RooAbsReal::canEvaluateBatchV(RooBatchData& /*batch*/, const RooArgSet* /*nset*/) const
+{
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the normalization applied by getValBatchV() for normalization set
+/// 'nset' is the same for all the events of 'batch'. Functions are not normalized,
+/// so this default implementation returns true.
+
+Bool_t RooAbsReal::canNormalizeBatch(RooBatchData& /*batch*/, const RooArgSet* /*nset*/) const
+{
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the values of this object for the events of the current batch into
+/// 'output'. This default implementation propagates the normalization set to the
+/// proxies as getValV() does and calls evaluateBatch().
+
+void RooAbsReal::getValBatchV(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const
+{
+  if (nset && nset!=_lastNSet) {
+    ((RooAbsReal*) this)->setProxyNormSet(nset) ;
+    _lastNSet = (RooArgSet*) nset ;
+  }
+  evaluateBatch(output,batch,nset) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): calculate the values of this object for the
+/// batch.size() events of the current batch into 'output', reading the values
+/// of the inputs with getValBatch(). Implementations should use simple loops
+/// over the events, which the compiler can vectorize.
+/// This default implementation is never called, since canEvaluateBatchV() returns false.
+
+void RooAbsReal::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  coutE(Eval) << "RooAbsReal::evaluateBatch(" << GetName() << ") ERROR: batch evaluation is not implemented by class "
+	      << IsA()->GetName() << endl ;
+  std::fill(output,output+batch.size(),std::numeric_limits<Double_t>::quiet_NaN()) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooAbsReal::numEvalErrorItems()
@@ -3581,6 +3696,9 @@ void RooAbsReal::logEvalError(const RooAbsReal* originator, const char* origName
     return ;
   }
 
+  // Errors may be logged concurrently by test statistics evaluated in threads
+  R__LOCKGUARD_IMT2(gROOTMutex) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
@@ -3636,6 +3754,9 @@ void RooAbsReal::logEvalError(const char* message, const char* serverValueString
     return ;
   }
 
+  // Errors may be logged concurrently by test statistics evaluated in threads
+  R__LOCKGUARD_IMT2(gROOTMutex) ;
+
   if (_evalErrorMode==CountErrors) {
     _evalErrorCount++ ;
     return ;
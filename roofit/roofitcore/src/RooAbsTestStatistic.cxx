@@ -32,6 +32,17 @@ organizes multi-processor parallel calculation of test statistic
 values. For the latter, the test statistic value is calculated in
 partitions in parallel executing processes and a posteriori
 combined in the main thread.
+
+If setMultiThreaded(kTRUE) is called before the test statistic is created,
+the partitions are instead calculated in threads of the implicit
+multi-threading pool (ROOT::EnableImplicitMT()). Each thread uses its own
+clone of the expression tree, its own copy of the parameters and its own
+copy of the dataset. Before each calculation the main thread copies the
+changed parameter values and constant flags to the thread copies, like the
+multi-processor mode sends them to the server processes. The partial
+results are combined in a fixed order, so that the result does not depend
+on the scheduling of the threads and is identical to the one of the
+multi-processor mode.
 **/
 
 
@@ -44,6 +55,7 @@ combined in the main thread.
 #include "RooAbsData.h"
 #include "RooArgSet.h"
 #include "RooRealVar.h"
+#include "RooCategory.h"
 #include "RooNLLVar.h"
 #include "RooRealMPFE.h"
 #include "RooErrorHandler.h"
@@ -51,14 +63,21 @@ combined in the main thread.
 #include "TTimeStamp.h"
 #include "RooProdPdf.h"
 #include "RooRealSumPdf.h"
+#include "TROOT.h"
 
 #include <string>
 
+#ifdef R__USE_IMT
+#include "tbb/parallel_for.h"
+#endif
+
 using namespace std;
 
 ClassImp(RooAbsTestStatistic)
 ;
 
+Bool_t RooAbsTestStatistic::_multiThreaded = kFALSE ;
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Default constructor
@@ -67,7 +86,7 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
   _func(0), _data(0), _projDeps(0), _splitRange(0), _simCount(0),
   _verbose(kFALSE), _init(kFALSE), _gofOpMode(Slave), _nEvents(0), _setNum(0),
   _numSets(0), _extSet(0), _nGof(0), _gofArray(0), _nCPU(1), _mpfeArray(0),
-  _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
+  _mtSerialEval(kTRUE), _mpinterl(RooFit::BulkPartition), _doOffset(kFALSE), _offset(0),
   _offsetCarry(0), _evalCarry(0)
 {
 }
@@ -85,6 +104,7 @@ RooAbsTestStatistic::RooAbsTestStatistic() :
 /// in each processing block many vary greatly thereby distributing the workload rather unevenly.
 /// If interleave is set to true, the interleave partitioning strategy is used where each partition
 /// i takes all bins for which (ibin % ncpu == i) which is more likely to result in an even workload.
+/// If setMultiThreaded(kTRUE) was called, the partitions are calculated in nCPU threads instead of processes.
 /// If splitCutRange is true, a different rangeName constructed as rangeName_{catName} will be used
 /// as range definition for each index state of a RooSimultaneous
 
@@ -105,6 +125,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
   _gofArray(0),
   _nCPU(nCPU),
   _mpfeArray(0),
+  _mtSerialEval(kTRUE),
   _mpinterl(interleave),
   _doOffset(kFALSE),
   _offset(0),
@@ -122,7 +143,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const char *name, const char *title, Ro
       _nCPU=1 ;
     }
 
-    _gofOpMode = MPMaster ;
+    _gofOpMode = _multiThreaded ? MTMaster : MPMaster ;
 
   } else {
 
@@ -164,6 +185,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
   _gofSplitMode(other._gofSplitMode),
   _nCPU(other._nCPU),
   _mpfeArray(0),
+  _mtSerialEval(kTRUE),
   _mpinterl(other._mpinterl),
   _doOffset(other._doOffset),
   _offset(other._offset),
@@ -179,7 +201,7 @@ RooAbsTestStatistic::RooAbsTestStatistic(const RooAbsTestStatistic& other, const
       _nCPU=1 ;
     }
       
-    _gofOpMode = MPMaster ;
+    _gofOpMode = (other._gofOpMode==MTMaster) ? MTMaster : MPMaster ;
 
   } else {
 
@@ -214,11 +236,14 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
     delete[] _mpfeArray ;
   }
 
-  if (SimMaster == _gofOpMode && _init) {
+  if ((SimMaster == _gofOpMode || MTMaster == _gofOpMode) && _init) {
     for (Int_t i = 0; i < _nGof; ++i) delete _gofArray[i];
     delete[] _gofArray ;
   }
 
+  for (UInt_t i = 0; i < _mtDataArray.size(); ++i) delete _mtDataArray[i];
+  for (UInt_t i = 0; i < _mtParamArray.size(); ++i) delete _mtParamArray[i];
+
   delete _projDeps ;
 
 }
@@ -230,7 +255,7 @@ RooAbsTestStatistic::~RooAbsTestStatistic()
 /// is calculated from on a RooSimultaneous, the test statistic calculation
 /// is performed separately on each simultaneous p.d.f component and associated
 /// data and then combined. If the test statistic calculation is parallelized
-/// partitions are calculated in nCPU processes and a posteriori combined.
+/// partitions are calculated in nCPU processes (or threads) and a posteriori combined.
 
 Double_t RooAbsTestStatistic::evaluate() const
 {
@@ -290,6 +315,47 @@ Double_t RooAbsTestStatistic::evaluate() const
     _evalCarry = carry;
     return ret ;
 
+  } else if (MTMaster == _gofOpMode) {
+
+    // Copy the current parameter values to the thread-private parameters
+    syncMTParameters() ;
+
+    // Calculate the partitions in parallel, each thread with its own test statistic
+    std::vector<Double_t> vals(_nGof), carries(_nGof) ;
+    auto evalGof = [&](Int_t i) {
+      vals[i] = _gofArray[i]->getValV() ;
+      carries[i] = _gofArray[i]->getCarry() ;
+    } ;
+
+    // The first calculation after a change of configuration is done serially,
+    // as it may create shared objects (normalization integrals, caches) on the fly
+    Bool_t parallel(kFALSE) ;
+#ifdef R__USE_IMT
+    parallel = !_mtSerialEval && _nGof>1 && ROOT::IsImplicitMTEnabled() ;
+    if (parallel) {
+      tbb::parallel_for(0, _nGof, evalGof) ;
+    }
+#endif
+    if (!parallel) {
+      for (Int_t i = 0; i < _nGof; ++i) evalGof(i) ;
+    }
+    _mtSerialEval = kFALSE ;
+
+    // Combine the partitions in a fixed order
+    Double_t sum(0), carry = 0.;
+    for (Int_t i = 0; i < _nGof; ++i) {
+      Double_t y = vals[i];
+      carry += carries[i];
+      y -= carry;
+      const Double_t t = sum + y;
+      carry = (t - sum) - y;
+      sum = t;
+    }
+
+    Double_t ret = sum ;
+    _evalCarry = carry;
+    return ret ;
+
   } else {
 
     // Evaluate as straight FUNC
@@ -345,6 +411,8 @@ Bool_t RooAbsTestStatistic::initialize()
   
   if (MPMaster == _gofOpMode) {
     initMPMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
+  } else if (MTMaster == _gofOpMode) {
+    initMTMode(_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   } else if (SimMaster == _gofOpMode) {
     initSimMode((RooSimultaneous*)_func,_data,_projDeps,_rangeName.size()?_rangeName.c_str():0,_addCoefRangeName.size()?_addCoefRangeName.c_str():0) ;
   }
@@ -386,7 +454,7 @@ Bool_t RooAbsTestStatistic::redirectServersHook(const RooAbsCollection& newServe
 
 void RooAbsTestStatistic::printCompactTreeHook(ostream& os, const char* indent)
 {
-  if (SimMaster == _gofOpMode) {
+  if (SimMaster == _gofOpMode || MTMaster == _gofOpMode) {
     // Forward to slaves
     os << indent << "RooAbsTestStatistic begin GOF contents" << endl ;
     for (Int_t i = 0; i < _nGof; ++i) {
@@ -424,6 +492,13 @@ void RooAbsTestStatistic::constOptimizeTestStatistic(ConstOpCode opcode, Bool_t
     for (Int_t i = 0; i < _nCPU; ++i) {
       _mpfeArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
     }
+  } else if (MTMaster == _gofOpMode) {
+    // The optimization depends on which parameters are constant
+    syncMTParameters() ;
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->constOptimizeTestStatistic(opcode,doAlsoTrackingOpt);
+    }
+    _mtSerialEval = kTRUE ;
   }
 }
 
@@ -481,6 +556,78 @@ void RooAbsTestStatistic::initMPMode(RooAbsReal* real, RooAbsData* data, const R
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Initialize multi-threaded calculation mode. Create one component test statistic
+/// per thread, each with its own clone of the expression tree, its own copy of the
+/// dataset and its own copy of the parameters, so that the threads share no
+/// objects that change during the calculation.
+
+void RooAbsTestStatistic::initMTMode(RooAbsReal* real, RooAbsData* data, const RooArgSet* projDeps, const char* rangeName, const char* addCoefRangeName)
+{
+  _nGof = _nCPU ;
+  _gofArray = new pRooAbsTestStatistic[_nGof] ;
+
+  for (Int_t i = 0; i < _nGof; ++i) {
+    RooAbsData* gofData = data->reduce(*data->get()) ;
+    _mtDataArray.push_back(gofData) ;
+
+    ccoutD(Eval) << "RooAbsTestStatistic::initMTMode: creating test statistic for thread #" << i << endl;
+    _gofArray[i] = create(Form("%s_GOF%d",GetName(),i),Form("%s_GOF%d",GetTitle(),i),*real,*gofData,*projDeps,rangeName,addCoefRangeName,1,_mpinterl,_verbose,_splitRange);
+
+    // Attach the thread test statistic to its own copy of the parameters
+    RooArgSet* params = (RooArgSet*) _paramSet.snapshot(kFALSE) ;
+    _mtParamArray.push_back(params) ;
+    _gofArray[i]->recursiveRedirectServers(*params);
+    _gofArray[i]->setMPSet(i,_nGof);
+  }
+  _mtSerialEval = kTRUE ;
+
+  coutI(Eval) << "RooAbsTestStatistic::initMTMode: created " << _nGof << " test statistics for calculation in threads" << endl;
+  return ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the values and constant flags of the parameters of this instance to the
+/// parameter copies of the thread test statistics. As for the server processes of
+/// the multi-processor mode, only changed values are copied, so that the caches of
+/// the thread test statistics stay valid for the other parameters.
+
+void RooAbsTestStatistic::syncMTParameters() const
+{
+  for (UInt_t i = 0; i < _mtParamArray.size(); ++i) {
+    RooFIter iter = _paramSet.fwdIterator() ;
+    RooAbsArg* arg ;
+    while ((arg = iter.next())) {
+      RooAbsArg* target = _mtParamArray[i]->find(arg->GetName()) ;
+      if (!target) continue ;
+
+      RooRealVar* rvar = dynamic_cast<RooRealVar*>(target) ;
+      if (rvar) {
+	Double_t value = ((RooAbsReal*)arg)->getVal() ;
+	if (rvar->getVal() != value) {
+	  rvar->setVal(value) ;
+	}
+	if (rvar->isConstant() != arg->isConstant()) {
+	  rvar->setConstant(arg->isConstant()) ;
+	}
+	continue ;
+      }
+
+      RooCategory* cat = dynamic_cast<RooCategory*>(target) ;
+      if (cat) {
+	Int_t index = ((RooAbsCategory*)arg)->getIndex() ;
+	if (cat->getIndex() != index) {
+	  cat->setIndex(index) ;
+	}
+      }
+    }
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize simultaneous p.d.f processing mode. Strip simultaneous
 /// p.d.f into individual components, split dataset in subset
@@ -662,6 +809,15 @@ Bool_t RooAbsTestStatistic::setData(RooAbsData& indata, Bool_t cloneData)
       }
     }
     break;
+  case MTMaster:
+    // Forward to the thread test statistics, each one needs its own copy of the data
+    for (Int_t i = 0; i < _nGof; ++i) {
+      _gofArray[i]->setData(indata, kTRUE);
+    }
+    for (UInt_t i = 0; i < _mtDataArray.size(); ++i) delete _mtDataArray[i];
+    _mtDataArray.clear();
+    _mtSerialEval = kTRUE ;
+    break;
   case MPMaster:
     // Not supported
     coutF(DataHandling) << "RooAbsTestStatistic::setData(" << GetName() << ") FATAL: setData() is not supported in multi-processor mode" << endl;
@@ -692,6 +848,7 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
     setValueDirty() ;
     break ;
   case SimMaster:
+  case MTMaster:
     _doOffset = flag;
     for (Int_t i = 0; i < _nGof; ++i) {
       _gofArray[i]->enableOffsetting(flag);
@@ -709,3 +866,26 @@ void RooAbsTestStatistic::enableOffsetting(Bool_t flag)
 
 Double_t RooAbsTestStatistic::getCarry() const
 { return _evalCarry; }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true, test statistics created afterwards with nCPU>1 calculate their
+/// partitions in threads of the implicit multi-threading pool instead of forking
+/// nCPU server processes. Without ROOT::EnableImplicitMT() the partitions are
+/// calculated one after the other in the main thread.
+
+void RooAbsTestStatistic::setMultiThreaded(Bool_t flag)
+{
+  _multiThreaded = flag ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if parallel calculations use threads instead of processes
+
+Bool_t RooAbsTestStatistic::isMultiThreaded()
+{
+  return _multiThreaded ;
+}
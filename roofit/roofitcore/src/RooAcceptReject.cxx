@@ -24,6 +24,22 @@ the accept/reject sampling technique on any positively valued function.
 The RooAcceptReject generator is used by the various generator context
 classes to take care of generation of observables for which p.d.fs
 do not define internal methods
+
+The trial events can be sampled in blocks, with the function evaluated for a
+whole block at once, if the function supports batch evaluation (see
+RooAbsReal::getValBatch()) and only real variables are generated. The random
+numbers are drawn in the same order as with the evaluation event by event,
+but the batch evaluation of a function may round differently (e.g. the
+vectorised TMath::Exp() of RooGaussian and RooExponential), so a trial event
+very close to the acceptance threshold may be decided differently and the
+generated events are not guaranteed to be identical. The size of the blocks is set
+by the blockSize parameter of the RooAcceptReject configuration. Its default
+of 1 evaluates the function event by event, so that toy studies generate the
+same events with the same seed as before; the blocks have to be enabled
+explicitly, e.g. with
+~~~ {.cpp}
+pdf.specialGeneratorConfig(kTRUE)->getConfigSection("RooAcceptReject").setRealValue("blockSize",1024) ;
+~~~
 **/
 
 
@@ -47,8 +63,10 @@ do not define internal methods
 #include "RooRealBinding.h"
 #include "RooNumGenFactory.h"
 #include "RooNumGenConfig.h"
+#include "RooBatchData.h"
 
 #include <assert.h>
+#include <algorithm>
 
 using namespace std;
 
@@ -65,9 +83,10 @@ void RooAcceptReject::registerSampler(RooNumGenFactory& fact)
   RooRealVar nTrial1D("nTrial1D","Number of trial samples for 1-dim generation",1000,0,1e9) ;
   RooRealVar nTrial2D("nTrial2D","Number of trial samples for 2-dim generation",100000,0,1e9) ;
   RooRealVar nTrial3D("nTrial3D","Number of trial samples for N-dim generation",10000000,0,1e9) ;
+  RooRealVar blockSize("blockSize","Number of trial samples evaluated together, 1 for event-by-event evaluation",1,1,1e6) ;
 
   RooAcceptReject* proto = new RooAcceptReject ;
-  fact.storeProtoSampler(proto,RooArgSet(nTrial0D,nTrial1D,nTrial2D,nTrial3D)) ;
+  fact.storeProtoSampler(proto,RooArgSet(nTrial0D,nTrial1D,nTrial2D,nTrial3D,blockSize)) ;
 }
 
 
@@ -79,12 +98,13 @@ void RooAcceptReject::registerSampler(RooNumGenFactory& fact)
 /// cloned and so will not be disturbed during the generation process.
 
 RooAcceptReject::RooAcceptReject(const RooAbsReal &func, const RooArgSet &genVars, const RooNumGenConfig& config, Bool_t verbose, const RooAbsReal* maxFuncVal) :
-  RooAbsNumGenerator(func,genVars,verbose,maxFuncVal), _nextCatVar(0), _nextRealVar(0)
+  RooAbsNumGenerator(func,genVars,verbose,maxFuncVal), _nextCatVar(0), _nextRealVar(0), _batch(0)
 {
   _minTrialsArray[0] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial0D")) ;
   _minTrialsArray[1] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial1D")) ;
   _minTrialsArray[2] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial2D")) ;
   _minTrialsArray[3] = static_cast<Int_t>(config.getConfigSection("RooAcceptReject").getRealValue("nTrial3D")) ;
+  _blockSize = static_cast<UInt_t>(config.getConfigSection("RooAcceptReject").getRealValue("blockSize",1)) ;
 
   _realSampleDim = _realVars.getSize() ;
   TIterator* iter = _catVars.createIterator() ;
@@ -156,6 +176,27 @@ RooAcceptReject::RooAcceptReject(const RooAbsReal &func, const RooArgSet &genVar
   _funcSum= 0;
   _totalEvents= 0;
   _eventsUsed= 0;
+
+  // Evaluate the function for blocks of trial events if all its objects that depend
+  // on the generated variables support it. The blocks are read from _trialValues.
+  if (_catVars.getSize()==0 && _realVars.getSize()>0 && _blockSize>1) {
+    _batch = new RooBatchData(_realVars) ;
+    _trialValues.resize(_realVars.getSize(),vector<Double_t>(_blockSize)) ;
+    _nextRealVar->Reset() ;
+    RooRealVar *real(0) ;
+    Int_t i(0) ;
+    while((real= (RooRealVar*)_nextRealVar->Next())) {
+      _batch->addColumn(real,&_trialValues[i++].front()) ;
+    }
+    if (!_funcClone->canEvaluateBatch(*_batch)) {
+      delete _batch ;
+      _batch = 0 ;
+      _trialValues.clear() ;
+    }
+  }
+  if (_verbose && _batch) {
+    ccoutI(Generation) << "  Function is evaluated for blocks of " << _blockSize << " trial events" << endl ;
+  }
 }
 
 
@@ -167,6 +208,7 @@ RooAcceptReject::~RooAcceptReject()
 {
   delete _nextCatVar;
   delete _nextRealVar;
+  delete _batch;
 }
 
 
@@ -189,7 +231,8 @@ const RooArgSet *RooAcceptReject::generateEvent(UInt_t remaining, Double_t& resa
     // maximum function value
 
     while(_totalEvents < _minTrials) {
-      addEventToCache();
+      // Add trial events up to the next reset of the cache at most
+      addEventsToCache(std::min(_minTrials-_totalEvents,UInt_t(1000001-_cache->numEntries())));
 
       // Limit cache size to 1M events
       if (_cache->numEntries()>1000000) {
@@ -225,14 +268,11 @@ const RooArgSet *RooAcceptReject::generateEvent(UInt_t remaining, Double_t& resa
       Long64_t extra= 1 + (Long64_t)(1.05*remaining/eff);
       cxcoutD(Generation) << "RooAcceptReject::generateEvent: adding " << extra << " events to the cache, eff = " << eff << endl;
       Double_t oldMax(_maxFuncVal);
-      while(extra--) {
-	addEventToCache();
-	if((_maxFuncVal > oldMax)) {
-	  cxcoutD(Generation) << "RooAcceptReject::generateEvent: estimated function maximum increased from "
-			      << oldMax << " to " << _maxFuncVal << endl;
-	  oldMax = _maxFuncVal ;
-	  // Trim cache here
-	}
+      addEventsToCache(extra);
+      if((_maxFuncVal > oldMax)) {
+	cxcoutD(Generation) << "RooAcceptReject::generateEvent: estimated function maximum increased from "
+			    << oldMax << " to " << _maxFuncVal << endl;
+	// Trim cache here
       }
     }
 
@@ -327,6 +367,76 @@ void RooAcceptReject::addEventToCache()
 
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add nEvents trial events to our cache and update our estimates of the function
+/// maximum value and integral, as nEvents calls to addEventToCache() do. If the
+/// function supports it, the trial events are sampled in blocks and the function
+/// is evaluated with getValBatch() for each block. The random numbers are drawn in
+/// the same order as in addEventToCache(), but the function values may differ by
+/// rounding.
+
+void RooAcceptReject::addEventsToCache(Long64_t nEvents) 
+{
+  if (!_batch) {
+    while(nEvents-- > 0) addEventToCache() ;
+    return ;
+  }
+
+  RooRealVar *real = 0;
+  while(nEvents>0) {
+
+    const UInt_t n = UInt_t(std::min(nEvents,Long64_t(_blockSize))) ;
+    nEvents -= n ;
+
+    // randomize each real argument of the trial events of the block
+    for (UInt_t k=0 ; k<n ; k++) {
+      _nextRealVar->Reset();
+      Int_t i(0) ;
+      while((real= (RooRealVar*)_nextRealVar->Next())) {
+	real->randomize();
+	_trialValues[i++][k] = real->getVal() ;
+      }
+    }
+
+    // calculate the function values of the block
+    _batch->clearIndices() ;
+    _batch->setRange(0,n) ;
+    const Double_t* vals = _funcClone->getValBatch(*_batch) ;
+
+    for (UInt_t k=0 ; k<n ; k++) {
+
+      _nextRealVar->Reset();
+      Int_t i(0) ;
+      while((real= (RooRealVar*)_nextRealVar->Next())) {
+	real->setVal(_trialValues[i++][k]) ;
+      }
+
+      Double_t val= vals[k] ;
+      if (!(val>=0)) {
+	// Negative or NaN value: let getVal() handle and report it
+	val = _funcClone->getVal() ;
+      }
+      _funcValPtr->setVal(val);
+
+      // Update the estimated integral and maximum value as in addEventToCache()
+      if(val > _maxFuncVal) _maxFuncVal= 1.05*val;
+      _funcSum+= val;
+
+      // fill a new entry in our cache dataset for this point
+      _cache->fill();
+      _totalEvents++;
+
+      if (_verbose &&_totalEvents%10000==0) {
+	cerr << "RooAcceptReject: generated " << _totalEvents << " events so far." << endl ;
+      }
+    }
+  }
+}
+
+
+
 Double_t RooAcceptReject::getFuncMax() 
 {
   // Empirically determine maximum value of function by taking a large number
@@ -335,7 +445,8 @@ Double_t RooAcceptReject::getFuncMax()
 
   // Generate the minimum required number of samples for a reliable maximum estimate
   while(_totalEvents < _minTrials) {
-    addEventToCache();
+    // Add trial events up to the next reset of the cache at most
+    addEventsToCache(std::min(_minTrials-_totalEvents,UInt_t(1000001-_cache->numEntries())));
 
     // Limit cache size to 1M events
     if (_cache->numEntries()>1000000) {
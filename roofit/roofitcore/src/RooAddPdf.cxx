@@ -75,6 +75,7 @@ of each coefficient_i.
 #include "RooGlobalFunc.h"
 #include "RooRealIntegral.h"
 #include "RooTrace.h"
+#include "RooBatchData.h"
 
 #include "Riostream.h"
 #include <algorithm>
@@ -860,6 +861,88 @@ Double_t RooAddPdf::evaluate() const
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// The sum can be evaluated for batches of events if the coefficients and their
+/// projection integrals do not depend on the observables and all the
+/// component p.d.f.s can be evaluated for batches of events
+
+Bool_t RooAddPdf::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const
+{
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  RooFIter ci = _coefList.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg = ci.next())) {
+    if (batch.dependsOnObservables(*arg)) return kFALSE ;
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+  const RooArgList* projLists[5] = { &cache->_suppNormList, &cache->_projList, &cache->_suppProjList,
+				     &cache->_refRangeProjList, &cache->_rangeProjList } ;
+  for (Int_t j=0 ; j<5 ; j++) {
+    RooFIter pi = projLists[j]->fwdIterator() ;
+    while((arg = pi.next())) {
+      if (batch.dependsOnObservables(*arg)) return kFALSE ;
+    }
+  }
+
+  RooFIter pi = _pdfList.fwdIterator() ;
+  RooAbsPdf* pdf ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    if (!pdf->canEvaluateBatch(batch,nset)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): add the values of the component p.d.f.s
+/// for the current batch of events, multiplied by their coefficients
+
+void RooAddPdf::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const
+{
+  if (nset==0 || nset->getSize()==0) {
+    if (_refCoefNorm.getSize()!=0) {
+      nset = &_refCoefNorm ;
+    }
+  }
+
+  CacheElem* cache = getProjCache(nset) ;
+  updateCoefficients(*cache,nset) ;
+
+  const Int_t n = batch.size() ;
+  std::fill(output,output+n,0.) ;
+
+  // Do running sum of coef/pdf pairs
+  RooAbsPdf* pdf ;
+  Int_t i(0) ;
+  RooFIter pi = _pdfList.fwdIterator() ;
+  while((pdf = (RooAbsPdf*)pi.next())) {
+    const Double_t* pdfVal = pdf->getValBatch(batch,nset) ;
+    if (pdf->isSelectedComp()) {
+      const Double_t coef = _coefCache[i] ;
+      if (cache->_needSupNorm) {
+	const Double_t snormVal = ((RooAbsReal*)cache->_suppNormList.at(i))->getVal() ;
+	for (Int_t k=0 ; k<n ; k++) {
+	  output[k] += pdfVal[k]*coef/snormVal ;
+	}
+      } else {
+	for (Int_t k=0 ; k<n ; k++) {
+	  output[k] += pdfVal[k]*coef ;
+	}
+      }
+    }
+    i++ ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Reset error counter to given value, limiting the number
 /// of future error messages for this pdf to 'resetValue'
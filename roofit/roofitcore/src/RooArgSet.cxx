@@ -44,6 +44,8 @@
 #include <fstream>
 #include <list>
 #include "TClass.h"
+#include "TROOT.h"
+#include "TVirtualMutex.h"
 #include "RooErrorHandler.h"
 #include "RooArgSet.h"
 #include "RooStreamParser.h"
@@ -105,6 +107,9 @@ void* RooArgSet::operator new (size_t bytes)
 {
   //cout << " RooArgSet::operator new(" << bytes << ")" << endl ;
 
+  // Sets may be created concurrently by test statistics evaluated in threads
+  R__LOCKGUARD_IMT2(gROOTMutex) ;
+
   if (!_poolBegin || _poolCur+(sizeof(RooArgSet)) >= _poolEnd) {
 
     if (_poolBegin!=0) {
@@ -179,6 +184,8 @@ void* RooArgSet::operator new (size_t bytes, void* ptr) noexcept
 
 void RooArgSet::operator delete (void* ptr)
 {
+  R__LOCKGUARD_IMT2(gROOTMutex) ;
+
   // Decrease use count in pool that ptr is on
   for (std::list<POOLDATA>::iterator poolIter =  _memPoolList.begin() ; poolIter!=_memPoolList.end() ; ++poolIter) {
     if ((char*)ptr > (char*)poolIter->_base && (char*)ptr < (char*)poolIter->_base + POOLSIZE) {
@@ -0,0 +1,194 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * @(#)root/roofitcore:$Id$
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\file RooBatchData.cxx
+\class RooBatchData
+\ingroup Roofitcore
+
+RooBatchData holds the input and the intermediate results of the batch
+evaluation of an expression (see RooAbsReal::getValBatch()) for a range of
+events. The values of the observables are read directly from columns, e.g.
+the vectors of a RooVectorDataStore (RooVectorDataStore::addBatchColumns()).
+The nodes of the expression store their values for the current range in work
+buffers owned by this object, so that nodes shared by several clients are
+evaluated only once per batch. The buffers are reused for the next range
+set with setRange().
+**/
+
+#include "RooFit.h"
+
+#include "RooBatchData.h"
+#include "RooAbsArg.h"
+
+using namespace std ;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor with the set of observables whose values are given by columns.
+/// Nodes that do not depend on these observables are constant in a batch.
+
+RooBatchData::RooBatchData(const RooArgSet& observables) :
+  _obs(observables), _first(0), _size(0), _nUsedBuffers(0)
+{
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+RooBatchData::~RooBatchData()
+{
+  for (UInt_t i=0 ; i<_buffers.size() ; i++) {
+    delete _buffers[i] ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Select the events [firstEvent,firstEvent+nEvents) as the current batch.
+/// The values calculated for the previous batch are forgotten and
+/// the work buffers are reused.
+
+void RooBatchData::setRange(Int_t firstEvent, Int_t nEvents)
+{
+  _first = firstEvent ;
+  _size = nEvents ;
+  _values.clear() ;
+  _nUsedBuffers = 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register the column of values of arg: values[i] is the value of arg in event i
+
+void RooBatchData::addColumn(const RooAbsArg* arg, const Double_t* values)
+{
+  _columns[arg] = values ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of arg in the events of the current batch if arg has a column,
+/// otherwise return zero
+
+const Double_t* RooBatchData::column(const RooAbsArg* arg) const
+{
+  map<const RooAbsArg*,const Double_t*>::const_iterator iter = _columns.find(arg) ;
+  if (iter==_columns.end() || iter->second==0) return 0 ;
+  return iter->second + _first ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the value of arg depends on the observables of the columns
+
+Bool_t RooBatchData::dependsOnObservables(const RooAbsArg& arg)
+{
+  map<const RooAbsArg*,Bool_t>::iterator iter = _depends.find(&arg) ;
+  if (iter!=_depends.end()) return iter->second ;
+  Bool_t ret = arg.dependsOnValue(_obs) ;
+  _depends[&arg] = ret ;
+  return ret ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return a work buffer for the values of the events of the current batch.
+/// The buffer remains valid until the next call to setRange().
+
+Double_t* RooBatchData::makeBuffer()
+{
+  if (_nUsedBuffers==_buffers.size()) {
+    _buffers.push_back(new vector<Double_t>) ;
+  }
+  vector<Double_t>* buf = _buffers[_nUsedBuffers++] ;
+  if (Int_t(buf->size())<_size) buf->resize(_size) ;
+  return buf->empty() ? 0 : &buf->front() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the values of arg, normalized to nset, calculated for the current batch,
+/// or zero if they have not been calculated yet
+
+const Double_t* RooBatchData::values(const RooAbsArg* arg, const RooArgSet* nset) const
+{
+  map<NodeKey,const Double_t*>::const_iterator iter = _values.find(NodeKey(arg,nset)) ;
+  return iter==_values.end() ? 0 : iter->second ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the values of arg, normalized to nset, for the current batch
+
+void RooBatchData::setValues(const RooAbsArg* arg, const RooArgSet* nset, const Double_t* values)
+{
+  _values[NodeKey(arg,nset)] = values ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the result of the check of the batch capability of arg with normalization set nset:
+/// 1 if it can be evaluated in batches, 0 if not, -1 if it has not been checked yet
+
+Int_t RooBatchData::batchStatus(const RooAbsArg* arg, const RooArgSet* nset) const
+{
+  map<NodeKey,Bool_t>::const_iterator iter = _canBatch.find(NodeKey(arg,nset)) ;
+  if (iter==_canBatch.end()) return -1 ;
+  return iter->second ? 1 : 0 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return an array of integers of size() elements associated to arg and to the
+/// current range of events, e.g. the bins of a histogram containing the events.
+/// Unlike the values, these arrays are kept when the range changes, so that data
+/// that only depend on the columns are calculated once for every range. 'filled' is
+/// set to true if the array has been returned before for the same range.
+
+Int_t* RooBatchData::indices(const RooAbsArg* arg, Bool_t& filled)
+{
+  std::vector<Int_t>& idx = _indices[RangeKey(arg,std::make_pair(_first,_size))] ;
+  filled = !idx.empty() || _size==0 ;
+  if (!filled) idx.resize(_size) ;
+  return idx.empty() ? 0 : &idx.front() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the integer data of the nodes of all ranges. This must be called when
+/// the values in the columns change, e.g. when they are refilled with new events.
+
+void RooBatchData::clearIndices()
+{
+  _indices.clear() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store the result of the check of the batch capability of arg with normalization set nset
+
+void RooBatchData::setBatchStatus(const RooAbsArg* arg, const RooArgSet* nset, Bool_t canBatch)
+{
+  _canBatch[NodeKey(arg,nset)] = canBatch ;
+}
@@ -50,6 +50,8 @@ or RooStringVar objects, thus data can be binned in real and/or discrete dimensi
 #include "RooTrace.h"
 #include "RooTreeData.h"
 
+#include <algorithm>
+
 using namespace std ;
 
 ClassImp(RooDataHist) 
@@ -78,6 +80,7 @@ RooDataHist::RooDataHist() : _pbinvCacheMgr(0,10)
   _curWgtErrHi = 0 ;
   _curWgtErrLo = 0 ;
   _cache_sum_valid = 0 ;
+  _contentVersion = 0 ;
   TRACE_CREATE
 }
 
@@ -101,7 +104,7 @@ RooDataHist::RooDataHist() : _pbinvCacheMgr(0,10)
 /// data hist as function of the threshold category instead of the real variable.
 
 RooDataHist::RooDataHist(const char *name, const char *title, const RooArgSet& vars, const char* binningName) : 
-  RooAbsData(name,title,vars), _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0)
+  RooAbsData(name,title,vars), _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0), _contentVersion(0)
 {
   // Initialize datastore
   _dstore = (defaultStorageType==Tree) ? ((RooAbsDataStore*) new RooTreeDataStore(name,title,_vars)) : 
@@ -139,7 +142,7 @@ RooDataHist::RooDataHist(const char *name, const char *title, const RooArgSet& v
 /// all missing dimensions will be projected.
 
 RooDataHist::RooDataHist(const char *name, const char *title, const RooArgSet& vars, const RooAbsData& data, Double_t wgt) :
-  RooAbsData(name,title,vars), _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0)
+  RooAbsData(name,title,vars), _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0), _contentVersion(0)
 {
   // Initialize datastore
   _dstore = (defaultStorageType==Tree) ? ((RooAbsDataStore*) new RooTreeDataStore(name,title,_vars)) : 
@@ -167,7 +170,7 @@ RooDataHist::RooDataHist(const char *name, const char *title, const RooArgSet& v
 RooDataHist::RooDataHist(const char *name, const char *title, const RooArgList& vars, RooCategory& indexCat, 
 			 map<string,TH1*> histMap, Double_t wgt) :
   RooAbsData(name,title,RooArgSet(vars,&indexCat)), 
-  _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0)
+  _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0), _contentVersion(0)
 {
   // Initialize datastore
   _dstore = (defaultStorageType==Tree) ? ((RooAbsDataStore*) new RooTreeDataStore(name,title,_vars)) : 
@@ -193,7 +196,7 @@ RooDataHist::RooDataHist(const char *name, const char *title, const RooArgList&
 RooDataHist::RooDataHist(const char *name, const char *title, const RooArgList& vars, RooCategory& indexCat, 
 			 map<string,RooDataHist*> dhistMap, Double_t wgt) :
   RooAbsData(name,title,RooArgSet(vars,&indexCat)), 
-  _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0)
+  _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0), _contentVersion(0)
 {
   // Initialize datastore
   _dstore = (defaultStorageType==Tree) ? ((RooAbsDataStore*) new RooTreeDataStore(name,title,_vars)) : 
@@ -214,7 +217,7 @@ RooDataHist::RooDataHist(const char *name, const char *title, const RooArgList&
 /// values are set accordingly on the arguments in 'vars'
 
 RooDataHist::RooDataHist(const char *name, const char *title, const RooArgList& vars, const TH1* hist, Double_t wgt) :
-  RooAbsData(name,title,vars), _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0)
+  RooAbsData(name,title,vars), _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0), _contentVersion(0)
 {
   // Initialize datastore
   _dstore = (defaultStorageType==Tree) ? ((RooAbsDataStore*) new RooTreeDataStore(name,title,_vars)) : 
@@ -272,7 +275,7 @@ RooDataHist::RooDataHist(const char *name, const char *title, const RooArgList&
 RooDataHist::RooDataHist(const char *name, const char *title, const RooArgList& vars, const RooCmdArg& arg1, const RooCmdArg& arg2, const RooCmdArg& arg3,
 			 const RooCmdArg& arg4,const RooCmdArg& arg5,const RooCmdArg& arg6,const RooCmdArg& arg7,const RooCmdArg& arg8) :
   RooAbsData(name,title,RooArgSet(vars,(RooAbsArg*)RooCmdConfig::decodeObjOnTheFly("RooDataHist::RooDataHist", "IndexCat",0,0,arg1,arg2,arg3,arg4,arg5,arg6,arg7,arg8))), 
-  _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0)
+  _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0), _contentVersion(0)
 {
   // Initialize datastore
   _dstore = (defaultStorageType==Tree) ? ((RooAbsDataStore*) new RooTreeDataStore(name,title,_vars)) : 
@@ -894,7 +897,7 @@ void RooDataHist::checkBinBounds() const
 /// Copy constructor
 
 RooDataHist::RooDataHist(const RooDataHist& other, const char* newname) :
-  RooAbsData(other,newname), RooDirItem(), _idxMult(other._idxMult), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(other._pbinvCacheMgr,0), _cache_sum_valid(0)
+  RooAbsData(other,newname), RooDirItem(), _idxMult(other._idxMult), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(other._pbinvCacheMgr,0), _cache_sum_valid(0), _contentVersion(0)
 {
   Int_t i ;
 
@@ -952,7 +955,7 @@ RooDataHist::RooDataHist(const RooDataHist& other, const char* newname) :
 RooDataHist::RooDataHist(const char* name, const char* title, RooDataHist* h, const RooArgSet& varSubset, 
 			 const RooFormulaVar* cutVar, const char* cutRange, Int_t nStart, Int_t nStop, Bool_t copyCache) :
   RooAbsData(name,title,varSubset),
-  _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0)
+  _wgt(0), _binValid(0), _curWeight(0), _curVolume(1), _pbinv(0), _pbinvCacheMgr(0,10), _cache_sum_valid(0), _contentVersion(0)
 {
   // Initialize datastore
   _dstore = new RooTreeDataStore(name,title,*h->_dstore,_vars,cutVar,cutRange,nStart,nStop,copyCache) ;
@@ -1115,6 +1118,34 @@ Int_t RooDataHist::calcTreeIndex() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the indices of the bins containing n points. values[i][k] is the value
+/// of the i-th observable of the histogram (in the order of get()) for the k-th point.
+/// Values outside the range of an observable are assigned to its first or last bin,
+/// as getIndex() does. Return false if an observable is not a real-valued variable.
+
+Bool_t RooDataHist::getBinIndices(const std::vector<const Double_t*>& values, Int_t n, Int_t* indices) const
+{
+  checkInit() ;
+  if (values.size()!=_lvbins.size()) return kFALSE ;
+  for (UInt_t i=0 ; i<_lvvars.size() ; i++) {
+    if (!dynamic_cast<RooAbsRealLValue*>(_lvvars[i])) return kFALSE ;
+  }
+
+  std::fill(indices,indices+n,0) ;
+  for (UInt_t i=0 ; i<_lvbins.size() ; i++) {
+    const RooAbsBinning* binning = _lvbins[i] ;
+    const Double_t* x = values[i] ;
+    const Int_t mult = _idxMult[i] ;
+    for (Int_t k=0 ; k<n ; k++) {
+      indices[k] += mult*binning->binNumber(x[k]) ;
+    }
+  }
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Debug stuff, should go...
 
@@ -1428,6 +1459,7 @@ void RooDataHist::add(const RooArgSet& row, Double_t wgt, Double_t sumw2)
   _errHi[idx] = -1 ;
 
   _cache_sum_valid = kFALSE ;
+  _contentVersion++ ;
 }
 
 
@@ -1448,6 +1480,7 @@ void RooDataHist::set(const RooArgSet& row, Double_t wgt, Double_t wgtErrLo, Dou
   _errHi[idx] = wgtErrHi ;  
 
   _cache_sum_valid = kFALSE ;
+  _contentVersion++ ;
 }
 
 
@@ -1471,6 +1504,7 @@ void RooDataHist::set(Double_t wgt, Double_t wgtErr)
   _sumw2[_curIndex] = wgtErr*wgtErr ;
 
   _cache_sum_valid = kFALSE ;
+  _contentVersion++ ;
 }
 
 
@@ -1492,6 +1526,7 @@ void RooDataHist::set(const RooArgSet& row, Double_t wgt, Double_t wgtErr)
   _sumw2[idx] = wgtErr*wgtErr ;
 
   _cache_sum_valid = kFALSE ;
+  _contentVersion++ ;
 }
 
 
@@ -1545,6 +1580,7 @@ void RooDataHist::add(const RooAbsData& dset, const RooFormulaVar* cutVar, Doubl
   } 
 
   _cache_sum_valid = kFALSE ;
+  _contentVersion++ ;
 }
 
 
@@ -1920,6 +1956,7 @@ void RooDataHist::reset()
   _curVolume = 1 ;
 
   _cache_sum_valid = kFALSE ;
+  _contentVersion++ ;
 
 }
 
@@ -1976,6 +2013,7 @@ void RooDataHist::setAllWeights(Double_t value)
   }
 
   _cache_sum_valid = kFALSE ;
+  _contentVersion++ ;
 }
 
 
@@ -24,6 +24,14 @@ for objects that are expensive to calculate. Owners of such objects
 can registers these here with associated parameter values for which
 the object is valid, so that other instances can, at a later moment
 retrieve these precalculated objects
+
+Numeric values, like the numeric integrals of RooRealIntegral, can in addition
+be kept in a persistent store in a ROOT file (see setPersistentFile()), so
+that they are reused by later jobs. The values of this store are addressed
+by a hash of a description of their full contents (see contentKey()), e.g.
+the expression, the values of its parameters and the integration configuration,
+instead of by the name of the object. New values are written to the file only
+by an explicit call of writePersistentFile().
 **/
 
 
@@ -34,6 +42,11 @@ retrieve these precalculated objects
 #include "RooAbsCategory.h"
 #include "RooArgSet.h"
 #include "RooMsgService.h"
+#include "TFile.h"
+#include "TTree.h"
+#include "TMD5.h"
+#include "TSystem.h"
+#include "TLockFile.h"
 #include <iostream>
 #include <math.h>
 using namespace std ;
@@ -50,7 +63,7 @@ RooExpensiveObjectCache* RooExpensiveObjectCache::_instance = 0 ;
 ////////////////////////////////////////////////////////////////////////////////
 /// Constructor
 
-RooExpensiveObjectCache::RooExpensiveObjectCache() : _nextUID(0)
+RooExpensiveObjectCache::RooExpensiveObjectCache() : _nextUID(0), _persistHits(0), _persistPid(0)
 {
 }
 
@@ -60,7 +73,7 @@ RooExpensiveObjectCache::RooExpensiveObjectCache() : _nextUID(0)
 /// Copy constructor
 
 RooExpensiveObjectCache::RooExpensiveObjectCache(const RooExpensiveObjectCache& other) :
-  TObject(other), _nextUID(0)
+  TObject(other), _nextUID(0), _persistHits(0), _persistPid(0)
 {
 }
 
@@ -235,6 +248,175 @@ void RooExpensiveObjectCache::clearAll()
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Use the ROOT file fileName as persistent store of numeric values (see retrieveValue()
+/// and registerValue()). The values already in the file are loaded, the file is created
+/// when values are first written. New values are only written by an explicit call of
+/// writePersistentFile(), or when another file is selected here. Several jobs may share
+/// the same file: each of them adds its new values to the values found in the file
+/// when writing it. A null fileName switches off the persistent store. Return kTRUE
+/// in case of error.
+
+Bool_t RooExpensiveObjectCache::setPersistentFile(const char* fileName) 
+{
+  writePersistentFile() ;
+
+  _persistFile = fileName ? fileName : "" ;
+  _persistValues.clear() ;
+  _persistNew.clear() ;
+  _persistHits = 0 ;
+  _persistPid = gSystem->GetPid() ;
+  if (!fileName) return kFALSE ;
+
+  if (readPersistentFile(_persistValues)) {
+    _persistFile = "" ;
+    return kTRUE ;
+  }
+  coutI(Caching) << "RooExpensiveObjectCache::setPersistentFile() using persistent store " << fileName 
+		 << " with " << _persistValues.size() << " values" << endl ;
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Read the values of the persistent store file into 'values'. A file that does
+/// not exist yet is an empty store. Return kTRUE in case of error.
+
+Bool_t RooExpensiveObjectCache::readPersistentFile(std::map<TString,Double_t>& values) const
+{
+  if (gSystem->AccessPathName(_persistFile)) return kFALSE ;
+
+  TFile* f = TFile::Open(_persistFile) ;
+  if (!f || f->IsZombie()) {
+    coutE(Caching) << "RooExpensiveObjectCache::readPersistentFile() ERROR: cannot open persistent store " << _persistFile << endl ;
+    delete f ;
+    return kTRUE ;
+  }
+
+  TTree* tree(0) ;
+  f->GetObject("RooExpensiveObjectCache",tree) ;
+  if (tree) {
+    char key[64] ;
+    Double_t value ;
+    tree->SetBranchAddress("key",key) ;
+    tree->SetBranchAddress("value",&value) ;
+    for (Long64_t i=0 ; i<tree->GetEntries() ; i++) {
+      tree->GetEntry(i) ;
+      values[key] = value ;
+    }
+  }
+  delete f ;
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the values added since the persistent store was read to its file, together
+/// with the values written to the file by other jobs in the meantime. Jobs writing
+/// the same store are serialized with the lock file <store>.lock, and the file is
+/// replaced by renaming a new file, so that jobs reading it concurrently never see a
+/// partially written store. Processes forked after the store was selected (e.g. the
+/// workers of TProcPool) do not write it: their new values are dropped.
+/// Return kTRUE in case of error.
+
+Bool_t RooExpensiveObjectCache::writePersistentFile() 
+{
+  if (_persistFile.Length()==0 || _persistNew.empty()) return kFALSE ;
+
+  if (gSystem->GetPid()!=_persistPid) {
+    _persistNew.clear() ;
+    return kFALSE ;
+  }
+
+  // Stale locks of crashed jobs are removed after 60 seconds
+  TLockFile lock(_persistFile + ".lock",60) ;
+
+  std::map<TString,Double_t> values ;
+  readPersistentFile(values) ;
+  for (std::map<TString,Double_t>::iterator iter = _persistNew.begin() ; iter!=_persistNew.end() ; ++iter) {
+    values[iter->first] = iter->second ;
+  }
+
+  TString tmpName = Form("%s.%d.tmp",_persistFile.Data(),gSystem->GetPid()) ;
+  TFile* f = TFile::Open(tmpName,"RECREATE") ;
+  if (!f || f->IsZombie()) {
+    coutE(Caching) << "RooExpensiveObjectCache::writePersistentFile() ERROR: cannot create " << tmpName << endl ;
+    delete f ;
+    return kTRUE ;
+  }
+
+  TTree* tree = new TTree("RooExpensiveObjectCache","Persistent store of RooFit numeric values") ;
+  char key[64] ;
+  Double_t value ;
+  tree->Branch("key",key,"key/C") ;
+  tree->Branch("value",&value,"value/D") ;
+  for (std::map<TString,Double_t>::iterator iter = values.begin() ; iter!=values.end() ; ++iter) {
+    strlcpy(key,iter->first.Data(),sizeof(key)) ;
+    value = iter->second ;
+    tree->Fill() ;
+  }
+  tree->Write() ;
+  delete f ;
+
+  if (gSystem->Rename(tmpName,_persistFile)) {
+    coutE(Caching) << "RooExpensiveObjectCache::writePersistentFile() ERROR: cannot replace " << _persistFile << endl ;
+    gSystem->Unlink(tmpName) ;
+    return kTRUE ;
+  }
+
+  coutI(Caching) << "RooExpensiveObjectCache::writePersistentFile() wrote " << _persistNew.size() << " new values to persistent store " 
+		 << _persistFile << " (" << values.size() << " values, " << _persistHits << " values reused)" << endl ;
+  _persistValues.swap(values) ;
+  _persistNew.clear() ;
+  return kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Retrieve the value stored under the given key in the persistent store. Return
+/// kTRUE and set 'value' if it is found, return kFALSE otherwise.
+
+Bool_t RooExpensiveObjectCache::retrieveValue(const char* key, Double_t& value) 
+{
+  std::map<TString,Double_t>::iterator iter = _persistValues.find(key) ;
+  if (iter==_persistValues.end()) return kFALSE ;
+  value = iter->second ;
+  _persistHits++ ;
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Store a value under the given key in the persistent store. The value is
+/// written to the file by the next call to writePersistentFile().
+
+void RooExpensiveObjectCache::registerValue(const char* key, Double_t value) 
+{
+  if (_persistFile.Length()==0) return ;
+  _persistValues[key] = value ;
+  _persistNew[key] = value ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key of a value in the persistent store: the MD5 hash of the
+/// description 'contents' of everything the value depends on
+
+TString RooExpensiveObjectCache::contentKey(const char* contents) 
+{
+  TMD5 md5 ;
+  md5.Update((const UChar_t*)contents,strlen(contents)) ;
+  md5.Final() ;
+  return md5.AsString() ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Construct ExpensiveObject oject for inPayLoad and store reference values
 /// for all RooAbsReal and RooAbsCategory parameters in params.
@@ -338,6 +520,11 @@ void RooExpensiveObjectCache::print() const
     iter->second->print() ;    
     ++iter ;
   }
+
+  if (_persistFile.Length()>0) {
+    cout << "persistent store " << _persistFile << ": " << _persistValues.size() << " values, " << _persistNew.size() 
+	 << " not yet written, " << _persistHits << " values reused" << endl ;
+  }
 }
 
 
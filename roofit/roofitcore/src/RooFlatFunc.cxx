@@ -0,0 +1,575 @@
+/*****************************************************************************
+ * Project: RooFit                                                           *
+ * Package: RooFitCore                                                       *
+ * @(#)root/roofitcore:$Id$
+ *                                                                           *
+ * Redistribution and use in source and binary forms,                        *
+ * with or without modification, are permitted according to the terms        *
+ * listed in LICENSE (http://roofit.sourceforge.net/license.txt)             *
+ *****************************************************************************/
+
+/**
+\file RooFlatFunc.cxx
+\class RooFlatFunc
+\ingroup Roofitcore
+
+RooFlatFunc is a flattened version of the expression tree of a RooAbsReal,
+exported as a ROOT::Math::IMultiGenFunction of a given list of parameters,
+so that it can be passed directly to a ROOT::Math::Minimizer.
+
+At construction the tree is walked once and translated into a program:
+a topologically sorted list of simple instructions (load parameter,
+constant, sum, product, call of a kernel function) that operate on an
+array of values, without virtual dispatch, proxies, normalization set
+lookups or dirty state propagation. Nodes that do not depend on the
+parameters are evaluated once and become constants of the program, so the
+observables and the other variables must not change while the program is
+used. Nodes that cannot be translated are evaluated through the expression
+tree with RooAbsReal::getVal(), after the parameter values have been copied
+to the RooAbsRealLValue parameters.
+
+Test statistics are translated event by event: the binned likelihood of a
+RooNLLVar (see RooNLLVar::translateFlat()) loads each bin of its dataset,
+and translates the p.d.f for that bin, between setObservables() and the
+last nextEvent(). The nodes that depend on the observables get new slots
+for each event; the others are shared by all events. If a node of an event
+cannot be translated, the translator removes its instructions with truncate()
+and the whole test statistic is evaluated through the expression tree. The
+program then calculates the value of the likelihood including the offset
+hiding state of RooAbsReal::hideOffset() at construction. RooMinimizer uses
+the program with RooMinimizer::setFlatEvaluation().
+
+RooAddition, RooProduct and the unnormalized RooRealSumPdf are translated by
+RooFitCore. Other classes can provide a translation with registerTranslator(),
+as done by RooNLLVar and the HistFactory interpolation classes. With compile(),
+the program is turned into C++ code that is compiled by the interpreter.
+**/
+
+#include "RooFit.h"
+
+#include "RooFlatFunc.h"
+#include "RooAbsReal.h"
+#include "RooAbsRealLValue.h"
+#include "RooAbsCategory.h"
+#include "RooAddition.h"
+#include "RooProduct.h"
+#include "RooRealSumPdf.h"
+#include "RooArgSet.h"
+#include "RooMsgService.h"
+#include "TInterpreter.h"
+#include "TMath.h"
+
+using namespace std ;
+
+ClassImp(RooFlatFunc)
+;
+
+
+namespace {
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Translate a RooAddition into the sum of its terms
+
+  Int_t translateAddition(RooFlatFunc& prog, const RooAbsReal& node)
+  {
+    vector<Int_t> inputs ;
+    RooFIter iter = static_cast<const RooAddition&>(node).list().fwdIterator() ;
+    RooAbsArg* arg ;
+    while((arg=iter.next())) {
+      inputs.push_back(prog.input(static_cast<const RooAbsReal&>(*arg))) ;
+    }
+    return prog.addSum(inputs) ;
+  }
+
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Translate a RooProduct into the product of its terms. Category terms must
+  /// not depend on the parameters
+
+  Int_t translateProduct(RooFlatFunc& prog, const RooAbsReal& node)
+  {
+    vector<Int_t> inputs ;
+    RooArgList comps = const_cast<RooProduct&>(static_cast<const RooProduct&>(node)).components() ;
+    RooFIter iter = comps.fwdIterator() ;
+    RooAbsArg* arg ;
+    while((arg=iter.next())) {
+      RooAbsReal* rcomp = dynamic_cast<RooAbsReal*>(arg) ;
+      if (rcomp) {
+	inputs.push_back(prog.input(*rcomp)) ;
+      } else {
+	if (arg->dependsOnValue(prog.params())) return -1 ;
+	inputs.push_back(prog.addConstant(static_cast<RooAbsCategory*>(arg)->getIndex())) ;
+      }
+    }
+    return prog.addProduct(inputs) ;
+  }
+
+  ////////////////////////////////////////////////////////////////////////////////
+  /// Translate the unnormalized value of a RooRealSumPdf, as used by binned likelihoods,
+  /// into the sum of the products of its functions and coefficients. Sums without
+  /// a coefficient for each function or with a floor at zero are not translated.
+  /// The selection of components for plotting is not applied.
+
+  Int_t translateRealSumPdf(RooFlatFunc& prog, const RooAbsReal& node)
+  {
+    const RooRealSumPdf& pdf = static_cast<const RooRealSumPdf&>(node) ;
+    if (prog.normSet() && !pdf.selfNormalized()) return -1 ;
+    if (pdf.coefList().getSize()!=pdf.funcList().getSize()) return -1 ;
+    if (pdf.getFloor() || RooRealSumPdf::getFloorGlobal()) return -1 ;
+
+    vector<Int_t> terms ;
+    RooFIter funcIter = pdf.funcList().fwdIterator() ;
+    RooFIter coefIter = pdf.coefList().fwdIterator() ;
+    RooAbsReal* func ;
+    while((func=static_cast<RooAbsReal*>(funcIter.next()))) {
+      RooAbsReal* coef = static_cast<RooAbsReal*>(coefIter.next()) ;
+      vector<Int_t> factors ;
+      factors.push_back(prog.input(*func)) ;
+      factors.push_back(prog.input(*coef)) ;
+      terms.push_back(prog.addProduct(factors)) ;
+    }
+    return prog.addSum(terms) ;
+  }
+
+  Bool_t registerCoreTranslators = RooFlatFunc::registerTranslator("RooAddition",translateAddition) &&
+                                   RooFlatFunc::registerTranslator("RooProduct",translateProduct) &&
+                                   RooFlatFunc::registerTranslator("RooRealSumPdf",translateRealSumPdf) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor from the function and the parameters that correspond to the elements
+/// of the input array. The parameters must be RooAbsRealLValue. The function value
+/// is calculated with normalization set nset.
+
+RooFlatFunc::RooFlatFunc(const RooAbsReal& func, const RooArgList& params, const RooArgSet* nset) :
+  _nset(nset), _obs(0), _eventFailed(kFALSE), _result(-1), _nGraph(0), _compiled(0)
+{
+  RooFIter iter = params.fwdIterator() ;
+  RooAbsArg* arg ;
+  while((arg=iter.next())) {
+    RooAbsRealLValue* lvalue = dynamic_cast<RooAbsRealLValue*>(arg) ;
+    if (!lvalue) {
+      oocoutE((TObject*)0,InputArguments) << "RooFlatFunc::ctor(" << func.GetName() << ") ERROR: parameter "
+					   << arg->GetName() << " is not a real-valued lvalue and is ignored" << endl ;
+      continue ;
+    }
+    _params.add(*lvalue) ;
+    _lvalues.push_back(lvalue) ;
+  }
+
+  // The first instructions load the parameters
+  for (UInt_t i=0 ; i<_lvalues.size() ; i++) {
+    Instr instr = { Param, Int_t(i), 0, 0., 0, 0 } ;
+    _instr.push_back(instr) ;
+    _slots[_lvalues[i]] = i ;
+  }
+
+  _result = input(func) ;
+  _values.resize(_instr.size()) ;
+
+  oocoutI((TObject*)0,Optimization) << "RooFlatFunc::ctor(" << func.GetName() << ") flattened expression into "
+				     << _instr.size() << " instructions, " << _nGraph
+				     << " nodes are evaluated through the expression tree" << endl ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy constructor. The copy evaluates the same expression tree.
+
+RooFlatFunc::RooFlatFunc(const RooFlatFunc& other) :
+  ROOT::Math::IMultiGenFunction(other),
+  _params(other._params),
+  _lvalues(other._lvalues),
+  _nset(other._nset),
+  _instr(other._instr),
+  _args(other._args),
+  _slots(other._slots),
+  _obs(0),
+  _eventFailed(kFALSE),
+  _result(other._result),
+  _nGraph(other._nGraph),
+  _values(other._values),
+  _callArgs(other._callArgs),
+  _compiled(other._compiled)
+{
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor
+
+RooFlatFunc::~RooFlatFunc()
+{
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the slot of the value of arg in the program, translating arg and its
+/// servers if not done yet. Nodes that do not depend on the parameters become
+/// constants, nodes without translator are evaluated through the expression tree.
+
+Int_t RooFlatFunc::input(const RooAbsReal& arg)
+{
+  map<const RooAbsReal*,Int_t>::iterator iter = _slots.find(&arg) ;
+  if (iter!=_slots.end()) return iter->second ;
+  if (_obs) {
+    iter = _eventSlots.find(&arg) ;
+    if (iter!=_eventSlots.end()) return iter->second ;
+  }
+
+  Int_t slot(-1) ;
+  if (!arg.dependsOnValue(_params)) {
+    slot = addConstant(arg.getVal(_nset)) ;
+  } else {
+    map<string,Translator>::iterator titer = translators().find(arg.IsA()->GetName()) ;
+    if (titer!=translators().end()) {
+      slot = titer->second(*this,arg) ;
+    }
+    if (slot<0) {
+      Instr instr = { Graph, 0, 0, 0., 0, &arg } ;
+      _instr.push_back(instr) ;
+      slot = _instr.size()-1 ;
+      _nGraph++ ;
+      // The expression tree is not evaluated for each event
+      if (_obs && dependsOnObservables(arg)) _eventFailed = kTRUE ;
+    }
+  }
+
+  if (_obs && dependsOnObservables(arg)) {
+    _eventSlots[&arg] = slot ;
+  } else {
+    _slots[&arg] = slot ;
+  }
+  return slot ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start (obs non-zero) or end (obs zero) the translation of the events of a dataset
+/// with observables obs. The translator loads each event in obs and calls nextEvent()
+/// before translating the nodes of that event.
+
+void RooFlatFunc::setObservables(const RooArgSet* obs)
+{
+  _obs = obs ;
+  _eventSlots.clear() ;
+  _obsDep.clear() ;
+  _eventFailed = kFALSE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Start the translation of the next event: the nodes that depend on the observables
+/// are translated again
+
+void RooFlatFunc::nextEvent()
+{
+  _eventSlots.clear() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if arg depends on the observables of the events being translated
+
+Bool_t RooFlatFunc::dependsOnObservables(const RooAbsReal& arg)
+{
+  map<const RooAbsReal*,Bool_t>::iterator iter = _obsDep.find(&arg) ;
+  if (iter!=_obsDep.end()) return iter->second ;
+  Bool_t ret = arg.dependsOnValue(*_obs) ;
+  _obsDep[&arg] = ret ;
+  return ret ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Remove the instructions from numInstr on, e.g. those of a test statistic that
+/// cannot be translated completely
+
+void RooFlatFunc::truncate(Int_t numInstr)
+{
+  if (numInstr>=Int_t(_instr.size())) return ;
+
+  for (UInt_t i=numInstr ; i<_instr.size() ; i++) {
+    if (_instr[i]._op==Graph) _nGraph-- ;
+  }
+  _instr.resize(numInstr) ;
+
+  // The inputs are appended in the order of the instructions
+  Int_t nArgs(0) ;
+  for (UInt_t i=0 ; i<_instr.size() ; i++) {
+    const Int_t op = _instr[i]._op ;
+    if (op==Sum || op==Prod || op==Call) nArgs = _instr[i]._first + _instr[i]._n ;
+  }
+  _args.resize(nArgs) ;
+
+  map<const RooAbsReal*,Int_t>::iterator iter = _slots.begin() ;
+  while (iter!=_slots.end()) {
+    if (iter->second>=numInstr) {
+      _slots.erase(iter++) ;
+    } else {
+      ++iter ;
+    }
+  }
+  _eventSlots.clear() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append a constant to the program and return its slot
+
+Int_t RooFlatFunc::addConstant(Double_t value)
+{
+  Instr instr = { Const, 0, 0, value, 0, 0 } ;
+  _instr.push_back(instr) ;
+  return _instr.size()-1 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the sum of the values in the given slots to the program and return its slot.
+/// The terms are added in the given order.
+
+Int_t RooFlatFunc::addSum(const vector<Int_t>& inputs)
+{
+  return addInstr(Sum,inputs) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the product of the values in the given slots to the program and return its slot.
+/// The factors are multiplied in the given order.
+
+Int_t RooFlatFunc::addProduct(const vector<Int_t>& inputs)
+{
+  return addInstr(Prod,inputs) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the call kernel(values,data) to the program and return its slot, where values
+/// is the array of the values in the given slots. The data must remain valid as long as
+/// the program is used; it is usually the translated node itself.
+
+Int_t RooFlatFunc::addKernel(const vector<Int_t>& inputs, Kernel kernel, const void* data)
+{
+  Int_t slot = addInstr(Call,inputs) ;
+  _instr[slot]._kernel = kernel ;
+  _instr[slot]._data = data ;
+  if (_callArgs.size()<inputs.size()) _callArgs.resize(inputs.size()) ;
+  return slot ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append an instruction operating on the values in the given slots
+
+Int_t RooFlatFunc::addInstr(Int_t op, const vector<Int_t>& inputs)
+{
+  Instr instr = { op, Int_t(_args.size()), Int_t(inputs.size()), 0., 0, 0 } ;
+  _args.insert(_args.end(),inputs.begin(),inputs.end()) ;
+  _instr.push_back(instr) ;
+  return _instr.size()-1 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Register the translator of the nodes of class className into instructions.
+/// The translator returns the slot of the value of the node, or -1 if the node
+/// cannot be translated.
+
+Bool_t RooFlatFunc::registerTranslator(const char* className, Translator translator)
+{
+  translators()[className] = translator ;
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the registry of translators, by class name
+
+map<string,RooFlatFunc::Translator>& RooFlatFunc::translators()
+{
+  static map<string,Translator> registry ;
+  return registry ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the parameter values to the parameter objects, for the nodes that are
+/// evaluated through the expression tree
+
+void RooFlatFunc::syncParams(const Double_t* x) const
+{
+  for (UInt_t i=0 ; i<_lvalues.size() ; i++) {
+    if (_lvalues[i]->getVal()!=x[i]) {
+      _lvalues[i]->setVal(x[i]) ;
+    }
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return value of node, calculated through the expression tree with normalization set nset.
+/// Called by the Graph instructions, also from the compiled code.
+
+Double_t RooFlatFunc::evalNode(const void* node, const void* nset)
+{
+  return static_cast<const RooAbsReal*>(node)->getVal(static_cast<const RooArgSet*>(nset)) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execute the program for the parameter values x
+
+double RooFlatFunc::DoEval(const double* x) const
+{
+  if (_nGraph>0) syncParams(x) ;
+
+  if (_compiled) return _compiled(x) ;
+
+  Double_t* v = &_values[0] ;
+  const Int_t* args = _args.empty() ? 0 : &_args[0] ;
+  const Int_t n = _instr.size() ;
+  for (Int_t i=0 ; i<n ; i++) {
+    const Instr& instr = _instr[i] ;
+    const Int_t* in = args + instr._first ;
+    switch(instr._op) {
+    case Param:
+      v[i] = x[instr._first] ;
+      break ;
+    case Const:
+      v[i] = instr._value ;
+      break ;
+    case Sum: {
+      Double_t sum(0) ;
+      for (Int_t k=0 ; k<instr._n ; k++) sum += v[in[k]] ;
+      v[i] = sum ;
+      break ;
+    }
+    case Prod: {
+      Double_t prod(1) ;
+      for (Int_t k=0 ; k<instr._n ; k++) prod *= v[in[k]] ;
+      v[i] = prod ;
+      break ;
+    }
+    case Call: {
+      for (Int_t k=0 ; k<instr._n ; k++) _callArgs[k] = v[in[k]] ;
+      v[i] = instr._kernel(_callArgs.empty() ? 0 : &_callArgs[0],instr._data) ;
+      break ;
+    }
+    case Graph:
+      v[i] = evalNode(instr._data,_nset) ;
+      break ;
+    }
+  }
+
+  return v[_result] ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return C++ code of a function 'double funcName(const double* x)' that executes
+/// the program. Kernels and the nodes evaluated through the expression tree are
+/// called through their addresses in this process, so the code can only be used
+/// in this process, while the translated expression tree exists.
+
+TString RooFlatFunc::generateCode(const char* funcName) const
+{
+  TString code ;
+  code += Form("double %s(const double* x) {\n",funcName) ;
+  // Not on the stack: the programs of binned likelihoods have an instruction per bin and term
+  code += Form("  static double v[%d];\n",Int_t(_instr.size())) ;
+  for (UInt_t i=0 ; i<_instr.size() ; i++) {
+    const Instr& instr = _instr[i] ;
+    switch(instr._op) {
+    case Param:
+      code += Form("  v[%d] = x[%d];\n",i,instr._first) ;
+      break ;
+    case Const:
+      if (TMath::IsNaN(instr._value)) {
+	code += Form("  v[%d] = __builtin_nan(\"\");\n",i) ;
+      } else if (!TMath::Finite(instr._value)) {
+	code += Form("  v[%d] = %s__builtin_inf();\n",i,instr._value<0?"-":"") ;
+      } else {
+	code += Form("  v[%d] = %a;\n",i,instr._value) ;
+      }
+      break ;
+    case Sum:
+    case Prod: {
+      // Same order of operations as in DoEval()
+      code += Form("  v[%d] = %s",i,instr._op==Sum?"0.0":"1.0") ;
+      for (Int_t k=0 ; k<instr._n ; k++) {
+	code += Form(" %s v[%d]",instr._op==Sum?"+":"*",_args[instr._first+k]) ;
+      }
+      code += ";\n" ;
+      break ;
+    }
+    case Call: {
+      code += "  {\n    const double in[] = { " ;
+      for (Int_t k=0 ; k<instr._n ; k++) {
+	code += Form("%sv[%d]",k?", ":"",_args[instr._first+k]) ;
+      }
+      if (instr._n==0) code += "0.0" ;
+      code += " };\n" ;
+      code += Form("    v[%d] = ((double(*)(const double*,const void*))0x%lx)(in,(const void*)0x%lx);\n  }\n",
+		   i,(ULong_t)instr._kernel,(ULong_t)instr._data) ;
+      break ;
+    }
+    case Graph:
+      code += Form("  v[%d] = ((double(*)(const void*,const void*))0x%lx)((const void*)0x%lx,(const void*)0x%lx);\n",
+		   i,(ULong_t)&RooFlatFunc::evalNode,(ULong_t)instr._data,(ULong_t)_nset) ;
+      break ;
+    }
+  }
+  code += Form("  return v[%d];\n}\n",_result) ;
+  return code ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compile the program with the interpreter. Subsequent evaluations execute
+/// the compiled code. Return true if successful.
+
+Bool_t RooFlatFunc::compile()
+{
+  if (_compiled) return kTRUE ;
+
+  static Int_t nCompiled(0) ;
+  TString funcName = Form("RooFlatFunc_program%d",nCompiled++) ;
+
+  if (!gInterpreter->Declare(generateCode(funcName))) {
+    oocoutE((TObject*)0,Optimization) << "RooFlatFunc::compile() ERROR: interpreter failed to compile the program" << endl ;
+    return kFALSE ;
+  }
+
+  TInterpreter::EErrorCode err(TInterpreter::kNoError) ;
+  Long_t addr = gInterpreter->Calc(Form("(long)&%s",funcName.Data()),&err) ;
+  if (err!=TInterpreter::kNoError || addr==0) {
+    oocoutE((TObject*)0,Optimization) << "RooFlatFunc::compile() ERROR: cannot find address of compiled program" << endl ;
+    return kFALSE ;
+  }
+
+  _compiled = (CompiledFunc) addr ;
+  return kTRUE ;
+}
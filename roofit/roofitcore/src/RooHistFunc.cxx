@@ -33,6 +33,7 @@ discrete dimensions and may have negative values
 #include "RooRealVar.h"
 #include "RooCategory.h"
 #include "RooWorkspace.h"
+#include "RooBatchData.h"
 
 #include "TError.h"
 
@@ -196,6 +197,22 @@ RooHistFunc::~RooHistFunc()
 Double_t RooHistFunc::evaluate() const
 {
   // Transfer values from   
+  if (!transferObservables()) {
+    return 0 ;
+  }
+
+  Double_t ret =  _dataHist->weight(_histObsList,_intOrder,kFALSE,_cdfBoundaries) ;  
+  return ret ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transfer the values of the function observables to the histogram observables.
+/// Return false if a value is outside the range of the histogram
+
+Bool_t RooHistFunc::transferObservables() const
+{
   if (_depList.getSize()>0) {
     _histObsIter->Reset() ;
     _pdfObsIter->Reset() ;
@@ -206,16 +223,123 @@ Double_t RooHistFunc::evaluate() const
 	parg->syncCache() ;
 	harg->copyCache(parg,kTRUE) ;
 	if (!harg->inRange(0)) {
-	  return 0 ;
+	  return kFALSE ;
 	}
       }
     }
   }
+  return kTRUE ;
+}
 
-  Double_t ret =  _dataHist->weight(_histObsList,_intOrder,kFALSE,_cdfBoundaries) ;  
-  return ret ;
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index of the bin of the histogram containing the current values
+/// of the observables, or -1 if they are outside the histogram. Functions with
+/// interpolation order zero have the same value for all points of a bin.
+
+Int_t RooHistFunc::getBin() const
+{
+  if (!transferObservables()) {
+    return -1 ;
+  }
+  return _dataHist->getIndex(_histObsList) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the indices of the bins containing the events of the current batch,
+/// or -1 for events outside the histogram, as getBin() does. When the observables
+/// are read directly from the columns of the batch, the indices are calculated
+/// once for each range of events and reused in later evaluations.
+/// The function must support batch evaluation (see canEvaluateBatch()).
+
+const Int_t* RooHistFunc::getBinBatch(RooBatchData& batch) const
+{
+  const Int_t n = batch.size() ;
+  Bool_t filled ;
+  Int_t* bins = batch.indices(this,filled) ;
+
+  // Map the observables of the histogram, in the order of the RooDataHist, onto the function observables
+  const RooArgSet* dvars = _dataHist->get() ;
+  std::vector<const Double_t*> values(dvars->getSize()) ;
+  std::vector<const RooAbsRealLValue*> ranges(dvars->getSize()) ;
+  Bool_t fromColumns(kTRUE) ;
+  RooFIter diter = dvars->fwdIterator() ;
+  RooAbsArg *darg, *harg, *parg ;
+  for (Int_t i=0 ; (darg=diter.next()) ; i++) {
+    RooFIter hiter = _histObsList.fwdIterator() ;
+    RooFIter piter = _depList.fwdIterator() ;
+    while((harg=hiter.next())) {
+      parg = piter.next() ;
+      if (harg->namePtr()==darg->namePtr()) break ;
+    }
+    if (!batch.column(parg)) fromColumns = kFALSE ;
+    values[i] = ((RooAbsReal*)parg)->getValBatch(batch) ;
+    ranges[i] = (harg!=parg) ? (const RooAbsRealLValue*)harg : 0 ;
+  }
+  if (filled && fromColumns) return bins ;
+
+  _dataHist->getBinIndices(values,n,bins) ;
+
+  // Points outside the range of the histogram observables have no bin (see RooAbsRealLValue::inRange())
+  for (UInt_t i=0 ; i<values.size() ; i++) {
+    if (!ranges[i]) continue ;
+    const Double_t xmin = ranges[i]->getMin() ;
+    const Double_t xmax = ranges[i]->getMax() ;
+    const Double_t* x = values[i] ;
+    for (Int_t k=0 ; k<n ; k++) {
+      const Double_t epsilon = 1e-8*fabs(x[k]) ;
+      if (!(x[k] >= xmin-epsilon && x[k] <= xmax+epsilon)) bins[k] = -1 ;
+    }
+  }
+  return bins ;
 }
 
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// The function can be evaluated for batches of events without interpolation,
+/// if the observables of the histogram are real-valued and the function
+/// observables can be evaluated for batches of events
+
+Bool_t RooHistFunc::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  if (_intOrder!=0 || _histObsList.getSize()!=_depList.getSize()) return kFALSE ;
+
+  const RooArgSet* dvars = _dataHist->get() ;
+  if (dvars->getSize()!=_histObsList.getSize()) return kFALSE ;
+
+  RooFIter hiter = _histObsList.fwdIterator() ;
+  RooFIter piter = _depList.fwdIterator() ;
+  RooAbsArg *harg, *parg ;
+  while((harg=hiter.next())) {
+    parg = piter.next() ;
+    if (!dynamic_cast<RooAbsRealLValue*>(harg) || !dynamic_cast<RooAbsRealLValue*>(dvars->find(harg->GetName()))) return kFALSE ;
+    RooAbsReal* preal = dynamic_cast<RooAbsReal*>(parg) ;
+    if (!preal || !preal->canEvaluateBatch(batch)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): look up the contents of the bins of the events
+
+void RooHistFunc::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  const Int_t* bins = getBinBatch(batch) ;
+  const Double_t* wgt = _dataHist->weightArray() ;
+  const Int_t n = batch.size() ;
+  for (Int_t k=0 ; k<n ; k++) {
+    output[k] = (bins[k]<0) ? 0. : wgt[bins[k]] ;
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Only handle case of maximum in all variables
 
@@ -242,6 +242,20 @@ void RooMinimizer::setOffsetting(Bool_t flag)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function with a flattened program (see RooFlatFunc) instead of
+/// the expression tree, optionally compiled by the interpreter. The program is
+/// built at the start of each minimization, for the values of the constant
+/// parameters at that time. Binned likelihoods are flattened bin by bin.
+
+void RooMinimizer::setFlatEvaluation(Bool_t flag, Bool_t compile)
+{
+  _fcn->SetFlatEvaluation(flag,compile) ;
+  fitterFcn()->SetFlatEvaluation(flag,compile) ;
+}
+
+
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Choose the minimzer algorithm.
@@ -35,6 +35,7 @@
 #include "RooRealVar.h"
 #include "RooAbsRealLValue.h"
 #include "RooMsgService.h"
+#include "RooFlatFunc.h"
 
 #include "RooMinimizer.h"
 
@@ -47,7 +48,8 @@ RooMinimizerFcn::RooMinimizerFcn(RooAbsReal *funct, RooMinimizer* context,
   _maxFCN(-1e30), _numBadNLL(0),  
   _printEvalErrors(10), _doEvalErrorWall(kTRUE),
   _nDim(0), _logfile(0),
-  _verbose(verbose)
+  _verbose(verbose),
+  _doFlat(kFALSE), _compileFlat(kFALSE), _flat(0)
 { 
 
   _evalCounter = 0 ;
@@ -105,6 +107,9 @@ RooMinimizerFcn::RooMinimizerFcn(const RooMinimizerFcn& other) : ROOT::Math::IBa
   _nDim(other._nDim),
   _logfile(other._logfile),
   _verbose(other._verbose),
+  _doFlat(other._doFlat),
+  _compileFlat(other._compileFlat),
+  _flat(0),
   _floatParamVec(other._floatParamVec)
 {  
   _floatParamList = new RooArgList(*other._floatParamList) ;
@@ -120,6 +125,7 @@ RooMinimizerFcn::~RooMinimizerFcn()
   delete _initFloatParamList;
   delete _constParamList;
   delete _initConstParamList;
+  delete _flat;
 }
 
 
@@ -527,7 +533,18 @@ double RooMinimizerFcn::DoEval(const double *x) const
 
   // Calculate the function for these parameters  
   RooAbsReal::setHideOffset(kFALSE) ;
-  double fvalue = _funct->getVal();
+  double fvalue ;
+  if (_doFlat) {
+    // The program is built for the constant parameters of this minimization: the fitter
+    // evaluates a clone of this object, made for each minimization
+    if (!_flat) {
+      _flat = new RooFlatFunc(*_funct,*_floatParamList) ;
+      if (_compileFlat) _flat->compile() ;
+    }
+    fvalue = (*_flat)(x) ;
+  } else {
+    fvalue = _funct->getVal();
+  }
   RooAbsReal::setHideOffset(kTRUE) ;
 
   if (RooAbsPdf::evalError() || RooAbsReal::numEvalErrors()>0 || fvalue>1e30) {
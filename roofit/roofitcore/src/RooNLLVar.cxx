@@ -43,11 +43,21 @@ In extended mode, a (Nexpect - Nobserved*log(NExpected) term is added
 #include "RooRealSumPdf.h"
 #include "RooRealVar.h"
 #include "RooProdPdf.h"
+#include "RooDataSet.h"
+#include "RooVectorDataStore.h"
+#include "RooBatchData.h"
+#include "RooFlatFunc.h"
 
 ClassImp(RooNLLVar)
 ;
 
 RooArgSet RooNLLVar::_emptySet ;
+Bool_t RooNLLVar::_batchEvaluation = kFALSE ;
+
+namespace {
+  // Number of events evaluated together in the batch evaluation
+  const Int_t kBatchSize = 1024 ;
+}
 
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -96,6 +106,8 @@ RooNLLVar::RooNLLVar(const char *name, const char* title, RooAbsPdf& pdf, RooAbs
   _offsetCarrySaveW2 = 0.;
 
   _binnedPdf = 0 ;
+  _binnedBatchStatus = -1 ;
+  _binnedBatch = 0 ;
 }
 
 
@@ -110,7 +122,8 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,RooArgSet(),rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
-  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
+  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.),
+  _binnedBatchStatus(-1), _binnedBatch(0)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
@@ -155,7 +168,8 @@ RooNLLVar::RooNLLVar(const char *name, const char *title, RooAbsPdf& pdf, RooAbs
   RooAbsOptTestStatistic(name,title,pdf,indata,projDeps,rangeName,addCoefRangeName,nCPU,interleave,verbose,splitRange,cloneData),
   _extended(extended),
   _weightSq(kFALSE),
-  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.)
+  _first(kTRUE), _offsetSaveW2(0.), _offsetCarrySaveW2(0.),
+  _binnedBatchStatus(-1), _binnedBatch(0)
 {
   // If binned likelihood flag is set, pdf is a RooRealSumPdf representing a yield vector
   // for a binned likelihood calculation
@@ -196,7 +210,7 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
   _weightSq(other._weightSq),
   _first(kTRUE), _offsetSaveW2(other._offsetSaveW2),
   _offsetCarrySaveW2(other._offsetCarrySaveW2),
-  _binw(other._binw) {
+  _binw(other._binw), _binnedBatchStatus(-1), _binnedBatch(0) {
   _binnedPdf = other._binnedPdf ? (RooRealSumPdf*)_funcClone : 0 ;
 }
 
@@ -208,6 +222,7 @@ RooNLLVar::RooNLLVar(const RooNLLVar& other, const char* name) :
 
 RooNLLVar::~RooNLLVar()
 {
+  delete _binnedBatch ;
 }
 
 
@@ -227,7 +242,7 @@ void RooNLLVar::applyWeightSquared(Bool_t flag)
   } else if ( _gofOpMode==MPMaster) {
     for (Int_t i=0 ; i<_nCPU ; i++)
       _mpfeArray[i]->applyNLLWeightSquared(flag);
-  } else if ( _gofOpMode==SimMaster) {
+  } else if ( _gofOpMode==SimMaster || _gofOpMode==MTMaster) {
     for (Int_t i=0 ; i<_nGof ; i++)
       ((RooNLLVar*)_gofArray[i])->applyWeightSquared(flag);
   }
@@ -261,7 +276,10 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
   // If pdf is marked as binned - do a binned likelihood calculation here (sum of log-Poisson for each bin)
   if (_binnedPdf) {
 
-    for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
+    // Use the batch evaluation of the p.d.f for contiguous ranges of bins if possible
+    Bool_t batchDone = (stepSize==1) && evaluateBinnedBatchPartition(firstEvent,lastEvent,result,carry,sumWeight,sumWeightCarry) ;
+
+    for (i=firstEvent ; !batchDone && i<lastEvent ; i+=stepSize) {
 
       _dataClone->get(i) ;
 
@@ -306,7 +324,10 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
   } else {
 
-    for (i=firstEvent ; i<lastEvent ; i+=stepSize) {
+    // Use the batch evaluation of the p.d.f for contiguous ranges of events if possible
+    Bool_t batchDone = (stepSize==1) && evaluateBatchPartition(firstEvent,lastEvent,result,carry,sumWeight,sumWeightCarry) ;
+
+    for (i=firstEvent ; !batchDone && i<lastEvent ; i+=stepSize) {
 
       _dataClone->get(i) ;
 
@@ -425,4 +446,340 @@ Double_t RooNLLVar::evaluatePartition(Int_t firstEvent, Int_t lastEvent, Int_t s
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the unbinned likelihood of the events [firstEvent,lastEvent) with the batch
+/// evaluation of the p.d.f (see RooAbsReal::getValBatch()): the p.d.f is evaluated for
+/// blocks of events, reading the observables directly from the vectors of the
+/// RooVectorDataStore, instead of loading each event and walking the expression tree
+/// once per event. The terms are added to the Kahan sums in the same order as in
+/// the event loop of evaluatePartition(). Events for which the batch evaluation finds
+/// a problem are evaluated again with getLogVal(), which logs the evaluation error.
+///
+/// Returns kFALSE without doing anything if the batch evaluation is switched off,
+/// if the dataset is not a RooDataSet with a vector store, if its weights are stored
+/// with float precision, or if an object of the p.d.f expression that depends on the
+/// observables does not support it.
+
+Bool_t RooNLLVar::evaluateBatchPartition(Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry,
+					 Double_t& sumWeight, Double_t& sumWeightCarry) const
+{
+  if (!_batchEvaluation || !dynamic_cast<RooDataSet*>(_dataClone)) return kFALSE ;
+  RooVectorDataStore* store = dynamic_cast<RooVectorDataStore*>(_dataClone->store()) ;
+  if (!store) return kFALSE ;
+
+  RooAbsPdf* pdfClone = (RooAbsPdf*) _funcClone ;
+  RooBatchData batch(*_funcObsSet) ;
+  store->addBatchColumns(batch) ;
+  if (!pdfClone->canEvaluateBatch(batch,_normSet)) return kFALSE ;
+
+  const Double_t* weights = store->weightArray() ;
+  if (store->isWeighted() && !weights) return kFALSE ;
+  std::vector<Double_t> logProb(kBatchSize) ;
+
+  for (Int_t first=firstEvent ; first<lastEvent ; first+=kBatchSize) {
+
+    const Int_t n = std::min(kBatchSize,lastEvent-first) ;
+    batch.setRange(first,n) ;
+
+    const Double_t* prob = pdfClone->getValBatch(batch,_normSet) ;
+    TMath::Log(n,prob,&logProb[0]) ;
+
+    for (Int_t k=0 ; k<n ; k++) {
+
+      Double_t eventWeight = weights ? weights[first+k] : 1. ;
+      if (0. == eventWeight * eventWeight) continue ;
+      if (_weightSq) eventWeight *= eventWeight ;
+
+      Double_t logVal = logProb[k] ;
+      if (!(prob[k]>0) || prob[k]>1e6) {
+	// Zero, negative, NaN or large value: let getLogVal() handle and report it
+	_dataClone->get(first+k) ;
+	logVal = pdfClone->getLogVal(_normSet) ;
+      }
+      Double_t term = -eventWeight * logVal ;
+
+      Double_t y = eventWeight - sumWeightCarry;
+      Double_t t = sumWeight + y;
+      sumWeightCarry = (t - sumWeight) - y;
+      sumWeight = t;
+
+      y = term - carry;
+      t = result + y;
+      carry = (t - result) - y;
+      result = t;
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Calculate the binned likelihood of the bins [firstEvent,lastEvent) with the batch
+/// evaluation of the p.d.f (see RooAbsReal::getValBatch()). The values of the observable,
+/// the observed events and LnGamma(N+1) of all bins are collected once, and the objects
+/// of the p.d.f expression can keep data that only depend on the bins, like the bin
+/// indices of histograms, between evaluations. The terms are added to the Kahan sums
+/// in the same order as in the bin loop of evaluatePartition(). Bins for which the
+/// batch evaluation finds a problem are evaluated again with getVal(), so that the
+/// evaluation errors are reported as in evaluatePartition().
+///
+/// Returns kFALSE without doing anything if the batch evaluation is switched off or
+/// if an object of the p.d.f expression that depends on the observable does not support it.
+
+Bool_t RooNLLVar::evaluateBinnedBatchPartition(Int_t firstEvent, Int_t lastEvent, Double_t& result, Double_t& carry,
+					       Double_t& sumWeight, Double_t& sumWeightCarry) const
+{
+  if (!_batchEvaluation) return kFALSE ;
+  if (_binnedBatchStatus<0) initBinnedBatch() ;
+  if (_binnedBatchStatus==0) return kFALSE ;
+
+  for (Int_t first=firstEvent ; first<lastEvent ; first+=kBatchSize) {
+
+    const Int_t n = std::min(kBatchSize,lastEvent-first) ;
+    _binnedBatch->setRange(first,n) ;
+
+    const Double_t* val = _binnedPdf->getValBatch(*_binnedBatch) ;
+
+    for (Int_t k=0 ; k<n ; k++) {
+
+      const Int_t i = first+k ;
+      if (!_binnedValid[i]) continue ;
+
+      Double_t eventWeight = _binnedWeight[i] ;
+
+      // Calculate log(Poisson(N|mu) for this bin
+      Double_t N = eventWeight ;
+      Double_t mu = val[k]*_binw[i] ;
+      if (!(val[k]>=0)) {
+	// Negative or NaN value: let getVal() handle and report it
+	_dataClone->get(i) ;
+	mu = _binnedPdf->getVal()*_binw[i] ;
+      }
+
+      if (mu<=0 && N>0) {
+
+	// Catch error condition: data present where zero events are predicted
+	logEvalError(Form("Observed %f events in bin %d with zero event yield",N,i)) ;
+
+      } else if (fabs(mu)<1e-10 && fabs(N)<1e-10) {
+
+	// Special handling of this case since log(Poisson(0,0)=0 but can't be calculated with usual log-formula
+	// since log(mu)=0. No update of result is required since term=0.
+
+      } else {
+
+	Double_t term = -1*(-mu + N*log(mu) - _binnedLnGamma[i]) ;
 
+	// Kahan summation of sumWeight
+	Double_t y = eventWeight - sumWeightCarry;
+	Double_t t = sumWeight + y;
+	sumWeightCarry = (t - sumWeight) - y;
+	sumWeight = t;
+
+	// Kahan summation of result
+	y = term - carry;
+	t = result + y;
+	carry = (t - result) - y;
+	result = t;
+      }
+    }
+  }
+
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Collect the data of the bins for evaluateBinnedBatchPartition() and check that
+/// the binned p.d.f supports the batch evaluation
+
+void RooNLLVar::initBinnedBatch() const
+{
+  _binnedBatchStatus = 0 ;
+
+  RooArgSet* obs = _funcClone->getObservables(_dataClone) ;
+  RooAbsReal* var = dynamic_cast<RooAbsReal*>(obs->first()) ;
+  if (obs->getSize()!=1 || !var) {
+    delete obs ;
+    return ;
+  }
+
+  const Int_t nBins = _dataClone->numEntries() ;
+  _binnedObs.resize(nBins) ;
+  _binnedWeight.resize(nBins) ;
+  _binnedLnGamma.resize(nBins) ;
+  _binnedValid.resize(nBins) ;
+  for (Int_t i=0 ; i<nBins ; i++) {
+    _dataClone->get(i) ;
+    _binnedObs[i] = var->getVal() ;
+    _binnedValid[i] = _dataClone->valid() ;
+    _binnedWeight[i] = _dataClone->weight() ;
+    _binnedLnGamma[i] = TMath::LnGamma(_binnedWeight[i]+1) ;
+  }
+
+  _binnedBatch = new RooBatchData(*obs) ;
+  _binnedBatch->addColumn(var,nBins>0 ? &_binnedObs[0] : 0) ;
+  delete obs ;
+
+  if (Int_t(_binw.size())<nBins || !_binnedPdf->canEvaluateBatch(*_binnedBatch)) {
+    delete _binnedBatch ;
+    _binnedBatch = 0 ;
+    return ;
+  }
+  _binnedBatchStatus = 1 ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Forget the data of the batch evaluation of the binned likelihood
+
+void RooNLLVar::clearBinnedBatch()
+{
+  delete _binnedBatch ;
+  _binnedBatch = 0 ;
+  _binnedBatchStatus = -1 ;
+  _binnedObs.clear() ;
+  _binnedWeight.clear() ;
+  _binnedLnGamma.clear() ;
+  _binnedValid.clear() ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Change dataset that is used to given one, forgetting the data of the batch
+/// evaluation of the binned likelihood collected from the previous dataset
+
+Bool_t RooNLLVar::setDataSlave(RooAbsData& indata, Bool_t cloneData, Bool_t ownNewData)
+{
+  clearBinnedBatch() ;
+  return RooAbsOptTestStatistic::setDataSlave(indata,cloneData,ownNewData) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// If flag is true, the unbinned likelihood and the binned likelihood of sums of
+/// templates are calculated with the batch evaluation of the p.d.f when all the
+/// objects of the p.d.f expression that depend on the observables support it
+/// (see RooAbsReal::getValBatch()). If false (the default), the p.d.f is always
+/// evaluated event by event.
+
+void RooNLLVar::setBatchEvaluation(Bool_t flag)
+{
+  _batchEvaluation = flag ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the batch evaluation of the p.d.f is enabled
+
+Bool_t RooNLLVar::batchEvaluation()
+{
+  return _batchEvaluation ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Translate the likelihood node into instructions of a RooFlatFunc program.
+///
+/// A likelihood of a RooSimultaneous becomes the sum of the likelihoods of its
+/// components. A binned likelihood (see the BinnedLikelihood attribute of RooRealSumPdf)
+/// is translated bin by bin: each bin of the dataset is loaded, the p.d.f is translated
+/// for that bin, and the log-Poisson term of the bin is a call of flatBinKernel().
+/// Unbinned likelihoods, parallel calculations and bins of which a node cannot be
+/// translated are not translated, and the likelihood is evaluated through the
+/// expression tree. The offset of the likelihood is applied as in getVal(), using the
+/// offset hiding state at translation.
+
+Int_t RooNLLVar::translateFlat(RooFlatFunc& prog, const RooAbsReal& node)
+{
+  const RooNLLVar& nll = static_cast<const RooNLLVar&>(node) ;
+
+  // Set up the components, the caches and the offsets in the first evaluation
+  nll.getVal() ;
+
+  if (nll.numSets()!=1) return -1 ;
+
+  if (nll._gofOpMode==SimMaster) {
+    if (nll._mpinterl!=RooFit::BulkPartition && nll._mpinterl!=RooFit::Interleave) return -1 ;
+    std::vector<Int_t> terms ;
+    for (Int_t i=0 ; i<nll._nGof ; i++) {
+      terms.push_back(prog.input(*nll._gofArray[i])) ;
+    }
+    return prog.addSum(terms) ;
+  }
+
+  if (nll._gofOpMode!=Slave || !nll._binnedPdf) return -1 ;
+
+  const Int_t start = prog.numInstructions() ;
+  const Double_t logSimCount = nll._simCount>1 ? log(1.0*nll._simCount) : 0. ;
+  RooAbsData& data = *nll._dataClone ;
+
+  std::vector<Int_t> terms ;
+  prog.setObservables(data.get()) ;
+  for (Int_t i=0 ; i<data.numEntries() ; i++) {
+
+    data.get(i) ;
+    if (!data.valid()) continue ;
+    prog.nextEvent() ;
+
+    const Double_t N = data.weight() ;
+    std::vector<Int_t> inputs ;
+    inputs.push_back(prog.input(*nll._binnedPdf)) ;
+    inputs.push_back(prog.addConstant(nll._binw[i])) ;
+    inputs.push_back(prog.addConstant(N)) ;
+    inputs.push_back(prog.addConstant(TMath::LnGamma(N+1))) ;
+    inputs.push_back(prog.addConstant(logSimCount)) ;
+    inputs.push_back(prog.addConstant(i)) ;
+    terms.push_back(prog.addKernel(inputs,&RooNLLVar::flatBinKernel,&nll)) ;
+
+    if (prog.eventFailed()) {
+      oocoutI(&nll,Optimization) << "RooNLLVar::translateFlat(" << nll.GetName() << ") p.d.f " << nll._binnedPdf->GetName()
+			  << " cannot be translated, likelihood is evaluated through the expression tree" << std::endl ;
+      prog.setObservables(0) ;
+      prog.truncate(start) ;
+      return -1 ;
+    }
+  }
+  prog.setObservables(0) ;
+
+  // Subtract the offset as in evaluatePartition(), unless getVal() adds it back
+  if (nll._doOffset && nll._offset!=0 && !hideOffset()) {
+    terms.push_back(prog.addConstant(-nll._offset-nll._offsetCarry)) ;
+  }
+
+  return prog.addSum(terms) ;
+}
+
+namespace {
+  Bool_t registerFlatTranslator = RooFlatFunc::registerTranslator("RooNLLVar",&RooNLLVar::translateFlat) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Kernel of the flattened binned likelihood: log-Poisson term of a bin as calculated
+/// by evaluatePartition(), for in = { value of the binned p.d.f, bin width, observed
+/// events N, LnGamma(N+1), log of the number of RooSimultaneous components, bin number }
+
+Double_t RooNLLVar::flatBinKernel(const Double_t* in, const void* self)
+{
+  const Double_t mu = in[0]*in[1] ;
+  const Double_t N = in[2] ;
+
+  if (mu<=0 && N>0) {
+    static_cast<const RooNLLVar*>(self)->logEvalError(Form("Observed %f events in bin %d with zero event yield",N,Int_t(in[5]))) ;
+    return 0 ;
+  }
+  if (fabs(mu)<1e-10 && fabs(N)<1e-10) return 0 ;
+
+  Double_t term = -1*(-mu + N*log(mu) - in[3]) ;
+  return term + N*in[4] ;
+}
@@ -30,6 +30,8 @@ fast searches and comparisons.
 
 #include "RooNameReg.h"
 #include "RooNameReg.h"
+#include "TROOT.h"
+#include "TVirtualMutex.h"
 #include <iostream>
 using namespace std ;
 
@@ -93,6 +95,9 @@ const TNamed* RooNameReg::constPtr(const char* inStr)
   // Handle null pointer case explicitly
   if (inStr==0) return 0 ;
 
+  // Names may be registered concurrently by test statistics evaluated in threads
+  R__LOCKGUARD_IMT2(gROOTMutex) ;
+
 //   cout << "RooNameReg::constPtr(inStr=" << inStr << ") _htable entries = " << _htable.entries() << endl ;
 
   // See if name is already registered ;
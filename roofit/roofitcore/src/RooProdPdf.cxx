@@ -57,6 +57,7 @@ have to appear in any specific place in the list.
 #include "RooCustomizer.h"
 #include "RooRealIntegral.h"
 #include "RooTrace.h"
+#include "RooBatchData.h"
 
 #include <cstring>
 #include <sstream>
@@ -477,20 +478,89 @@ Double_t RooProdPdf::getValV(const RooArgSet* set) const
 /// Calculate current value of object
 
 Double_t RooProdPdf::evaluate() const
+{
+  return calculate(*getCacheElem(_curNormSet)) ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the cache element with the factorized product terms for normalization set 'nset'
+
+RooProdPdf::CacheElem* RooProdPdf::getCacheElem(const RooArgSet* nset) const
 {
   Int_t code ;
-  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+  CacheElem* cache = (CacheElem*) _cacheMgr.getObj(nset,0,&code) ;
 
   // If cache doesn't have our configuration, recalculate here
   if (!cache) {
     RooArgList *plist(0) ;
     RooLinkedList *nlist(0) ;
-    getPartIntList(_curNormSet,0,plist,nlist,code) ;
-    cache = (CacheElem*) _cacheMgr.getObj(_curNormSet,0,&code) ;
+    getPartIntList(nset,0,plist,nlist,code) ;
+    cache = (CacheElem*) _cacheMgr.getObj(nset,0,&code) ;
   }
 
+  return cache ;
+}
+
 
-  return calculate(*cache) ;
+
+////////////////////////////////////////////////////////////////////////////////
+/// The product can be evaluated for batches of events if it is not rearranged
+/// and all its terms can be evaluated for batches of events
+
+Bool_t RooProdPdf::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* nset) const
+{
+  CacheElem* cache = getCacheElem(nset) ;
+  if (cache->_isRearranged) return kFALSE ;
+
+  RooAbsReal* partInt;
+  RooArgSet* normSet;
+  RooFIter plIter = cache->_partList.fwdIterator();
+  RooFIter nlIter = cache->_normList.fwdIterator();
+  for (partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next(); partInt && normSet;
+       partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next()) {
+    if (!partInt->canEvaluateBatch(batch,normSet->getSize() > 0 ? normSet : 0)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): running product of the terms for the current batch of events.
+/// As in calculate(), the product of an event is not changed anymore once it is below the cutoff.
+
+void RooProdPdf::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* nset) const
+{
+  CacheElem* cache = getCacheElem(nset) ;
+
+  const Int_t n = batch.size() ;
+  std::fill(output,output+n,1.) ;
+
+  RooAbsReal* partInt;
+  RooArgSet* normSet;
+  RooFIter plIter = cache->_partList.fwdIterator();
+  RooFIter nlIter = cache->_normList.fwdIterator();
+  Bool_t first(kTRUE) ;
+  for (partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next(); partInt && normSet;
+       partInt = (RooAbsReal*) plIter.next(),
+	 normSet = (RooArgSet*) nlIter.next()) {
+    const Double_t* piVal = partInt->getValBatch(batch,normSet->getSize() > 0 ? normSet : 0) ;
+    if (first) {
+      for (Int_t k=0 ; k<n ; k++) {
+	output[k] *= piVal[k] ;
+      }
+      first = kFALSE ;
+    } else {
+      for (Int_t k=0 ; k<n ; k++) {
+	output[k] = (output[k] <= _cutOff) ? output[k] : output[k]*piVal[k] ;
+      }
+    }
+  }
 }
 
 
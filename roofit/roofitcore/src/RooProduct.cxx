@@ -39,6 +39,7 @@ of a given set of other RooAbsReal objects
 #include "RooErrorHandler.h"
 #include "RooMsgService.h"
 #include "RooTrace.h"
+#include "RooBatchData.h"
 
 using namespace std ;
 
@@ -386,6 +387,59 @@ Double_t RooProduct::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// The product can be evaluated for batches of events if all real-valued terms
+/// can and the categories do not depend on the observables of the batch
+
+Bool_t RooProduct::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  RooFIter compCIter = _compCSet.fwdIterator() ;
+  RooAbsArg* ccomp ;
+  while((ccomp=compCIter.next())) {
+    if (batch.dependsOnObservables(*ccomp)) return kFALSE ;
+  }
+
+  RooFIter compRIter = _compRSet.fwdIterator() ;
+  RooAbsReal* rcomp ;
+  while((rcomp=(RooAbsReal*)compRIter.next())) {
+    if (!rcomp->canEvaluateBatch(batch,_compRSet.nset())) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): multiply the values of the terms in the same
+/// order as evaluate()
+
+void RooProduct::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  const Int_t n = batch.size() ;
+  std::fill(output,output+n,1.) ;
+
+  RooFIter compRIter = _compRSet.fwdIterator() ;
+  RooAbsReal* rcomp ;
+  const RooArgSet* nset = _compRSet.nset() ;
+  while((rcomp=(RooAbsReal*)compRIter.next())) {
+    const Double_t* val = rcomp->getValBatch(batch,nset) ;
+    for (Int_t k=0 ; k<n ; k++) {
+      output[k] *= val[k] ;
+    }
+  }
+
+  RooFIter compCIter = _compCSet.fwdIterator() ;
+  RooAbsCategory* ccomp ;
+  while((ccomp=(RooAbsCategory*)compCIter.next())) {
+    const Double_t index = ccomp->getIndex() ;
+    for (Int_t k=0 ; k<n ; k++) {
+      output[k] *= index ;
+    }
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Forward the plot sampling hint from the p.d.f. that defines the observable obs  
 
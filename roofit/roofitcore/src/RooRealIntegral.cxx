@@ -50,12 +50,141 @@ integration is performed in the various implemenations of the RooAbsIntegrator b
 #include "RooConstVar.h"
 #include "RooDouble.h"
 #include "RooTrace.h"
+#include "RooAbsPdf.h"
+#include "RooDataHist.h"
+#include "RooLinkedList.h"
+#include "TBaseClass.h"
+#include "TDataMember.h"
+#include <sstream>
 
 using namespace std;
 
 ClassImp(RooRealIntegral) 
 ;
 
+namespace {
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// Return true for the RooFit base classes whose data members are names,
+  /// caches and plotting defaults, which do not change the value of an object
+
+  Bool_t isGenericBase(const TClass* cl)
+  {
+    static const char* names[] = { "TObject", "TNamed", "RooPrintable", "RooAbsArg", "RooAbsReal", "RooAbsPdf",
+				   "RooAbsLValue", "RooAbsRealLValue", "RooAbsCategory", "RooAbsCategoryLValue", 0 } ;
+    for (Int_t i=0 ; names[i] ; i++) {
+      if (!strcmp(cl->GetName(),names[i])) return kTRUE ;
+    }
+    return kFALSE ;
+  }
+
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// Write the coordinates and the weight of all bins of 'dh'
+
+  void writeDataHistState(ostream& os, const RooDataHist* dh)
+  {
+    if (!dh) return ;
+    for (Int_t i=0 ; i<dh->numEntries() ; i++) {
+      RooFIter iter = dh->get(i)->fwdIterator() ;
+      RooAbsArg* arg ;
+      while((arg=iter.next())) {
+	RooAbsReal* real = dynamic_cast<RooAbsReal*>(arg) ;
+	RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(arg) ;
+	if (real) os << real->getVal() << "," ;
+	if (cat) os << cat->getIndex() << "," ;
+      }
+      os << dh->weight() << ";" ;
+    }
+  }
+
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// Write the names of the elements of a collection
+
+  void writeCollectionState(ostream& os, const RooAbsCollection* coll)
+  {
+    RooFIter iter = coll->fwdIterator() ;
+    RooAbsArg* arg ;
+    while((arg=iter.next())) {
+      os << arg->GetName() << "," ;
+    }
+  }
+
+
+  //////////////////////////////////////////////////////////////////////////////
+  /// Write the persistent data members of class 'cl', and of its base classes,
+  /// of the object 'obj' at 'offset'. Proxies are skipped, since the servers are
+  /// described separately, and so are cache managers. Return kFALSE if a member
+  /// has a type whose contents cannot be described.
+
+  Bool_t writeMemberState(ostream& os, const char* obj, TClass* cl, Long_t offset)
+  {
+    if (isGenericBase(cl)) return kTRUE ;
+
+    TIter biter(cl->GetListOfBases()) ;
+    TBaseClass* base ;
+    while((base=(TBaseClass*)biter())) {
+      TClass* bcl = base->GetClassPointer() ;
+      if (!bcl || !writeMemberState(os,obj,bcl,offset+base->GetDelta())) return kFALSE ;
+    }
+
+    TIter miter(cl->GetListOfDataMembers()) ;
+    TDataMember* dm ;
+    while((dm=(TDataMember*)miter())) {
+      if (!dm->IsPersistent() || (dm->Property() & kIsStatic)) continue ;
+      const char* addr = obj + offset + dm->GetOffset() ;
+
+      // Basic types and arrays of them: their bytes
+      if ((dm->IsBasic() || dm->IsEnum()) && !dm->IsaPointer()) {
+	Int_t size = dm->GetUnitSize() ;
+	for (Int_t i=0 ; i<dm->GetArrayDim() ; i++) size *= dm->GetMaxIndex(i) ;
+	os << " " << dm->GetName() << "=" ;
+	for (Int_t i=0 ; i<size ; i++) os << Form("%02x",(UChar_t)addr[i]) ;
+	continue ;
+      }
+
+      TClass* mcl = TClass::GetClass(dm->GetTypeName()) ;
+      if (!mcl || dm->GetArrayDim()>0) return kFALSE ;
+      if (!dm->IsaPointer()) {
+	if (mcl->InheritsFrom("RooAbsProxy") || mcl->InheritsFrom("RooAbsCache")) continue ;
+	os << " " << dm->GetName() << "=" ;
+	if (mcl==TString::Class()) {
+	  os << *(const TString*)addr ;
+	} else if (mcl->InheritsFrom(RooAbsCollection::Class())) {
+	  writeCollectionState(os,(const RooAbsCollection*)addr) ;
+	} else if (mcl->InheritsFrom(RooLinkedList::Class())) {
+	  RooFIter iter = ((const RooLinkedList*)addr)->fwdIterator() ;
+	  TObject* elem ;
+	  while((elem=iter.next())) {
+	    if (dynamic_cast<RooAbsCollection*>(elem)) {
+	      os << "(" ; writeCollectionState(os,(RooAbsCollection*)elem) ; os << ")" ;
+	    } else if (dynamic_cast<TNamed*>(elem)) {
+	      os << elem->GetName() << "," ;
+	    } else {
+	      return kFALSE ;
+	    }
+	  }
+	} else {
+	  return kFALSE ;
+	}
+      } else {
+	const void* ptr = *(const void* const*)addr ;
+	os << " " << dm->GetName() << "=" ;
+	if (mcl->InheritsFrom(RooDataHist::Class())) {
+	  writeDataHistState(os,(const RooDataHist*)ptr) ;
+	} else if (mcl==TNamed::Class()) {
+	  os << (ptr ? ((const TNamed*)ptr)->GetName() : "") ;
+	} else {
+	  return kFALSE ;
+	}
+      }
+    }
+    return kTRUE ;
+  }
+
+}
+
 
 Int_t RooRealIntegral::_cacheAllNDim(2) ;
 
@@ -881,6 +1010,98 @@ Double_t RooRealIntegral::getValV(const RooArgSet* nset) const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the key of the value of this integral in the persistent store of
+/// RooExpensiveObjectCache. The key is a hash of a description of everything the
+/// value depends on: the structure of the integrand, the values of its parameters,
+/// the integration ranges of the observables and the configuration of the numeric
+/// integration. Identical integrals in different jobs, or in different instances
+/// of the same model, thus have the same key, while any change of the model or of
+/// a parameter value results in a different key.
+///
+/// Besides its servers, the state of each node of the integrand is given by the values
+/// of fundamentals and by the persistent data members of the other classes, e.g. the
+/// value of a RooConstVar or the contents of the RooDataHist of a RooHistPdf.
+/// If a node has a data member whose contents cannot be described, the integral
+/// is not persisted and an empty key is returned.
+
+TString RooRealIntegral::persistentCacheKey() const
+{
+  const char* rangeName = RooNameReg::str(_rangeName) ;
+
+  ostringstream os ;
+  os.precision(17) ;
+  os << ClassName() << "::" << GetName() << " range=" << (rangeName?rangeName:"") << endl ;
+
+  // Numeric integration configuration
+  const RooNumIntConfig* cfg = _iconfig ? _iconfig : getIntegratorConfig() ;
+  os << "epsAbs=" << cfg->epsAbs() << " epsRel=" << cfg->epsRel() << endl ;
+  const RooCategory* methods[6] = { &cfg->method1D(), &cfg->method1DOpen(), &cfg->method2D(), 
+				    &cfg->method2DOpen(), &cfg->methodND(), &cfg->methodNDOpen() } ;
+  for (Int_t i=0 ; i<6 ; i++) {
+    const char* label = methods[i]->getLabel() ;
+    os << methods[i]->GetName() << "=" << label ;
+    RooFIter citer = cfg->getConfigSection(label).fwdIterator() ;
+    RooAbsArg* carg ;
+    while((carg=citer.next())) {
+      RooAbsReal* creal = dynamic_cast<RooAbsReal*>(carg) ;
+      RooAbsCategory* ccat = dynamic_cast<RooAbsCategory*>(carg) ;
+      os << " " << carg->GetName() << "=" ;
+      if (creal) os << creal->getVal() ;
+      if (ccat) os << ccat->getLabel() ;
+    }
+    os << endl ;
+  }
+
+  // Integrand: structure, parameter values and integration ranges
+  RooArgSet iset(intVars()) ;
+  RooArgSet nodes ;
+  _function.arg().treeNodeServerList(&nodes) ;
+  RooFIter iter = nodes.fwdIterator() ;
+  RooAbsArg* node ;
+  while((node=iter.next())) {
+    os << node->ClassName() << "::" << node->GetName() << "(" ;
+    RooFIter siter = node->serverMIterator() ;
+    RooAbsArg* server ;
+    while((server=siter.next())) {
+      os << server->GetName() << "," ;
+    }
+    os << ")" ;
+    node->printMetaArgs(os) ;
+    if (iset.find(node->GetName())) {
+      RooAbsRealLValue* lval = dynamic_cast<RooAbsRealLValue*>(node) ;
+      if (lval) os << " [" << lval->getMin(rangeName) << "," << lval->getMax(rangeName) << "]" ;
+    } else if (node->isFundamental()) {
+      RooAbsReal* real = dynamic_cast<RooAbsReal*>(node) ;
+      RooAbsCategory* cat = dynamic_cast<RooAbsCategory*>(node) ;
+      if (real) os << " =" << real->getVal() ;
+      if (cat) os << " =" << cat->getIndex() ;
+    }
+    if (!node->isFundamental()) {
+      RooAbsPdf* pdf = dynamic_cast<RooAbsPdf*>(node) ;
+      if (pdf && pdf->normRange()) os << " normRange=" << pdf->normRange() ;
+      if (!writeMemberState(os,(const char*)dynamic_cast<const void*>(node),node->IsA(),0)) {
+	cxcoutD(Caching) << "RooRealIntegral::persistentCacheKey(" << GetName() << ") value is not persisted: the state of "
+			 << node->ClassName() << "::" << node->GetName() << " cannot be described" << endl ;
+	return TString() ;
+      }
+    }
+    os << endl ;
+  }
+  if (_funcNormSet) {
+    os << "normSet=" ;
+    RooFIter niter = _funcNormSet->fwdIterator() ;
+    while((node=niter.next())) {
+      os << node->GetName() << "," ;
+    }
+    os << endl ;
+  }
+
+  return RooExpensiveObjectCache::contentKey(os.str().c_str()) ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Perform the integration and return the result
 
@@ -897,6 +1118,19 @@ Double_t RooRealIntegral::evaluate() const
 	cacheVal = (RooDouble*) expensiveObjectCache().retrieveObject(GetName(),RooDouble::Class(),parameters())  ;
       }
 
+      // If active, look up the value in the persistent store shared between jobs
+      TString persistKey ;
+      if (!cacheVal && ((_cacheNum && _intList.getSize()>0) || _intList.getSize()>=_cacheAllNDim) &&
+	  RooExpensiveObjectCache::instance().persistentFile()) {
+	persistKey = persistentCacheKey() ;
+	Double_t storedVal ;
+	if (persistKey.Length()>0 && RooExpensiveObjectCache::instance().retrieveValue(persistKey,storedVal)) {
+	  RooDouble* val = new RooDouble(storedVal) ;
+	  expensiveObjectCache().registerObject(_function.arg().GetName(),GetName(),*val,parameters())  ;
+	  cacheVal = val ;
+	}
+      }
+
       if (cacheVal) {
 	retVal = *cacheVal ;
 	//	cout << "using cached value of integral" << GetName() << endl ;
@@ -934,6 +1168,9 @@ Double_t RooRealIntegral::evaluate() const
 	  RooDouble* val = new RooDouble(retVal) ;
 	  expensiveObjectCache().registerObject(_function.arg().GetName(),GetName(),*val,parameters())  ;
 //  	  cout << "### caching value of integral" << GetName() << " in " << &expensiveObjectCache() << endl ;
+	  if (persistKey.Length()>0) {
+	    RooExpensiveObjectCache::instance().registerValue(persistKey,retVal) ;
+	  }
 	}
 	
       }
@@ -48,6 +48,7 @@ In the present version \f$coef_i\f$ may not depend on x, but this limitation may
 #include "RooRealIntegral.h"
 #include "RooMsgService.h"
 #include "RooNameReg.h"
+#include "RooBatchData.h"
 #include <memory>
 #include <algorithm>
 
@@ -278,6 +279,87 @@ Double_t RooRealSumPdf::evaluate() const
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// The sum can be evaluated for batches of events if the coefficients do not
+/// depend on the observables of the batch and all functions can be evaluated
+/// for batches of events
+
+Bool_t RooRealSumPdf::canEvaluateBatchV(RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  RooFIter coefIter = _coefList.fwdIterator() ;
+  RooAbsArg* coef ;
+  while((coef=coefIter.next())) {
+    if (batch.dependsOnObservables(*coef)) return kFALSE ;
+  }
+
+  RooFIter funcIter = _funcList.fwdIterator() ;
+  RooAbsReal* func ;
+  while((func=(RooAbsReal*)funcIter.next())) {
+    if (!func->canEvaluateBatch(batch)) return kFALSE ;
+  }
+  return kTRUE ;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Batch version of evaluate(): add the values of the functions for the current
+/// batch of events, multiplied by their coefficients, in the same order as evaluate()
+
+void RooRealSumPdf::evaluateBatch(Double_t* output, RooBatchData& batch, const RooArgSet* /*nset*/) const
+{
+  const Int_t n = batch.size() ;
+  std::fill(output,output+n,0.) ;
+
+  RooFIter funcIter = _funcList.fwdIterator() ;
+  RooFIter coefIter = _coefList.fwdIterator() ;
+  RooAbsReal* coef ;
+  RooAbsReal* func ;
+
+  // N funcs, N-1 coefficients 
+  Double_t lastCoef(1) ;
+  while((coef=(RooAbsReal*)coefIter.next())) {
+    func = (RooAbsReal*)funcIter.next() ;
+    Double_t coefVal = coef->getVal() ;
+    if (coefVal) {
+      if (func->isSelectedComp()) {
+	const Double_t* funcVal = func->getValBatch(batch) ;
+	for (Int_t k=0 ; k<n ; k++) {
+	  output[k] += funcVal[k]*coefVal ;
+	}
+      }
+      lastCoef -= coefVal ;
+    }
+  }
+
+  if (!_haveLastCoef) {
+    // Add last func with correct coefficient
+    func = (RooAbsReal*) funcIter.next() ;
+    if (func->isSelectedComp()) {
+      const Double_t* funcVal = func->getValBatch(batch) ;
+      for (Int_t k=0 ; k<n ; k++) {
+	output[k] += funcVal[k]*lastCoef ;
+      }
+    }
+
+    // Warn about coefficient degeneration
+    if (lastCoef<0 || lastCoef>1) {
+      coutW(Eval) << "RooRealSumPdf::evaluateBatch(" << GetName() 
+		  << " WARNING: sum of FUNC coefficients not in range [0-1], value=" 
+		  << 1-lastCoef << endl ;
+    } 
+  }
+
+  // Introduce floor if so requested
+  if (_doFloor || _doFloorGlobal) {
+    for (Int_t k=0 ; k<n ; k++) {
+      if (output[k]<0) output[k] = 0 ;
+    }
+  }
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Check if FUNC is valid for given normalization set.
 /// Coeffient and FUNC must be non-overlapping, but func-coefficient 
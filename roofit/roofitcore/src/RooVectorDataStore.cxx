@@ -21,6 +21,10 @@
 
 RooVectorDataStore is the abstract base class for data collection that
 use a TTree as internal storage mechanism
+
+The values of real-valued variables that carry the attribute StoreAsFloat
+are stored with float precision, which halves the memory of their columns.
+Category columns store the index of the state only.
 **/
 
 #include "RooFit.h"
@@ -39,6 +43,7 @@ use a TTree as internal storage mechanism
 #include "RooNameSet.h"
 #include "RooHistError.h"
 #include "RooTrace.h"
+#include "RooBatchData.h"
 
 #include <iomanip>
 #include <algorithm>
@@ -1053,9 +1058,14 @@ void RooVectorDataStore::reserve(Int_t nEvts)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
+/// Append all events of 'other' to this store. If 'other' is a RooVectorDataStore
+/// with the same columns, its vectors are appended to ours in bulk (see appendColumns()),
+/// otherwise the events are copied one by one.
 
 void RooVectorDataStore::append(RooAbsDataStore& other) 
 {
+  if (appendColumns(other)) return ;
+
   Int_t nevt = other.numEntries() ;
   reserve(nevt + numEntries());
   for (int i=0 ; i<nevt ; i++) {  
@@ -1070,6 +1080,80 @@ void RooVectorDataStore::append(RooAbsDataStore& other)
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Append the events of 'other' by appending each of its vectors to the vector of the
+/// same variable in this store, if 'other' is a RooVectorDataStore with the same set of
+/// columns, errors and weight variable, and if neither store has an external weight
+/// array or a cache. The result is the same as copying the events one by one.
+/// Return kFALSE without changing anything if these conditions are not met.
+
+Bool_t RooVectorDataStore::appendColumns(RooAbsDataStore& other) 
+{
+  RooVectorDataStore* vother = dynamic_cast<RooVectorDataStore*>(&other) ;
+  if (!vother || vother==this || _cache || vother->_cache || _extWgtArray || vother->_extWgtArray) return kFALSE ;
+  if (vother->_realStoreList.size()!=_realStoreList.size() || vother->_realfStoreList.size()!=_realfStoreList.size() ||
+      vother->_catStoreList.size()!=_catStoreList.size()) return kFALSE ;
+  if ((_wgtVar==0)!=(vother->_wgtVar==0) || (_wgtVar && _wgtVar->namePtr()!=vother->_wgtVar->namePtr())) return kFALSE ;
+
+  const Int_t nevt = vother->numEntries() ;
+  const Double_t* wgt = vother->weightArray() ;
+  if (_wgtVar && nevt>0 && !wgt) return kFALSE ;
+
+  // Find the vector of 'other' for each of our vectors
+  vector<RealVector*> realSrc ;
+  for (vector<RealVector*>::iterator iter = _realStoreList.begin() ; iter!=_realStoreList.end() ; ++iter) {
+    RealVector* src(0) ;
+    for (vector<RealVector*>::iterator oiter = vother->_realStoreList.begin() ; oiter!=vother->_realStoreList.end() ; ++oiter) {
+      if ((*oiter)->bufArg()->namePtr()==(*iter)->bufArg()->namePtr()) src = *oiter ;
+    }
+    if (!src || src->size()<nevt || (*iter)->size()!=_nEntries) return kFALSE ;
+    realSrc.push_back(src) ;
+  }
+  vector<RealFullVector*> realfSrc ;
+  for (vector<RealFullVector*>::iterator iter = _realfStoreList.begin() ; iter!=_realfStoreList.end() ; ++iter) {
+    RealFullVector* src(0) ;
+    for (vector<RealFullVector*>::iterator oiter = vother->_realfStoreList.begin() ; oiter!=vother->_realfStoreList.end() ; ++oiter) {
+      if ((*oiter)->bufArg()->namePtr()==(*iter)->bufArg()->namePtr()) src = *oiter ;
+    }
+    if (!src || src->size()<nevt || (*iter)->size()!=_nEntries) return kFALSE ;
+    if ((src->_vecE==0)!=((*iter)->_vecE==0) || (src->_vecEL==0)!=((*iter)->_vecEL==0)) return kFALSE ;
+    realfSrc.push_back(src) ;
+  }
+  vector<CatVector*> catSrc ;
+  for (vector<CatVector*>::iterator iter = _catStoreList.begin() ; iter!=_catStoreList.end() ; ++iter) {
+    CatVector* src(0) ;
+    for (vector<CatVector*>::iterator oiter = vother->_catStoreList.begin() ; oiter!=vother->_catStoreList.end() ; ++oiter) {
+      if ((*oiter)->bufArg()->namePtr()==(*iter)->bufArg()->namePtr()) src = *oiter ;
+    }
+    if (!src || src->size()<nevt || (*iter)->size()!=_nEntries) return kFALSE ;
+    catSrc.push_back(src) ;
+  }
+
+  // Append the vectors
+  for (UInt_t i=0 ; i<_realStoreList.size() ; i++) {
+    _realStoreList[i]->append(*realSrc[i],nevt) ;
+  }
+  for (UInt_t i=0 ; i<_realfStoreList.size() ; i++) {
+    _realfStoreList[i]->append(*realfSrc[i],nevt) ;
+  }
+  for (UInt_t i=0 ; i<_catStoreList.size() ; i++) {
+    _catStoreList[i]->append(*catSrc[i],nevt) ;
+  }
+
+  // Sum the weights in the same order as fill()
+  for (Int_t i=0 ; i<nevt ; i++) {
+    Double_t y = (_wgtVar ? wgt[i] : 1.) - _sumWeightCarry;
+    Double_t t = _sumWeight + y;
+    _sumWeightCarry = (t - _sumWeight) - y;
+    _sumWeight = t;
+  }
+  _nEntries += nevt ;
+
+  return kTRUE ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Int_t RooVectorDataStore::numEntries() const 
@@ -1442,6 +1526,54 @@ void RooVectorDataStore::setArgStatus(const RooArgSet& /*set*/, Bool_t /*active*
 
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Register the vectors of the real-valued variables as columns of 'batch'.
+/// The columns are attached to the objects whose buffers are connected to the
+/// vectors, i.e. the observables of an external function after attachBuffers().
+/// The values of the objects cached by the constant-term optimizer (see cacheArgs())
+/// are registered as well, so that their cached values are used. Columns stored with
+/// float precision (attribute StoreAsFloat) are registered without values, so that
+/// the objects depending on them are evaluated event by event.
+
+void RooVectorDataStore::addBatchColumns(RooBatchData& batch) const
+{
+  for (Int_t i=0 ; i<_nReal ; i++) {
+    const RealVector* rv = *(_firstReal+i) ;
+    batch.addColumn(rv->_real ? rv->_real : rv->_nativeReal, rv->_float ? 0 : rv->_vec0) ;
+  }
+  for (Int_t i=0 ; i<_nRealF ; i++) {
+    const RealFullVector* rv = *(_firstRealF+i) ;
+    batch.addColumn(rv->_real ? rv->_real : rv->_nativeReal, rv->_float ? 0 : rv->_vec0) ;
+  }
+  if (_cache) {
+    _cache->addBatchColumns(batch) ;
+  }
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the array of the event weights, or zero if all events have unit weight
+/// or if the weights are stored with float precision
+
+const Double_t* RooVectorDataStore::weightArray() const
+{
+  if (_extWgtArray) return _extWgtArray ;
+  if (!_wgtVar) return 0 ;
+
+  for (Int_t i=0 ; i<_nReal ; i++) {
+    const RealVector* rv = *(_firstReal+i) ;
+    if (rv->bufArg()->namePtr()==_wgtVar->namePtr()) return rv->_float ? 0 : rv->_vec0 ;
+  }
+  for (Int_t i=0 ; i<_nRealF ; i++) {
+    const RealFullVector* rv = *(_firstRealF+i) ;
+    if (rv->bufArg()->namePtr()==_wgtVar->namePtr()) return rv->_float ? 0 : rv->_vec0 ;
+  }
+  return 0 ;
+}
+
+
+
 ////////////////////////////////////////////////////////////////////////////////
 
 void RooVectorDataStore::attachBuffers(const RooArgSet& extObs) 
@@ -1483,9 +1615,9 @@ void RooVectorDataStore::dump()
   for (; iter!=_realStoreList.end() ; ++iter) {
     cout << "RealVector " << *iter << " _nativeReal = " << (*iter)->_nativeReal << " = " << (*iter)->_nativeReal->GetName() << " bufptr = " << (*iter)->_buf  << endl ;
     cout << " values : " ;
-    Int_t imax = (*iter)->_vec.size()>10 ? 10 : (*iter)->_vec.size() ;
+    Int_t imax = (*iter)->size()>10 ? 10 : (*iter)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter)->_vec[i] << " " ;
+      cout << (*iter)->value(i) << " " ;
     }
     cout << endl ;
   }    
@@ -1495,9 +1627,9 @@ void RooVectorDataStore::dump()
 	 << " bufptr = " << (*iter2)->_buf  << " errbufptr = " << (*iter2)->_bufE << endl ;
 
     cout << " values : " ;
-    Int_t imax = (*iter2)->_vec.size()>10 ? 10 : (*iter2)->_vec.size() ;
+    Int_t imax = (*iter2)->size()>10 ? 10 : (*iter2)->size() ;
     for (Int_t i=0 ; i<imax ; i++) {
-      cout << (*iter2)->_vec[i] << " " ;
+      cout << (*iter2)->value(i) << " " ;
     }
     cout << endl ;
     if ((*iter2)->_vecE) {
@@ -1554,7 +1686,7 @@ void RooVectorDataStore::RealVector::Streamer(TBuffer &R__b)
 {
    if (R__b.IsReading()) {
       R__b.ReadClassBuffer(RooVectorDataStore::RealVector::Class(),this);
-      _vec0 = _vec.size()>0 ? &_vec.front() : 0 ;
+      updateVecPointers() ;
    } else {
       R__b.WriteClassBuffer(RooVectorDataStore::RealVector::Class(),this);
    }
@@ -1567,6 +1699,7 @@ void RooVectorDataStore::RealFullVector::Streamer(TBuffer &R__b)
 {
    if (R__b.IsReading()) {
      R__b.ReadClassBuffer(RooVectorDataStore::RealFullVector::Class(),this);
+     updateVecPointers() ;
 
      // WVE - It seems that ROOT persistence turns null pointers to vectors into pointers to null-sized vectors 
      //       Intervene here to remove those null-sized vectors and replace with null pointers to not break
@@ -26,6 +26,7 @@ class RooRealVar;
 class TGraphErrors;
 
 #include <memory>
+#include <vector>
 
 
 
@@ -165,6 +166,11 @@ public:
    // set flag to close proof for every new run
    static void SetCloseProof(Bool_t flag);
 
+   // set number of local worker processes used to run the points of a fixed scan in parallel
+   // (0 or 1: serial scan, negative: number of cores)
+   void SetNWorkers(int nWorkers = -1) { fNWorkers = nWorkers; }
+   int GetNWorkers() const { return fNWorkers; }
+
   
 protected:
 
@@ -179,6 +185,15 @@ protected:
    // run the hybrid at a single point
    HypoTestResult * Eval( HypoTestCalculatorGeneric &hc, bool adaptive , double clsTarget) const;
 
+   // run the hypothesis test at the given value of the scanned variable
+   HypoTestResult * EvalPoint( double rVal, bool adaptive, double clsTarget) const;
+
+   // add the result of a point to the HypoTestInverterResult
+   void StoreResult( double rVal, HypoTestResult * result) const;
+
+   // run the points of a fixed scan in parallel worker processes
+   bool RunParallelScan( const std::vector<double> & xValues) const;
+
    // helper functions 
    static RooRealVar * GetVariableToScan(const HypoTestCalculatorGeneric &hc);    
    static void CheckInputModels(const HypoTestCalculatorGeneric &hc, const RooRealVar & scanVar);    
@@ -215,6 +230,7 @@ private:
    double fXmin; 
    double fXmax; 
    double fNumErr;
+   int fNWorkers;  //! number of local worker processes for the fixed scan
 
 protected:
 
@@ -91,6 +91,12 @@ For parallel runs, ToyMCSampler can be given an instance of ProofConfig
 and then run in parallel using proof or proof-lite. Internally, it uses
 ToyMCStudy with the RooStudyManager.
 
+Alternatively, with SetNWorkers() the toys are distributed over local worker
+processes forked by TProcPool. Each worker runs on its own copy of the model
+and uses an independent random number seed drawn from RooRandom, so that the
+result is reproducible for a given seed and number of workers. The sampling
+distributions of the workers are merged in memory.
+
 \ingroup Roostats
 
 */
@@ -112,6 +118,7 @@ class ToyMCSampler: public TestStatSampler {
       virtual SamplingDistribution* GetSamplingDistribution(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributions(RooArgSet& paramPoint);
       virtual RooDataSet* GetSamplingDistributionsSingleWorker(RooArgSet& paramPoint);
+      virtual RooDataSet* GetSamplingDistributionsMultiProcess(RooArgSet& paramPoint);
 
       virtual SamplingDistribution* AppendSamplingDistribution(
          RooArgSet& allParameters, 
@@ -262,6 +269,11 @@ class ToyMCSampler: public TestStatSampler {
       // calling with argument or NULL deactivates proof
       void SetProofConfig(ProofConfig *pc = NULL) { fProofConfig = pc; }
 
+      // number of local worker processes used to generate the toys (0 or 1: serial run,
+      // negative: number of cores). Ignored when a ProofConfig is given
+      void SetNWorkers(Int_t nWorkers = -1) { fNWorkers = nWorkers; }
+      Int_t GetNWorkers() const { return fNWorkers; }
+
       void SetProtoData(const RooDataSet* d) { fProtoData = d; }
       
    protected:
@@ -307,6 +319,7 @@ class ToyMCSampler: public TestStatSampler {
       const RooDataSet *fProtoData; // in dev
       
       ProofConfig *fProofConfig;   //!
+      Int_t fNWorkers;             //! number of local worker processes
       
       mutable NuisanceParametersSampler *fNuisanceParametersSampler; //!
 
@@ -48,6 +48,10 @@
 
 #include "RooStats/ProofConfig.h"
 
+#include "TProcPool.h"
+#include <algorithm>
+#include <cstdlib>
+
 ClassImp(RooStats::HypoTestInverter)
 
 using namespace RooStats;
@@ -149,7 +153,8 @@ HypoTestInverter::HypoTestInverter( ) :
    fVerbose(0),
    fCalcType(kUndefined), 
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(0)
 {
   // default constructor (doesn't do anything) 
 }
@@ -167,7 +172,8 @@ HypoTestInverter::HypoTestInverter( HypoTestCalculatorGeneric& hc,
    fVerbose(0),
    fCalcType(kUndefined), 
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(0)
 {
    // Constructor from a HypoTestCalculatorGeneric
    // The HypoTest calculator must be a FrequentistCalculator or HybridCalculator type 
@@ -221,7 +227,8 @@ HypoTestInverter::HypoTestInverter( HybridCalculator& hc,
    fVerbose(0),
    fCalcType(kHybrid), 
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(0)
 {
    // Constructor from a reference to a HybridCalculator 
    // The calculator must be created before by using the S+B model for the null and 
@@ -255,7 +262,8 @@ HypoTestInverter::HypoTestInverter( FrequentistCalculator& hc,
    fVerbose(0),
    fCalcType(kFrequentist), 
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(0)
 {
    // Constructor from a reference to a FrequentistCalculator  
    // The calculator must be created before by using the S+B model for the null and 
@@ -285,7 +293,8 @@ HypoTestInverter::HypoTestInverter( AsymptoticCalculator& hc,
    fVerbose(0),
    fCalcType(kAsymptotic), 
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(0)
 {
    // Constructor from a reference to a AsymptoticCalculator 
    // The calculator must be created before by using the S+B model for the null and 
@@ -324,7 +333,8 @@ HypoTestInverter::HypoTestInverter( RooAbsData& data, ModelConfig &sbModel, Mode
    fVerbose(0),
    fCalcType(type), 
    fNBins(0), fXmin(1), fXmax(1),
-   fNumErr(0)
+   fNumErr(0),
+   fNWorkers(0)
 {
    if(fCalcType==kFrequentist) fHC.reset(new FrequentistCalculator(data, bModel, sbModel)); 
    if(fCalcType==kHybrid) fHC.reset( new HybridCalculator(data, bModel, sbModel)) ; 
@@ -374,6 +384,7 @@ HypoTestInverter & HypoTestInverter::operator= (const HypoTestInverter & rhs) {
    fXmin = rhs.fXmin;
    fXmax = rhs.fXmax;
    fNumErr = rhs.fNumErr;
+   fNWorkers = rhs.fNWorkers;
 
    return *this;
 }
@@ -600,6 +611,7 @@ bool HypoTestInverter::RunFixedScan( int nBins, double xMin, double xMax, bool s
                                           << xMax << std::endl; 
    }         
 
+   std::vector<double> xValues(nBins);
    double thisX = xMin; 
    for (int i=0; i<nBins; i++) {
       
@@ -609,8 +621,15 @@ bool HypoTestInverter::RunFixedScan( int nBins, double xMin, double xMax, bool s
          else
             thisX = xMin + i*(xMax-xMin)/(nBins-1);          // linear scan in x 
       }
+      xValues[i] = thisX;
+   }
+
+   if ((fNWorkers > 1 || fNWorkers < 0) && nBins > 1) 
+      return RunParallelScan(xValues);
+
+   for (int i=0; i<nBins; i++) {
          
-      bool status = RunOnePoint(thisX);
+      bool status = RunOnePoint(xValues[i]);
       
       // check if failed status
       if ( status==false ) {
@@ -650,21 +669,8 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
    // save old value 
    double oldValue = fScannedVariable->getVal();
 
-   // evaluate hybrid calculator at a single point
-   fScannedVariable->setVal(rVal);
-   // need to set value of rval in hybridcalculator
-   // assume null model is S+B and alternate is B only
-   const ModelConfig * sbModel = fCalculator0->GetNullModel();
-   RooArgSet poi; poi.add(*sbModel->GetParametersOfInterest());
-   // set poi to right values 
-   poi = RooArgSet(*fScannedVariable);
-   const_cast<ModelConfig*>(sbModel)->SetSnapshot(poi);
-
-   if (fVerbose > 0) 
-      oocoutP((TObject*)0,Eval) << "Running for " << fScannedVariable->GetName() << " = " << fScannedVariable->getVal() << endl;
-   
    // compute the results
-   HypoTestResult* result =   Eval(*fCalculator0,adaptive,clTarget);
+   HypoTestResult* result = EvalPoint(rVal,adaptive,clTarget);
    if (!result) { 
       oocoutE((TObject*)0,Eval) << "HypoTestInverter - Error running point " << fScannedVariable->GetName() << " = " <<
    fScannedVariable->getVal() << endl;
@@ -677,6 +683,44 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
       return true;  // need to return true to avoid breaking the scan loop
    }
    
+   StoreResult(rVal,result);
+
+   fScannedVariable->setVal(oldValue);
+   
+   return true;
+}
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run the hypothesis test with the scanned variable set to rVal.
+/// The value of the scanned variable is not restored.
+
+HypoTestResult * HypoTestInverter::EvalPoint(double rVal, bool adaptive, double clTarget) const
+{
+   // evaluate hybrid calculator at a single point
+   fScannedVariable->setVal(rVal);
+   // need to set value of rval in hybridcalculator
+   // assume null model is S+B and alternate is B only
+   const ModelConfig * sbModel = fCalculator0->GetNullModel();
+   RooArgSet poi; poi.add(*sbModel->GetParametersOfInterest());
+   // set poi to right values 
+   poi = RooArgSet(*fScannedVariable);
+   const_cast<ModelConfig*>(sbModel)->SetSnapshot(poi);
+
+   if (fVerbose > 0) 
+      oocoutP((TObject*)0,Eval) << "Running for " << fScannedVariable->GetName() << " = " << fScannedVariable->getVal() << endl;
+   
+   return Eval(*fCalculator0,adaptive,clTarget);
+}
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the result of the point rVal to the HypoTestInverterResult, taking its ownership.
+/// If the last point of the result has the same value, the two results are merged.
+
+void HypoTestInverter::StoreResult(double rVal, HypoTestResult * result) const
+{
    double lastXtested;
    if ( fResults->ArraySize()!=0 ) lastXtested = fResults->GetXValue(fResults->ArraySize()-1);
    else lastXtested = -999;
@@ -705,13 +749,89 @@ bool HypoTestInverter::RunOnePoint( double rVal, bool adaptive, double clTarget)
      fResults->fYObjects.Add(result);
 
    }
+}
 
-      // std::cout << "computed value for poi  " << rVal  << " : " << fResults->GetYValue(fResults->ArraySize()-1) 
-      //        << " +/- " << fResults->GetYError(fResults->ArraySize()-1) << endl;
 
-   fScannedVariable->setVal(oldValue);
-   
-   return true;
+////////////////////////////////////////////////////////////////////////////////
+/// Run the points of a fixed scan in parallel in local worker processes forked with TProcPool
+/// (see SetNWorkers). Every point is a task executed by a worker on its own copy of the
+/// models and of the calculator, with a random seed drawn from RooRandom in the master so that
+/// the scan is reproducible. The results are added to the HypoTestInverterResult in the order
+/// of the scan. A worker process should not also run the toys of a point in parallel, so a
+/// ToyMCSampler configured with ToyMCSampler::SetNWorkers runs serially in the workers.
+
+bool HypoTestInverter::RunParallelScan(const std::vector<double> & xValues) const
+{
+   int nPoints = xValues.size();
+   std::vector<UInt_t> points(nPoints);
+   std::vector<UInt_t> seeds(nPoints);
+   for (int i = 0; i < nPoints; ++i) {
+      points[i] = i;
+      // seeds are in [1,UINT_MAX]: a seed of 0 would make SetSeed() take the seed from the clock
+      seeds[i] = 1 + RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max());
+   }
+
+   TProcPool pool(fNWorkers > 0 ? fNWorkers : 0);
+   oocoutI((TObject*)0,Eval) << "HypoTestInverter::RunFixedScan - running " << nPoints << " points in "
+                             << std::min<int>(pool.GetNWorkers(),nPoints) << " worker processes" << std::endl;
+
+   // executed in the worker processes
+   auto runPoint = [&](UInt_t point) -> HypoTestResult* {
+      RooRandom::randomGenerator()->SetSeed(seeds[point]);
+      ToyMCSampler * sampler = dynamic_cast<ToyMCSampler*>(fCalculator0->GetTestStatSampler());
+      if (sampler) sampler->SetNWorkers(0);
+      HypoTestResult * result = EvalPoint(xValues[point],false,-1);
+      // the result is sent back to the master, an empty result with a failure tag
+      // is returned in case of errors
+      if (!result) {
+         result = new HypoTestResult();
+         result->SetTitle("failed");
+      }
+      // tag the result with the point number to restore the scan order
+      result->SetName(TString::Format("%u_%s",point,result->GetName()));
+      return result;
+   };
+   std::vector<HypoTestResult*> results = pool.Map(runPoint, points);
+
+   // sort by point number and remove the tag
+   std::vector<int> resultPoints(results.size());
+   for (unsigned int i = 0; i < results.size(); ++i) {
+      TString name = results[i]->GetName();
+      resultPoints[i] = atoi(name.Data());
+      results[i]->SetName(TString(name(name.Index("_")+1,name.Length())));
+   }
+   std::vector<unsigned int> order(results.size());
+   for (unsigned int i = 0; i < order.size(); ++i) order[i] = i;
+   std::sort(order.begin(), order.end(), [&](unsigned int a, unsigned int b) { return resultPoints[a] < resultPoints[b]; });
+
+   bool status = ((int)results.size() == nPoints);
+   if (!status) 
+      oocoutE((TObject*)0,Eval) << "HypoTestInverter::RunFixedScan - only " << results.size() << " of "
+                                << nPoints << " points have been returned by the worker processes" << std::endl;
+
+   for (unsigned int i = 0; i < order.size(); ++i) {
+      HypoTestResult * result = results[order[i]];
+      double rVal = xValues[resultPoints[order[i]]];
+      if (TString(result->GetTitle()) == "failed") {
+         oocoutE((TObject*)0,Eval) << "HypoTestInverter - Error running point " << fScannedVariable->GetName() << " = " <<
+            rVal << endl;
+         delete result;
+         status = false;
+         continue;
+      }
+      // in case of a dummy result
+      if (TMath::IsNaN(result->NullPValue() ) && TMath::IsNaN(result->AlternatePValue() ) ) {
+         oocoutW((TObject*)0,Eval) << "HypoTestInverter - Skip invalid result for  point " << fScannedVariable->GetName() << " = " <<
+            rVal << endl;
+         delete result;
+         continue;
+      }
+      if (result->GetNullDistribution() && result->GetAltDistribution()) 
+         fTotalToysRun += (result->GetAltDistribution()->GetSize() + result->GetNullDistribution()->GetSize());
+      StoreResult(rVal,result);
+   }
+
+   return status;
 }
 
 
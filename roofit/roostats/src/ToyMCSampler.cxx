@@ -28,6 +28,7 @@
 #include "RooRandom.h"
 
 #include "RooStudyManager.h"
+#include "TProcPool.h"
 #include "RooStats/ToyMCStudy.h"
 #include "RooStats/DetailedOutputAggregator.h"
 #include "RooStats/RooStatsUtils.h"
@@ -36,6 +37,9 @@
 
 #include "TMath.h"
 
+#include <algorithm>
+#include <cstdlib>
+
 
 using namespace RooFit;
 using namespace std;
@@ -157,6 +161,7 @@ ToyMCSampler::ToyMCSampler() : fSamplingDistName("SD"), fNToys(1)
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -196,6 +201,7 @@ ToyMCSampler::ToyMCSampler(TestStatistic &ts, Int_t ntoys) :
    fProtoData = NULL;
 
    fProofConfig = NULL;
+   fNWorkers = 0;
    fNuisanceParametersSampler = NULL;
 
    _allVars = NULL ;
@@ -302,8 +308,11 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    // Use for serial and parallel runs.
 
    // ======= S I N G L E   R U N ? =======
-   if(!fProofConfig)
+   if(!fProofConfig) {
+      if (fNWorkers > 1 || fNWorkers < 0)
+         return GetSamplingDistributionsMultiProcess(paramPointIn);
       return GetSamplingDistributionsSingleWorker(paramPointIn);
+   }
 
 
    // ======= P A R A L L E L   R U N =======
@@ -346,6 +355,86 @@ RooDataSet* ToyMCSampler::GetSamplingDistributions(RooArgSet& paramPointIn)
    return output;
 }
 
+RooDataSet* ToyMCSampler::GetSamplingDistributionsMultiProcess(RooArgSet& paramPointIn)
+{
+   // Run the toys in parallel in local worker processes forked with TProcPool.
+   // It is called automatically from inside GetSamplingDistribution when
+   // SetNWorkers() was called and no ProofConfig is given.
+   // The toys are split in one task per worker. Each task runs
+   // GetSamplingDistributionsSingleWorker on the copy of the model of its
+   // worker process, with a random seed drawn here from RooRandom, and the
+   // outputs are merged in the order of the tasks. The numbers of toys and
+   // of toys in the tails for adaptive sampling are shared among the tasks.
+
+   if (!CheckConfig()){
+      oocoutE((TObject*)NULL, InputArguments)
+         << "Bad COnfiguration in ToyMCSampler "
+         << endl;
+      return nullptr;
+   }
+
+   TProcPool pool(fNWorkers > 0 ? fNWorkers : 0);
+   Int_t nTasks = pool.GetNWorkers();
+   if (nTasks > fNToys) nTasks = fNToys;
+   if (nTasks < 2) return GetSamplingDistributionsSingleWorker(paramPointIn);
+
+   // draw the seeds of the tasks in the master so that the result is reproducible
+   std::vector<UInt_t> tasks(nTasks);
+   std::vector<UInt_t> seeds(nTasks);
+   for (Int_t i = 0; i < nTasks; ++i) {
+      tasks[i] = i;
+      // seeds are in [1,UINT_MAX]: a seed of 0 would make SetSeed() take the seed from the clock
+      seeds[i] = 1 + RooRandom::randomGenerator()->Integer(TMath::Limits<unsigned int>::Max());
+   }
+
+   const Int_t totToys = fNToys;
+   const Double_t totMaxToys = fMaxToys;
+   const Double_t totToysInTails = fToysInTails;
+
+   oocoutI((TObject*)NULL, Generation) << "ToyMCSampler: generating " << totToys
+      << " toys in " << nTasks << " worker processes" << endl;
+
+   // executed in the worker processes, which own a copy of this sampler and of the model
+   auto runTask = [&](UInt_t task) -> RooDataSet* {
+      RooRandom::randomGenerator()->SetSeed(seeds[task]);
+      fNToys = totToys / nTasks + (Int_t(task) < totToys % nTasks ? 1 : 0);
+      fMaxToys = totMaxToys / nTasks;
+      fToysInTails = totToysInTails / nTasks;
+      RooDataSet* r = GetSamplingDistributionsSingleWorker(paramPointIn);
+      if (!r) r = new RooDataSet;
+      // tag the output with the task number to merge the outputs in a fixed order
+      r->SetName(TString::Format("%u", task));
+      return r;
+   };
+   std::vector<RooDataSet*> outputs = pool.Map(runTask, tasks);
+
+   std::sort(outputs.begin(), outputs.end(), [](const RooDataSet* a, const RooDataSet* b) {
+      return atoi(a->GetName()) < atoi(b->GetName());
+   });
+
+   RooDataSet* output = NULL;
+   for (UInt_t i = 0; i < outputs.size(); ++i) {
+      if (outputs[i]->numEntries() == 0) {
+         delete outputs[i];
+      } else if (!output) {
+         output = outputs[i];
+      } else {
+         output->append(*outputs[i]);
+         delete outputs[i];
+      }
+   }
+   if (Int_t(outputs.size()) != nTasks) {
+      oocoutE((TObject*)NULL, Generation) << "ToyMCSampler: only " << outputs.size() << " of "
+         << nTasks << " worker processes returned their toys" << endl;
+   }
+   if (output) {
+      output->SetName(fSamplingDistName.c_str());
+      output->SetTitle(fSamplingDistName.c_str());
+   }
+
+   return output;
+}
+
 RooDataSet* ToyMCSampler::GetSamplingDistributionsSingleWorker(RooArgSet& paramPointIn)
 {
    // This is the main function for serial runs. It is called automatically
@@ -629,6 +629,31 @@ bool test36() {
    
    return ok; 
 } 
+bool test37() {
+   // test the exact parameter gradient of the formula
+   bool ok = true;
+   TF1 f1("f1","gaus(0)+expo(3)+[5]*sin(x)",-5,5);
+   f1.SetParameters(2,0.5,1.2,0.3,-0.2,1.5);
+   ok &= f1.GetFormula()->GenerateGradientPar();
+   double x = 1.3;
+   std::vector<double> grad(6);
+   f1.GetFormula()->GradientPar(&x, grad.data());
+   for (int i = 0; i < 6; ++i) {
+      // compare with the numerical derivative
+      double gnum = f1.GradientPar(i, &x);
+      if (!TMath::AreEqualRel( grad[i], gnum, 1.E-6) ) {
+         std::cout << "Error in test37 - derivative " << i << " is " << grad[i] << " instead of " << gnum << std::endl;
+         ok = false;
+      }
+   }
+   // functions without known derivative use the numerical gradient
+   TF1 f2("f2","landau",-5,5);
+   f2.SetParameters(1,0,1);
+   ok &= !f2.GetFormula()->GenerateGradientPar();
+   f2.GradientPar(&x, grad.data());
+   ok &= TMath::AreEqualRel( grad[0], TMath::Landau(x,0,1), 1.E-6);
+   return ok;
+}
    
 void PrintError(int itest)  { 
    Error("TFormula test","test%d FAILED ",itest);
@@ -683,6 +708,7 @@ int runTests(bool debug = false) {
    IncrTest(itest); if (!test34() ) { PrintError(itest); }
    IncrTest(itest); if (!test35() ) { PrintError(itest); }
    IncrTest(itest); if (!test36() ) { PrintError(itest); }
+   IncrTest(itest); if (!test37() ) { PrintError(itest); }
 
    std::cout << ".\n";
     
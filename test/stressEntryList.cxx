@@ -12,6 +12,10 @@
 //               and using ">>+elist" in TTree::Draw
 //   - Test3() - transforming TEventList objects into TEntryList objects for a TChain
 //   - Test4() - same as Test3() but for a TTree
+//   - Test5() - very big and very small entry lists for a TChain
+//   - Test6() - same as Test5() with TTrees in TDirectories
+//   - Test7() - fast CopyTree of a TEntryList selection, compared with
+//               the entry by entry CopyTree
 //
 //   To run in batch mode, do
 //     stressEntryList
@@ -31,6 +35,9 @@
 // Test2: Adding and subtracting entry lists-------------------------- OK
 // Test3: TEntryList and TEventList for TChain------------------------ OK
 // Test4: TEntryList and TEventList for TTree------------------------- OK
+// Test5: Full and Empty TEntryList----------------------------------- OK
+// Test6: Full and Empty TEntryList w/ TTrees in TDirectories--------- OK
+// Test7: Fast CopyTree of a TEntryList selection--------------------- OK
 // **********************************************************************
 // *******************Deleting the data files****************************
 // **********************************************************************
@@ -50,6 +57,7 @@
 #include "TCut.h"
 #include "TFile.h"
 #include "TSystem.h"
+#include "TTreeCloner.h"
 
 Int_t stressEntryList(Int_t nentries = 10000, Int_t nfiles = 10);
 void MakeTrees(Int_t nentries, Int_t nfiles);
@@ -532,6 +540,127 @@ Bool_t Test6()
                      "stressEntryListTrees*.root/Dir2/tree2"});
 }
 
+Bool_t CompareCopies(const char *fname1, const char *fname2)
+{
+   //Compare the entries of the trees "copy" in two files
+
+   TFile f1(fname1);
+   TFile f2(fname2);
+   TTree *t1 = (TTree*)f1.Get("copy");
+   TTree *t2 = (TTree*)f2.Get("copy");
+   if (!t1 || !t2 || t1->GetEntries() != t2->GetEntries())
+      return kFALSE;
+
+   Int_t i1, i2, n1, n2;
+   Double_t x1, x2;
+   Float_t v1[10], v2[10];
+   t1->SetBranchAddress("i", &i1);
+   t1->SetBranchAddress("x", &x1);
+   t1->SetBranchAddress("n", &n1);
+   t1->SetBranchAddress("v", v1);
+   t2->SetBranchAddress("i", &i2);
+   t2->SetBranchAddress("x", &x2);
+   t2->SetBranchAddress("n", &n2);
+   t2->SetBranchAddress("v", v2);
+
+   Int_t wrongentries = 0;
+   for (Long64_t entry=0; entry<t1->GetEntries(); entry++){
+      t1->GetEntry(entry);
+      t2->GetEntry(entry);
+      if (i1 != i2 || x1 != x2 || n1 != n2) {
+         wrongentries++;
+         continue;
+      }
+      for (Int_t k=0; k<n1; k++)
+         if (v1[k] != v2[k]) wrongentries++;
+   }
+   if (wrongentries > 0)
+      printf("\nfast and slow copy: number of wrong entries=%d\n", wrongentries);
+   return wrongentries == 0;
+}
+
+Bool_t Test7()
+{
+   //Test CopyTree with option "fast" for a tree with an entry list:
+   //the tree has small baskets, so that the selection contains baskets
+   //which are completely selected and copied without being unzipped, and
+   //baskets which are partially selected and filtered. The result must be
+   //identical to the one of the entry by entry copy
+
+   const char *fnamein   = "stressEntryListFastIn.root";
+   const char *fnameslow = "stressEntryListSlow.root";
+   const char *fnamefast = "stressEntryListFast.root";
+   const char *fnametest = "stressEntryListCloner.root";
+
+   TFile fin(fnamein, "RECREATE");
+   TTree *tree = new TTree("tree", "input of the fast copy");
+   Int_t i, n;
+   Double_t x;
+   Float_t v[10];
+   tree->Branch("i", &i, "i/I");
+   tree->Branch("x", &x, "x/D");
+   tree->Branch("n", &n, "n/I");
+   tree->Branch("v", v, "v[n]/F");
+   tree->SetBasketSize("*", 2000);
+   for (i=0; i<20000; i++){
+      x = 0.5*i;
+      n = i%10;
+      for (Int_t k=0; k<n; k++) v[k] = i + 0.25*k;
+      tree->Fill();
+   }
+   tree->Write();
+
+   //all entries at the beginning, every third one and none at the end
+   tree->Draw(">>elfast", "i<5000 || (i<15000 && i%3==0)", "entrylist");
+   TEntryList *elfast = (TEntryList*)gDirectory->Get("elfast");
+   if (!elfast) return kFALSE;
+   tree->SetEntryList(elfast);
+
+   //the selection can be transferred by TTreeCloner, so "fast" is not
+   //silently falling back to the entry by entry copy
+   Bool_t ok = kTRUE;
+   {
+      TFile ftest(fnametest, "RECREATE");
+      TTree *clone = tree->CloneTree(0);
+      TTreeCloner cloner(tree, clone, "", TTreeCloner::kNoWarnings);
+      cloner.SetEntryList(elfast);
+      if (!cloner.IsValid()) {
+         printf("\nfast copy not possible: %s\n", cloner.GetWarning());
+         ok = kFALSE;
+      }
+      delete clone;
+   }
+
+   TFile fslow(fnameslow, "RECREATE");
+   TTree *slow = tree->CopyTree("");
+   slow->SetName("copy");
+   slow->Write();
+   Long64_t nslow = slow->GetEntries();
+   fslow.Close();
+
+   TFile ffast(fnamefast, "RECREATE");
+   TTree *fast = tree->CopyTree("", "fast");
+   fast->SetName("copy");
+   fast->Write();
+   Long64_t nfast = fast->GetEntries();
+   ffast.Close();
+
+   if (nslow != elfast->GetN() || nfast != nslow) {
+      printf("\nentries in list: %lld, slow copy: %lld, fast copy: %lld\n", elfast->GetN(), nslow, nfast);
+      ok = kFALSE;
+   }
+
+   tree->SetEntryList(0);
+   fin.Close();
+
+   if (ok) ok = CompareCopies(fnameslow, fnamefast);
+
+   gSystem->Unlink(fnamein);
+   gSystem->Unlink(fnameslow);
+   gSystem->Unlink(fnamefast);
+   gSystem->Unlink(fnametest);
+   return ok;
+}
 
 void SetupTree(TTree* tree, Double_t x, Double_t y, Double_t z)
 {
@@ -620,7 +749,8 @@ Int_t stressEntryList(Int_t nentries, Int_t nfiles)
       {Test3, "Test3: TEntryList and TEventList for TChain------------------------ "},
       {Test4, "Test4: TEntryList and TEventList for TTree------------------------- "},
       {Test5, "Test5: Full and Empty TEntryList----------------------------------- "},
-      {Test6, "Test6: Full and Empty TEntryList w/ TTrees in TDirectories--------- "}
+      {Test6, "Test6: Full and Empty TEntryList w/ TTrees in TDirectories--------- "},
+      {Test7, "Test7: Fast CopyTree of a TEntryList selection--------------------- "}
    };
 
    for (auto const & testDescrPair : testDescrList) {
@@ -1,12 +1,16 @@
 // ROOT headers
 #include "TString.h"
+#include "TH1F.h"
+#include "TMath.h"
 
 // RooFit headers
 #include "RooWorkspace.h"
+#include "RooRealSumPdf.h"
 
 // HistFactory headers
 #include "RooStats/HistFactory/Measurement.h"
 #include "RooStats/HistFactory/MakeModelAndMeasurementsFast.h"
+#include "RooStats/HistFactory/HistoToWorkspaceFactoryFast.h"
 
 using namespace RooFit;
 using namespace RooStats;
@@ -84,3 +88,87 @@ void buildAPI_XML_TestModel(TString prefix)
 
   meas.PrintXML();
 }
+
+
+
+////////////////////////////////////////////////////////////////////////////////
+/// Build model with a signal region and a sideband region from histograms
+/// in memory and return the combined workspace. The channel p.d.f.s are
+/// marked for the binned likelihood calculation.
+
+RooWorkspace* buildInMemoryTestModel()
+{
+  HistFactory::Measurement meas("Test","InMemoryTestModel");
+  meas.SetPOI("mu");
+  meas.SetLumi(1.0);
+  meas.SetLumiRelErr(0.1);
+  meas.AddConstantParam("Lumi");
+
+  // fixed histogram contents, so that the model does not depend on the random generator
+  // (the samples, channels and systematics take ownership of the histograms)
+  const Int_t nBins = 10;
+  TH1F* hSignal = new TH1F("InMemory_signal","signal",nBins,0,10);
+  TH1F* hBackground = new TH1F("InMemory_background","background",nBins,0,10);
+  TH1F* hBackgroundLow = new TH1F("InMemory_background_Low","background low",nBins,0,10);
+  TH1F* hBackgroundHigh = new TH1F("InMemory_background_High","background high",nBins,0,10);
+  TH1F* hData = new TH1F("InMemory_data","data",nBins,0,10);
+  TH1F* hSideband = new TH1F("InMemory_sideband","sideband",nBins,0,10);
+  TH1F* hSidebandData = new TH1F("InMemory_sideband_data","sideband data",nBins,0,10);
+  for (Int_t i = 1; i <= nBins; ++i) {
+    Double_t s = 20*TMath::Gaus(i,5,1.5);
+    Double_t b = 50 - 3*i;
+    hSignal->SetBinContent(i,s);
+    hBackground->SetBinContent(i,b);
+    hBackground->SetBinError(i,TMath::Sqrt(b)/2);
+    hBackgroundLow->SetBinContent(i,b*(1 - 0.02*i));
+    hBackgroundHigh->SetBinContent(i,b*(1 + 0.02*i));
+    hData->SetBinContent(i,TMath::Nint(b + 1.3*s) + 3*((i%3) - 1));
+    hSideband->SetBinContent(i,20);
+    hSidebandData->SetBinContent(i,20 + 2*((i%4) - 1));
+  }
+
+  // signal region
+  HistFactory::Channel SignalRegion("SignalRegion");
+  SignalRegion.SetData(hData);
+  SignalRegion.SetStatErrorConfig(0.05,HistFactory::Constraint::Gaussian);
+
+  HistFactory::Sample Signal("signal");
+  Signal.SetHisto(hSignal);
+  Signal.AddNormFactor("mu",1,0,10);
+  Signal.AddOverallSys("AccSys",0.95,1.05);
+  SignalRegion.AddSample(Signal);
+
+  HistFactory::Sample Background("background");
+  Background.SetHisto(hBackground);
+  Background.ActivateStatError();
+  HistFactory::HistoSys shapeSys("bkg_shape_unc");
+  shapeSys.SetHistoLow(hBackgroundLow);
+  shapeSys.SetHistoHigh(hBackgroundHigh);
+  Background.AddHistoSys(shapeSys);
+  Background.AddNormFactor("bkg",1,0,20);
+  SignalRegion.AddSample(Background);
+
+  // sideband region
+  HistFactory::Channel SidebandRegion("SidebandRegion");
+  SidebandRegion.SetData(hSidebandData);
+
+  HistFactory::Sample Sideband("sideband");
+  Sideband.SetHisto(hSideband);
+  Sideband.SetNormalizeByTheory(kFALSE);
+  Sideband.AddNormFactor("bkg",1,0,20);
+  Sideband.AddOverallSys("bkg_unc",0.9,1.1);
+  SidebandRegion.AddSample(Sideband);
+
+  meas.AddChannel(SignalRegion);
+  meas.AddChannel(SidebandRegion);
+
+  RooWorkspace* w = HistFactory::HistoToWorkspaceFactoryFast::MakeCombinedModel(meas);
+
+  RooFIter iter = w->components().fwdIterator();
+  RooAbsArg* arg;
+  while ((arg = iter.next())) {
+    if (arg->InheritsFrom(RooRealSumPdf::Class())) arg->setAttribute("BinnedLikelihood");
+  }
+
+  return w;
+}
@@ -1,6 +1,7 @@
 // C/C++ headers
 #include <iostream>
 #include <stdio.h>
+#include <vector>
 
 // ROOT headers
 #include "TFile.h"
@@ -17,10 +18,19 @@
 #include "RooLinkedListIter.h"
 #include "RooAbsPdf.h"
 #include "RooDataSet.h"
+#include "RooRealVar.h"
+#include "RooFitResult.h"
+#include "RooMinimizer.h"
+#include "RooFlatFunc.h"
+#include "RooNLLVar.h"
+#include "RooDataHist.h"
+#include "RooHistFunc.h"
+#include "RooProduct.h"
 
 // RooStats header(s)
 #include "RooStats/ModelConfig.h"
 #include "RooStats/RooStatsUtils.h"
+#include "RooStats/HistFactory/PiecewiseInterpolation.h"
 
 #include "stressHistFactory_models.cxx"
 
@@ -477,3 +487,292 @@ private:
     return kTRUE;
   }
 };
+
+
+
+class FlatEvaluation : public RooUnitTest {
+public:
+  FlatEvaluation(
+    TFile* refFile,
+    Bool_t writeRef,
+    Int_t verbose
+    ) :
+    RooUnitTest("Flattened binned likelihood for HistFactory", refFile, writeRef, verbose)
+  {}
+
+  Bool_t testCode()
+  {
+    RooWorkspace* w = buildInMemoryTestModel();
+    ModelConfig* mc = (ModelConfig*)w->obj("ModelConfig");
+    RooAbsData* data = w->data("obsData");
+    if(!mc || !data) {
+       Error("testCode","Error retrieving the ModelConfig or the data");
+       return kFALSE;
+    }
+
+    RooAbsReal* nll = mc->GetPdf()->createNLL(*data,Constrain(*mc->GetNuisanceParameters()),
+                                              GlobalObservables(*mc->GetGlobalObservables()));
+
+    RooArgSet candidates(*mc->GetParametersOfInterest());
+    candidates.add(*mc->GetNuisanceParameters());
+    RooArgList params;
+    RooFIter iter = candidates.fwdIterator();
+    RooAbsArg* arg;
+    while((arg = iter.next())) {
+       if(!arg->isConstant()) params.add(*arg);
+    }
+    RooArgList* initial = (RooArgList*)params.snapshot();
+
+    // the channel likelihoods are translated bin by bin, only the constraint terms
+    // are evaluated through the expression tree
+    RooFlatFunc flat(*nll,params);
+    if(_verb > 0)
+       Info("testCode","%d parameters, %d instructions in flattened program",params.getSize(),flat.numInstructions());
+    if(flat.numFallbacks() > 1) {
+       Error("testCode","%d nodes of the flattened likelihood are evaluated through the expression tree",flat.numFallbacks());
+       return kFALSE;
+    }
+
+    // compare the flattened and the expression tree likelihood at a few points around the initial values
+    std::vector<Double_t> x(params.getSize());
+    for(Int_t k = 0; k < 5; ++k) {
+       params = *initial;
+       for(Int_t i = 0; i < params.getSize(); ++i) {
+          RooRealVar& par = (RooRealVar&)params[i];
+          x[i] = par.getVal() + 0.05*(k + 1)*((i%3) - 1);
+       }
+       Double_t flatVal = flat(&x[0]);
+       for(Int_t i = 0; i < params.getSize(); ++i) {
+          ((RooRealVar&)params[i]).setVal(x[i]);
+       }
+       Double_t graphVal = nll->getVal();
+       if(_verb > 0)
+          Info("testCode","point %d: flattened %.12g, expression tree %.12g",k,flatVal,graphVal);
+       if(!TMath::AreEqualRel(flatVal,graphVal,1e-9)) {
+          Error("testCode","flattened likelihood %.12g differs from expression tree likelihood %.12g",flatVal,graphVal);
+          return kFALSE;
+       }
+    }
+
+    // fit with and without the flattened program from the same starting point
+    std::string minimizerType = "Minuit2";
+    int prec = gErrorIgnoreLevel;
+    gErrorIgnoreLevel = kFatal;
+    if (gSystem->Load("libMinuit2") < 0) minimizerType = "Minuit";
+    gErrorIgnoreLevel=prec;
+
+    params = *initial;
+    RooMinimizer m1(*nll);
+    m1.setPrintLevel(_verb > 0 ? 0 : -1);
+    m1.minimize(minimizerType.c_str());
+    RooFitResult* r1 = m1.save();
+    if (minimizerType == "Minuit") {
+       if (gMinuit) { delete gMinuit; gMinuit=0; }
+    }
+
+    params = *initial;
+    RooMinimizer m2(*nll);
+    m2.setPrintLevel(_verb > 0 ? 0 : -1);
+    m2.setFlatEvaluation(kTRUE);
+    m2.minimize(minimizerType.c_str());
+    RooFitResult* r2 = m2.save();
+
+    if(_verb > 0)
+    {
+      r1->Print("v");
+      r2->Print("v");
+    }
+
+    Bool_t ret = kTRUE;
+    if(!TMath::AreEqualAbs(r1->minNll(),r2->minNll(),1e-6))
+    {
+      Error("testCode","fits end up in different minima: %.8f vs %.8f",r1->minNll(),r2->minNll());
+      ret = kFALSE;
+    }
+    for(Int_t i = 0; i < r1->floatParsFinal().getSize(); ++i) {
+      RooRealVar& par1 = (RooRealVar&)r1->floatParsFinal()[i];
+      RooRealVar* par2 = (RooRealVar*)r2->floatParsFinal().find(par1.GetName());
+      if(!par2 || !TMath::AreEqualAbs(par1.getVal(),par2->getVal(),1e-3*par1.getError()))
+      {
+        Error("testCode","fitted values of parameter %s differ",par1.GetName());
+        ret = kFALSE;
+      }
+    }
+
+    delete r1;
+    delete r2;
+    delete initial;
+    delete nll;
+    delete w;
+
+    return ret;
+  }
+};
+
+
+
+class BatchEvaluation : public RooUnitTest {
+public:
+  BatchEvaluation(
+    TFile* refFile,
+    Bool_t writeRef,
+    Int_t verbose
+    ) :
+    RooUnitTest("Batched binned likelihood for HistFactory", refFile, writeRef, verbose)
+  {}
+
+  Bool_t testCode()
+  {
+    if(RooNLLVar::batchEvaluation()) {
+       Error("testCode","batch evaluation of the likelihood is switched on by default");
+       return kFALSE;
+    }
+
+    RooWorkspace* w = buildInMemoryTestModel();
+    ModelConfig* mc = (ModelConfig*)w->obj("ModelConfig");
+    RooAbsData* data = w->data("obsData");
+    RooAbsData* asimov = w->data("asimovData");
+    if(!mc || !data || !asimov) {
+       Error("testCode","Error retrieving the ModelConfig or the data");
+       return kFALSE;
+    }
+
+    // two likelihoods of the same model, one evaluated bin by bin and one with the batch evaluation
+    RooAbsReal* nllScalar = mc->GetPdf()->createNLL(*data,Constrain(*mc->GetNuisanceParameters()),
+                                                    GlobalObservables(*mc->GetGlobalObservables()));
+    RooAbsReal* nllBatch = mc->GetPdf()->createNLL(*data,Constrain(*mc->GetNuisanceParameters()),
+                                                   GlobalObservables(*mc->GetGlobalObservables()));
+
+    RooArgSet candidates(*mc->GetParametersOfInterest());
+    candidates.add(*mc->GetNuisanceParameters());
+    RooArgList params;
+    RooFIter iter = candidates.fwdIterator();
+    RooAbsArg* arg;
+    while((arg = iter.next())) {
+       if(!arg->isConstant()) params.add(*arg);
+    }
+    RooArgList* initial = (RooArgList*)params.snapshot();
+
+    // the batch evaluation keeps data of the bins, which must be collected again after setData()
+    Bool_t ret = CompareLikelihoods(*nllScalar,*nllBatch,params,*initial,"observed data");
+    if(ret) {
+       nllScalar->setData(*asimov,kFALSE);
+       nllBatch->setData(*asimov,kFALSE);
+       ret = CompareLikelihoods(*nllScalar,*nllBatch,params,*initial,"Asimov data");
+    }
+
+    delete initial;
+    delete nllScalar;
+    delete nllBatch;
+    delete w;
+
+    return ret;
+  }
+
+private:
+  Bool_t CompareLikelihoods(RooAbsReal& nllScalar, RooAbsReal& nllBatch, RooArgList& params,
+                            const RooArgList& initial, const char* dataName)
+  {
+    for(Int_t k = 0; k < 5; ++k) {
+       params = initial;
+       for(Int_t i = 0; i < params.getSize(); ++i) {
+          RooRealVar& par = (RooRealVar&)params[i];
+          par.setVal(par.getVal() + 0.05*k*((i%3) - 1));
+       }
+       RooNLLVar::setBatchEvaluation(kFALSE);
+       Double_t scalarVal = nllScalar.getVal();
+       RooNLLVar::setBatchEvaluation(kTRUE);
+       Double_t batchVal = nllBatch.getVal();
+       RooNLLVar::setBatchEvaluation(kFALSE);
+
+       if(_verb > 0)
+          Info("CompareLikelihoods","%s, point %d: bin by bin %.12g, batch %.12g",dataName,k,scalarVal,batchVal);
+       if(!TMath::AreEqualRel(scalarVal,batchVal,1e-10)) {
+          Error("CompareLikelihoods","%s: batched likelihood %.12g differs from likelihood evaluated bin by bin %.12g",
+                dataName,batchVal,scalarVal);
+          return kFALSE;
+       }
+    }
+    return kTRUE;
+  }
+};
+
+
+class InterpolationCache : public RooUnitTest {
+public:
+  InterpolationCache(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Cached HistFactory interpolation", refFile, writeRef, verbose) {};
+
+  Bool_t testCode() {
+
+    RooRealVar x("x","x",0,10);
+    x.setBins(10);
+
+    // nominal and variations, all positive for the multiplicative interpolation
+    TH1F hNom("hNom","",10,0,10), hLow1("hLow1","",10,0,10), hHigh1("hHigh1","",10,0,10);
+    TH1F hLow2("hLow2","",10,0,10), hHigh2("hHigh2","",10,0,10);
+    for(Int_t b = 1; b <= 10; ++b) {
+       hNom.SetBinContent(b,20. + 3.*b);
+       hLow1.SetBinContent(b,(20. + 3.*b)*(0.85 + 0.01*b));
+       hHigh1.SetBinContent(b,(20. + 3.*b)*(1.10 + 0.02*b));
+       hLow2.SetBinContent(b,18. + 2.5*b);
+       hHigh2.SetBinContent(b,23. + 3.5*b);
+    }
+    RooDataHist dNom("dNom","",x,&hNom), dLow1("dLow1","",x,&hLow1), dHigh1("dHigh1","",x,&hHigh1);
+    RooDataHist dLow2("dLow2","",x,&hLow2), dHigh2("dHigh2","",x,&hHigh2);
+    RooHistFunc nom("nom","",x,dNom), low1("low1","",x,dLow1), high1("high1","",x,dHigh1);
+    RooHistFunc low2("low2","",x,dLow2), high2("high2","",x,dHigh2);
+
+    // the same nominal, which is not a RooHistFunc and therefore disables the cache
+    RooProduct nomUncached("nomUncached","",RooArgList(nom));
+
+    RooRealVar alpha1("alpha1","",0,-5,5), alpha2("alpha2","",0,-5,5);
+    RooArgList lowSet(low1,low2), highSet(high1,high2), params(alpha1,alpha2);
+
+    for(Int_t code = 0; code <= 4; ++code) {
+       PiecewiseInterpolation cached("cached","",nom,lowSet,highSet,params);
+       PiecewiseInterpolation uncached("uncached","",nomUncached,lowSet,highSet,params);
+       cached.setAllInterpCodes(code);
+       uncached.setAllInterpCodes(code);
+
+       // scan alpha1 across the |alpha|=1 boundary, while alpha2 changes only now and then
+       Bool_t ret = kTRUE;
+       for(Int_t k = 0; k < 25 && ret; ++k) {
+          alpha1.setVal(-1.8 + 0.15*k);
+          alpha2.setVal(k%5 == 0 ? 0.3 - 0.1*k : alpha2.getVal());
+          ret = CompareBins(x,cached,uncached,code);
+       }
+
+       // changes of the histogram contents must be picked up by the cached values
+       if(ret) {
+          dNom.get(3);
+          dNom.set(dNom.weight()*1.5);
+          dHigh1.get(7);
+          dHigh1.set(dHigh1.weight() + 4.);
+          nom.setValueDirty();
+          high1.setValueDirty();
+          ret = CompareBins(x,cached,uncached,code);
+       }
+       if(!ret) return kFALSE;
+    }
+
+    return kTRUE;
+  }
+
+private:
+  Bool_t CompareBins(RooRealVar& x, RooAbsReal& cached, RooAbsReal& uncached, Int_t code)
+  {
+    for(Int_t b = 0; b < x.numBins(); ++b) {
+       x.setBin(b);
+       Double_t cachedVal = cached.getVal();
+       Double_t uncachedVal = uncached.getVal();
+       if(_verb > 0)
+          Info("CompareBins","code %d, bin %d: cached %.12g, uncached %.12g",code,b,cachedVal,uncachedVal);
+       if(!TMath::AreEqualRel(cachedVal,uncachedVal,1e-12)) {
+          Error("CompareBins","interpolation code %d, bin %d: cached value %.12g differs from uncached value %.12g",
+                code,b,cachedVal,uncachedVal);
+          return kFALSE;
+       }
+    }
+    return kTRUE;
+  }
+};
@@ -0,0 +1,179 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A stress test for the multi-threaded THttpServer___
+//
+//   The functions below submit read-only requests from several threads
+//   at once, as the http engines do with THttpServer::SetMultiThreaded()
+//   - Test1() - root.json requests for several histograms, while the
+//               process numeric locale uses a decimal comma; every reply
+//               must be identical to the JSON produced in the main thread
+//   - Test2() - same as Test1() with the sniffer JSON cache enabled
+//   - Test3() - h.json requests for the objects hierarchy
+//
+//   To run in batch mode, do
+//     stressHttp
+//
+//   An example of output when all tests pass:
+// **********************************************************************
+// ******************Starting THttpServer stress test********************
+// **********************************************************************
+// Test1: Parallel root.json requests--------------------------------- OK
+// Test2: Parallel root.json requests with JSON cache----------------- OK
+// Test3: Parallel h.json requests------------------------------------ OK
+// **********************************************************************
+
+#include <stdio.h>
+#include <locale.h>
+#include <thread>
+#include <atomic>
+#include <vector>
+
+#include "TROOT.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TString.h"
+#include "TPRegexp.h"
+#include "TBufferJSON.h"
+#include "THttpServer.h"
+#include "THttpCallArg.h"
+#include "TRootSniffer.h"
+
+Int_t stressHttp();
+
+static const Int_t kNThreads  = 8;
+static const Int_t kNRequests = 50;
+static const Int_t kNHist     = 4;
+
+static THttpServer *gServ = 0;
+static TH1 *gHist[kNHist];
+static TString gRef[kNHist];
+
+////////////////////////////////////////////////////////////////////////////////
+/// Execute one GET request the way an engine thread does.
+
+static TString Request(const char *path, const char *fname)
+{
+   THttpCallArg arg;
+   arg.SetMethod("GET");
+   arg.SetPathName(path);
+   arg.SetFileName(fname);
+   gServ->ExecuteHttp(&arg);
+   if (arg.Is404())
+      return "";
+   return TString((const char *) arg.GetContent(), arg.GetContentLength());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Request the histograms from all threads and compare with the reference.
+
+static Bool_t ParallelObjects()
+{
+   std::atomic<Int_t> nbad(0);
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < kNThreads; t++)
+      threads.push_back(std::thread([t, &nbad]() {
+         for (Int_t i = 0; i < kNRequests; i++) {
+            Int_t k = (t + i) % kNHist;
+            TString path = TString::Format("hist/%s", gHist[k]->GetName());
+            if (Request(path, "root.json") != gRef[k])
+               nbad++;
+         }
+      }));
+   for (size_t t = 0; t < threads.size(); t++)
+      threads[t].join();
+   return nbad == 0;
+}
+
+Bool_t Test1()
+{
+   return ParallelObjects();
+}
+
+Bool_t Test2()
+{
+   gServ->GetSniffer()->SetJsonCacheSize(kNHist);
+   Bool_t ok = ParallelObjects();
+   gServ->GetSniffer()->SetJsonCacheSize(0);
+   return ok;
+}
+
+Bool_t Test3()
+{
+   TString ref = Request("", "h.json");
+   if ((ref.Length() == 0) || !ref.Contains(gHist[0]->GetName()))
+      return kFALSE;
+
+   std::atomic<Int_t> nbad(0);
+   std::vector<std::thread> threads;
+   for (Int_t t = 0; t < kNThreads; t++)
+      threads.push_back(std::thread([&ref, &nbad]() {
+         for (Int_t i = 0; i < kNRequests; i++)
+            if (Request("", "h.json") != ref)
+               nbad++;
+      }));
+   for (size_t t = 0; t < threads.size(); t++)
+      threads[t].join();
+   return nbad == 0;
+}
+
+Int_t stressHttp()
+{
+   printf("**********************************************************************\n");
+   printf("******************Starting THttpServer stress test********************\n");
+   printf("**********************************************************************\n");
+
+   // a locale with decimal comma, if one is installed: JSON must not use it
+   const char *locales[] = { "de_DE.UTF-8", "de_DE.utf8", "de_DE", "fr_FR.UTF-8", "fr_FR", "ru_RU.UTF-8", 0 };
+   for (Int_t i = 0; locales[i]; i++)
+      if (setlocale(LC_NUMERIC, locales[i]))
+         break;
+
+   // no engine, requests are submitted directly
+   gServ = new THttpServer("");
+   gServ->SetMultiThreaded();
+
+   for (Int_t k = 0; k < kNHist; k++) {
+      if (k % 2 == 0)
+         gHist[k] = new TH1F(TString::Format("h1_%d", k), "1D histogram", 100 + k, -1.5, 2.5);
+      else
+         gHist[k] = new TH2F(TString::Format("h2_%d", k), "2D histogram", 20, 0., 1.25, 20 + k, -0.5, 0.5);
+      for (Int_t bin = 0; bin < gHist[k]->GetNcells(); bin++)
+         gHist[k]->SetBinContent(bin, 0.25 + bin * 0.125 + k);
+      gServ->Register("/hist", gHist[k]);
+   }
+
+   // references are produced in the main thread, without concurrency
+   TPRegexp comma("[0-9],[0-9]");
+   Bool_t refok = kTRUE;
+   for (Int_t k = 0; k < kNHist; k++) {
+      gRef[k] = TBufferJSON::ConvertToJSON(gHist[k], 0);
+      if ((gRef[k].Length() == 0) || comma.MatchB(gRef[k]))
+         refok = kFALSE;
+   }
+
+   Bool_t ok1 = refok && Test1();
+   printf("Test1: Parallel root.json requests--------------------------------- %s\n",
+          ok1 ? "OK" : "FAILED");
+   Bool_t ok2 = refok && Test2();
+   printf("Test2: Parallel root.json requests with JSON cache----------------- %s\n",
+          ok2 ? "OK" : "FAILED");
+   Bool_t ok3 = Test3();
+   printf("Test3: Parallel h.json requests------------------------------------ %s\n",
+          ok3 ? "OK" : "FAILED");
+
+   printf("**********************************************************************\n");
+
+   delete gServ;
+   for (Int_t k = 0; k < kNHist; k++)
+      delete gHist[k];
+   setlocale(LC_NUMERIC, "C");
+
+   return (ok1 && ok2 && ok3) ? 0 : 1;
+}
+
+int main()
+{
+   return stressHttp();
+}
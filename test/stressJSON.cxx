@@ -0,0 +1,302 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A stress test for the TBufferJSON conversions___
+//
+//   The functions below write JsonTestObject (see stressJSON.h) with
+//   TBufferJSON::ConvertToJSON and read it back with ConvertFromJSON
+//   - Test1() - members of all basic types, including the Long64_t and
+//               ULong64_t limits, which do not fit into a Double_t
+//   - Test2() - fixed and variable size arrays, TArrays, STL containers
+//               and a TList
+//   - Test3() - TBufferJSON::ExportToFile, which flushes its output in
+//               chunks, produces exactly the ConvertToJSON string
+//
+//   To run in batch mode, do
+//     stressJSON
+//
+//   An example of output when all tests pass:
+// **********************************************************************
+// ******************Starting TBufferJSON stress test********************
+// **********************************************************************
+// Test1: Round trip of basic types and 64-bit limits----------------- OK
+// Test2: Round trip of arrays and containers------------------------- OK
+// Test3: ExportToFile output identical to ConvertToJSON-------------- OK
+// **********************************************************************
+
+#include <stdio.h>
+#include <fstream>
+#include <sstream>
+
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TMath.h"
+#include "TNamed.h"
+#include "TBufferJSON.h"
+
+#include "stressJSON.h"
+
+ClassImp(JsonTestObject)
+
+Int_t stressJSON();
+
+////////////////////////////////////////////////////////////////////////////////
+/// Create an object with all members zero or empty.
+
+JsonTestObject::JsonTestObject() :
+   fBool(kFALSE), fChar(0), fUChar(0), fShort(0), fUShort(0), fInt(0), fUInt(0),
+   fLong(0), fULong(0), fLong64(0), fULong64(0), fFloat(0), fDouble(0), fBigDouble(0),
+   fN(0), fValues(0), fList(0)
+{
+   for (Int_t i = 0; i < 3; i++) fIntArray[i] = 0;
+   for (Int_t i = 0; i < 4; i++) fLong64Array[i] = 0;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Destructor.
+
+JsonTestObject::~JsonTestObject()
+{
+   delete [] fValues;
+   if (fList) fList->Delete();
+   delete fList;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill all members with test values. Floating point values have at most
+/// seven significant digits, which is what TBufferJSON writes. With nlarge
+/// the vector of doubles and the list get that many more entries.
+
+void JsonTestObject::Fill(Int_t nlarge)
+{
+   const Long64_t  l64min = TMath::Limits<Long64_t>::Min();
+   const Long64_t  l64max = TMath::Limits<Long64_t>::Max();
+   const ULong64_t u64max = TMath::Limits<ULong64_t>::Max();
+   const Long64_t  p53    = 9007199254740993LL;  // 2^53 + 1
+
+   fBool      = kTRUE;
+   fChar      = -100;
+   fUChar     = 250;
+   fShort     = TMath::Limits<Short_t>::Min();
+   fUShort    = TMath::Limits<UShort_t>::Max();
+   fInt       = TMath::Limits<Int_t>::Min();
+   fUInt      = TMath::Limits<UInt_t>::Max();
+   fLong      = TMath::Limits<Long_t>::Min();
+   fULong     = TMath::Limits<ULong_t>::Max();
+   fLong64    = l64max;
+   fULong64   = u64max;
+   fFloat     = 1.25;
+   fDouble    = -3.5e-3;
+   fBigDouble = 1e20;
+   fString    = "TString with \"quotes\" and \\ backslash";
+   fStdString = "std::string with\nnew line";
+
+   fIntArray[0] = TMath::Limits<Int_t>::Min();
+   fIntArray[1] = 0;
+   fIntArray[2] = TMath::Limits<Int_t>::Max();
+   fLong64Array[0] = l64min;
+   fLong64Array[1] = l64max;
+   fLong64Array[2] = p53;
+   fLong64Array[3] = -p53;
+
+   delete [] fValues;
+   fN = 5;
+   fValues = new Double_t[fN];
+   for (Int_t i = 0; i < fN; i++) fValues[i] = 0.25 + 0.5 * i;
+
+   fTArrayL64.Set(4);
+   fTArrayL64[0] = l64max;
+   fTArrayL64[1] = l64min;
+   fTArrayL64[2] = p53;
+   fTArrayL64[3] = 0;
+   fTArrayD.Set(3);
+   fTArrayD[0] = 1.5;
+   fTArrayD[1] = -2.25;
+   fTArrayD[2] = 1e20;
+
+   fVecInt.clear();
+   fVecInt.push_back(-1);
+   fVecInt.push_back(0);
+   fVecInt.push_back(TMath::Limits<Int_t>::Max());
+   fVecLong64.clear();
+   fVecLong64.push_back(l64min);
+   fVecLong64.push_back(l64max);
+   fVecLong64.push_back(p53);
+   fVecULong64.clear();
+   fVecULong64.push_back(0);
+   fVecULong64.push_back(u64max);
+   fVecULong64.push_back(9223372036854775809ULL);  // 2^63 + 1
+   fVecDouble.clear();
+   fVecDouble.push_back(0.125);
+   fVecDouble.push_back(-7.5);
+   fVecDouble.push_back(1e20);
+   for (Int_t i = 0; i < nlarge; i++) fVecDouble.push_back(0.5 * i);
+   fVecString.clear();
+   fVecString.push_back("a");
+   fVecString.push_back("b c");
+   fVecString.push_back("\"quoted\"");
+   fMap.clear();
+   fMap[-3] = 0.25;
+   fMap[7] = 1e20;
+
+   if (fList) fList->Delete();
+   delete fList;
+   fList = new TList;
+   for (Int_t i = 0; i < 3 + nlarge; i++)
+      fList->Add(new TNamed(TString::Format("n%d", i), TString::Format("title %d", i)));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compare the members of basic types with the ones of another object.
+
+Bool_t JsonTestObject::SameBasic(const JsonTestObject &o) const
+{
+   if ((fBool != o.fBool) || (fChar != o.fChar) || (fUChar != o.fUChar) ||
+       (fShort != o.fShort) || (fUShort != o.fUShort) || (fInt != o.fInt) ||
+       (fUInt != o.fUInt) || (fLong != o.fLong) || (fULong != o.fULong) ||
+       (fLong64 != o.fLong64) || (fULong64 != o.fULong64) || (fFloat != o.fFloat) ||
+       (fDouble != o.fDouble) || (fBigDouble != o.fBigDouble) ||
+       (fString != o.fString) || (fStdString != o.fStdString))
+      return kFALSE;
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compare the array and container members with the ones of another object.
+
+Bool_t JsonTestObject::SameContainers(const JsonTestObject &o) const
+{
+   for (Int_t i = 0; i < 3; i++)
+      if (fIntArray[i] != o.fIntArray[i]) return kFALSE;
+   for (Int_t i = 0; i < 4; i++)
+      if (fLong64Array[i] != o.fLong64Array[i]) return kFALSE;
+   if (fN != o.fN) return kFALSE;
+   for (Int_t i = 0; i < fN; i++)
+      if (fValues[i] != o.fValues[i]) return kFALSE;
+
+   if ((fTArrayL64.GetSize() != o.fTArrayL64.GetSize()) || (fTArrayD.GetSize() != o.fTArrayD.GetSize()))
+      return kFALSE;
+   for (Int_t i = 0; i < fTArrayL64.GetSize(); i++)
+      if (fTArrayL64[i] != o.fTArrayL64[i]) return kFALSE;
+   for (Int_t i = 0; i < fTArrayD.GetSize(); i++)
+      if (fTArrayD[i] != o.fTArrayD[i]) return kFALSE;
+
+   if ((fVecInt != o.fVecInt) || (fVecLong64 != o.fVecLong64) || (fVecULong64 != o.fVecULong64) ||
+       (fVecDouble != o.fVecDouble) || (fVecString != o.fVecString) || (fMap != o.fMap))
+      return kFALSE;
+
+   if (!fList || !o.fList) return fList == o.fList;
+   if (fList->GetSize() != o.fList->GetSize()) return kFALSE;
+   TIter next1(fList), next2(o.fList);
+   TObject *obj1, *obj2;
+   while ((obj1 = next1()) && (obj2 = next2())) {
+      if ((obj1->IsA() != obj2->IsA()) || strcmp(obj1->GetName(), obj2->GetName()) ||
+          strcmp(obj1->GetTitle(), obj2->GetTitle()))
+         return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Write the object to JSON and read it back.
+
+static JsonTestObject *RoundTrip(const JsonTestObject &obj, Int_t compact)
+{
+   TString json = TBufferJSON::ConvertToJSON(&obj, compact);
+   TObject *res = TBufferJSON::ConvertFromJSON(json.Data());
+   JsonTestObject *copy = dynamic_cast<JsonTestObject *>(res);
+   if (!copy) delete res;
+   return copy;
+}
+
+Bool_t Test1()
+{
+   JsonTestObject obj;
+   obj.Fill();
+
+   Bool_t ok = kTRUE;
+   for (Int_t compact = 0; compact <= 3; compact += 3) {
+      JsonTestObject *copy = RoundTrip(obj, compact);
+      if (!copy || !copy->SameBasic(obj)) ok = kFALSE;
+      delete copy;
+   }
+
+   // an object with all members at default values must stay so
+   JsonTestObject empty;
+   JsonTestObject *copy = RoundTrip(empty, 0);
+   if (!copy || !copy->IsSame(empty)) ok = kFALSE;
+   delete copy;
+
+   return ok;
+}
+
+Bool_t Test2()
+{
+   JsonTestObject obj;
+   obj.Fill();
+
+   Bool_t ok = kTRUE;
+   for (Int_t compact = 0; compact <= 3; compact++) {
+      JsonTestObject *copy = RoundTrip(obj, compact);
+      if (!copy || !copy->SameContainers(obj)) ok = kFALSE;
+      delete copy;
+   }
+   return ok;
+}
+
+Bool_t Test3()
+{
+   // large enough to flush many chunks into the file
+   JsonTestObject obj;
+   obj.Fill(20000);
+
+   const char *fname = "stressJSON.json";
+   Bool_t ok = kTRUE;
+   for (Int_t compact = 0; compact <= 3; compact++) {
+      TString json = TBufferJSON::ConvertToJSON(&obj, compact);
+      Long64_t len = TBufferJSON::ExportToFile(fname, &obj, compact);
+      std::ifstream ifs(fname, std::ios::binary);
+      std::stringstream content;
+      content << ifs.rdbuf();
+      if ((len != json.Length()) || (content.str() != json.Data()))
+         ok = kFALSE;
+   }
+
+   // the exported file reads back into the same object
+   std::ifstream ifs(fname, std::ios::binary);
+   std::stringstream content;
+   content << ifs.rdbuf();
+   TObject *res = TBufferJSON::ConvertFromJSON(content.str().c_str());
+   JsonTestObject *copy = dynamic_cast<JsonTestObject *>(res);
+   if (!copy || !copy->IsSame(obj)) ok = kFALSE;
+   delete res;
+
+   gSystem->Unlink(fname);
+   return ok;
+}
+
+Int_t stressJSON()
+{
+   printf("**********************************************************************\n");
+   printf("******************Starting TBufferJSON stress test********************\n");
+   printf("**********************************************************************\n");
+
+   Bool_t ok1 = Test1();
+   printf("Test1: Round trip of basic types and 64-bit limits----------------- %s\n",
+          ok1 ? "OK" : "FAILED");
+   Bool_t ok2 = Test2();
+   printf("Test2: Round trip of arrays and containers------------------------- %s\n",
+          ok2 ? "OK" : "FAILED");
+   Bool_t ok3 = Test3();
+   printf("Test3: ExportToFile output identical to ConvertToJSON-------------- %s\n",
+          ok3 ? "OK" : "FAILED");
+
+   printf("**********************************************************************\n");
+   return (ok1 && ok2 && ok3) ? 0 : 1;
+}
+
+int main()
+{
+   return stressJSON();
+}
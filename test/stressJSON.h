@@ -0,0 +1,70 @@
+#ifndef ROOT_stressJSON
+#define ROOT_stressJSON
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// JsonTestObject                                                       //
+//                                                                      //
+// Object with members of all basic types and of several containers,    //
+// used by stressJSON to test TBufferJSON round trips                   //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include <string>
+#include <vector>
+#include <map>
+
+#include "TObject.h"
+#include "TString.h"
+#include "TArrayL64.h"
+#include "TArrayD.h"
+#include "TList.h"
+
+
+class JsonTestObject : public TObject {
+
+public:
+   Bool_t         fBool;
+   Char_t         fChar;
+   UChar_t        fUChar;
+   Short_t        fShort;
+   UShort_t       fUShort;
+   Int_t          fInt;
+   UInt_t         fUInt;
+   Long_t         fLong;
+   ULong_t        fULong;
+   Long64_t       fLong64;
+   ULong64_t      fULong64;
+   Float_t        fFloat;
+   Double_t       fDouble;
+   Double_t       fBigDouble;         //integral value beyond the Long64_t range
+   TString        fString;
+   std::string    fStdString;
+
+   Int_t          fIntArray[3];
+   Long64_t       fLong64Array[4];
+   Int_t          fN;
+   Double_t      *fValues;            //[fN]
+   TArrayL64      fTArrayL64;
+   TArrayD        fTArrayD;
+
+   std::vector<Int_t>        fVecInt;
+   std::vector<Long64_t>     fVecLong64;
+   std::vector<ULong64_t>    fVecULong64;
+   std::vector<Double_t>     fVecDouble;
+   std::vector<std::string>  fVecString;
+   std::map<Int_t, Double_t> fMap;
+   TList                    *fList;    //list of TNamed
+
+   JsonTestObject();
+   virtual ~JsonTestObject();
+
+   void   Fill(Int_t nlarge = 0);
+   Bool_t SameBasic(const JsonTestObject &o) const;
+   Bool_t SameContainers(const JsonTestObject &o) const;
+   Bool_t IsSame(const JsonTestObject &o) const { return SameBasic(o) && SameContainers(o); }
+
+   ClassDef(JsonTestObject,1)  //Object to test JSON round trips
+};
+
+#endif
@@ -84,11 +84,13 @@
 // Test  3 : Pseudo-Inverse, Moore-Penrose......................... OK  //
 // Test  4 : Eigen - Values/Vectors.................................OK  //
 // Test  5 : Decomposition Persistence..............................OK  //
+// Test  6 : Blocked Kernels vs. Reference Loops....................OK  //
 // *******************************************************************  //
 //                                                                      //
 //////////////////////////////////////////////////////////////////////////
 
 #include <stdlib.h>
+#include <vector>
 #include <Riostream.h>
 #include <TSystem.h>
 #include <TFile.h>
@@ -163,6 +165,8 @@ void   astress_lineqn              ();
 void   astress_pseudo              ();
 void   astress_eigen               (Int_t msize);
 void   astress_decomp_io           (Int_t msize);
+Bool_t astress_blocked_size        (Int_t msize,Double_t &seed,TMatrixD *res);
+void   astress_blocked             (Int_t maxSize);
 
 void   stress_backward_io          ();
 
@@ -276,6 +280,7 @@ void stressLinear(Int_t maxSizeReq,Int_t verbose)
     astress_pseudo();
     astress_eigen(5);
     astress_decomp_io(10);
+    astress_blocked(maxSize);
     std::cout << "******************************************************************" <<std::endl;
   }
 
@@ -4375,6 +4380,441 @@ void astress_decomp_io(Int_t msize)
   StatusPrint(5,"Decomposition Persistence",ok);
 }
 
+//------------------------------------------------------------------------
+//    Reference versions of the matrix product and of the Cholesky, LU
+//    (Crout) and symmetric eigen decompositions: the plain, unblocked and
+//    single threaded loops, used to check the blocked kernels
+//
+void ref_mult(const TMatrixD &a,Bool_t transa,const TMatrixD &b,Bool_t transb,TMatrixD &c)
+{
+  const Int_t m   = transa ? a.GetNcols() : a.GetNrows();
+  const Int_t k   = transa ? a.GetNrows() : a.GetNcols();
+  const Int_t n   = transb ? b.GetNrows() : b.GetNcols();
+  const Int_t lda = a.GetNcols();
+  const Int_t ldb = b.GetNcols();
+  const Double_t *pA = a.GetMatrixArray();
+  const Double_t *pB = b.GetMatrixArray();
+
+  c.ResizeTo(m,n);
+  Double_t *pC = c.GetMatrixArray();
+  for (Int_t i = 0; i < m; i++) {
+    for (Int_t j = 0; j < n; j++) {
+      Double_t r = 0.0;
+      for (Int_t l = 0; l < k; l++) {
+        const Double_t ail = transa ? pA[l*lda+i] : pA[i*lda+l];
+        const Double_t blj = transb ? pB[j*ldb+l] : pB[l*ldb+j];
+        r += ail*blj;
+      }
+      pC[i*n+j] = r;
+    }
+  }
+}
+
+Bool_t ref_chol(TMatrixD &u)
+{
+  const Int_t n  = u.GetNrows();
+  Double_t   *pU = u.GetMatrixArray();
+  for (Int_t icol = 0; icol < n; icol++) {
+    const Int_t rowOff = icol*n;
+    Double_t ujj = pU[rowOff+icol];
+    for (Int_t irow = 0; irow < icol; irow++)
+      ujj -= pU[irow*n+icol]*pU[irow*n+icol];
+    if (ujj <= 0)
+      return kFALSE;
+    ujj = TMath::Sqrt(ujj);
+    pU[rowOff+icol] = ujj;
+    for (Int_t j = icol+1; j < n; j++) {
+      for (Int_t i = 0; i < icol; i++)
+        pU[rowOff+j] -= pU[i*n+j]*pU[i*n+icol];
+    }
+    for (Int_t j = icol+1; j < n; j++)
+      pU[rowOff+j] /= ujj;
+  }
+  for (Int_t irow = 0; irow < n; irow++)
+    for (Int_t icol = 0; icol < irow; icol++)
+      pU[irow*n+icol] = 0.0;
+  return kTRUE;
+}
+
+Bool_t ref_lu_crout(TMatrixD &lu)
+{
+  const Int_t n   = lu.GetNcols();
+  Double_t   *pLU = lu.GetMatrixArray();
+
+  TVectorD scale(n);
+  for (Int_t i = 0; i < n; i++) {
+    Double_t max = 0.0;
+    for (Int_t j = 0; j < n; j++)
+      max = TMath::Max(max,TMath::Abs(pLU[i*n+j]));
+    scale(i) = (max == 0.0 ? 0.0 : 1.0/max);
+  }
+
+  for (Int_t j = 0; j < n; j++) {
+    const Int_t off_j = j*n;
+    for (Int_t i = 0; i < j; i++) {
+      Double_t r = pLU[i*n+j];
+      for (Int_t k = 0; k < i; k++)
+        r -= pLU[i*n+k]*pLU[k*n+j];
+      pLU[i*n+j] = r;
+    }
+
+    Double_t max = 0.0;
+    Int_t imax = 0;
+    for (Int_t i = j; i < n; i++) {
+      Double_t r = pLU[i*n+j];
+      for (Int_t k = 0; k < j; k++)
+        r -= pLU[i*n+k]*pLU[k*n+j];
+      pLU[i*n+j] = r;
+      const Double_t tmp = scale(i)*TMath::Abs(r);
+      if (tmp >= max) {
+        max = tmp;
+        imax = i;
+      }
+    }
+
+    if (j != imax) {
+      for (Int_t k = 0; k < n; k++) {
+        const Double_t tmp = pLU[imax*n+k];
+        pLU[imax*n+k] = pLU[off_j+k];
+        pLU[off_j+k]  = tmp;
+      }
+      scale(imax) = scale(j);
+    }
+
+    if (pLU[off_j+j] == 0.0)
+      return kFALSE;
+    const Double_t tmp = 1.0/pLU[off_j+j];
+    for (Int_t i = j+1; i < n; i++)
+      pLU[i*n+j] *= tmp;
+  }
+  return kTRUE;
+}
+
+void ref_sym_eigen(TMatrixD &v,TVectorD &d)
+{
+  const Int_t n  = v.GetNrows();
+  Double_t   *pV = v.GetMatrixArray();
+  TVectorD e(n);
+  d.ResizeTo(n);
+  Double_t *pD = d.GetMatrixArray();
+  Double_t *pE = e.GetMatrixArray();
+
+  // Householder reduction to tridiagonal form (tred2)
+  const Int_t off_n1 = (n-1)*n;
+  for (Int_t j = 0; j < n; j++)
+    pD[j] = pV[off_n1+j];
+
+  for (Int_t i = n-1; i > 0; i--) {
+    const Int_t off_i1 = (i-1)*n;
+    const Int_t off_i  = i*n;
+    Double_t scale = 0.0;
+    Double_t h = 0.0;
+    for (Int_t k = 0; k < i; k++)
+      scale += TMath::Abs(pD[k]);
+    if (scale == 0.0) {
+      pE[i] = pD[i-1];
+      for (Int_t j = 0; j < i; j++) {
+        pD[j] = pV[off_i1+j];
+        pV[off_i+j] = 0.0;
+        pV[j*n+i] = 0.0;
+      }
+    } else {
+      for (Int_t k = 0; k < i; k++) {
+        pD[k] /= scale;
+        h += pD[k]*pD[k];
+      }
+      Double_t f = pD[i-1];
+      Double_t g = TMath::Sqrt(h);
+      if (f > 0)
+        g = -g;
+      pE[i]   = scale*g;
+      h       = h-f*g;
+      pD[i-1] = f-g;
+      for (Int_t j = 0; j < i; j++)
+        pE[j] = 0.0;
+      for (Int_t j = 0; j < i; j++) {
+        f = pD[j];
+        pV[j*n+i] = f;
+        g = pE[j]+pV[j*n+j]*f;
+        for (Int_t k = j+1; k <= i-1; k++) {
+          g += pV[k*n+j]*pD[k];
+          pE[k] += pV[k*n+j]*f;
+        }
+        pE[j] = g;
+      }
+      f = 0.0;
+      for (Int_t j = 0; j < i; j++) {
+        pE[j] /= h;
+        f += pE[j]*pD[j];
+      }
+      const Double_t hh = f/(h+h);
+      for (Int_t j = 0; j < i; j++)
+        pE[j] -= hh*pD[j];
+      for (Int_t j = 0; j < i; j++) {
+        f = pD[j];
+        g = pE[j];
+        for (Int_t k = j; k <= i-1; k++)
+          pV[k*n+j] -= (f*pE[k]+g*pD[k]);
+        pD[j] = pV[off_i1+j];
+        pV[off_i+j] = 0.0;
+      }
+    }
+    pD[i] = h;
+  }
+
+  for (Int_t i = 0; i < n-1; i++) {
+    pV[off_n1+i] = pV[i*n+i];
+    pV[i*n+i] = 1.0;
+    const Double_t h = pD[i+1];
+    if (h != 0.0) {
+      for (Int_t k = 0; k <= i; k++)
+        pD[k] = pV[k*n+i+1]/h;
+      for (Int_t j = 0; j <= i; j++) {
+        Double_t g = 0.0;
+        for (Int_t k = 0; k <= i; k++)
+          g += pV[k*n+i+1]*pV[k*n+j];
+        for (Int_t k = 0; k <= i; k++)
+          pV[k*n+j] -= g*pD[k];
+      }
+    }
+    for (Int_t k = 0; k <= i; k++)
+      pV[k*n+i+1] = 0.0;
+  }
+  for (Int_t j = 0; j < n; j++) {
+    pD[j] = pV[off_n1+j];
+    pV[off_n1+j] = 0.0;
+  }
+  pV[off_n1+n-1] = 1.0;
+  pE[0] = 0.0;
+
+  // QL iterations (tql2)
+  for (Int_t i = 1; i < n; i++)
+    pE[i-1] = pE[i];
+  pE[n-1] = 0.0;
+
+  Double_t f = 0.0;
+  Double_t tst1 = 0.0;
+  const Double_t eps = TMath::Power(2.0,-52.0);
+  for (Int_t l = 0; l < n; l++) {
+    tst1 = TMath::Max(tst1,TMath::Abs(pD[l])+TMath::Abs(pE[l]));
+    Int_t m = l;
+    while (m < n) {
+      if (TMath::Abs(pE[m]) <= eps*tst1)
+        break;
+      m++;
+    }
+    if (m > l) {
+      Int_t iter = 0;
+      do {
+        if (iter++ == 30)
+          break;
+        Double_t g = pD[l];
+        Double_t p = (pD[l+1]-g)/(2.0*pE[l]);
+        Double_t r = TMath::Hypot(p,1.0);
+        if (p < 0)
+          r = -r;
+        pD[l] = pE[l]/(p+r);
+        pD[l+1] = pE[l]*(p+r);
+        const Double_t dl1 = pD[l+1];
+        Double_t h = g-pD[l];
+        for (Int_t i = l+2; i < n; i++)
+          pD[i] -= h;
+        f = f+h;
+
+        p = pD[m];
+        Double_t c = 1.0;
+        Double_t c2 = c;
+        Double_t c3 = c;
+        const Double_t el1 = pE[l+1];
+        Double_t s = 0.0;
+        Double_t s2 = 0.0;
+        for (Int_t i = m-1; i >= l; i--) {
+          c3 = c2;
+          c2 = c;
+          s2 = s;
+          g = c*pE[i];
+          h = c*p;
+          r = TMath::Hypot(p,pE[i]);
+          pE[i+1] = s*r;
+          s = pE[i]/r;
+          c = p/r;
+          p = c*pD[i]-s*g;
+          pD[i+1] = h+s*(c*g+s*pD[i]);
+          for (Int_t k = 0; k < n; k++) {
+            h = pV[k*n+i+1];
+            pV[k*n+i+1] = s*pV[k*n+i]+c*h;
+            pV[k*n+i]   = c*pV[k*n+i]-s*h;
+          }
+        }
+        p = -s*s2*c3*el1*pE[l]/dl1;
+        pE[l] = s*p;
+        pD[l] = c*p;
+      } while (TMath::Abs(pE[l]) > eps*tst1);
+    }
+    pD[l] = pD[l]+f;
+    pE[l] = 0.0;
+  }
+
+  // sort eigenvalues and corresponding vectors
+  for (Int_t i = 0; i < n-1; i++) {
+    Int_t k = i;
+    Double_t p = pD[i];
+    for (Int_t j = i+1; j < n; j++) {
+      if (pD[j] > p) {
+        k = j;
+        p = pD[j];
+      }
+    }
+    if (k != i) {
+      pD[k] = pD[i];
+      pD[i] = p;
+      for (Int_t j = 0; j < n; j++) {
+        p = pV[j*n+i];
+        pV[j*n+i] = pV[j*n+k];
+        pV[j*n+k] = p;
+      }
+    }
+  }
+}
+
+//------------------------------------------------------------------------
+//    Compare the blocked (and, with implicit multi-threading, parallel)
+//    products and decompositions with the reference loops, for sizes
+//    around and between the block sizes. The results must not depend on
+//    the number of threads.
+//
+Bool_t astress_blocked_size(Int_t msize,Double_t &seed,TMatrixD *res)
+{
+  Bool_t ok = kTRUE;
+  const Double_t tol = msize*msize*EPSILON;
+
+  // products of non-square matrices: op(A) is msize x (msize+3)
+  TMatrixD a(msize,msize+3);   a.Randomize(-1.0,1.0,seed);
+  TMatrixD at(msize+3,msize);  at.Randomize(-1.0,1.0,seed);
+  TMatrixD b(msize+3,msize-1 > 0 ? msize-1 : 1);
+  b.Randomize(-1.0,1.0,seed);
+  TMatrixD bt(b.GetNcols(),msize+3); bt.Randomize(-1.0,1.0,seed);
+
+  TMatrixD ref;
+  res[0].ResizeTo(a.GetNrows(),b.GetNcols());
+  res[0].Mult(a,b);
+  ref_mult(a,kFALSE,b,kFALSE,ref);
+  ok &= VerifyMatrixIdentity(res[0],ref,gVerbose,tol);
+
+  res[1].ResizeTo(at.GetNcols(),b.GetNcols());
+  res[1].TMult(at,b);
+  ref_mult(at,kTRUE,b,kFALSE,ref);
+  ok &= VerifyMatrixIdentity(res[1],ref,gVerbose,tol);
+
+  res[2].ResizeTo(a.GetNrows(),bt.GetNrows());
+  res[2].MultT(a,bt);
+  ref_mult(a,kFALSE,bt,kTRUE,ref);
+  ok &= VerifyMatrixIdentity(res[2],ref,gVerbose,tol);
+
+  // Cholesky of a positive definite matrix
+  TMatrixDSym s(msize);
+  s.RandomizePD(-1.0,1.0,seed);
+  {
+    TDecompChol chol(s);
+    ok &= chol.Decompose();
+    res[3].ResizeTo(msize,msize);
+    res[3] = chol.GetU();
+    ref.ResizeTo(msize,msize);
+    ref = s;
+    ok &= ref_chol(ref);
+    ok &= VerifyMatrixIdentity(res[3],ref,gVerbose,tol);
+  }
+
+  // LU (Crout with implicit pivoting) of a general matrix
+  {
+    TMatrixD g(msize,msize);
+    g.Randomize(-1.0,1.0,seed);
+    TDecompLU lu(g);
+    ok &= lu.Decompose();
+    res[4].ResizeTo(msize,msize);
+    res[4] = lu.GetLU();
+    ref.ResizeTo(msize,msize);
+    ref = g;
+    ok &= ref_lu_crout(ref);
+    ok &= VerifyMatrixIdentity(res[4],ref,gVerbose,tol);
+  }
+
+  // eigen values and vectors of a symmetric matrix
+  {
+    TMatrixDSym sg(msize);
+    sg.Randomize(-1.0,1.0,seed);
+    const TMatrixDSymEigen eigen(sg);
+    res[5].ResizeTo(msize,msize);
+    res[5] = eigen.GetEigenVectors();
+    res[6].ResizeTo(msize,1);
+    TMatrixDColumn(res[6],0) = eigen.GetEigenValues();
+    ref.ResizeTo(msize,msize);
+    ref = sg;
+    TVectorD refVal;
+    ref_sym_eigen(ref,refVal);
+    ok &= VerifyMatrixIdentity(res[5],ref,gVerbose,tol);
+    ok &= VerifyVectorIdentity(eigen.GetEigenValues(),refVal,gVerbose,tol);
+  }
+
+  if (gVerbose && !ok)
+    std::cout << "blocked kernels differ from reference for size " << msize << std::endl;
+
+  return ok;
+}
+
+void astress_blocked(Int_t maxSize)
+{
+  if (gVerbose)
+    std::cout << "\n---> Test blocked kernels against reference loops" << std::endl;
+
+  Bool_t ok = kTRUE;
+
+  // sizes below, at and above the block sizes of the kernels (16, 64, 128
+  // and 256), most of them not a multiple of any block size; only the largest
+  // ones are split among threads
+  std::vector<Int_t> sizes = { 1, 7, 63, 64, 65, 129, 301, 513 };
+  if (maxSize >= 1000)
+    sizes.push_back(1001);
+
+  const Int_t nres = 7;
+  for (UInt_t isize = 0; isize < sizes.size(); isize++) {
+    const Int_t msize = sizes[isize];
+    TMatrixD res1[nres];
+    TMatrixD res2[nres];
+
+    Double_t seed = 1.0+isize;
+#ifdef R__USE_IMT
+    ROOT::DisableImplicitMT();
+#endif
+    ok &= astress_blocked_size(msize,seed,res1);
+
+#ifdef R__USE_IMT
+    // same matrices with the implicit multi-threading: identical results
+    seed = 1.0+isize;
+    ROOT::EnableImplicitMT(4);
+    ok &= astress_blocked_size(msize,seed,res2);
+    ROOT::DisableImplicitMT();
+    for (Int_t i = 0; i < nres; i++) {
+      const Double_t *p1 = res1[i].GetMatrixArray();
+      const Double_t *p2 = res2[i].GetMatrixArray();
+      for (Int_t j = 0; j < res1[i].GetNoElements(); j++) {
+        if (p1[j] != p2[j]) {
+          if (gVerbose)
+            std::cout << "multi-threaded result " << i << " differs for size " << msize << std::endl;
+          ok = kFALSE;
+          break;
+        }
+      }
+    }
+#endif
+  }
+
+  if (gVerbose)
+    std::cout << "\nDone\n" << std::endl;
+
+  StatusPrint(6,"Blocked Kernels vs. Reference Loops",ok);
+}
+
 void stress_backward_io()
 {
   TFile::SetCacheFileDir(".");
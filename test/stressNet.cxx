@@ -0,0 +1,268 @@
+// @(#)root/test:$Id$
+
+/////////////////////////////////////////////////////////////////
+//
+//___A stress test for the TSocket/TMessage transport___
+//
+//   The functions below exchange messages over a local socket pair
+//   - Test1() - sends several large messages from a child process and
+//               checks the received content; the receive buffers come
+//               from the TMessage buffer pool and are reused, some of the
+//               messages are bigger than the largest pooled buffer, and
+//               the first one goes out as a gather write together with
+//               its streamer info message
+//   - Test2() - same as Test1(), but the sender is interrupted by a timer
+//               signal while blocked in sendmsg(), so that the gather
+//               write returns after a partial transfer and has to be
+//               resumed by TUnixSystem::UnixSendv()
+//   - Test3() - monitors one end of a socket pair via epoll (Root.UseEpoll)
+//               in the event loop; a descriptor that is readable and
+//               writable at the same time must get both notifications
+//
+//   To run in batch mode, do
+//     stressNet
+//
+//   An example of output when all tests pass:
+// **********************************************************************
+// ******************Starting TSocket/TMessage stress test***************
+// **********************************************************************
+// Test1: Large messages through the TMessage buffer pool------------- OK
+// Test2: Resuming interrupted gather writes-------------------------- OK
+// Test3: Read and write notifications via epoll---------------------- OK
+// **********************************************************************
+
+#include <stdio.h>
+#include <string.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/time.h>
+#include <sys/wait.h>
+#include <sys/socket.h>
+
+#include "TROOT.h"
+#include "TEnv.h"
+#include "TSystem.h"
+#include "TSysEvtHandler.h"
+#include "TSocket.h"
+#include "TMessage.h"
+#include "TNamed.h"
+#include "TString.h"
+
+Int_t stressNet();
+
+// message sizes, in bytes of payload: growing, shrinking (pooled buffers
+// reused for smaller messages) and beyond the 4 MB pool buffer limit
+static const Int_t kNMess = 8;
+static const Int_t kMessSize[kNMess] = { 3000000, 100000, 5000000, 1000000,
+                                         3000000, 64, 4200000, 2000000 };
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the payload of message i: every message has a different pattern, so
+/// that stale content of a reused pool buffer does not go unnoticed.
+
+static void FillPayload(TString &s, Int_t i)
+{
+   Int_t n = kMessSize[i];
+   s.Resize(n);
+   char *p = (char *)s.Data();
+   for (Int_t j = 0; j < n; j++)
+      p[j] = 'a' + (i*7 + j) % 26;
+}
+
+static void AlarmHandler(int) { }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Send all the messages through socket fd. With interrupt, a 1 ms timer
+/// interrupts the blocked sender. The handler is installed with SA_RESTART,
+/// so a sendmsg() that was interrupted before transferring anything is
+/// restarted by the kernel, while one that already transferred part of the
+/// data returns the partial count. Returns 0 if all messages were sent in
+/// full.
+
+static Int_t Sender(Int_t fd, Bool_t interrupt)
+{
+   TSocket sock(fd);
+   // small kernel buffers, so that each message needs many transfers
+   sock.SetOption(kSendBuffer, 8192);
+
+   if (interrupt) {
+      struct sigaction sa;
+      memset(&sa, 0, sizeof(sa));
+      sa.sa_handler = AlarmHandler;
+      sa.sa_flags = SA_RESTART;
+      sigaction(SIGALRM, &sa, 0);
+      struct itimerval it;
+      it.it_interval.tv_sec  = 0;
+      it.it_interval.tv_usec = 1000;
+      it.it_value = it.it_interval;
+      setitimer(ITIMER_REAL, &it, 0);
+   }
+
+   Int_t rc = 0;
+   TString payload;
+   for (Int_t i = 0; i < kNMess; i++) {
+      FillPayload(payload, i);
+      TNamed obj(TString::Format("mess%d", i), payload);
+      TMessage mess(kMESS_OBJECT);
+      // the first message carries the TNamed streamer info as well, which
+      // goes out in the same gather write
+      mess.EnableSchemaEvolution();
+      mess.WriteObject(&obj);
+      if (sock.Send(mess) != mess.Length()) {
+         rc = 1;
+         break;
+      }
+   }
+
+   if (interrupt) {
+      struct itimerval it;
+      memset(&it, 0, sizeof(it));
+      setitimer(ITIMER_REAL, &it, 0);
+   }
+   return rc;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Receive the messages from socket fd and compare them with the expected
+/// ones. The receiver sleeps a little between messages so that the sender
+/// blocks on the full socket buffer.
+
+static Bool_t Receiver(Int_t fd)
+{
+   TSocket sock(fd);
+   sock.SetOption(kRecvBuffer, 8192);
+
+   Bool_t ok = kTRUE;
+   TString payload;
+   for (Int_t i = 0; i < kNMess && ok; i++) {
+      gSystem->Sleep(20);
+      TMessage *mess = 0;
+      if (sock.Recv(mess) <= 0 || !mess || mess->What() != kMESS_OBJECT) {
+         ok = kFALSE;
+         delete mess;
+         break;
+      }
+      TNamed *obj = (TNamed *)mess->ReadObject(TNamed::Class());
+      FillPayload(payload, i);
+      if (!obj || TString::Format("mess%d", i) != obj->GetName() ||
+          payload != obj->GetTitle())
+         ok = kFALSE;
+      delete obj;
+      // returns the receive buffer to the pool for the next message
+      delete mess;
+   }
+   return ok;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Run the sender in a child process and the receiver in this process.
+
+static Bool_t Exchange(Bool_t interrupt)
+{
+   int fds[2];
+   if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+      printf("Exchange: socketpair failed\n");
+      return kFALSE;
+   }
+
+   pid_t pid = fork();
+   if (pid < 0) {
+      printf("Exchange: fork failed\n");
+      return kFALSE;
+   }
+   if (pid == 0) {
+      close(fds[0]);
+      _exit(Sender(fds[1], interrupt));
+   }
+
+   close(fds[1]);
+   Bool_t ok = Receiver(fds[0]);
+
+   int status = 0;
+   waitpid(pid, &status, 0);
+   if (!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+      ok = kFALSE;
+   return ok;
+}
+
+Bool_t Test1()
+{
+   return Exchange(kFALSE);
+}
+
+Bool_t Test2()
+{
+   return Exchange(kTRUE);
+}
+
+// counts the notifications it receives
+class TCountingHandler : public TFileHandler {
+public:
+   Int_t fNRead;
+   Int_t fNWrite;
+   TCountingHandler(Int_t fd) : TFileHandler(fd, kRead | kWrite), fNRead(0), fNWrite(0) { }
+   Bool_t ReadNotify() { fNRead++; return kTRUE; }
+   Bool_t WriteNotify() { fNWrite++; return kTRUE; }
+};
+
+Bool_t Test3()
+{
+#ifndef R__LINUX
+   // epoll is only available on Linux
+   return kTRUE;
+#else
+   int fds[2];
+   if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) < 0) {
+      printf("Test3: socketpair failed\n");
+      return kFALSE;
+   }
+
+   // epoll is switched on when the first file handler is added
+   gEnv->SetValue("Root.UseEpoll", 1);
+
+   // fds[0] is always writable, and readable once the peer has written
+   TCountingHandler h(fds[0]);
+   h.Add();
+   Bool_t ok = (write(fds[1], "x", 1) == 1);
+
+   // one event for a readable and writable descriptor notifies both
+   gSystem->DispatchOneEvent(kTRUE);
+   ok = ok && h.fNRead == 1 && h.fNWrite == 1;
+
+   // after draining the input only the write readiness remains
+   char c;
+   ok = ok && read(fds[0], &c, 1) == 1;
+   gSystem->DispatchOneEvent(kTRUE);
+   ok = ok && h.fNRead == 1 && h.fNWrite == 2;
+
+   h.Remove();
+   close(fds[0]);
+   close(fds[1]);
+   return ok;
+#endif
+}
+
+Int_t stressNet()
+{
+   printf("**********************************************************************\n");
+   printf("******************Starting TSocket/TMessage stress test***************\n");
+   printf("**********************************************************************\n");
+
+   Bool_t ok1 = Test1();
+   printf("Test1: Large messages through the TMessage buffer pool------------- %s\n",
+          ok1 ? "OK" : "FAILED");
+   Bool_t ok2 = Test2();
+   printf("Test2: Resuming interrupted gather writes-------------------------- %s\n",
+          ok2 ? "OK" : "FAILED");
+   Bool_t ok3 = Test3();
+   printf("Test3: Read and write notifications via epoll---------------------- %s\n",
+          ok3 ? "OK" : "FAILED");
+
+   printf("**********************************************************************\n");
+   return (ok1 && ok2 && ok3) ? 0 : 1;
+}
+
+int main()
+{
+   return stressNet();
+}
@@ -164,6 +164,12 @@ Int_t stressRooFit(const char* refFile, Bool_t writeRef, Int_t doVerbose, Int_t
   testList.push_back(new TestBasic802(fref,writeRef,doVerbose)) ;
   testList.push_back(new TestBasic803(fref,writeRef,doVerbose)) ;
   testList.push_back(new TestBasic804(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic901(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic902(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic903(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic904(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic905(fref,writeRef,doVerbose)) ;
+  testList.push_back(new TestBasic906(fref,writeRef,doVerbose)) ;
 
   cout << "*  Starting  S T R E S S  basic suite                            *" <<endl;
   cout << "******************************************************************" <<endl;
@@ -6444,3 +6444,582 @@ public:
   }
 } ;
 
+//////////////////////////////////////////////////////////////////////////
+//
+// 'BATCH EVALUATION' RooFit test #901
+//
+// Compare the unbinned likelihood calculated with the batch evaluation
+// of the p.d.f with the event-by-event one, also for p.d.f.s whose
+// normalization depends on conditional observables
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooPolynomial.h"
+#include "RooAddPdf.h"
+#include "RooProdPdf.h"
+#include "RooNLLVar.h"
+
+using namespace RooFit ;
+
+
+class TestBasic901 : public RooUnitTest
+{
+public:
+  TestBasic901(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Batch evaluation of unbinned likelihoods",refFile,writeRef,verbose) {} ;
+
+  // Compare the likelihoods of 'pdf' on 'data' with and without batch evaluation,
+  // at the current parameter values and after changing the value of 'par'
+  Bool_t compareNLL(RooAbsPdf& pdf, RooAbsData& data, RooRealVar& par, const RooCmdArg& arg=RooCmdArg::none()) {
+
+    Bool_t batchFlag = RooNLLVar::batchEvaluation() ;
+    Double_t par0 = par.getVal() ;
+    RooAbsReal* nllScalar = pdf.createNLL(data,arg) ;
+    RooAbsReal* nllBatch = pdf.createNLL(data,arg) ;
+
+    Bool_t ret = kTRUE ;
+    for (Int_t i=0 ; i<2 ; i++) {
+      par.setVal(par0 + i*0.3) ;
+      RooNLLVar::setBatchEvaluation(kFALSE) ;
+      Double_t valScalar = nllScalar->getVal() ;
+      RooNLLVar::setBatchEvaluation(kTRUE) ;
+      Double_t valBatch = nllBatch->getVal() ;
+      if (fabs(valBatch-valScalar) > 1e-10*fabs(valScalar)) {
+        if (_verb>0) {
+          cout << "TestBasic901 ERROR: likelihood of " << pdf.GetName() << " is " << valBatch
+               << " with batch evaluation and " << valScalar << " without" << endl ;
+        }
+        ret = kFALSE ;
+      }
+    }
+
+    RooNLLVar::setBatchEvaluation(batchFlag) ;
+    par.setVal(par0) ;
+    delete nllScalar ;
+    delete nllBatch ;
+    return ret ;
+  }
+
+  Bool_t testCode() {
+
+    // S u m   o f   p . d . f . s   w i t h   b a t c h   s u p p o r t
+    // -----------------------------------------------------------------
+
+    RooRealVar x("x","x",-10,10) ;
+    RooRealVar m("m","m",1,-10,10) ;
+    RooRealVar s("s","s",2,0.1,10) ;
+    RooGaussian g("g","g",x,m,s) ;
+
+    RooRealVar c("c","c",-0.1,-1,1) ;
+    RooExponential e("e","e",x,c) ;
+
+    RooRealVar f("f","f",0.4,0.,1.) ;
+    RooAddPdf sum("sum","sum",RooArgSet(g,e),f) ;
+
+    RooDataSet* data = sum.generate(x,2000) ;
+    Bool_t ret = compareNLL(sum,*data,m) ;
+    ret &= compareNLL(sum,*data,c) ;
+
+
+    // G a u s s i a n   w i t h   p e r - e v e n t   w i d t h
+    // ---------------------------------------------------------
+
+    // The normalization of gdx over x depends on the conditional observable dx,
+    // which changes from event to event
+    RooRealVar dx("dx","dx",0.5,5) ;
+    RooPolynomial pdx("pdx","pdx",dx) ;
+    RooGaussian gdx("gdx","gdx",x,m,dx) ;
+
+    RooDataSet* dxData = pdx.generate(dx,1000) ;
+    RooDataSet* condData = gdx.generate(x,ProtoData(*dxData)) ;
+    ret &= compareNLL(gdx,*condData,m,ConditionalObservables(dx)) ;
+
+    // The same as conditional term of a product
+    RooProdPdf model("model","model",RooArgSet(pdx),Conditional(gdx,x)) ;
+    ret &= compareNLL(model,*condData,m) ;
+
+    delete data ;
+    delete dxData ;
+    delete condData ;
+
+    return ret ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'PERSISTENT INTEGRAL STORE' RooFit test #902
+//
+// Write numeric integrals to the persistent store of the expensive object
+// cache, read them back, and check that an integrand that differs only
+// by the value of a constant does not reuse the stored value
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooConstVar.h"
+#include "RooGaussian.h"
+#include "RooRealIntegral.h"
+#include "RooExpensiveObjectCache.h"
+
+using namespace RooFit ;
+
+
+class TestBasic902 : public RooUnitTest
+{
+public:
+  TestBasic902(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Persistent store of numeric integrals",refFile,writeRef,verbose) {} ;
+
+  // Numeric integral over x of a Gaussian with a constant width. The objects
+  // have the same names for all widths.
+  Double_t integral(Double_t width) {
+    RooRealVar x("x","x",-3,3) ;
+    RooRealVar m("m","m",0.5,-10,10) ;
+    RooConstVar s("s","s",width) ;
+    RooGaussian g("g","g",x,m,s) ;
+    g.forceNumInt(kTRUE) ;
+
+    RooAbsReal* integ = g.createIntegral(x) ;
+    RooRealIntegral* rint = dynamic_cast<RooRealIntegral*>(integ) ;
+    if (rint) rint->setCacheNumeric(kTRUE) ;
+    Double_t val = integ->getVal() ;
+    delete integ ;
+
+    // Keep only the persistent store, not the values cached in memory by name
+    RooExpensiveObjectCache::instance().clearAll() ;
+    return val ;
+  }
+
+  Bool_t testCode() {
+
+    RooExpensiveObjectCache& cache = RooExpensiveObjectCache::instance() ;
+    TString fileName = Form("stressRooFit_intstore_%d.root",gSystem->GetPid()) ;
+    gSystem->Unlink(fileName) ;
+
+    // Calculate an integral and write it to the store
+    cache.setPersistentFile(fileName) ;
+    Double_t val1 = integral(1.) ;
+    Bool_t ret = !cache.writePersistentFile() ;
+
+    // Read the store again: the integral is not recalculated
+    cache.setPersistentFile(fileName) ;
+    Double_t val2 = integral(1.) ;
+    if (cache.numPersistentHits()!=1 || val2!=val1) {
+      if (_verb>0) cout << "TestBasic902 ERROR: stored integral " << val2 << " instead of " << val1 << endl ;
+      ret = kFALSE ;
+    }
+
+    // A different constant width gives a different integral
+    Double_t val3 = integral(2.) ;
+    if (cache.numPersistentHits()!=1 || fabs(val3-val1)<1e-6) {
+      if (_verb>0) cout << "TestBasic902 ERROR: stored integral reused for a different integrand" << endl ;
+      ret = kFALSE ;
+    }
+
+    cache.setPersistentFile(0) ;
+    gSystem->Unlink(fileName) ;
+
+    return ret ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'COMPACT DATASET STORAGE' RooFit test #903
+//
+// Store a real-valued column with float precision and a category column
+// as state indices, check the values after reduce() and after writing
+// and reading the dataset
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooCategory.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooVectorDataStore.h"
+#include "TMemFile.h"
+
+using namespace RooFit ;
+
+
+class TestBasic903 : public RooUnitTest
+{
+public:
+  TestBasic903(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Compact storage of dataset columns",refFile,writeRef,verbose) {} ;
+
+  // Values of x (exact in float precision), y and c in event i of the test dataset
+  static Double_t xValue(Int_t i) { return (i-500)/64. ; }
+  static Double_t yValue(Int_t i) { return 0.1*i ; }
+  static Int_t cIndex(Int_t i) { return 2*(i%3)-1 ; }
+
+  RooDataSet* makeData(RooRealVar& x, RooRealVar& y, RooCategory& c) {
+    RooDataSet* data = new RooDataSet("d","d",RooArgSet(x,y,c)) ;
+    for (Int_t i=0 ; i<1000 ; i++) {
+      x.setVal(xValue(i)) ;
+      y.setVal(yValue(i)) ;
+      c.setIndex(cIndex(i)) ;
+      data->add(RooArgSet(x,y,c)) ;
+    }
+    return data ;
+  }
+
+  // Check the events of a dataset selected from the test dataset, starting at event 'first'
+  Bool_t checkData(const RooAbsData& data, Int_t first, Int_t n, Bool_t floatY, const char* what) {
+    if (data.numEntries()!=n) {
+      if (_verb>0) cout << "TestBasic903 ERROR: " << what << " has " << data.numEntries() << " events instead of " << n << endl ;
+      return kFALSE ;
+    }
+    for (Int_t i=0 ; i<n ; i++) {
+      const RooArgSet* row = data.get(i) ;
+      Double_t y = floatY ? Float_t(yValue(first+i)) : yValue(first+i) ;
+      if (row->getRealValue("x")!=xValue(first+i) || row->getCatIndex("c")!=cIndex(first+i) ||
+	  (row->find("y") && row->getRealValue("y")!=y)) {
+	if (_verb>0) cout << "TestBasic903 ERROR: " << what << " event " << i << " is (" << row->getRealValue("x") << ","
+			  << row->getRealValue("y") << "," << row->getCatIndex("c") << ")" << endl ;
+	return kFALSE ;
+      }
+    }
+    return kTRUE ;
+  }
+
+  Bool_t testCode() {
+
+    RooRealVar x("x","x",-10,10) ;
+    RooRealVar y("y","y",0,100) ;
+    RooCategory c("c","c") ;
+    c.defineType("m",-1) ;
+    c.defineType("p",1) ;
+    c.defineType("q",3) ;
+
+    y.setAttribute("StoreAsFloat") ;
+    RooDataSet* data = makeData(x,y,c) ;
+    RooVectorDataStore* store = dynamic_cast<RooVectorDataStore*>(data->store()) ;
+    Bool_t ret = store && checkData(*data,0,1000,kTRUE,"float dataset") ;
+
+    // Selections keep the float precision
+    RooAbsData* sel = data->reduce(RooArgSet(x,y,c),"x>=0") ;
+    ret &= checkData(*sel,500,500,kTRUE,"reduced dataset") ;
+    delete sel ;
+
+    // Write and read the dataset
+    TMemFile f("stressRooFit_903.root","RECREATE") ;
+    f.WriteTObject(data,"d") ;
+    RooDataSet* dread = dynamic_cast<RooDataSet*>(f.Get("d")) ;
+    ret &= dread && checkData(*dread,0,1000,kTRUE,"dataset read from file") ;
+    delete dread ;
+
+    // The likelihood of the float column is that of the rounded values
+    y.setAttribute("StoreAsFloat",kFALSE) ;
+    RooDataSet* ddouble = new RooDataSet("dd","dd",RooArgSet(x,y,c)) ;
+    for (Int_t i=0 ; i<data->numEntries() ; i++) {
+      ddouble->add(*data->get(i)) ;
+    }
+    RooRealVar m("m","m",40,0,100) ;
+    RooRealVar s("s","s",30,1,100) ;
+    RooGaussian g("g","g",y,m,s) ;
+    RooAbsReal* nllf = g.createNLL(*data) ;
+    RooAbsReal* nlld = g.createNLL(*ddouble) ;
+    if (nllf->getVal()!=nlld->getVal()) {
+      if (_verb>0) cout << "TestBasic903 ERROR: likelihood of float column " << nllf->getVal() << " instead of " << nlld->getVal() << endl ;
+      ret = kFALSE ;
+    }
+    delete nllf ;
+    delete nlld ;
+    delete ddouble ;
+    delete data ;
+
+    return ret ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'PARALLEL GENERATION' RooFit test #904
+//
+// Generate events in worker processes with NumCPU() twice with the same
+// seed, and check that the two datasets are identical
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooProdPdf.h"
+#include "RooRandom.h"
+
+using namespace RooFit ;
+
+
+class TestBasic904 : public RooUnitTest
+{
+public:
+  TestBasic904(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Event generation in worker processes",refFile,writeRef,verbose) {} ;
+
+  // Check that two datasets hold the same events in the same order
+  Bool_t sameData(const RooDataSet& d1, const RooDataSet& d2) {
+    if (d1.numEntries()!=d2.numEntries()) {
+      if (_verb>0) cout << "TestBasic904 ERROR: " << d1.numEntries() << " events instead of " << d2.numEntries() << endl ;
+      return kFALSE ;
+    }
+    for (Int_t i=0 ; i<d1.numEntries() ; i++) {
+      const RooArgSet* row1 = d1.get(i) ;
+      Double_t x1 = row1->getRealValue("x") ;
+      Double_t y1 = row1->getRealValue("y") ;
+      const RooArgSet* row2 = d2.get(i) ;
+      if (x1!=row2->getRealValue("x") || y1!=row2->getRealValue("y")) {
+	if (_verb>0) cout << "TestBasic904 ERROR: event " << i << " differs" << endl ;
+	return kFALSE ;
+      }
+    }
+    return kTRUE ;
+  }
+
+  Bool_t testCode() {
+
+    // Exponential (accept/reject sampling) times Gaussian (internal generator)
+    RooRealVar x("x","x",0,10) ;
+    RooRealVar c("c","c",-0.3,-1.,0.) ;
+    RooExponential e("e","e",x,c) ;
+    RooRealVar y("y","y",-10,10) ;
+    RooRealVar m("m","m",0,-10,10) ;
+    RooRealVar s("s","s",2,0.1,10) ;
+    RooGaussian g("g","g",y,m,s) ;
+    RooProdPdf p("p","p",RooArgSet(e,g)) ;
+
+    RooRandom::randomGenerator()->SetSeed(904) ;
+    RooDataSet* d1 = p.generate(RooArgSet(x,y),10000,NumCPU(2)) ;
+    RooRandom::randomGenerator()->SetSeed(904) ;
+    RooDataSet* d2 = p.generate(RooArgSet(x,y),10000,NumCPU(2)) ;
+
+    Bool_t ret = d1 && d2 && d1->numEntries()==10000 && sameData(*d1,*d2) ;
+
+    delete d1 ;
+    delete d2 ;
+
+    return ret ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'BATCHED ACCEPT/REJECT SAMPLING' RooFit test #905
+//
+// Generate events with accept/reject sampling with the function evaluated
+// event by event and in blocks of trial events. With the same seed nearly
+// all events are the same (they may differ by rounding of the function
+// values), and the mean of both samples agrees with the expected one
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooExponential.h"
+#include "RooNumGenConfig.h"
+#include "RooRandom.h"
+
+using namespace RooFit ;
+
+
+class TestBasic905 : public RooUnitTest
+{
+public:
+  TestBasic905(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Batched accept/reject sampling",refFile,writeRef,verbose) {} ;
+
+  // Generate events with the given number of trial events evaluated together
+  RooDataSet* generate(RooAbsPdf& pdf, RooRealVar& x, Int_t blockSize) {
+    pdf.specialGeneratorConfig(kTRUE)->getConfigSection("RooAcceptReject").setRealValue("blockSize",blockSize) ;
+    RooRandom::randomGenerator()->SetSeed(905) ;
+    return pdf.generate(x,20000) ;
+  }
+
+  // Check that the mean of x in the dataset agrees with the expected one within 5 standard deviations
+  Bool_t checkMean(RooDataSet& data, RooRealVar& x, Double_t mean, Double_t rms, const char* what) {
+    Double_t dmean = data.mean(x) ;
+    if (fabs(dmean-mean)>5*rms/sqrt(1.0*data.numEntries())) {
+      if (_verb>0) cout << "TestBasic905 ERROR: mean of " << what << " is " << dmean << " instead of " << mean << endl ;
+      return kFALSE ;
+    }
+    return kTRUE ;
+  }
+
+  Bool_t testCode() {
+
+    RooRealVar x("x","x",0,10) ;
+    RooRealVar c("c","c",-0.3,-1.,0.) ;
+    RooExponential e("e","e",x,c) ;
+
+    RooDataSet* d1 = generate(e,x,1) ;
+    RooDataSet* d2 = generate(e,x,1024) ;
+    e.setGeneratorConfig() ;
+
+    if (d1->numEntries()!=20000 || d2->numEntries()!=20000) {
+      if (_verb>0) cout << "TestBasic905 ERROR: " << d1->numEntries() << " and " << d2->numEntries() << " events generated" << endl ;
+      delete d1 ;
+      delete d2 ;
+      return kFALSE ;
+    }
+
+    Int_t nSame(0) ;
+    for (Int_t i=0 ; i<d1->numEntries() ; i++) {
+      Double_t x1 = d1->get(i)->getRealValue("x") ;
+      if (x1==d2->get(i)->getRealValue("x")) nSame++ ;
+    }
+    Bool_t ret = kTRUE ;
+    if (nSame<0.99*d1->numEntries()) {
+      if (_verb>0) cout << "TestBasic905 ERROR: only " << nSame << " events are the same" << endl ;
+      ret = kFALSE ;
+    }
+
+    // Mean and RMS of the exponential distribution with slope l in [0,L]
+    const Double_t l(0.3), L(10) ;
+    const Double_t r = L*exp(-l*L)/(1-exp(-l*L)) ;
+    const Double_t mean = 1/l - r ;
+    const Double_t rms = sqrt(1/(l*l) - r*r*exp(l*L)) ;
+    ret &= checkMean(*d1,x,mean,rms,"events generated event by event") ;
+    ret &= checkMean(*d2,x,mean,rms,"events generated in blocks") ;
+
+    delete d1 ;
+    delete d2 ;
+
+    return ret ;
+  }
+} ;
+//////////////////////////////////////////////////////////////////////////
+//
+// 'LIKELIHOOD IN THREADS' RooFit test #906
+//
+// Calculate a likelihood with NumCPU() partitions in threads (with
+// RooAbsTestStatistic::setMultiThreaded) and in forked server processes
+// for a scan of the parameters. Both must give exactly the same values,
+// which agree with the serial calculation up to the rounding of the
+// partial sums, and the same fit results. With implicit multi-threading
+// support the thread partitions run in parallel
+//
+/////////////////////////////////////////////////////////////////////////
+
+#ifndef __CINT__
+#include "RooGlobalFunc.h"
+#endif
+#include "RooRealVar.h"
+#include "RooDataSet.h"
+#include "RooGaussian.h"
+#include "RooExponential.h"
+#include "RooAddPdf.h"
+#include "RooAbsTestStatistic.h"
+#include "RooRandom.h"
+#include "TROOT.h"
+
+using namespace RooFit ;
+
+
+class TestBasic906 : public RooUnitTest
+{
+public:
+  TestBasic906(TFile* refFile, Bool_t writeRef, Int_t verbose) : RooUnitTest("Likelihood calculation in threads",refFile,writeRef,verbose) {} ;
+
+  // Fit the model with the likelihood calculated in two partitions and return the fitted parameters
+  void fit(RooAbsPdf& p, RooDataSet& data, RooArgList& params, Double_t* values) {
+    const Double_t start[4] = { 0, 2, -0.2, 0.6 } ;
+    for (Int_t i=0 ; i<params.getSize() ; i++) {
+      ((RooRealVar*)params.at(i))->setVal(start[i]) ;
+    }
+    p.fitTo(data,NumCPU(2),PrintLevel(-1)) ;
+    for (Int_t i=0 ; i<params.getSize() ; i++) {
+      values[i] = ((RooRealVar*)params.at(i))->getVal() ;
+    }
+  }
+
+  Bool_t testCode() {
+
+    RooRealVar x("x","x",-10,10) ;
+    RooRealVar m("m","m",0,-10,10) ;
+    RooRealVar s("s","s",2,0.1,10) ;
+    RooGaussian g("g","g",x,m,s) ;
+    RooRealVar c("c","c",-0.2,-1.,0.) ;
+    RooExponential e("e","e",x,c) ;
+    RooRealVar f("f","f",0.6,0.,1.) ;
+    RooAddPdf p("p","p",RooArgList(g,e),f) ;
+
+    RooRandom::randomGenerator()->SetSeed(906) ;
+    RooDataSet* data = p.generate(x,10000) ;
+
+    // Bulk and interleaved partitions in forked processes and in threads
+    RooAbsReal* nll = p.createNLL(*data) ;
+    RooAbsReal* nllProc = p.createNLL(*data,NumCPU(3)) ;
+    RooAbsReal* nllProcInterl = p.createNLL(*data,NumCPU(3,1)) ;
+    RooAbsTestStatistic::setMultiThreaded(kTRUE) ;
+    RooAbsReal* nllThread = p.createNLL(*data,NumCPU(3)) ;
+    RooAbsReal* nllThreadInterl = p.createNLL(*data,NumCPU(3,1)) ;
+    RooAbsTestStatistic::setMultiThreaded(kFALSE) ;
+
+#ifdef R__USE_IMT
+    ROOT::EnableImplicitMT(3) ;
+#endif
+
+    Bool_t ret = kTRUE ;
+    for (Int_t i=0 ; i<10 ; i++) {
+      m.setVal(-1+0.25*i) ;
+      s.setVal(1.5+0.1*i) ;
+      if (i%2==0) f.setVal(0.4+0.04*i) ;
+      Double_t v = nll->getVal() ;
+      Double_t vProc = nllProc->getVal() ;
+      Double_t vThread = nllThread->getVal() ;
+      Double_t vProcInterl = nllProcInterl->getVal() ;
+      Double_t vThreadInterl = nllThreadInterl->getVal() ;
+      if (vThread!=vProc || vThreadInterl!=vProcInterl) {
+	if (_verb>0) cout << "TestBasic906 ERROR: likelihood in threads " << vThread << " " << vThreadInterl
+			  << " instead of " << vProc << " " << vProcInterl << " in processes" << endl ;
+	ret = kFALSE ;
+      }
+      if (fabs(vThread-v)>1e-10*fabs(v) || fabs(vThreadInterl-v)>1e-10*fabs(v)) {
+	if (_verb>0) cout << "TestBasic906 ERROR: likelihood in threads " << vThread << " " << vThreadInterl
+			  << " instead of " << v << endl ;
+	ret = kFALSE ;
+      }
+    }
+
+    // Fits with the likelihood calculated in processes and in threads
+    RooArgList params(m,s,c,f) ;
+    Double_t procValues[4], threadValues[4] ;
+    fit(p,*data,params,procValues) ;
+    RooAbsTestStatistic::setMultiThreaded(kTRUE) ;
+    fit(p,*data,params,threadValues) ;
+    RooAbsTestStatistic::setMultiThreaded(kFALSE) ;
+    for (Int_t i=0 ; i<4 ; i++) {
+      if (fabs(threadValues[i]-procValues[i])>1e-8) {
+	if (_verb>0) cout << "TestBasic906 ERROR: fitted " << params.at(i)->GetName() << " is " << threadValues[i]
+			  << " in threads and " << procValues[i] << " in processes" << endl ;
+	ret = kFALSE ;
+      }
+    }
+
+#ifdef R__USE_IMT
+    ROOT::DisableImplicitMT() ;
+#endif
+
+    delete nll ;
+    delete nllProc ;
+    delete nllProcInterl ;
+    delete nllThread ;
+    delete nllThreadInterl ;
+    delete data ;
+
+    return ret ;
+  }
+} ;
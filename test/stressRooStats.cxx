@@ -192,6 +192,12 @@ Int_t stressRooStats(const char* refFile, Bool_t writeRef, Int_t verbose, Bool_t
    testList.push_back(new TestHypoTestInverter2(fref, writeRef, verbose, kFrequentist, kProfileLROneSided, 10, 0.95));
    testList.push_back(new TestHypoTestInverter2(fref, writeRef, verbose, kHybrid, kSimpleLR, 10, 0.95));
 
+   // 49 TEST TOYMCSAMPLER REPRODUCIBILITY WITH WORKER PROCESSES
+   testList.push_back(new TestToyMCSamplerMultiProcess(fref, writeRef, verbose, 2));
+
+   // 50 TEST HTI PARALLEL FIXED SCAN
+   testList.push_back(new TestHypoTestInverterParallel(fref, writeRef, verbose, 2));
+
 
    TString suiteType = TString::Format(" Starting S.T.R.E.S.S. %s",
                                        allTests ? "full suite" : (oneTest ? TString::Format("test %d", testNumber).Data() : "basic suite")
@@ -1394,6 +1394,7 @@ public:
 #include "RooStats/ToyMCSampler.h"
 #include "RooStats/HypoTestInverterPlot.h"
 #include "RooStats/SamplingDistPlot.h"
+#include "RooRandom.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 //
@@ -1755,6 +1756,213 @@ public:
 };
 
 
+///////////////////////////////////////////////////////////////////////////////
+//
+// TOYMCSAMPLER - WORKER PROCESSES - ON / OFF MODEL
+//
+// Test that the toys run by the ToyMCSampler in local worker processes are
+// reproducible: two runs with the same seed of RooRandom must give the same
+// sampling distribution, in the same order.
+//
+// ModelConfig (explicit) : Poisson On / Off Model
+//    built in stressRooStats_models.cxx
+//
+// Input Parameters:
+//    nWorkers -> number of worker processes
+//
+///////////////////////////////////////////////////////////////////////////////
+
+class TestToyMCSamplerMultiProcess : public RooUnitTest {
+private:
+   Int_t fNWorkers;
+
+public:
+   TestToyMCSamplerMultiProcess(
+      TFile* refFile,
+      Bool_t writeRef,
+      Int_t verbose,
+      Int_t nWorkers = 2
+   ) :
+      RooUnitTest(TString::Format("ToyMCSampler Reproducibility - On / Off Model - %d Worker Processes", nWorkers),
+                  refFile, writeRef, verbose),
+      fNWorkers(nWorkers)
+   {};
+
+   Bool_t testCode() {
+
+      const Int_t nToys = 200;
+
+      // Build workspace and model
+      RooWorkspace* w = new RooWorkspace("w");
+      buildOnOffModel(w);
+      w->var("sig")->setVal(20);
+      w->var("bkg")->setVal(100);
+      w->var("tau")->setVal(1);
+      w->var("tau")->setConstant();
+      ModelConfig *sbModel = (ModelConfig *)w->obj("S+B");
+
+      ProfileLikelihoodTestStat pll(*sbModel->GetPdf());
+      ToyMCSampler sampler(pll, nToys);
+      sampler.SetPdf(*sbModel->GetPdf());
+      sampler.SetObservables(*sbModel->GetObservables());
+      sampler.SetParametersForTestStat(*sbModel->GetParametersOfInterest());
+      sampler.SetNEventsPerToy(1);
+      sampler.SetNWorkers(fNWorkers);
+
+      RooArgSet* paramPoint = (RooArgSet*)RooArgSet(*w->var("sig"), *w->var("bkg")).snapshot();
+
+      RooRandom::randomGenerator()->SetSeed(44);
+      SamplingDistribution* sd1 = sampler.GetSamplingDistribution(*paramPoint);
+      RooRandom::randomGenerator()->SetSeed(44);
+      SamplingDistribution* sd2 = sampler.GetSamplingDistribution(*paramPoint);
+
+      Bool_t ret = sd1 && sd2;
+      if (ret) {
+         const std::vector<Double_t>& v1 = sd1->GetSamplingDistribution();
+         const std::vector<Double_t>& v2 = sd2->GetSamplingDistribution();
+         if (Int_t(v1.size()) != nToys || v1 != v2) {
+            Error("testCode", "sampling distributions of %u and %u toys differ", (UInt_t)v1.size(), (UInt_t)v2.size());
+            ret = kFALSE;
+         }
+      }
+
+      // cleanup
+      delete sd1;
+      delete sd2;
+      delete paramPoint;
+      delete w;
+
+      return ret ;
+   }
+};
+
+
+///////////////////////////////////////////////////////////////////////////////
+//
+// HYPOTESTINVERTER PARALLEL FIXED SCAN - POISSON EFFICIENCY MODEL
+//
+// Test the fixed scan of the HypoTestInverter run in local worker processes.
+// With the AsymptoticCalculator, which does not use random numbers, the
+// parallel scan must give the same points and CLs values as the serial scan.
+// With the FrequentistCalculator, two parallel scans with the same seed of
+// RooRandom must give identical results.
+//
+// ModelConfig (explicit) : Poisson Efficiency Model
+//    built in stressRooStats_models.cxx
+//
+// Input Parameters:
+//    nWorkers -> number of worker processes
+//
+///////////////////////////////////////////////////////////////////////////////
+
+class TestHypoTestInverterParallel : public RooUnitTest {
+private:
+   Int_t fNWorkers;
+
+public:
+   TestHypoTestInverterParallel(
+      TFile* refFile,
+      Bool_t writeRef,
+      Int_t verbose,
+      Int_t nWorkers = 2
+   ) :
+      RooUnitTest(TString::Format("HypoTestInverter Parallel Fixed Scan - Poisson Efficiency Model - %d Worker Processes", nWorkers),
+                  refFile, writeRef, verbose),
+      fNWorkers(nWorkers)
+   {};
+
+   // Run a fixed scan of the signal with the given calculator and number of worker processes
+   HypoTestInverterResult *runScan(RooWorkspace *w, ECalculatorType calculatorType, Int_t nWorkers, Int_t npoints) {
+      w->loadSnapshot("initialVariables");
+      ModelConfig *sbModel = (ModelConfig *)w->obj("S+B");
+      ModelConfig *bModel = (ModelConfig *)w->obj("B");
+
+      HypoTestCalculatorGeneric *calc =
+         buildHypoTestCalculator(calculatorType, *w->data("data"), *sbModel, *bModel, 50, 50);
+      if(calculatorType == kAsymptotic) ((AsymptoticCalculator *)calc)->SetOneSided(kTRUE);
+      HypoTestInverter hti(*calc, NULL, 0.05);
+      TestStatistic *testStat = buildTestStatistic(kProfileLROneSided, *sbModel, *bModel);
+      hti.SetTestStatistic(*testStat);
+      hti.SetFixedScan(npoints, w->var("sig")->getMin(), w->var("sig")->getMax());
+      hti.SetNWorkers(nWorkers);
+
+      ToyMCSampler *tmcs = (ToyMCSampler *)hti.GetHypoTestCalculator()->GetTestStatSampler();
+      tmcs->SetNEventsPerToy(1);
+      tmcs->SetUseMultiGen(kTRUE);
+
+      HypoTestInverterResult *result = hti.GetInterval();
+
+      delete calc;
+      delete testStat;
+      return result;
+   }
+
+   // Compare the points and CLs values of two scans
+   Bool_t compareScans(HypoTestInverterResult &r1, HypoTestInverterResult &r2, Double_t tolerance, const char *what) {
+      if (r1.ArraySize() == 0 || r1.ArraySize() != r2.ArraySize()) {
+         Error("compareScans", "%s: scans have %d and %d points", what, r1.ArraySize(), r2.ArraySize());
+         return kFALSE;
+      }
+      for (Int_t i = 0; i < r1.ArraySize(); ++i) {
+         if (r1.GetXValue(i) != r2.GetXValue(i) || !TMath::AreEqualAbs(r1.CLs(i), r2.CLs(i), tolerance)) {
+            Error("compareScans", "%s: point %d is (%f,%f) instead of (%f,%f)", what, i,
+                  r2.GetXValue(i), r2.CLs(i), r1.GetXValue(i), r1.CLs(i));
+            return kFALSE;
+         }
+      }
+      return kTRUE;
+   }
+
+   Bool_t testCode() {
+
+      // Create workspace and model
+      RooWorkspace *w = new RooWorkspace("w");
+      buildPoissonEfficiencyModel(w);
+      ModelConfig *sbModel = (ModelConfig *)w->obj("S+B");
+      ModelConfig *bModel = (ModelConfig *)w->obj("B");
+
+      // add observed value to data set
+      w->var("x")->setVal(10);
+      w->data("data")->add(*sbModel->GetObservables());
+
+      // set snapshots
+      sbModel->SetSnapshot(*sbModel->GetParametersOfInterest());
+      w->var("sig")->setVal(0);
+      bModel->SetSnapshot(*bModel->GetParametersOfInterest());
+
+      const RooArgSet * initialVariables = sbModel->GetPdf()->getVariables();
+      w->saveSnapshot("initialVariables",*initialVariables);
+      delete initialVariables;
+
+      AsymptoticCalculator::SetPrintLevel(_verb);
+
+      // serial and parallel asymptotic scans
+      HypoTestInverterResult *serial = runScan(w, kAsymptotic, 0, 20);
+      HypoTestInverterResult *parallel = runScan(w, kAsymptotic, fNWorkers, 20);
+      Bool_t ret = compareScans(*serial, *parallel, 1e-6, "serial and parallel asymptotic scans");
+      if (ret && !TMath::AreEqualAbs(serial->UpperLimit(), parallel->UpperLimit(), 1e-6)) {
+         Error("testCode", "upper limit of parallel scan %f instead of %f", parallel->UpperLimit(), serial->UpperLimit());
+         ret = kFALSE;
+      }
+      delete serial;
+      delete parallel;
+
+      // parallel frequentist scans with the same seed
+      RooRandom::randomGenerator()->SetSeed(45);
+      HypoTestInverterResult *toys1 = runScan(w, kFrequentist, fNWorkers, 5);
+      RooRandom::randomGenerator()->SetSeed(45);
+      HypoTestInverterResult *toys2 = runScan(w, kFrequentist, fNWorkers, 5);
+      ret &= compareScans(*toys1, *toys2, 0, "parallel frequentist scans with the same seed");
+      delete toys1;
+      delete toys2;
+
+      delete w;
+
+      return ret ;
+   }
+};
+
+
 //
 // END OF PART FIVE
 //
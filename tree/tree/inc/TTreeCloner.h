@@ -33,7 +33,9 @@ namespace std {
 }
 #endif
 
+class TBasket;
 class TBranch;
+class TEntryList;
 class TTree;
 class TFileCacheRead;
 
@@ -66,6 +68,9 @@ class TTreeCloner {
    TFileCacheRead *fFileCache;   ///< File Cache used to reduce the number of individual reads
    TFileCacheRead *fPrevCache;   ///< Cache that set before the TTreeCloner ctor for the 'from' TTree if any.
 
+   TEntryList            *fEntryList;        ///< Selection of the entries to be copied, if any.
+   std::vector<Long64_t>  fSelectedEntries;  ///< Sorted entry numbers (in the 'from' TTree) taken from fEntryList.
+
    enum ECloneMethod {
       kDefault             = 0,
       kSortBasketsByBranch = 1,
@@ -94,6 +99,8 @@ class TTreeCloner {
    void CreateCache();
    UInt_t FillCache(UInt_t from);
    void RestoreCache();
+   Bool_t CopyEntryBytes(TBranch *to, const char *data, Int_t nbytes);
+   void   WriteSelectedBaskets(UInt_t ibranch, TBasket *rawbasket);
 
 private:
    TTreeCloner(const TTreeCloner&) = delete;
@@ -123,8 +130,10 @@ public:
    Bool_t IsValid() { return fIsValid; }
    Bool_t NeedConversion() { return fNeedConversion; }
    void   SetCacheSize(Int_t size);
+   void   SetEntryList(TEntryList *list);
    void   SortBaskets();
    void   WriteBaskets();
+   void   WriteSelectedBaskets();
 
    ClassDef(TTreeCloner,0); // helper used for the fast cloning of TTrees.
 };
@@ -3529,6 +3529,10 @@ Long64_t TTree::CopyEntries(TTree* tree, Long64_t nentries /* = -1 */, Option_t*
 /// Example macro to copy a subset of a tree to a new tree.
 /// Only selected entries are copied to the new tree.
 /// NOTE that only the active branches are copied.
+///
+/// If option contains "fast", the baskets of the selected entries are
+/// transferred with TTreeCloner: the fully selected baskets are copied
+/// without being unzipped (see TTreePlayer::CopyTree).
 
 TTree* TTree::CopyTree(const char* selection, Option_t* option /* = 0 */, Long64_t nentries /* = TTree::kMaxEntries */, Long64_t firstentry /* = 0 */)
 {
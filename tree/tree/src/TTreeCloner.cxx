@@ -34,9 +34,16 @@ Class implementing or helping  the various TTree cloning method
 #include "TLeafO.h"
 #include "TLeafC.h"
 #include "TFileCacheRead.h"
+#include "TEntryList.h"
+#include "TROOT.h"
+#include "TVirtualMutex.h"
 
 #include <algorithm>
 
+#ifdef R__USE_IMT
+#include "tbb/task_group.h"
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////
 
 Bool_t TTreeCloner::CompareSeek::operator()(UInt_t i1, UInt_t i2)
@@ -121,7 +128,8 @@ TTreeCloner::TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t option
    fToStartEntries(0),
    fCacheSize(0LL),
    fFileCache(nullptr),
-   fPrevCache(nullptr)
+   fPrevCache(nullptr),
+   fEntryList(nullptr)
 {
    TString opt(method);
    opt.ToLower();
@@ -196,6 +204,16 @@ Bool_t TTreeCloner::Exec()
    if (!IsValid()) {
       return kFALSE;
    }
+   if (fEntryList) {
+      // The cluster boundaries of the input do not apply to the selected
+      // subset and the baskets are not read in a pre-computed order, so
+      // neither the cluster ranges nor the read cache are used.
+      CopyStreamerInfos();
+      CopyProcessIds();
+      CloseOutWriteBaskets();
+      WriteSelectedBaskets();
+      return kTRUE;
+   }
    CreateCache();
    ImportClusterRanges();
    CopyStreamerInfos();
@@ -664,6 +682,69 @@ void TTreeCloner::SetCacheSize(Int_t size)
    // beginning of Exec.
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Restrict the copy to the entries of the 'from' TTree listed in 'list'.
+///
+/// The baskets whose entries are all selected are transferred without
+/// being unzipped, exactly as for a full copy.  The baskets that are only
+/// partially selected are unzipped and the bytes of the selected entries
+/// are appended to the baskets of the output branch, which are then
+/// compressed again.  When implicit multi-threading is enabled, the
+/// branches are processed in parallel; the writes to the output file are
+/// serialized.
+///
+/// This requires the entries to be self-contained in their basket, i.e.
+/// that none of the branches made use of the buffer's object map (see
+/// TBranch::kDoNotUseBufferMap) and, in addition, that the output file
+/// does not yet contain any TProcessID (otherwise the references in the
+/// re-serialized entries would need to be shifted).  If this is not the
+/// case the cloner is marked invalid and NeedConversion() returns true:
+/// the selected entries must then be copied with GetEntry/Fill.
+///
+/// The caller is in charge of updating the number of entries of the
+/// output TTree, by the number of entries in 'list'.
+
+void TTreeCloner::SetEntryList(TEntryList *list)
+{
+   fEntryList = list;
+   fSelectedEntries.clear();
+   if (!list || !IsValid()) {
+      return;
+   }
+
+   if (fToTree->GetCurrentFile()->GetNProcessIDs() != 0) {
+      fWarningMsg.Form("The output file (%s) already contains TProcessID, the selected entries of %s can not be copied without being unstreamed.",
+                       fToTree->GetCurrentFile()->GetName(), fFromTree->GetName());
+      if (!(fOptions & kNoWarnings)) {
+         Warning("TTreeCloner::SetEntryList", "%s", fWarningMsg.Data());
+      }
+      fIsValid = kFALSE;
+      fNeedConversion = kTRUE;
+      return;
+   }
+   for(Int_t i=0; i<fFromBranches.GetEntries(); ++i) {
+      TBranch *from = (TBranch*)fFromBranches.UncheckedAt(i);
+      TBranch *to   = (TBranch*)fToBranches.UncheckedAt(i);
+      if (!from->TestBit(TBranch::kDoNotUseBufferMap) || (from->GetEntryOffsetLen() && !to->GetEntryOffsetLen())) {
+         fWarningMsg.Form("The entries of the branch %s can not be copied individually without being unstreamed.",
+                          from->GetName());
+         if (!(fOptions & kNoWarnings)) {
+            Warning("TTreeCloner::SetEntryList", "%s", fWarningMsg.Data());
+         }
+         fIsValid = kFALSE;
+         fNeedConversion = kTRUE;
+         return;
+      }
+   }
+
+   fSelectedEntries.reserve(list->GetN());
+   for(Long64_t entry = list->GetN() ? list->GetEntry(0) : -1; entry >= 0; entry = list->Next()) {
+      fSelectedEntries.push_back(entry);
+   }
+   std::sort(fSelectedEntries.begin(), fSelectedEntries.end());
+   fSelectedEntries.erase(std::unique(fSelectedEntries.begin(), fSelectedEntries.end()), fSelectedEntries.end());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sort the basket according to the user request.
 
@@ -760,3 +841,155 @@ void TTreeCloner::WriteBaskets()
    }
    delete basket;
 }
+
+////////////////////////////////////////////////////////////////////////////////
+/// Append the 'nbytes' bytes of one entry to the write basket of the branch
+/// 'to', as TBranch::Fill would have done after streaming the entry.
+/// Return true if the basket is full and must be written.
+
+Bool_t TTreeCloner::CopyEntryBytes(TBranch *to, const char *data, Int_t nbytes)
+{
+   TBasket *basket = (TBasket*)to->GetListOfBaskets()->At(to->GetWriteBasket());
+   if (!basket) {
+      {
+         R__LOCKGUARD_IMT2(gROOTMutex); // Lock for parallel TTree I/O
+         basket = fToTree->CreateBasket(to);
+      }
+      ++to->fNBaskets;
+      to->fBaskets.AddAtAndExpand(basket,to->fWriteBasket);
+   }
+   TBuffer *buf = basket->GetBufferRef();
+   if (buf->IsReading()) {
+      basket->SetWriteMode();
+   }
+
+   Int_t lold = buf->Length();
+   basket->Update(lold);
+   ++to->fEntries;
+   ++to->fEntryNumber;
+   buf->WriteFastArray(data, nbytes);
+
+   Int_t nsize = 0;
+   if (to->fEntryOffsetLen) {
+      nsize = basket->GetNevBuf() * sizeof(Int_t);
+   } else if (!basket->GetNevBufSize()) {
+      basket->SetNevBufSize(nbytes);
+   }
+   return (buf->Length() + (2 * nsize) + nbytes) >= to->fBasketSize;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the selected entries of one branch.  'rawbasket' is a scratch
+/// basket used to transfer the fully selected baskets.
+
+void TTreeCloner::WriteSelectedBaskets(UInt_t ibranch, TBasket *rawbasket)
+{
+   TBranch *from = (TBranch*)fFromBranches.UncheckedAt( ibranch );
+   TBranch *to   = (TBranch*)fToBranches.UncheckedAt( ibranch );
+
+   TFile *tofile = to->GetFile(0);
+   TFile *fromfile = from->GetFile(0);
+
+   Long64_t nselected = fSelectedEntries.size();
+   Bool_t hasData = kFALSE;
+
+   for(Int_t index = 0; index <= from->GetWriteBasket(); ++index) {
+      Long64_t first = from->GetBasketEntry()[index];
+      Long64_t last = index < from->GetWriteBasket() ? from->GetBasketEntry()[index+1] : from->GetEntries();
+      auto begin = std::lower_bound(fSelectedEntries.begin(), fSelectedEntries.end(), first);
+      auto end = std::lower_bound(begin, fSelectedEntries.end(), last);
+      if (begin == end) {
+         continue;
+      }
+
+      Long64_t pos = from->GetBasketSeek(index);
+      if (pos != 0 && (end - begin) == (last - first)) {
+         // All the entries are selected, transfer the basket as is.
+         R__LOCKGUARD_IMT2(gROOTMutex); // Lock for parallel TTree I/O
+
+         // The basket must follow the entries already added.
+         TBasket *wbasket = (TBasket*)to->GetListOfBaskets()->At(to->GetWriteBasket());
+         if (wbasket && wbasket->GetNevBuf()) {
+            to->WriteBasket(wbasket,to->GetWriteBasket());
+            wbasket = (TBasket*)to->GetListOfBaskets()->At(to->GetWriteBasket());
+         }
+         if (wbasket) {
+            wbasket->DropBuffers();
+            delete wbasket;
+            --to->fNBaskets;
+            to->fBaskets[to->GetWriteBasket()] = 0;
+         }
+
+         if (from->GetBasketBytes()[index] == 0) {
+            from->GetBasketBytes()[index] = rawbasket->ReadBasketBytes(pos, fromfile);
+         }
+         Int_t len = from->GetBasketBytes()[index];
+
+         rawbasket->LoadBasketBuffers(pos,len,fromfile,fFromTree);
+         rawbasket->CopyTo(tofile);
+         to->AddBasket(*rawbasket,kTRUE,to->fEntryNumber);
+         to->AddLastBasket(to->fEntryNumber);
+         hasData = kTRUE;
+         continue;
+      }
+
+      // Only some of the entries are selected (or the basket is not on
+      // disk): unzip the basket and copy the bytes of each selected entry.
+      TBasket *basket = from->GetBasket(index);
+      if (!basket || basket->GetNevBuf() == 0) {
+         continue;
+      }
+      hasData = kTRUE;
+      TBuffer *buf = basket->GetBufferRef();
+      Int_t nevbuf = basket->GetNevBuf();
+      Int_t lastbyte = buf->IsReading() ? basket->GetLast() : buf->Length();
+      for(auto iter = begin; iter != end; ++iter) {
+         Int_t i = (Int_t)(*iter - first);
+         Int_t start = basket->GetEntryPointer(i);
+         Int_t stop = (i+1) < nevbuf ? basket->GetEntryPointer(i+1) : lastbyte;
+         if (CopyEntryBytes(to, buf->Buffer() + start, stop - start)) {
+            R__LOCKGUARD_IMT2(gROOTMutex); // Lock for parallel TTree I/O
+            to->WriteBasket((TBasket*)to->GetListOfBaskets()->At(to->GetWriteBasket()),to->GetWriteBasket());
+         }
+      }
+      if (pos != 0) {
+         from->DropBaskets();
+      }
+   }
+
+   // Non-terminal 'object' branches do not hold any data but still
+   // record the number of entries (see CopyMemoryBaskets).
+   if (!hasData && from->GetEntries() != 0) {
+      to->SetEntries(to->GetEntries() + nselected);
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Transfer the selected entries from the input file to the output file,
+/// branch by branch (in parallel when implicit multi-threading is enabled).
+
+void TTreeCloner::WriteSelectedBaskets()
+{
+   UInt_t nbranches = fFromBranches.GetEntries();
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && fFromTree->GetImplicitMT() && nbranches > 1) {
+      tbb::task_group g;
+      for(UInt_t i = 0; i < nbranches; ++i) {
+         g.run([this, i]() {
+            TBasket *rawbasket = new TBasket();
+            WriteSelectedBaskets(i, rawbasket);
+            delete rawbasket;
+         });
+      }
+      g.wait();
+      return;
+   }
+#endif
+
+   TBasket *rawbasket = new TBasket();
+   for(UInt_t i = 0; i < nbranches; ++i) {
+      WriteSelectedBaskets(i, rawbasket);
+   }
+   delete rawbasket;
+}
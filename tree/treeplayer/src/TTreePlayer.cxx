@@ -75,6 +75,7 @@ extra libraries (Histogram, display, etc).
 #include "TRefArrayProxy.h"
 #include "TVirtualMonitoring.h"
 #include "TTreeCache.h"
+#include "TTreeCloner.h"
 #include "TStyle.h"
 
 #include "HFitInterface.h"
@@ -177,8 +178,15 @@ TVirtualIndex *TTreePlayer::BuildIndex(const TTree *T, const char *majorname, co
 ///   TTree *T2 = T->CopyTree("fNtrack<595");
 ///   T2->Write();
 /// ~~~
+///
+/// If option contains "fast" and this tree is not a TChain, the selected
+/// entries are first collected in a TEntryList and then transferred with
+/// TTreeCloner: the baskets whose entries are all selected are copied
+/// without being unzipped, and only the partially selected baskets are
+/// unzipped and filtered (see TTreeCloner::SetEntryList).  If this is not
+/// possible for this tree, the entries are copied one by one.
 
-TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentries,
+TTree *TTreePlayer::CopyTree(const char *selection, Option_t *option, Long64_t nentries,
                              Long64_t firstentry)
 {
 
@@ -213,6 +221,13 @@ TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentrie
       fFormulaList->Add(select);
    }
 
+   TString opt = option;
+   opt.ToLower();
+   TEntryList *selected = 0;
+   if (opt.Contains("fast") && fTree->GetTree() == fTree && fTree->GetCurrentFile()) {
+      selected = new TEntryList(fTree);
+   }
+
    //loop on the specified entries
    Int_t tnumber = -1;
    for (entry=firstentry;entry<firstentry+nentries;entry++) {
@@ -232,10 +247,32 @@ TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentrie
          }
          if (!keep) continue;
       }
+      if (selected) {
+         selected->Enter(localEntry);
+         continue;
+      }
       fTree->GetEntry(entryNumber);
       tree->Fill();
    }
    fFormulaList->Clear();
+
+   if (selected) {
+      TTreeCloner cloner(fTree, tree, option, TTreeCloner::kNoWarnings);
+      cloner.SetEntryList(selected);
+      if (cloner.IsValid()) {
+         tree->SetEntries(tree->GetEntries() + selected->GetN());
+         cloner.Exec();
+      } else {
+         if (!cloner.NeedConversion()) {
+            Warning("CopyTree", "%s", cloner.GetWarning());
+         }
+         for (Long64_t e = selected->GetN() ? selected->GetEntry(0) : -1; e >= 0; e = selected->Next()) {
+            fTree->GetEntry(e);
+            tree->Fill();
+         }
+      }
+      delete selected;
+   }
    return tree;
 }
 